@@ -0,0 +1,101 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "vec/common/hash_table/join_hash_table.h"
+
+namespace doris {
+
+// Probe a join hash table of string keys whose chains hold many rows of different keys,
+// as a duplicate heavy build side colliding in few buckets does. state.range(0) is the
+// number of buckets, state.range(1) is 1 to use the hash tags of the keys, 0 to give all
+// the rows the same tag, so that every row of a chain has its key compared.
+static void BM_JoinHashTableProbeLongChains(benchmark::State& state) {
+    state.PauseTiming();
+    constexpr size_t build_rows = 1 << 16;
+    constexpr size_t probe_rows = 4096;
+    constexpr size_t distinct_keys = 1024;
+    const auto num_buckets = static_cast<uint32_t>(state.range(0));
+    const bool use_tags = state.range(1) != 0;
+
+    std::vector<std::string> values(distinct_keys * 2);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = "join_key_with_a_common_prefix_" + std::to_string(i);
+    }
+    using Table = JoinHashTable<StringRef>;
+    Table table;
+    auto make_keys = [&](size_t rows, size_t num_values, std::mt19937& rng,
+                         std::vector<StringRef>* keys, std::vector<uint32_t>* buckets,
+                         std::vector<uint8_t>* tags) {
+        std::uniform_int_distribution<size_t> dist(0, num_values - 1);
+        keys->resize(rows);
+        buckets->resize(rows);
+        tags->resize(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            const auto& value = values[dist(rng)];
+            (*keys)[i] = StringRef(value.data(), value.size());
+            size_t hash_value = table.hash((*keys)[i]);
+            (*buckets)[i] = hash_value % num_buckets;
+            (*tags)[i] = use_tags ? Table::hash_tag(hash_value) : 0;
+        }
+    };
+
+    std::mt19937 rng(42);
+    std::vector<StringRef> build_keys;
+    std::vector<uint32_t> build_buckets;
+    std::vector<uint8_t> build_tags;
+    make_keys(build_rows, distinct_keys, rng, &build_keys, &build_buckets, &build_tags);
+    table.prepare_build<TJoinOp::LEFT_SEMI_JOIN>(build_rows, probe_rows, false);
+    table.build(build_keys.data(), build_buckets.data(), build_rows, false, build_tags.data());
+
+    // half of the probe keys are not in the build side
+    std::vector<StringRef> probe_keys;
+    std::vector<uint32_t> probe_buckets;
+    std::vector<uint8_t> probe_tags;
+    make_keys(probe_rows, distinct_keys * 2, rng, &probe_keys, &probe_buckets, &probe_tags);
+    DorisVector<uint32_t> build_idx_map(probe_buckets.begin(), probe_buckets.end());
+    table.pre_build_idxs(build_idx_map);
+    std::vector<uint32_t> probe_idxs(probe_rows + 1);
+    std::vector<uint32_t> build_idxs(probe_rows + 1);
+    bool probe_visited = false;
+    state.ResumeTiming();
+
+    for (auto _ : state) {
+        int probe_idx = 0;
+        while (probe_idx < static_cast<int>(probe_rows)) {
+            auto [new_probe_idx, new_build_idx, matched] =
+                    table.find_batch<TJoinOp::LEFT_SEMI_JOIN>(
+                            probe_keys.data(), probe_tags.data(), build_idx_map.data(),
+                            probe_idx, 0, probe_rows, probe_idxs.data(), probe_visited,
+                            build_idxs.data(), nullptr, false, false, false);
+            probe_idx = new_probe_idx;
+            benchmark::DoNotOptimize(matched);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * probe_rows);
+}
+
+BENCHMARK(BM_JoinHashTableProbeLongChains)
+        ->ArgsProduct({{64, 1024}, {0, 1}})
+        ->Unit(benchmark::kMicrosecond);
+
+} // namespace doris
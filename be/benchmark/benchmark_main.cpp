@@ -18,6 +18,8 @@
 #include <benchmark/benchmark.h>
 
 #include "benchmark_bit_pack.hpp"
+#include "benchmark_join_hash_table.hpp"
+#include "benchmark_stream_load_pipe.hpp"
 #include "binary_cast_benchmark.hpp"
 #include "vec/core/block.h"
 #include "vec/data_types/data_type.h"
@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+#include <event2/buffer.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "http/utils.h"
+#include "io/fs/stream_load_pipe.h"
+#include "util/byte_buffer.h"
+
+namespace doris {
+
+// Ingest throughput of a stream load body from the evbuffer of the http request to a
+// reader of the pipe. state.range(0) is 1 to move the evbuffer chains into the pipe,
+// 0 to copy them into new 128KB buffers as on_chunk_data does without zero copy.
+static void BM_StreamLoadPipeIngest(benchmark::State& state) {
+    const bool zero_copy = state.range(0) != 0;
+    constexpr size_t total_bytes = 256 << 20;
+    // libevent reads the socket in pieces of about this size
+    constexpr size_t socket_read_size = 16 << 10;
+    constexpr size_t reads_per_callback = 64;
+    std::string data(socket_read_size, 'x');
+    evbuffer* evbuf = evbuffer_new();
+
+    for (auto _ : state) {
+        auto pipe = std::make_shared<io::StreamLoadPipe>();
+        std::thread consumer([&pipe]() {
+            std::vector<char> buf(1 << 20);
+            size_t bytes_read = 0;
+            do {
+                if (!pipe->read_at(0, Slice(buf.data(), buf.size()), &bytes_read).ok()) {
+                    return;
+                }
+            } while (bytes_read > 0);
+        });
+        for (size_t sent = 0; sent < total_bytes; sent += socket_read_size * reads_per_callback) {
+            for (size_t i = 0; i < reads_per_callback; ++i) {
+                evbuffer_add(evbuf, data.data(), data.size());
+            }
+            if (zero_copy) {
+                size_t moved_bytes = 0;
+                static_cast<void>(move_evbuffer_to_sink(evbuf, pipe.get(), &moved_bytes));
+                continue;
+            }
+            while (evbuffer_get_length(evbuf) > 0) {
+                ByteBufferPtr bb;
+                static_cast<void>(ByteBuffer::allocate(128 * 1024, &bb));
+                bb->pos = evbuffer_remove(evbuf, bb->ptr, bb->capacity);
+                bb->flip();
+                static_cast<void>(pipe->append(bb));
+            }
+        }
+        static_cast<void>(pipe->finish());
+        consumer.join();
+    }
+    state.SetBytesProcessed(state.iterations() * total_bytes);
+    evbuffer_free(evbuf);
+}
+
+BENCHMARK(BM_StreamLoadPipeIngest)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+} // namespace doris
@@ -23,6 +23,7 @@
 #include "cloud/config.h"
 #include "olap/tablet_fwd.h"
 #include "runtime/exec_env.h"
+#include "util/time.h"
 
 namespace doris {
 
@@ -42,6 +43,50 @@ void TabletHotspot::count(const BaseTablet& tablet) {
     counter->cur_counter++;
 }
 
+void TabletHotspot::count_columns(const BaseTablet& tablet,
+                                  const std::vector<int32_t>& column_unique_ids) {
+    int64_t now = UnixSeconds();
+    auto& slot = _columns_access[tablet.table_id() % s_column_slot_size];
+    std::lock_guard lock(slot.mtx);
+    auto& columns = slot.map[tablet.table_id()];
+    for (int32_t unique_id : column_unique_ids) {
+        columns[unique_id] = now;
+    }
+}
+
+std::unordered_set<int32_t> TabletHotspot::get_accessed_columns(int64_t table_id,
+                                                                int64_t window_s) {
+    std::unordered_set<int32_t> accessed_columns;
+    int64_t since = UnixSeconds() - window_s;
+    auto& slot = _columns_access[table_id % s_column_slot_size];
+    std::lock_guard lock(slot.mtx);
+    if (auto iter = slot.map.find(table_id); iter != slot.map.end()) {
+        for (const auto& [unique_id, last_access_time] : iter->second) {
+            if (last_access_time >= since) {
+                accessed_columns.insert(unique_id);
+            }
+        }
+    }
+    return accessed_columns;
+}
+
+void TabletHotspot::evict_column_access(int64_t window_s) {
+    int64_t since = UnixSeconds() - window_s;
+    for (auto& slot : _columns_access) {
+        std::lock_guard lock(slot.mtx);
+        for (auto iter = slot.map.begin(); iter != slot.map.end();) {
+            std::erase_if(iter->second, [since](const auto& column) {
+                return column.second < since;
+            });
+            if (iter->second.empty()) {
+                iter = slot.map.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+}
+
 TabletHotspot::TabletHotspot() {
     _counter_thread = std::thread(&TabletHotspot::make_dot_point, this);
 }
@@ -204,6 +249,7 @@ void TabletHotspot::make_dot_point() {
             std::for_each(counters.begin(), counters.end(),
                           [](HotspotCounterPtr& counter) { counter->make_dot_point(); });
         });
+        evict_column_access(config::file_cache_warm_up_column_access_window_s);
     }
 }
 
@@ -21,6 +21,7 @@
 #include <chrono>
 #include <condition_variable>
 #include <memory>
+#include <unordered_set>
 
 #include "gen_cpp/BackendService.h"
 #include "olap/tablet.h"
@@ -69,6 +70,13 @@ public:
     ~TabletHotspot();
     // When query the tablet, count it
     void count(const BaseTablet& tablet);
+    // When query the columns of the tablet, record their access time for the table of the tablet
+    void count_columns(const BaseTablet& tablet, const std::vector<int32_t>& column_unique_ids);
+    // Get the unique ids of the columns of the table accessed in the last `window_s` seconds
+    std::unordered_set<int32_t> get_accessed_columns(int64_t table_id, int64_t window_s);
+    // Forget the columns not accessed in the last `window_s` seconds, and the tables left without
+    // any column
+    void evict_column_access(int64_t window_s);
     void get_top_n_hot_partition(std::vector<THotTableMessage>* hot_tables);
 
 private:
@@ -80,6 +88,14 @@ private:
     };
     static constexpr size_t s_slot_size = 1024;
     std::array<HotspotMap, s_slot_size> _tablets_hotspot;
+
+    struct ColumnAccessMap {
+        std::mutex mtx;
+        // table_id -> column unique id -> last access time in seconds
+        std::unordered_map<int64_t, std::unordered_map<int32_t, int64_t>> map;
+    };
+    static constexpr size_t s_column_slot_size = 64;
+    std::array<ColumnAccessMap, s_column_slot_size> _columns_access;
     std::thread _counter_thread;
     bool _closed {false};
     std::mutex _mtx;
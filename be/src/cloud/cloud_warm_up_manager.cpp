@@ -24,13 +24,20 @@
 #include <cstddef>
 #include <tuple>
 
+#include "cloud/cloud_tablet_hotspot.h"
 #include "cloud/cloud_tablet_mgr.h"
+#include "cloud/config.h"
 #include "common/logging.h"
+#include "gen_cpp/segment_v2.pb.h"
 #include "io/cache/block_file_cache_downloader.h"
 #include "olap/rowset/beta_rowset.h"
 #include "olap/rowset/segment_v2/inverted_index_desc.h"
+#include "olap/rowset/segment_v2/ordinal_page_index.h"
+#include "olap/rowset/segment_v2/segment_writer.h"
 #include "olap/tablet.h"
 #include "runtime/exec_env.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
 #include "util/time.h"
 
 namespace doris {
@@ -75,9 +82,16 @@ void CloudWarmUpManager::submit_download_tasks(io::Path path, int64_t file_size,
         }
     }
 
+    submit_range_download_tasks(std::move(path), file_size, 0, file_size, std::move(file_system),
+                                expiration_time, std::move(wait));
+}
+
+void CloudWarmUpManager::submit_range_download_tasks(
+        io::Path path, int64_t file_size, int64_t offset, int64_t size,
+        io::FileSystemSPtr file_system, int64_t expiration_time,
+        std::shared_ptr<bthread::CountdownEvent> wait) {
     const int64_t chunk_size = 10 * 1024 * 1024; // 10MB
-    int64_t offset = 0;
-    int64_t remaining_size = file_size;
+    int64_t remaining_size = size;
 
     while (remaining_size > 0) {
         int64_t current_chunk_size = std::min(chunk_size, remaining_size);
@@ -108,6 +122,128 @@ void CloudWarmUpManager::submit_download_tasks(io::Path path, int64_t file_size,
     }
 }
 
+// Footer := SegmentFooterPB, FooterPBSize(4), FooterPBChecksum(4), MagicNumber(4)
+static Status read_segment_footer(const io::FileReaderSPtr& file_reader,
+                                  segment_v2::SegmentFooterPB* footer, int64_t* footer_offset) {
+    auto file_size = static_cast<int64_t>(file_reader->size());
+    if (file_size < 12) {
+        return Status::Corruption("Bad segment file {}: file size {} < 12",
+                                  file_reader->path().native(), file_size);
+    }
+    uint8_t fixed_buf[12];
+    size_t bytes_read = 0;
+    io::IOContext io_ctx {.is_index_data = true};
+    RETURN_IF_ERROR(
+            file_reader->read_at(file_size - 12, Slice(fixed_buf, 12), &bytes_read, &io_ctx));
+    if (memcmp(fixed_buf + 8, segment_v2::k_segment_magic,
+               segment_v2::k_segment_magic_length) != 0) {
+        return Status::Corruption("Bad segment file {}: magic number not match",
+                                  file_reader->path().native());
+    }
+    uint32_t footer_length = decode_fixed32_le(fixed_buf);
+    if (file_size < 12 + footer_length) {
+        return Status::Corruption("Bad segment file {}: file size {} < {}",
+                                  file_reader->path().native(), file_size, 12 + footer_length);
+    }
+    std::string footer_buf;
+    footer_buf.resize(footer_length);
+    *footer_offset = file_size - 12 - footer_length;
+    RETURN_IF_ERROR(file_reader->read_at(*footer_offset, footer_buf, &bytes_read, &io_ctx));
+    if (crc32c::Value(footer_buf.data(), footer_buf.size()) != decode_fixed32_le(fixed_buf + 4)) {
+        return Status::Corruption("Bad segment file {}: footer checksum not match",
+                                  file_reader->path().native());
+    }
+    if (!footer->ParseFromString(footer_buf)) {
+        return Status::Corruption("Bad segment file {}: failed to parse footer",
+                                  file_reader->path().native());
+    }
+    return Status::OK();
+}
+
+// Get the byte range [*begin, *end) of the data pages of the column and of its sub columns,
+// from the ordinal index of each of them.
+static Status column_data_range(const io::FileReaderSPtr& file_reader,
+                                const segment_v2::ColumnMetaPB& column_meta, uint32_t num_rows,
+                                int64_t* begin, int64_t* end) {
+    for (const auto& index_meta : column_meta.indexes()) {
+        if (index_meta.type() != segment_v2::ORDINAL_INDEX) {
+            continue;
+        }
+        segment_v2::OrdinalIndexReader ordinal_index(file_reader, num_rows,
+                                                     index_meta.ordinal_index());
+        RETURN_IF_ERROR(ordinal_index.load(false, false, nullptr));
+        for (auto iter = ordinal_index.begin(); iter.valid(); iter.next()) {
+            const auto& page = iter.page();
+            *begin = std::min(*begin, static_cast<int64_t>(page.offset));
+            *end = std::max(*end, static_cast<int64_t>(page.offset + page.size));
+        }
+    }
+    for (const auto& child_meta : column_meta.children_columns()) {
+        RETURN_IF_ERROR(column_data_range(file_reader, child_meta, num_rows, begin, end));
+    }
+    return Status::OK();
+}
+
+Status CloudWarmUpManager::get_selective_download_ranges(
+        const io::FileReaderSPtr& file_reader, const std::unordered_set<int32_t>& column_uids,
+        std::vector<std::pair<int64_t, int64_t>>* ranges) {
+    auto file_size = static_cast<int64_t>(file_reader->size());
+    segment_v2::SegmentFooterPB footer;
+    int64_t footer_offset = 0;
+    RETURN_IF_ERROR(read_segment_footer(file_reader, &footer, &footer_offset));
+
+    // Skip the data pages of the columns which are not selected, the remaining bytes are the
+    // data of the selected columns, the dictionaries, the indexes and the footer.
+    std::vector<std::pair<int64_t, int64_t>> skipped_ranges;
+    for (const auto& column_meta : footer.columns()) {
+        if (column_uids.contains(static_cast<int32_t>(column_meta.unique_id()))) {
+            continue;
+        }
+        int64_t begin = footer_offset;
+        int64_t end = 0;
+        RETURN_IF_ERROR(
+                column_data_range(file_reader, column_meta, footer.num_rows(), &begin, &end));
+        if (begin < end) {
+            skipped_ranges.emplace_back(begin, end);
+        }
+    }
+    std::sort(skipped_ranges.begin(), skipped_ranges.end());
+    int64_t offset = 0;
+    for (const auto& [begin, end] : skipped_ranges) {
+        if (begin > offset) {
+            ranges->emplace_back(offset, begin - offset);
+        }
+        offset = std::max(offset, end);
+    }
+    if (file_size > offset) {
+        ranges->emplace_back(offset, file_size - offset);
+    }
+    return Status::OK();
+}
+
+Status CloudWarmUpManager::submit_selective_download_tasks(
+        io::Path path, int64_t file_size, io::FileSystemSPtr file_system,
+        const std::unordered_set<int32_t>& column_uids, int64_t expiration_time,
+        std::shared_ptr<bthread::CountdownEvent> wait) {
+    io::FileReaderOptions reader_options {
+            .cache_type = config::enable_file_cache ? io::FileCachePolicy::FILE_BLOCK_CACHE
+                                                    : io::FileCachePolicy::NO_CACHE,
+            .is_doris_table = true,
+            .cache_base_path = "",
+            .file_size = file_size,
+    };
+    io::FileReaderSPtr file_reader;
+    RETURN_IF_ERROR(file_system->open_file(path, &file_reader, &reader_options));
+    file_size = static_cast<int64_t>(file_reader->size());
+    std::vector<std::pair<int64_t, int64_t>> ranges;
+    RETURN_IF_ERROR(get_selective_download_ranges(file_reader, column_uids, &ranges));
+    for (const auto& [offset, size] : ranges) {
+        submit_range_download_tasks(path, file_size, offset, size, file_system, expiration_time,
+                                    wait);
+    }
+    return Status::OK();
+}
+
 void CloudWarmUpManager::handle_jobs() {
 #ifndef BE_TEST
     constexpr int WAIT_TIME_SECONDS = 600;
@@ -148,6 +284,18 @@ void CloudWarmUpManager::handle_jobs() {
 
             auto tablet_meta = tablet->tablet_meta();
             auto rs_metas = snapshot_rs_metas(tablet.get());
+            // Columns of the selective warm-up, it is a full warm-up when it is empty
+            std::unordered_set<int32_t> column_uids;
+            if (config::enable_file_cache_selective_warm_up) {
+                column_uids = _engine.tablet_hotspot().get_accessed_columns(
+                        tablet->table_id(), config::file_cache_warm_up_column_access_window_s);
+                if (!column_uids.empty()) {
+                    const auto& tablet_schema = tablet->tablet_schema();
+                    for (size_t i = 0; i < tablet_schema->num_key_columns(); ++i) {
+                        column_uids.insert(tablet_schema->column(i).unique_id());
+                    }
+                }
+            }
             for (auto& [_, rs] : rs_metas) {
                 for (int64_t seg_id = 0; seg_id < rs->num_segments(); seg_id++) {
                     auto storage_resource = rs->remote_storage_resource();
@@ -165,10 +313,23 @@ void CloudWarmUpManager::handle_jobs() {
                     }
 
                     // 1st. download segment files
-                    submit_download_tasks(
-                            storage_resource.value()->remote_segment_path(*rs, seg_id),
-                            rs->segment_file_size(seg_id), storage_resource.value()->fs,
-                            expiration_time, wait);
+                    auto segment_path = storage_resource.value()->remote_segment_path(*rs, seg_id);
+                    if (column_uids.empty()) {
+                        submit_download_tasks(segment_path, rs->segment_file_size(seg_id),
+                                              storage_resource.value()->fs, expiration_time, wait);
+                    } else {
+                        st = submit_selective_download_tasks(
+                                segment_path, rs->segment_file_size(seg_id),
+                                storage_resource.value()->fs, column_uids, expiration_time, wait);
+                        if (!st) {
+                            LOG_WARNING("Warm up error, fall back to a full warm up")
+                                    .tag("path", segment_path)
+                                    .error(st);
+                            submit_download_tasks(segment_path, rs->segment_file_size(seg_id),
+                                                  storage_resource.value()->fs, expiration_time,
+                                                  wait);
+                        }
+                    }
 
                     // 2nd. download inverted index files
                     int64_t file_size = -1;
@@ -177,6 +338,11 @@ void CloudWarmUpManager::handle_jobs() {
                     const auto& idx_file_info = rs->inverted_index_file_info(seg_id);
                     if (idx_version == InvertedIndexStorageFormatPB::V1) {
                         for (const auto& index : schema_ptr->inverted_indexes()) {
+                            if (!column_uids.empty() && !index->col_unique_ids().empty() &&
+                                !column_uids.contains(index->col_unique_ids()[0])) {
+                                // the selective warm-up skips the indexes of the other columns
+                                continue;
+                            }
                             auto idx_path = storage_resource.value()->remote_idx_v1_path(
                                     *rs, seg_id, index->index_id(), index->get_index_suffix());
                             if (idx_file_info.index_info_size() > 0) {
@@ -24,11 +24,13 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_set>
 #include <vector>
 
 #include "cloud/cloud_storage_engine.h"
 #include "common/status.h"
 #include "gen_cpp/BackendService.h"
+#include "io/fs/file_reader_writer_fwd.h"
 
 namespace doris {
 
@@ -74,6 +76,22 @@ private:
     void submit_download_tasks(io::Path path, int64_t file_size, io::FileSystemSPtr file_system,
                                int64_t expiration_time,
                                std::shared_ptr<bthread::CountdownEvent> wait);
+    // Download the bytes [offset, offset + size) of the file
+    void submit_range_download_tasks(io::Path path, int64_t file_size, int64_t offset,
+                                     int64_t size, io::FileSystemSPtr file_system,
+                                     int64_t expiration_time,
+                                     std::shared_ptr<bthread::CountdownEvent> wait);
+    // Get the [offset, size) ranges of the segment file of `file_reader` to download, which are
+    // everything but the data pages of the columns not in `column_uids`
+    static Status get_selective_download_ranges(const io::FileReaderSPtr& file_reader,
+                                                const std::unordered_set<int32_t>& column_uids,
+                                                std::vector<std::pair<int64_t, int64_t>>* ranges);
+    // Download the segment without the data pages of the columns which are not in `column_uids`
+    Status submit_selective_download_tasks(io::Path path, int64_t file_size,
+                                           io::FileSystemSPtr file_system,
+                                           const std::unordered_set<int32_t>& column_uids,
+                                           int64_t expiration_time,
+                                           std::shared_ptr<bthread::CountdownEvent> wait);
     std::mutex _mtx;
     std::condition_variable _cond;
     int64_t _cur_job_id {0};
@@ -91,5 +91,9 @@ DEFINE_mInt32(meta_service_conflict_error_retry_times, "10");
 
 DEFINE_Bool(enable_check_storage_vault, "true");
 
+DEFINE_mBool(enable_file_cache_selective_warm_up, "false");
+
+DEFINE_mInt64(file_cache_warm_up_column_access_window_s, "604800");
+
 #include "common/compile_check_end.h"
 } // namespace doris::config
@@ -127,5 +127,15 @@ DECLARE_mInt32(meta_service_conflict_error_retry_times);
 
 DECLARE_Bool(enable_check_storage_vault);
 
+// Whether the file cache warm-up of a tablet only downloads the footer and the indexes of its
+// segments, plus the data of the key columns and of the columns recently read by the queries of
+// its table. Tables without recent column access are still fully warmed up.
+// Column access is only recorded in memory by the backend which ran the queries, so the warm-up
+// of a new cluster, or after a restart, has no column access to use and is a full warm-up.
+DECLARE_mBool(enable_file_cache_selective_warm_up);
+
+// Columns read by the queries in this window are downloaded by the selective warm-up
+DECLARE_mInt64(file_cache_warm_up_column_access_window_s);
+
 #include "common/compile_check_end.h"
 } // namespace doris::config
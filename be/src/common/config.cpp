@@ -225,6 +225,8 @@ DEFINE_Int32(delete_worker_count, "3");
 DEFINE_Int32(alter_tablet_worker_count, "3");
 // the count of thread to alter index
 DEFINE_Int32(alter_index_worker_count, "3");
+// the max count of segments of a rowset that one build index task builds concurrently
+DEFINE_mInt32(index_builder_segment_parallelism, "4");
 // the count of thread to clone
 DEFINE_Int32(clone_worker_count, "3");
 // the count of thread to clone
@@ -325,6 +327,9 @@ DEFINE_mInt32(doris_scanner_row_num, "16384");
 DEFINE_mInt32(doris_scanner_row_bytes, "10485760");
 // single read execute fragment max run time millseconds
 DEFINE_mInt32(doris_scanner_max_run_time_ms, "1000");
+DEFINE_mBool(enable_scan_task_priority_scheduling, "false");
+DEFINE_mInt32(scan_task_priority_level_quantum_ms, "100");
+DEFINE_mInt32(scan_task_priority_aging_ms, "2000");
 // (Advanced) Maximum size of per-query receive-side buffer
 DEFINE_mInt32(exchg_node_buffer_size_bytes, "20485760");
 DEFINE_mInt32(exchg_buffer_queue_capacity_factor, "64");
@@ -391,6 +396,14 @@ DEFINE_Bool(disable_pk_storage_page_cache, "false");
 DEFINE_String(pk_storage_page_cache_limit, "10%");
 // data page size for primary key index
 DEFINE_Int32(primary_key_data_page_size, "32768");
+DEFINE_mBool(enable_adaptive_page_size, "false");
+DEFINE_mInt32(adaptive_page_size_scan_target_bytes, "65536");
+DEFINE_mInt32(adaptive_page_size_lookup_target_bytes, "16384");
+DEFINE_mBool(enable_row_store_zstd_dict, "false");
+DEFINE_mInt32(row_store_zstd_dict_capacity, "16384");
+DEFINE_mInt32(zstd_dict_training_sample_ratio, "100");
+DEFINE_mBool(enable_rowset_shared_dictionary, "false");
+DEFINE_mBool(enable_page_sum_stats, "false");
 
 DEFINE_mInt32(data_page_cache_stale_sweep_time_sec, "300");
 DEFINE_mInt32(index_page_cache_stale_sweep_time_sec, "600");
@@ -414,6 +427,10 @@ DEFINE_mInt32(vertical_compaction_num_columns_per_group, "5");
 DEFINE_Int32(vertical_compaction_max_row_source_memory_mb, "1024");
 // In vertical compaction, max dest segment file size
 DEFINE_mInt64(vertical_compaction_max_segment_size, "1073741824");
+DEFINE_mString(compaction_clustering_columns, "");
+DEFINE_mString(compaction_clustering_curve, "zorder");
+DEFINE_mInt64(compaction_clustering_buffer_rows, "1048576");
+DEFINE_mInt64(compaction_clustering_buffer_bytes, "134217728");
 
 // If enabled, segments will be flushed column by column
 DEFINE_mBool(enable_vertical_segment_writer, "true");
@@ -539,6 +556,7 @@ DEFINE_mInt32(migration_remaining_size_threshold_mb, "10");
 DEFINE_mInt32(migration_task_timeout_secs, "300");
 // timeout for try_lock migration lock
 DEFINE_Int64(migration_lock_timeout_ms, "1000");
+DEFINE_mInt32(migration_copy_file_threads, "8");
 
 // Port to start debug webserver on
 DEFINE_Int32(webserver_port, "8040");
@@ -608,6 +626,7 @@ DEFINE_Int32(stream_load_record_expire_time_secs, "28800");
 DEFINE_mInt64(clean_stream_load_record_interval_secs, "1800");
 // enable stream load commit txn on BE directly, bypassing FE. Only for cloud.
 DEFINE_mBool(enable_stream_load_commit_txn_on_be, "false");
+DEFINE_mBool(enable_stream_load_zero_copy, "false");
 // The buffer size to store stream table function schema info
 DEFINE_Int64(stream_tvf_buffer_size, "1048576"); // 1MB
 
@@ -699,6 +718,10 @@ DEFINE_mInt32(priority_queue_remaining_tasks_increased_frequency, "512");
 // sync tablet_meta when modifying meta
 DEFINE_mBool(sync_tablet_meta, "false");
 
+DEFINE_mBool(enable_incremental_tablet_meta_save, "false");
+
+DEFINE_mBool(enable_lock_free_rowset_capture, "false");
+
 // sync when closing a file writer
 DEFINE_mBool(sync_file_on_close, "true");
 
@@ -1226,6 +1249,9 @@ DEFINE_mInt64(auto_inc_low_water_level_mark_size_ratio, "3");
 DEFINE_mInt64(auto_inc_fetch_thread_num, "3");
 // default max to 2048 connections
 DEFINE_mInt64(lookup_connection_cache_capacity, "2048");
+DEFINE_mBool(enable_descriptor_tbl_cache, "false");
+DEFINE_Int32(descriptor_tbl_cache_capacity, "1024");
+DEFINE_mInt32(descriptor_tbl_cache_recycle_interval, "3600");
 
 // level of compression when using LZ4_HC, whose defalut value is LZ4HC_CLEVEL_DEFAULT
 DEFINE_mInt64(LZ4_HC_compression_level, "9");
@@ -1405,6 +1431,7 @@ DEFINE_mInt64(table_sink_partition_write_min_partition_data_processed_rebalance_
               "15728640"); // 15MB
 // Maximum processed partition nums of per writer when partition writing
 DEFINE_mInt32(table_sink_partition_write_max_partition_nums_per_writer, "128");
+DEFINE_mBool(enable_table_sink_close_cold_partition_writers, "false");
 
 /** Hive sink configurations **/
 DEFINE_mInt64(hive_sink_max_file_size, "1073741824"); // 1GB
@@ -1434,6 +1461,13 @@ DEFINE_Int64(num_buffered_reader_prefetch_thread_pool_max_thread, "64");
 DEFINE_Int64(num_s3_file_upload_thread_pool_min_thread, "16");
 // The max thread num for S3FileUploadThreadPool
 DEFINE_Int64(num_s3_file_upload_thread_pool_max_thread, "64");
+// The min thread num for DecompressionThreadPool
+DEFINE_Int64(num_decompression_thread_pool_min_thread, "0");
+// The max thread num for DecompressionThreadPool
+DEFINE_Int64(num_decompression_thread_pool_max_thread, "0");
+DEFINE_mBool(enable_parallel_decompression, "false");
+DEFINE_mInt64(parallel_decompression_max_frame_bytes, "4194304");
+DEFINE_mInt64(parallel_decompression_queue_bytes, "67108864");
 // The maximum jvm heap usage ratio for hdfs write workload
 DEFINE_mDouble(max_hdfs_wirter_jni_heap_usage_ratio, "0.5");
 // The sleep milliseconds duration when hdfs write exceeds the maximum usage
@@ -1475,12 +1509,16 @@ DEFINE_mInt64(compaction_batch_size, "-1");
 // filter wrong data.
 DEFINE_mBool(enable_parquet_page_index, "true");
 
+DEFINE_mBool(enable_parquet_bloom_filter, "false");
+
 DEFINE_mBool(ignore_not_found_file_in_external_table, "true");
 
 DEFINE_mBool(enable_hdfs_mem_limiter, "true");
 
 DEFINE_mInt16(topn_agg_limit_multiplier, "2");
 
+DEFINE_mBool(enable_streaming_agg_sorted_input, "false");
+
 // Tablet meta size limit after serialization, 1.5GB
 DEFINE_mInt64(tablet_meta_serialize_size_limit, "1610612736");
 // Protobuf supports a maximum of 2GB, so the size of the tablet meta after serialization must be less than 2GB
@@ -270,6 +270,8 @@ DECLARE_Int32(delete_worker_count);
 DECLARE_Int32(alter_tablet_worker_count);
 // the count of thread to alter index
 DECLARE_Int32(alter_index_worker_count);
+// the max count of segments of a rowset that one build index task builds concurrently
+DECLARE_mInt32(index_builder_segment_parallelism);
 // the count of thread to clone
 DECLARE_Int32(clone_worker_count);
 // the count of thread to clone
@@ -367,6 +369,15 @@ DECLARE_mInt32(doris_scanner_row_num);
 DECLARE_mInt32(doris_scanner_row_bytes);
 // single read execute fragment max run time millseconds
 DECLARE_mInt32(doris_scanner_max_run_time_ms);
+// Whether to run pending scan tasks of a scan scheduler by multilevel feedback priority,
+// the scan tasks of the scan operators which have consumed less scan time run first.
+DECLARE_mBool(enable_scan_task_priority_scheduling);
+// The scan time a scan operator can consume before dropping to the next priority level,
+// the quantum of each lower level is 4 times of the upper one.
+DECLARE_mInt32(scan_task_priority_level_quantum_ms);
+// A scan task waiting longer than this is run first whatever its priority level,
+// to prevent the scan tasks of big queries from starving.
+DECLARE_mInt32(scan_task_priority_aging_ms);
 // (Advanced) Maximum size of per-query receive-side buffer
 DECLARE_mInt32(exchg_node_buffer_size_bytes);
 DECLARE_mInt32(exchg_buffer_queue_capacity_factor);
@@ -437,6 +448,33 @@ DECLARE_Bool(disable_pk_storage_page_cache);
 DECLARE_String(pk_storage_page_cache_limit);
 // data page size for primary key index
 DECLARE_Int32(primary_key_data_page_size);
+// Whether the segment writers adapt the data page size of each column to its compression
+// ratio and value width, when the table does not set storage_page_size.
+// Pages of well compressed columns may grow up to 16x storage_page_size (at most 64K rows),
+// so a column writer may buffer up to 1MB of uncompressed values instead of 64KB, and readers
+// decompress pages of that size.
+DECLARE_mBool(enable_adaptive_page_size);
+// target compressed size of the adaptive data pages of scan-heavy tables
+DECLARE_mInt32(adaptive_page_size_scan_target_bytes);
+// target compressed size of the adaptive data pages of lookup-heavy (merge-on-write) tables
+DECLARE_mInt32(adaptive_page_size_lookup_target_bytes);
+// Whether the row store column of ZSTD compressed tables is compressed with a dictionary
+// trained from its first pages, which keeps small row store pages well compressed.
+// Segments written with it can not be read by the versions that do not support it.
+DECLARE_mBool(enable_row_store_zstd_dict);
+// max size of the ZSTD dictionary of the row store column of a segment
+DECLARE_mInt32(row_store_zstd_dict_capacity);
+// a ZSTD dictionary is trained from samples of this many times its capacity, values below 4
+// are treated as 4, the least amount of samples a dictionary is trained from
+DECLARE_mInt32(zstd_dict_training_sample_ratio);
+// Whether the segments of a rowset share the dictionary of low-cardinality string columns,
+// so that a string has the same dict code in all the segments of the rowset. Segments whose
+// dictionary page holds only shared words record it in their footer, and readers decode these
+// words once for all of them.
+DECLARE_mBool(enable_rowset_shared_dictionary);
+// keep the sum, non-null count and null count of each data page of numeric columns in the
+// segment footer, so that aggregations over whole pages can skip decoding them
+DECLARE_mBool(enable_page_sum_stats);
 
 // inc_rowset snapshot rs sweep time interval
 DECLARE_mInt32(data_page_cache_stale_sweep_time_sec);
@@ -462,6 +500,17 @@ DECLARE_mInt32(vertical_compaction_num_columns_per_group);
 DECLARE_Int32(vertical_compaction_max_row_source_memory_mb);
 // In vertical compaction, max dest segment file size
 DECLARE_mInt64(vertical_compaction_max_segment_size);
+// Duplicate tables without sort keys whose compaction output is clustered on a space
+// filling curve, in the form of "<table_id>:<column>,<column>;<table_id>:<column>".
+// Compactions of these tables are horizontal.
+DECLARE_mString(compaction_clustering_columns);
+// space filling curve of the clustered compactions, "zorder" or "hilbert"
+DECLARE_mString(compaction_clustering_curve);
+// number of rows a clustered compaction sorts at a time
+DECLARE_mInt64(compaction_clustering_buffer_rows);
+// max size of the rows a clustered compaction sorts at a time, sorting them takes about as
+// much memory again
+DECLARE_mInt64(compaction_clustering_buffer_bytes);
 
 // If enabled, segments will be flushed column by column
 DECLARE_mBool(enable_vertical_segment_writer);
@@ -579,6 +628,8 @@ DECLARE_mInt32(migration_remaining_size_threshold_mb);
 DECLARE_mInt32(migration_task_timeout_secs);
 // timeout for try_lock migration lock
 DECLARE_Int64(migration_lock_timeout_ms);
+// Max number of threads used to copy the files of a tablet concurrently in a migration task
+DECLARE_mInt32(migration_copy_file_threads);
 
 // Port to start debug webserver on
 DECLARE_Int32(webserver_port);
@@ -643,6 +694,9 @@ DECLARE_Int32(stream_load_record_expire_time_secs);
 DECLARE_mInt64(clean_stream_load_record_interval_secs);
 // enable stream load commit txn on BE directly, bypassing FE. Only for cloud.
 DECLARE_mBool(enable_stream_load_commit_txn_on_be);
+// Hand the memory of the received http body over to the stream load pipe instead of
+// copying it into new buffers.
+DECLARE_mBool(enable_stream_load_zero_copy);
 // The buffer size to store stream table function schema info
 DECLARE_Int64(stream_tvf_buffer_size);
 
@@ -737,6 +791,18 @@ DECLARE_mInt32(priority_queue_remaining_tasks_increased_frequency);
 // sync tablet_meta when modifying meta
 DECLARE_mBool(sync_tablet_meta);
 
+// Save the rowset metas of a tablet under separate keys of the meta store, so that saving the
+// tablet meta writes only the changed rowset metas instead of all of them.
+// A BE binary without this option does not read the separate keys, and would load these tablets
+// without rowsets. Before downgrading, set it to false and restart the BE once: the tablets with
+// separate keys are saved as a whole again while they are loaded.
+DECLARE_mBool(enable_incremental_tablet_meta_save);
+
+// Capture the rowsets of queries from an immutable snapshot of the rowsets of the tablet,
+// instead of under the meta lock of the tablet. The snapshot is only kept while it is enabled,
+// a tablet is captured under the meta lock until its rowsets change after it is enabled.
+DECLARE_mBool(enable_lock_free_rowset_capture);
+
 // sync a file writer when it is closed
 DECLARE_mBool(sync_file_on_close);
 
@@ -1280,6 +1346,12 @@ DECLARE_mInt64(auto_inc_low_water_level_mark_size_ratio);
 DECLARE_mInt64(auto_inc_fetch_thread_num);
 // Max connection cache num for point lookup queries
 DECLARE_mInt64(lookup_connection_cache_capacity);
+// Whether the queries sending the same descriptor table share the descriptors built from it
+DECLARE_mBool(enable_descriptor_tbl_cache);
+// Max number of descriptor tables in the descriptor table cache
+DECLARE_Int32(descriptor_tbl_cache_capacity);
+// Used to modify the recycle interval of descriptor table cache
+DECLARE_mInt32(descriptor_tbl_cache_recycle_interval);
 
 // level of compression when using LZ4_HC, whose defalut value is LZ4HC_CLEVEL_DEFAULT
 DECLARE_mInt64(LZ4_HC_compression_level);
@@ -1474,6 +1546,9 @@ DECLARE_mInt64(table_sink_partition_write_min_data_processed_rebalance_threshold
 DECLARE_mInt64(table_sink_partition_write_min_partition_data_processed_rebalance_threshold);
 // Maximum processed partition nums of per writer when partition writing
 DECLARE_mInt32(table_sink_partition_write_max_partition_nums_per_writer);
+// Close the least recently written partition writer instead of failing the write when a new
+// partition exceeds table_sink_partition_write_max_partition_nums_per_writer
+DECLARE_mBool(enable_table_sink_close_cold_partition_writers);
 
 /** Hive sink configurations **/
 DECLARE_mInt64(hive_sink_max_file_size);
@@ -1501,6 +1576,21 @@ DECLARE_Int64(num_buffered_reader_prefetch_thread_pool_max_thread);
 DECLARE_Int64(num_s3_file_upload_thread_pool_min_thread);
 // The max thread num for S3FileUploadThreadPool
 DECLARE_Int64(num_s3_file_upload_thread_pool_max_thread);
+// The min thread num for DecompressionThreadPool
+DECLARE_Int64(num_decompression_thread_pool_min_thread);
+// The max thread num for DecompressionThreadPool
+DECLARE_Int64(num_decompression_thread_pool_max_thread);
+// Whether to decompress the independent frames of zstd, lz4 frame and bgzf csv and json lines
+// files on the DecompressionThreadPool ahead of the line reader
+DECLARE_mBool(enable_parallel_decompression);
+// The max compressed size of a frame decompressed on the DecompressionThreadPool, the rest of a
+// file is decompressed by the reading thread once a larger frame is met. It is also the max
+// size of the piece of a frame a thread decompresses at a time, the rest of a larger frame is
+// decompressed by the reading thread.
+DECLARE_mInt64(parallel_decompression_max_frame_bytes);
+// The max decompressed size of the frames of a file which are decompressing or decompressed but
+// not yet read
+DECLARE_mInt64(parallel_decompression_queue_bytes);
 // The maximum jvm heap usage ratio for hdfs write workload
 DECLARE_mDouble(max_hdfs_wirter_jni_heap_usage_ratio);
 // The sleep milliseconds duration when hdfs write exceeds the maximum usage
@@ -1544,6 +1634,10 @@ DECLARE_mInt64(compaction_batch_size);
 
 DECLARE_mBool(enable_parquet_page_index);
 
+// Whether to skip parquet row groups by the split block bloom filters written in file.
+// Off by default until it has run against the files of more writers.
+DECLARE_mBool(enable_parquet_bloom_filter);
+
 // Wheather to ignore not found file in external teble(eg, hive)
 // Default is true, if set to false, the not found file will result in query failure.
 DECLARE_mBool(ignore_not_found_file_in_external_table);
@@ -1554,6 +1648,10 @@ DECLARE_mBool(enable_hdfs_mem_limiter);
 // we should do agg limit opt
 DECLARE_mInt16(topn_agg_limit_multiplier);
 
+// Whether the streaming pre-aggregation aggregates the runs of equal keys directly, without
+// a hash table, while its input is found ordered by the group by keys.
+DECLARE_mBool(enable_streaming_agg_sorted_input);
+
 DECLARE_mInt64(tablet_meta_serialize_size_limit);
 
 DECLARE_mInt64(pipeline_task_leakage_detect_period_secs);
@@ -413,7 +413,7 @@ Status Lz4FrameDecompressor::decompress(uint8_t* input, size_t input_len, size_t
         src += remaining_input_size;
         remaining_input_size = input_len - remaining_input_size;
 
-        LOG(INFO) << "lz4 block size: " << _expect_dec_buf_size;
+        VLOG_DEBUG << "lz4 block size: " << _expect_dec_buf_size;
     }
 
     // decompress
@@ -355,6 +355,16 @@ void StreamLoadAction::on_chunk_data(HttpRequest* req) {
     SCOPED_ATTACH_TASK(ExecEnv::GetInstance()->stream_load_pipe_tracker());
 
     int64_t start_read_data_time = MonotonicNanos();
+    if (config::enable_stream_load_zero_copy) {
+        size_t moved_bytes = 0;
+        Status st = move_evbuffer_to_sink(evbuf, ctx->body_sink.get(), &moved_bytes);
+        ctx->receive_bytes += moved_bytes;
+        if (!st.ok()) {
+            LOG(WARNING) << "append body content failed. errmsg=" << st << ", " << ctx->brief();
+            ctx->status = st;
+            return;
+        }
+    }
     while (evbuffer_get_length(evbuf) > 0) {
         ByteBufferPtr bb;
         Status st = ByteBuffer::allocate(128 * 1024, &bb);
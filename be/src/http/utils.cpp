@@ -18,11 +18,13 @@
 #include "http/utils.h"
 
 #include <absl/strings/str_split.h>
+#include <event2/buffer.h>
 #include <fcntl.h>
 #include <stdint.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <memory>
 #include <ostream>
 #include <string>
 #include <unordered_map>
@@ -43,6 +45,8 @@
 #include "io/fs/local_file_system.h"
 #include "olap/wal/wal_manager.h"
 #include "runtime/exec_env.h"
+#include "runtime/message_body_sink.h"
+#include "util/byte_buffer.h"
 #include "util/md5.h"
 #include "util/path_util.h"
 #include "util/security.h"
@@ -242,6 +246,32 @@ bool load_size_smaller_than_wal_limit(int64_t content_length) {
     return (content_length < 0.8 * max_available_size);
 }
 
+Status move_evbuffer_to_sink(evbuffer* evbuf, MessageBodySink* sink, size_t* moved_bytes) {
+    *moved_bytes = 0;
+    if (evbuffer_get_length(evbuf) == 0) {
+        return Status::OK();
+    }
+    std::shared_ptr<evbuffer> chains(evbuffer_new(), evbuffer_free);
+    if (chains == nullptr) {
+        return Status::MemoryAllocFailed("failed to allocate evbuffer");
+    }
+    // only the chain pointers are moved, the data is not copied
+    if (evbuffer_add_buffer(chains.get(), evbuf) != 0) {
+        return Status::InternalError("failed to move the http body out of the request");
+    }
+    int num_vecs = evbuffer_peek(chains.get(), -1, nullptr, nullptr, 0);
+    std::vector<evbuffer_iovec> vecs(num_vecs);
+    evbuffer_peek(chains.get(), -1, nullptr, vecs.data(), num_vecs);
+    for (const auto& vec : vecs) {
+        ByteBufferPtr bb;
+        RETURN_IF_ERROR(
+                ByteBuffer::wrap(static_cast<char*>(vec.iov_base), vec.iov_len, chains, &bb));
+        RETURN_IF_ERROR(sink->append(bb));
+        *moved_bytes += vec.iov_len;
+    }
+    return Status::OK();
+}
+
 Status is_support_batch_download(const std::string& endpoint) {
     std::string url = fmt::format("http://{}/api/_tablet/_batch_download?check=true", endpoint);
     auto check_support_cb = [&url](HttpClient* client) {
@@ -23,10 +23,12 @@
 #include "http/http_request.h"
 
 struct bufferevent_rate_limit_group;
+struct evbuffer;
 
 namespace doris {
 
 struct AuthInfo;
+class MessageBodySink;
 
 std::string encode_basic_auth(const std::string& user, const std::string& passwd);
 // parse Basic authorization
@@ -47,6 +49,11 @@ std::string get_content_type(const std::string& file_name);
 
 bool load_size_smaller_than_wal_limit(int64_t content_length);
 
+// Move the content of evbuf into sink without copying it: the chains of evbuf are taken
+// over by buffers that point into them, and freed when the last of these buffers is, under
+// the mem tracker of the calling thread.
+Status move_evbuffer_to_sink(evbuffer* evbuf, MessageBodySink* sink, size_t* moved_bytes);
+
 // Whether a backend supports batch download
 Status is_support_batch_download(const std::string& address);
 
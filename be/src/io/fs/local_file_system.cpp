@@ -26,6 +26,11 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#if defined(__linux__)
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#endif
+
 #include <filesystem>
 #include <iomanip>
 #include <istream>
@@ -370,9 +375,71 @@ Status LocalFileSystem::copy_path(const Path& src, const Path& dest) {
     FILESYSTEM_M(copy_path_impl(src, dest));
 }
 
+#if defined(__linux__)
+// Copy a regular file in the kernel, by a reflink clone if the file system supports it,
+// otherwise by copy_file_range. `copied` is false if neither is supported, then nothing is
+// left at dest and the caller should copy the file in user space.
+static Status kernel_copy_file(const Path& src, const Path& dest, bool* copied) {
+    *copied = false;
+    int src_fd = ::open(src.c_str(), O_RDONLY | O_CLOEXEC);
+    if (src_fd < 0) {
+        return localfs_error(errno, fmt::format("failed to open {}", src.native()));
+    }
+    Defer close_src {[&]() { ::close(src_fd); }};
+    struct stat src_stat;
+    if (::fstat(src_fd, &src_stat) != 0) {
+        return localfs_error(errno, fmt::format("failed to stat {}", src.native()));
+    }
+    int dest_fd = ::open(dest.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC,
+                         src_stat.st_mode & 0777);
+    if (dest_fd < 0) {
+        return localfs_error(errno, fmt::format("failed to create {}", dest.native()));
+    }
+    Defer close_dest {[&]() { ::close(dest_fd); }};
+
+    if (::ioctl(dest_fd, FICLONE, src_fd) == 0) {
+        *copied = true;
+        return Status::OK();
+    }
+    off_t remaining = src_stat.st_size;
+    while (remaining > 0) {
+        ssize_t n = ::copy_file_range(src_fd, nullptr, dest_fd, nullptr, remaining, 0);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (remaining == src_stat.st_size &&
+                (errno == EXDEV || errno == ENOSYS || errno == EOPNOTSUPP || errno == EINVAL)) {
+                // not supported between these files, nothing has been copied
+                ::unlink(dest.c_str());
+                return Status::OK();
+            }
+            return localfs_error(errno, fmt::format("failed to copy from {} to {}",
+                                                    src.native(), dest.native()));
+        }
+        if (n == 0) {
+            break;
+        }
+        remaining -= n;
+    }
+    *copied = true;
+    return Status::OK();
+}
+#endif
+
 Status LocalFileSystem::copy_path_impl(const Path& src, const Path& dest) {
     VLOG_DEBUG << "copy from " << src.native() << " to " << dest.native();
     std::error_code ec;
+#if defined(__linux__)
+    if (std::filesystem::is_regular_file(src, ec)) {
+        bool copied = false;
+        RETURN_IF_ERROR(kernel_copy_file(src, dest, &copied));
+        if (copied) {
+            return Status::OK();
+        }
+    }
+    ec.clear();
+#endif
     std::filesystem::copy(src, dest, std::filesystem::copy_options::recursive, ec);
     if (ec) {
         return localfs_error(
@@ -47,6 +47,7 @@
 #include "io/fs/file_writer.h"
 #include "io/fs/remote_file_system.h"
 #include "io/io_common.h"
+#include "olap/compaction_clustering.h"
 #include "olap/cumulative_compaction.h"
 #include "olap/cumulative_compaction_policy.h"
 #include "olap/cumulative_compaction_time_series_policy.h"
@@ -179,6 +180,12 @@ Status Compaction::merge_input_rowsets() {
         input_rs_readers.push_back(std::move(rs_reader));
     }
 
+    // clustered rows are reordered as a whole, which vertical compaction can not do
+    ClusteringSpec clustering_spec;
+    if (_is_vertical && get_clustering_spec(*_tablet, *_cur_tablet_schema, &clustering_spec)) {
+        _is_vertical = false;
+    }
+
     RowsetWriterContext ctx;
     RETURN_IF_ERROR(construct_output_rowset_writer(ctx));
 
@@ -399,6 +406,12 @@ bool CompactionMixin::handle_ordered_data_compaction() {
         return false;
     }
 
+    ClusteringSpec clustering_spec;
+    if (get_clustering_spec(*_tablet, *_tablet->tablet_schema(), &clustering_spec)) {
+        // linked segments would not be clustered with each other
+        return false;
+    }
+
     // check delete version: if compaction type is base compaction and
     // has a delete version, use original compaction
     if (compaction_type() == ReaderType::READER_BASE_COMPACTION ||
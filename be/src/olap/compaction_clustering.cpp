@@ -0,0 +1,242 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/compaction_clustering.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <utility>
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "common/config.h"
+#include "common/logging.h"
+#include "olap/base_tablet.h"
+#include "olap/tablet_schema.h"
+#include "vec/columns/column.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+namespace {
+
+// zone maps are not kept for these types, clustering on them does not help pruning
+bool is_clusterable_type(FieldType type) {
+    switch (type) {
+    case FieldType::OLAP_FIELD_TYPE_STRUCT:
+    case FieldType::OLAP_FIELD_TYPE_ARRAY:
+    case FieldType::OLAP_FIELD_TYPE_MAP:
+    case FieldType::OLAP_FIELD_TYPE_JSONB:
+    case FieldType::OLAP_FIELD_TYPE_AGG_STATE:
+    case FieldType::OLAP_FIELD_TYPE_BITMAP:
+    case FieldType::OLAP_FIELD_TYPE_HLL:
+    case FieldType::OLAP_FIELD_TYPE_QUANTILE_STATE:
+    case FieldType::OLAP_FIELD_TYPE_VARIANT:
+        return false;
+    default:
+        return true;
+    }
+}
+
+// Replace the values of a column with their dense ranks in the column, scaled to
+// `bits` bits, so that columns of any type and distribution get the same weight.
+void rank_column(const vectorized::IColumn& column, uint32_t bits, std::vector<uint32_t>* ranks) {
+    size_t rows = column.size();
+    std::vector<uint32_t> order(rows);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs) {
+        return column.compare_at(lhs, rhs, column, -1) < 0;
+    });
+    std::vector<uint64_t> dense_ranks(rows);
+    uint64_t rank = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        if (i > 0 && column.compare_at(order[i - 1], order[i], column, -1) != 0) {
+            ++rank;
+        }
+        dense_ranks[order[i]] = rank;
+    }
+    uint64_t max_rank = rank;
+    uint64_t max_coord = (bits >= 32) ? UINT32_MAX : ((1ULL << bits) - 1);
+    ranks->resize(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        (*ranks)[i] = static_cast<uint32_t>(
+                max_rank == 0 ? 0
+                              : static_cast<uint64_t>(static_cast<double>(dense_ranks[i]) /
+                                                      static_cast<double>(max_rank) *
+                                                      static_cast<double>(max_coord)));
+    }
+}
+
+} // namespace
+
+bool get_clustering_spec(const BaseTablet& tablet, const TabletSchema& tablet_schema,
+                         ClusteringSpec* spec) {
+    std::string config_value = config::compaction_clustering_columns;
+    if (config_value.empty() || tablet_schema.keys_type() != KeysType::DUP_KEYS ||
+        tablet_schema.num_key_columns() != 0) {
+        return false;
+    }
+    // <table_id>:<column>,<column>;<table_id>:<column>,...
+    std::string table_id = std::to_string(tablet.table_id());
+    for (std::string_view table : absl::StrSplit(config_value, ";", absl::SkipWhitespace())) {
+        std::pair<std::string_view, std::string_view> table_columns =
+                absl::StrSplit(table, absl::MaxSplits(":", 1));
+        if (table_columns.first != table_id) {
+            continue;
+        }
+        spec->column_ids.clear();
+        for (std::string_view name :
+             absl::StrSplit(table_columns.second, ",", absl::SkipWhitespace())) {
+            int32_t cid = tablet_schema.field_index(std::string(name));
+            if (cid < 0 || !is_clusterable_type(tablet_schema.column(cid).type())) {
+                LOG(WARNING) << "ignore clustering column " << name << " of table " << table_id
+                             << ", it does not exist or can not be clustered";
+                continue;
+            }
+            spec->column_ids.push_back(cid);
+        }
+        // at least 8 bits for each dimension of a 64 bits curve index
+        if (spec->column_ids.empty() || spec->column_ids.size() > 8) {
+            return false;
+        }
+        spec->curve = config::compaction_clustering_curve == "hilbert" ? ClusteringCurve::HILBERT
+                                                                       : ClusteringCurve::ZORDER;
+        return true;
+    }
+    return false;
+}
+
+uint64_t zorder_index(const std::vector<uint32_t>& coords, uint32_t bits) {
+    if (coords.size() == 1) {
+        return coords[0];
+    }
+    uint64_t index = 0;
+    for (int bit = static_cast<int>(bits) - 1; bit >= 0; --bit) {
+        for (auto coord : coords) {
+            index = (index << 1) | ((coord >> bit) & 1);
+        }
+    }
+    return index;
+}
+
+// J. Skilling, "Programming the Hilbert curve": transform the coordinates into the
+// transposed Hilbert index, whose bits interleaved like a Z-order index give the index.
+uint64_t hilbert_index(std::vector<uint32_t> coords, uint32_t bits) {
+    size_t n = coords.size();
+    if (n == 1 || bits == 0) {
+        return n == 1 ? coords[0] : 0;
+    }
+    uint32_t m = 1U << (bits - 1);
+    // inverse undo
+    for (uint32_t q = m; q > 1; q >>= 1) {
+        uint32_t p = q - 1;
+        for (size_t i = 0; i < n; ++i) {
+            if (coords[i] & q) {
+                coords[0] ^= p;
+            } else {
+                uint32_t t = (coords[0] ^ coords[i]) & p;
+                coords[0] ^= t;
+                coords[i] ^= t;
+            }
+        }
+    }
+    // gray encode
+    for (size_t i = 1; i < n; ++i) {
+        coords[i] ^= coords[i - 1];
+    }
+    uint32_t t = 0;
+    for (uint32_t q = m; q > 1; q >>= 1) {
+        if (coords[n - 1] & q) {
+            t ^= q - 1;
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        coords[i] ^= t;
+    }
+    return zorder_index(coords, bits);
+}
+
+Status cluster_block(const ClusteringSpec& spec, vectorized::Block* block) {
+    size_t rows = block->rows();
+    if (rows <= 1 || spec.column_ids.empty()) {
+        return Status::OK();
+    }
+    auto bits = static_cast<uint32_t>(std::min<size_t>(32, 64 / spec.column_ids.size()));
+    std::vector<std::vector<uint32_t>> ranks(spec.column_ids.size());
+    RETURN_IF_CATCH_EXCEPTION({
+        for (size_t i = 0; i < spec.column_ids.size(); ++i) {
+            rank_column(*block->get_by_position(spec.column_ids[i]).column, bits, &ranks[i]);
+        }
+    });
+
+    std::vector<uint64_t> keys(rows);
+    std::vector<uint32_t> coords(spec.column_ids.size());
+    for (size_t row = 0; row < rows; ++row) {
+        for (size_t i = 0; i < coords.size(); ++i) {
+            coords[i] = ranks[i][row];
+        }
+        keys[row] = spec.curve == ClusteringCurve::HILBERT ? hilbert_index(coords, bits)
+                                                           : zorder_index(coords, bits);
+    }
+    vectorized::IColumn::Permutation perm(rows);
+    std::iota(perm.begin(), perm.end(), 0);
+    std::stable_sort(perm.begin(), perm.end(),
+                     [&](size_t lhs, size_t rhs) { return keys[lhs] < keys[rhs]; });
+
+    RETURN_IF_CATCH_EXCEPTION({
+        for (auto& column : *block) {
+            column.column = column.column->permute(perm, 0);
+        }
+    });
+    return Status::OK();
+}
+
+ClusteringBuffer::ClusteringBuffer(ClusteringSpec spec, vectorized::Block block,
+                                   int64_t tablet_id)
+        : _spec(std::move(spec)),
+          _block(std::move(block)),
+          _buffer(vectorized::MutableBlock::build_mutable_block(&_block)),
+          _mem_tracker(fmt::format("CompactionClustering:tablet={}", tablet_id)) {}
+
+Status ClusteringBuffer::add_block(vectorized::Block* block, const WriteBlockFunc& write_block) {
+    RETURN_IF_ERROR(_buffer.merge(*block));
+    _mem_tracker.set_consumption(static_cast<int64_t>(_buffer.allocated_bytes()));
+    // the columns keep their capacity across batches, the batch is bounded by its data size
+    if (static_cast<int64_t>(_buffer.rows()) >= config::compaction_clustering_buffer_rows ||
+        static_cast<int64_t>(_buffer.bytes()) >= config::compaction_clustering_buffer_bytes) {
+        return flush(write_block);
+    }
+    return Status::OK();
+}
+
+Status ClusteringBuffer::flush(const WriteBlockFunc& write_block) {
+    if (_buffer.rows() == 0) {
+        return Status::OK();
+    }
+    _block = _buffer.to_block();
+    RETURN_IF_ERROR(cluster_block(_spec, &_block));
+    RETURN_IF_ERROR(write_block(&_block));
+    _block.clear_column_data();
+    _buffer = vectorized::MutableBlock::build_mutable_block(&_block);
+    _mem_tracker.set_consumption(static_cast<int64_t>(_buffer.allocated_bytes()));
+    return Status::OK();
+}
+
+} // namespace doris
@@ -0,0 +1,87 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "common/status.h"
+#include "olap/tablet_fwd.h"
+#include "runtime/memory/mem_tracker.h"
+#include "vec/core/block.h"
+
+namespace doris {
+class TabletSchema;
+
+enum class ClusteringCurve { ZORDER, HILBERT };
+
+// Multi-dimensional layout of the rows written by the compactions of a table: the rows
+// are ordered by their index on a space filling curve over the clustered columns, so
+// that the zone maps of pages and segments are selective on all of them.
+struct ClusteringSpec {
+    ClusteringCurve curve = ClusteringCurve::ZORDER;
+    // ordinals of the clustered columns in the tablet schema
+    std::vector<uint32_t> column_ids;
+};
+
+// Get the clustering layout of the table of tablet from config::compaction_clustering_columns.
+// Only duplicate tables without sort keys are clustered, since the rows of the others
+// have to stay in key order for the short key index.
+// Return false if the rows of the tablet are not clustered.
+bool get_clustering_spec(const BaseTablet& tablet, const TabletSchema& tablet_schema,
+                         ClusteringSpec* spec);
+
+// Reorder the rows of block by their index on the clustering curve.
+Status cluster_block(const ClusteringSpec& spec, vectorized::Block* block);
+
+// Buffers the rows merged by a compaction of a clustered table, and writes them reordered on
+// the clustering curve a batch at a time. A batch holds at most
+// config::compaction_clustering_buffer_rows rows and about
+// config::compaction_clustering_buffer_bytes bytes, the buffered rows are tracked by
+// mem_tracker().
+class ClusteringBuffer {
+public:
+    using WriteBlockFunc = std::function<Status(vectorized::Block*)>;
+
+    // block is an empty block of the merged columns
+    ClusteringBuffer(ClusteringSpec spec, vectorized::Block block, int64_t tablet_id);
+
+    // Buffers the rows of block, and writes the buffered rows if the batch is full.
+    Status add_block(vectorized::Block* block, const WriteBlockFunc& write_block);
+
+    // Writes the buffered rows.
+    Status flush(const WriteBlockFunc& write_block);
+
+    const MemTracker& mem_tracker() const { return _mem_tracker; }
+
+private:
+    ClusteringSpec _spec;
+    vectorized::Block _block;
+    vectorized::MutableBlock _buffer;
+    MemTracker _mem_tracker;
+};
+
+// Index of a point on the Z-order curve, coords.size() * bits must not exceed 64.
+uint64_t zorder_index(const std::vector<uint32_t>& coords, uint32_t bits);
+
+// Index of a point on the Hilbert curve, coords.size() * bits must not exceed 64.
+uint64_t hilbert_index(std::vector<uint32_t> coords, uint32_t bits);
+
+} // namespace doris
@@ -212,6 +212,11 @@ Status DataDir::_init_meta() {
         RETURN_NOT_OK_STATUS_WITH_WARN(Status::IOError("open rocksdb failed, path={}", _path),
                                        "init OlapMeta failed");
     }
+    bool has_separate_rs_metas = false;
+    RETURN_NOT_OK_STATUS_WITH_WARN(
+            TabletMetaManager::has_separate_rs_metas(_meta, &has_separate_rs_metas),
+            "check separate rowset metas failed");
+    _may_have_separate_rs_metas = has_separate_rs_metas;
     return Status::OK();
 }
 
@@ -419,11 +424,27 @@ Status DataDir::load() {
     LOG(INFO) << "begin loading tablet from meta";
     std::set<int64_t> tablet_ids;
     std::set<int64_t> failed_tablet_ids;
-    auto load_tablet_func = [this, &tablet_ids, &failed_tablet_ids](
-                                    int64_t tablet_id, int32_t schema_hash,
-                                    std::string_view value) -> bool {
+    int64_t num_converted_tablets = 0;
+    auto load_tablet_func = [this, &tablet_ids, &failed_tablet_ids, &num_converted_tablets](
+                                    int64_t tablet_id, int32_t schema_hash, std::string_view value,
+                                    const TabletSeparateRsIds& rs_ids) -> bool {
         Status status = _engine.tablet_manager()->load_tablet_from_meta(
                 this, tablet_id, schema_hash, value, false, false, false, false);
+        if (status.ok() && !rs_ids.empty()) {
+            auto tablet = _engine.tablet_manager()->get_tablet(tablet_id);
+            if (tablet != nullptr && tablet->data_dir() == this &&
+                tablet->schema_hash() == schema_hash) {
+                if (config::enable_incremental_tablet_meta_save) {
+                    tablet->tablet_meta()->init_separately_saved_rs_metas(rs_ids);
+                } else {
+                    // Saved as a whole again, so that a BE which does not know the separate
+                    // rowset metas can load the tablet.
+                    std::lock_guard<std::shared_mutex> wrlock(tablet->get_header_lock());
+                    tablet->save_meta();
+                    ++num_converted_tablets;
+                }
+            }
+        }
         if (!status.ok() && !status.is<TABLE_ALREADY_DELETED_ERROR>() &&
             !status.is<ENGINE_INSERT_OLD_TABLET>()) {
             // load_tablet_from_meta() may return Status::Error<TABLE_ALREADY_DELETED_ERROR>()
@@ -469,6 +490,7 @@ Status DataDir::load() {
         LOG(INFO) << "load tablet from meta finished"
                   << ", loaded tablet: " << tablet_ids.size()
                   << ", error tablet: " << failed_tablet_ids.size()
+                  << ", tablet saved as a whole again: " << num_converted_tablets
                   << ", cost: " << tablet_timer.elapsed_time_milliseconds()
                   << " ms, path: " << _path;
     }
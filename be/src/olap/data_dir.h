@@ -87,6 +87,11 @@ public:
 
     OlapMeta* get_meta() { return _meta; }
 
+    // Whether the meta may have rowset metas saved under separate keys, which a full save or a
+    // remove of a tablet meta has to look for. Checked once the meta is opened.
+    bool may_have_separate_rs_metas() const { return _may_have_separate_rs_metas; }
+    void set_may_have_separate_rs_metas() { _may_have_separate_rs_metas = true; }
+
     bool is_ssd_disk() const { return _storage_medium == TStorageMedium::SSD; }
 
     TStorageMedium::type storage_medium() const { return _storage_medium; }
@@ -191,6 +196,7 @@ private:
     std::set<TabletInfo> _tablet_set;
 
     OlapMeta* _meta = nullptr;
+    std::atomic<bool> _may_have_separate_rs_metas = true;
 
     std::shared_ptr<MetricEntity> _data_dir_metric_entity;
     IntGauge* disks_total_capacity = nullptr;
@@ -17,6 +17,7 @@
 
 #include "olap/hll.h"
 
+#include <algorithm>
 #include <cmath>
 #include <map>
 #include <ostream>
@@ -51,8 +52,96 @@ void HyperLogLog::_convert_explicit_to_register() {
     vectorized::flat_hash_set<uint64_t>().swap(_hash_set);
 }
 
-// Change HLL_DATA_EXPLICIT to HLL_DATA_FULL directly, because HLL_DATA_SPARSE
-// is implemented in the same way in memory with HLL_DATA_FULL.
+// Convert explicit values to sparse registers, the explicit values are cleared.
+void HyperLogLog::_convert_explicit_to_sparse() {
+    DCHECK(_type == HLL_DATA_EXPLICIT)
+            << "_type(" << _type << ") should be explicit(" << HLL_DATA_EXPLICIT << ")";
+    std::vector<uint32_t> sparse_registers;
+    sparse_registers.reserve(_hash_set.size());
+    for (auto value : _hash_set) {
+        int idx;
+        uint8_t first_one_bit;
+        _hash_to_register(value, &idx, &first_one_bit);
+        sparse_registers.push_back((uint32_t(idx) << 8) | first_one_bit);
+    }
+    // For the same index, the max value is the last one after sorting.
+    std::sort(sparse_registers.begin(), sparse_registers.end());
+    size_t num_registers = 0;
+    for (size_t i = 0; i < sparse_registers.size(); ++i) {
+        if (num_registers > 0 && _sparse_index(sparse_registers[num_registers - 1]) ==
+                                         _sparse_index(sparse_registers[i])) {
+            sparse_registers[num_registers - 1] = sparse_registers[i];
+        } else {
+            sparse_registers[num_registers++] = sparse_registers[i];
+        }
+    }
+    sparse_registers.resize(num_registers);
+    // clear _hash_set
+    vectorized::flat_hash_set<uint64_t>().swap(_hash_set);
+    _sparse_registers = std::move(sparse_registers);
+    _type = HLL_DATA_SPARSE;
+    if (_sparse_registers.size() > HLL_SPARSE_MEMORY_THRESHOLD) {
+        _convert_sparse_to_register();
+    }
+}
+
+// Convert sparse registers to full registers, and clear sparse registers.
+void HyperLogLog::_convert_sparse_to_register() {
+    DCHECK(_type == HLL_DATA_SPARSE)
+            << "_type(" << _type << ") should be sparse(" << HLL_DATA_SPARSE << ")";
+    _registers = new uint8_t[HLL_REGISTERS_COUNT];
+    memset(_registers, 0, HLL_REGISTERS_COUNT);
+    _merge_sparse_to_registers(_sparse_registers);
+    std::vector<uint32_t>().swap(_sparse_registers);
+    _type = HLL_DATA_FULL;
+}
+
+void HyperLogLog::_update_sparse_registers(uint64_t hash_value) {
+    int idx;
+    uint8_t first_one_bit;
+    _hash_to_register(hash_value, &idx, &first_one_bit);
+    auto it = std::lower_bound(_sparse_registers.begin(), _sparse_registers.end(),
+                               uint32_t(idx) << 8);
+    if (it != _sparse_registers.end() && _sparse_index(*it) == uint32_t(idx)) {
+        if (_sparse_value(*it) < first_one_bit) {
+            *it = (uint32_t(idx) << 8) | first_one_bit;
+        }
+        return;
+    }
+    _sparse_registers.insert(it, (uint32_t(idx) << 8) | first_one_bit);
+    if (_sparse_registers.size() > HLL_SPARSE_MEMORY_THRESHOLD) {
+        _convert_sparse_to_register();
+    }
+}
+
+void HyperLogLog::_merge_sparse_registers(const std::vector<uint32_t>& other_sparse_registers) {
+    DCHECK(_type == HLL_DATA_SPARSE);
+    std::vector<uint32_t> merged;
+    merged.reserve(_sparse_registers.size() + other_sparse_registers.size());
+    auto lhs = _sparse_registers.begin();
+    auto rhs = other_sparse_registers.begin();
+    while (lhs != _sparse_registers.end() && rhs != other_sparse_registers.end()) {
+        uint32_t lhs_idx = _sparse_index(*lhs);
+        uint32_t rhs_idx = _sparse_index(*rhs);
+        if (lhs_idx < rhs_idx) {
+            merged.push_back(*lhs++);
+        } else if (rhs_idx < lhs_idx) {
+            merged.push_back(*rhs++);
+        } else {
+            // same index, the larger element has the larger register value
+            merged.push_back(std::max(*lhs++, *rhs++));
+        }
+    }
+    merged.insert(merged.end(), lhs, _sparse_registers.end());
+    merged.insert(merged.end(), rhs, other_sparse_registers.end());
+    _sparse_registers = std::move(merged);
+    if (_sparse_registers.size() > HLL_SPARSE_MEMORY_THRESHOLD) {
+        _convert_sparse_to_register();
+    }
+}
+
+// Explicit values are converted to sparse registers, which are converted to full
+// registers lazily when there are too many non-zero registers.
 void HyperLogLog::update(uint64_t hash_value) {
     switch (_type) {
     case HLL_DATA_EMPTY:
@@ -64,10 +153,16 @@ void HyperLogLog::update(uint64_t hash_value) {
             _hash_set.insert(hash_value);
             break;
         }
-        _convert_explicit_to_register();
-        _type = HLL_DATA_FULL;
-        // fall through
+        _convert_explicit_to_sparse();
+        if (_type == HLL_DATA_FULL) {
+            _update_registers(hash_value);
+        } else {
+            _update_sparse_registers(hash_value);
+        }
+        break;
     case HLL_DATA_SPARSE:
+        _update_sparse_registers(hash_value);
+        break;
     case HLL_DATA_FULL:
         _update_registers(hash_value);
         break;
@@ -88,6 +183,8 @@ void HyperLogLog::merge(const HyperLogLog& other) {
             _hash_set = other._hash_set;
             break;
         case HLL_DATA_SPARSE:
+            _sparse_registers = other._sparse_registers;
+            break;
         case HLL_DATA_FULL:
             _registers = new uint8_t[HLL_REGISTERS_COUNT];
             memcpy(_registers, other._registers, HLL_REGISTERS_COUNT);
@@ -104,11 +201,17 @@ void HyperLogLog::merge(const HyperLogLog& other) {
             // HLL_EXPLICIT_INT64_NUM. This is OK because the max value is 2 * 160.
             _hash_set.insert(other._hash_set.begin(), other._hash_set.end());
             if (_hash_set.size() > HLL_EXPLICIT_INT64_NUM) {
-                _convert_explicit_to_register();
-                _type = HLL_DATA_FULL;
+                _convert_explicit_to_sparse();
             }
         } break;
         case HLL_DATA_SPARSE:
+            _convert_explicit_to_sparse();
+            if (_type == HLL_DATA_FULL) {
+                _merge_sparse_to_registers(other._sparse_registers);
+            } else {
+                _merge_sparse_registers(other._sparse_registers);
+            }
+            break;
         case HLL_DATA_FULL:
             _convert_explicit_to_register();
             _merge_registers(other._registers);
@@ -119,7 +222,26 @@ void HyperLogLog::merge(const HyperLogLog& other) {
         }
         break;
     }
-    case HLL_DATA_SPARSE:
+    case HLL_DATA_SPARSE: {
+        switch (other._type) {
+        case HLL_DATA_EXPLICIT:
+            for (auto hash_value : other._hash_set) {
+                // this may be converted to full registers in the loop
+                update(hash_value);
+            }
+            break;
+        case HLL_DATA_SPARSE:
+            _merge_sparse_registers(other._sparse_registers);
+            break;
+        case HLL_DATA_FULL:
+            _convert_sparse_to_register();
+            _merge_registers(other._registers);
+            break;
+        default:
+            break;
+        }
+        break;
+    }
     case HLL_DATA_FULL: {
         switch (other._type) {
         case HLL_DATA_EXPLICIT:
@@ -128,6 +250,8 @@ void HyperLogLog::merge(const HyperLogLog& other) {
             }
             break;
         case HLL_DATA_SPARSE:
+            _merge_sparse_to_registers(other._sparse_registers);
+            break;
         case HLL_DATA_FULL:
             _merge_registers(other._registers);
             break;
@@ -147,6 +271,7 @@ size_t HyperLogLog::max_serialized_size() const {
     case HLL_DATA_EXPLICIT:
         return 2 + _hash_set.size() * 8;
     case HLL_DATA_SPARSE:
+        return 1 + 4 + 3 * _sparse_registers.size();
     case HLL_DATA_FULL:
         return 1 + HLL_REGISTERS_COUNT;
     }
@@ -174,7 +299,21 @@ size_t HyperLogLog::serialize(uint8_t* dst) const {
         }
         break;
     }
-    case HLL_DATA_SPARSE:
+    case HLL_DATA_SPARSE: {
+        DCHECK(_sparse_registers.size() <= HLL_SPARSE_THRESHOLD);
+        *ptr++ = HLL_DATA_SPARSE;
+        // 2-5(4 byte): number of registers
+        encode_fixed32_le(ptr, (uint32_t)_sparse_registers.size());
+        ptr += 4;
+        for (auto sparse_register : _sparse_registers) {
+            // 2 bytes: register index
+            // 1 byte: register value
+            encode_fixed16_le(ptr, (uint16_t)_sparse_index(sparse_register));
+            ptr += 2;
+            *ptr++ = _sparse_value(sparse_register);
+        }
+        break;
+    }
     case HLL_DATA_FULL: {
         uint32_t num_non_zero_registers = 0;
         for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
@@ -284,18 +423,55 @@ bool HyperLogLog::deserialize(const Slice& slice) {
         break;
     }
     case HLL_DATA_SPARSE: {
-        _registers = new uint8_t[HLL_REGISTERS_COUNT];
-        memset(_registers, 0, HLL_REGISTERS_COUNT);
         // 2-5(4 byte): number of registers
         uint32_t num_registers = decode_fixed32_le(ptr);
         ptr += 4;
+        if (num_registers > HLL_SPARSE_MEMORY_THRESHOLD) {
+            _type = HLL_DATA_FULL;
+            _registers = new uint8_t[HLL_REGISTERS_COUNT];
+            memset(_registers, 0, HLL_REGISTERS_COUNT);
+            for (uint32_t i = 0; i < num_registers; ++i) {
+                // 2 bytes: register index
+                // 1 byte: register value
+                uint16_t register_idx = decode_fixed16_le(ptr);
+                ptr += 2;
+                _registers[register_idx] = *ptr++;
+            }
+            break;
+        }
+        _sparse_registers.reserve(num_registers);
+        bool sorted = true;
         for (uint32_t i = 0; i < num_registers; ++i) {
-            // 2 bytes: register index
-            // 1 byte: register value
-            uint16_t register_idx = decode_fixed16_le(ptr);
+            uint32_t register_idx = decode_fixed16_le(ptr) % HLL_REGISTERS_COUNT;
             ptr += 2;
-            _registers[register_idx] = *ptr++;
+            uint32_t sparse_register = (register_idx << 8) | *ptr++;
+            if (!_sparse_registers.empty() &&
+                _sparse_index(_sparse_registers.back()) >= register_idx) {
+                sorted = false;
+            }
+            _sparse_registers.push_back(sparse_register);
+        }
+        if (!sorted) {
+            // Binaries written by other writers may be out of order, keep the last value of
+            // each index which is the same as writing them into full registers one by one.
+            std::stable_sort(_sparse_registers.begin(), _sparse_registers.end(),
+                             [](uint32_t lhs, uint32_t rhs) {
+                                 return _sparse_index(lhs) < _sparse_index(rhs);
+                             });
+            size_t num_unique = 0;
+            for (size_t i = 0; i < _sparse_registers.size(); ++i) {
+                if (num_unique > 0 && _sparse_index(_sparse_registers[num_unique - 1]) ==
+                                              _sparse_index(_sparse_registers[i])) {
+                    _sparse_registers[num_unique - 1] = _sparse_registers[i];
+                } else {
+                    _sparse_registers[num_unique++] = _sparse_registers[i];
+                }
+            }
+            _sparse_registers.resize(num_unique);
         }
+        std::erase_if(_sparse_registers, [](uint32_t sparse_register) {
+            return _sparse_value(sparse_register) == 0;
+        });
         break;
     }
     case HLL_DATA_FULL: {
@@ -337,11 +513,26 @@ int64_t HyperLogLog::estimate_cardinality() const {
     float harmonic_mean = 0;
     int num_zero_registers = 0;
 
-    for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
-        harmonic_mean += powf(2.0F, -_registers[i]);
+    if (_type == HLL_DATA_SPARSE) {
+        // Sum in the order of register index, so the estimate is exactly the same as the
+        // one of full registers.
+        auto it = _sparse_registers.begin();
+        for (uint32_t i = 0; i < HLL_REGISTERS_COUNT; ++i) {
+            if (it != _sparse_registers.end() && _sparse_index(*it) == i) {
+                harmonic_mean += powf(2.0F, -_sparse_value(*it));
+                ++it;
+            } else {
+                harmonic_mean += 1.0F;
+                ++num_zero_registers;
+            }
+        }
+    } else {
+        for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
+            harmonic_mean += powf(2.0F, -_registers[i]);
 
-        if (_registers[i] == 0) {
-            ++num_zero_registers;
+            if (_registers[i] == 0) {
+                ++num_zero_registers;
+            }
         }
     }
 
@@ -22,6 +22,7 @@
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 #ifdef __x86_64__
 #include <immintrin.h>
@@ -37,6 +38,9 @@ inline const int HLL_COLUMN_PRECISION = 14;
 inline const int HLL_ZERO_COUNT_BITS = (64 - HLL_COLUMN_PRECISION);
 inline const int HLL_EXPLICIT_INT64_NUM = 160;
 inline const int HLL_SPARSE_THRESHOLD = 4096;
+// Max number of non-zero registers kept in the in-memory sparse format, each one occupies
+// 4 bytes, so a sparse HLL never uses more than a quarter of the full registers.
+inline const int HLL_SPARSE_MEMORY_THRESHOLD = 1024;
 inline const int HLL_REGISTERS_COUNT = 16 * 1024;
 // maximum size in byte of serialized HLL: type(1) + registers (2^14)
 inline const int HLL_COLUMN_DEFAULT_LEN = HLL_REGISTERS_COUNT + 1;
@@ -68,6 +72,13 @@ inline const int HLL_EMPTY_SIZE = 1;
 //
 // HLL_DATA_FULL: most space-consuming, store all registers
 //
+// In memory, HLL_DATA_SPARSE keeps the non-zero registers in a sorted array, each
+// element is (register index << 8 | register value). Aggregations grouped by many keys
+// usually see only a few values per group, so they don't need to pay for the full
+// registers. The array is converted to full registers lazily when it has more than
+// HLL_SPARSE_MEMORY_THRESHOLD elements, and sparse values are merged by walking the
+// sorted arrays without materializing the full registers.
+//
 // A HLL value will change in the sequence empty -> explicit -> sparse -> full, and not
 // allow reverse.
 //
@@ -97,7 +108,10 @@ public:
             this->_hash_set = other._hash_set;
             break;
         }
-        case HLL_DATA_SPARSE:
+        case HLL_DATA_SPARSE: {
+            this->_sparse_registers = other._sparse_registers;
+            break;
+        }
         case HLL_DATA_FULL: {
             _registers = new uint8_t[HLL_REGISTERS_COUNT];
             memcpy(_registers, other._registers, HLL_REGISTERS_COUNT);
@@ -118,7 +132,11 @@ public:
             other._type = HLL_DATA_EMPTY;
             break;
         }
-        case HLL_DATA_SPARSE:
+        case HLL_DATA_SPARSE: {
+            this->_sparse_registers = std::move(other._sparse_registers);
+            other._type = HLL_DATA_EMPTY;
+            break;
+        }
         case HLL_DATA_FULL: {
             this->_registers = other._registers;
             other._registers = nullptr;
@@ -132,10 +150,7 @@ public:
 
     HyperLogLog& operator=(HyperLogLog&& other) noexcept {
         if (this != &other) {
-            if (_registers != nullptr) {
-                delete[] _registers;
-                _registers = nullptr;
-            }
+            clear();
 
             this->_type = other._type;
             switch (other._type) {
@@ -146,7 +161,11 @@ public:
                 other._type = HLL_DATA_EMPTY;
                 break;
             }
-            case HLL_DATA_SPARSE:
+            case HLL_DATA_SPARSE: {
+                this->_sparse_registers = std::move(other._sparse_registers);
+                other._type = HLL_DATA_EMPTY;
+                break;
+            }
             case HLL_DATA_FULL: {
                 this->_registers = other._registers;
                 other._registers = nullptr;
@@ -162,10 +181,7 @@ public:
 
     HyperLogLog& operator=(const HyperLogLog& other) {
         if (this != &other) {
-            if (_registers != nullptr) {
-                delete[] _registers;
-                _registers = nullptr;
-            }
+            clear();
 
             this->_type = other._type;
             switch (other._type) {
@@ -175,7 +191,10 @@ public:
                 this->_hash_set = other._hash_set;
                 break;
             }
-            case HLL_DATA_SPARSE:
+            case HLL_DATA_SPARSE: {
+                this->_sparse_registers = other._sparse_registers;
+                break;
+            }
             case HLL_DATA_FULL: {
                 _registers = new uint8_t[HLL_REGISTERS_COUNT];
                 memcpy(_registers, other._registers, HLL_REGISTERS_COUNT);
@@ -192,6 +211,7 @@ public:
     void clear() {
         _type = HLL_DATA_EMPTY;
         _hash_set.clear();
+        std::vector<uint32_t>().swap(_sparse_registers);
         delete[] _registers;
         _registers = nullptr;
     }
@@ -214,7 +234,9 @@ public:
         size_t size = sizeof(*this);
         if (_type == HLL_DATA_EXPLICIT) {
             size += _hash_set.size() * sizeof(uint64_t);
-        } else if (_type == HLL_DATA_SPARSE || _type == HLL_DATA_FULL) {
+        } else if (_type == HLL_DATA_SPARSE) {
+            size += _sparse_registers.capacity() * sizeof(uint32_t);
+        } else if (_type == HLL_DATA_FULL) {
             size += HLL_REGISTERS_COUNT;
         }
         return size;
@@ -261,19 +283,48 @@ public:
 
 private:
     void _convert_explicit_to_register();
-
-    // update one hash value into this registers
-    void _update_registers(uint64_t hash_value) {
-        // Use the lower bits to index into the number of streams and then
-        // find the first 1 bit after the index bits.
-        int idx = hash_value % HLL_REGISTERS_COUNT;
+    // Convert explicit values to sparse registers, or to full registers directly if there
+    // are too many non-zero registers. _type is changed accordingly.
+    void _convert_explicit_to_sparse();
+    void _convert_sparse_to_register();
+
+    // Use the lower bits to index into the number of streams and then
+    // find the first 1 bit after the index bits.
+    static void _hash_to_register(uint64_t hash_value, int* idx, uint8_t* first_one_bit) {
+        *idx = hash_value % HLL_REGISTERS_COUNT;
         hash_value >>= HLL_COLUMN_PRECISION;
         // make sure max first_one_bit is HLL_ZERO_COUNT_BITS + 1
         hash_value |= ((uint64_t)1 << HLL_ZERO_COUNT_BITS);
-        uint8_t first_one_bit = __builtin_ctzl(hash_value) + 1;
+        *first_one_bit = __builtin_ctzl(hash_value) + 1;
+    }
+
+    static uint32_t _sparse_index(uint32_t sparse_register) { return sparse_register >> 8; }
+    static uint8_t _sparse_value(uint32_t sparse_register) { return sparse_register & 0xFF; }
+
+    // update one hash value into this registers
+    void _update_registers(uint64_t hash_value) {
+        int idx;
+        uint8_t first_one_bit;
+        _hash_to_register(hash_value, &idx, &first_one_bit);
         _registers[idx] = (_registers[idx] < first_one_bit ? first_one_bit : _registers[idx]);
     }
 
+    // update one hash value into the sparse registers, may convert this to full registers
+    void _update_sparse_registers(uint64_t hash_value);
+
+    // absorb sorted sparse registers into this sparse registers, may convert this
+    // to full registers
+    void _merge_sparse_registers(const std::vector<uint32_t>& other_sparse_registers);
+
+    // absorb sparse registers into this full registers
+    void _merge_sparse_to_registers(const std::vector<uint32_t>& sparse_registers) {
+        for (auto sparse_register : sparse_registers) {
+            uint32_t idx = _sparse_index(sparse_register);
+            uint8_t value = _sparse_value(sparse_register);
+            _registers[idx] = (_registers[idx] < value ? value : _registers[idx]);
+        }
+    }
+
     // absorb other registers into this registers
     void _merge_registers(const uint8_t* other_registers) {
 #ifdef __AVX2__
@@ -298,6 +349,9 @@ private:
     HllDataType _type = HLL_DATA_EMPTY;
     vectorized::flat_hash_set<uint64_t> _hash_set;
 
+    // Sorted non-zero registers for HLL_DATA_SPARSE, see the comments of HllDataType.
+    std::vector<uint32_t> _sparse_registers;
+
     // This field is much space consuming(HLL_REGISTERS_COUNT), we create
     // it only when it is really needed.
     uint8_t* _registers = nullptr;
@@ -38,6 +38,7 @@
 #include "common/logging.h"
 #include "common/status.h"
 #include "olap/base_tablet.h"
+#include "olap/compaction_clustering.h"
 #include "olap/iterators.h"
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
@@ -107,6 +108,22 @@ Status Merger::vmerge_rowsets(BaseTabletSPtr tablet, ReaderType reader_type,
     RETURN_IF_ERROR(reader.init(reader_params));
 
     vectorized::Block block = cur_tablet_schema.create_block(reader_params.return_columns);
+    // rows are buffered and reordered before written if the table is clustered, the row ids
+    // of the output can not be recorded then
+    ClusteringSpec clustering_spec;
+    std::unique_ptr<ClusteringBuffer> clustering_buffer;
+    if (!reader_params.record_rowids &&
+        get_clustering_spec(*tablet, cur_tablet_schema, &clustering_spec)) {
+        clustering_buffer = std::make_unique<ClusteringBuffer>(
+                std::move(clustering_spec),
+                cur_tablet_schema.create_block(reader_params.return_columns), tablet->tablet_id());
+    }
+    auto write_block = [&](vectorized::Block* output_block) {
+        RETURN_NOT_OK_STATUS_WITH_WARN(dst_rowset_writer->add_block(output_block),
+                                       "failed to write block when merging rowsets of tablet " +
+                                               std::to_string(tablet->tablet_id()));
+        return Status::OK();
+    };
     size_t output_rows = 0;
     bool eof = false;
     while (!eof && !ExecEnv::GetInstance()->storage_engine().stopped()) {
@@ -121,9 +138,14 @@ Status Merger::vmerge_rowsets(BaseTabletSPtr tablet, ReaderType reader_type,
         RETURN_NOT_OK_STATUS_WITH_WARN(reader.next_block_with_aggregation(&block, &eof),
                                        "failed to read next block when merging rowsets of tablet " +
                                                std::to_string(tablet->tablet_id()));
-        RETURN_NOT_OK_STATUS_WITH_WARN(dst_rowset_writer->add_block(&block),
-                                       "failed to write block when merging rowsets of tablet " +
-                                               std::to_string(tablet->tablet_id()));
+        if (clustering_buffer != nullptr) {
+            RETURN_IF_ERROR(clustering_buffer->add_block(&block, write_block));
+            if (eof) {
+                RETURN_IF_ERROR(clustering_buffer->flush(write_block));
+            }
+        } else {
+            RETURN_IF_ERROR(write_block(&block));
+        }
 
         if (reader_params.record_rowids && block.rows() > 0) {
             std::vector<uint32_t> segment_num_rows;
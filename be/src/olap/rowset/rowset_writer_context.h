@@ -21,6 +21,7 @@
 
 #include "olap/olap_define.h"
 #include "olap/partial_update_info.h"
+#include "olap/rowset/segment_v2/shared_dictionary.h"
 #include "olap/storage_policy.h"
 #include "olap/tablet.h"
 #include "olap/tablet_schema.h"
@@ -38,7 +39,9 @@ class LocalSchemaChangeRecorder;
 }
 
 struct RowsetWriterContext {
-    RowsetWriterContext() : schema_lock(new std::mutex) {
+    RowsetWriterContext()
+            : schema_lock(new std::mutex),
+              shared_dictionaries(std::make_shared<segment_v2::RowsetSharedDictionaries>()) {
         load_id.set_hi(0);
         load_id.set_lo(0);
     }
@@ -108,6 +111,8 @@ struct RowsetWriterContext {
     // In semi-structure senario tablet_schema will be updated concurrently,
     // this lock need to be held when update.Use shared_ptr to avoid delete copy contructor
     std::shared_ptr<std::mutex> schema_lock;
+    // dictionaries of low-cardinality string columns shared by the segments of the rowset
+    std::shared_ptr<segment_v2::RowsetSharedDictionaries> shared_dictionaries;
 
     int64_t compaction_level = 0;
 
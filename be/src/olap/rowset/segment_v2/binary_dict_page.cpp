@@ -27,6 +27,7 @@
 #include "common/logging.h"
 #include "common/status.h"
 #include "olap/rowset/segment_v2/bitshuffle_page.h"
+#include "olap/rowset/segment_v2/shared_dictionary.h"
 #include "util/coding.h"
 #include "util/slice.h" // for Slice
 #include "vec/columns/column.h"
@@ -62,7 +63,46 @@ Status BinaryDictPageBuilder::init() {
             &dict_builder_ptr, dict_builder_options));
     _dict_builder.reset(static_cast<BinaryPlainPageBuilder<FieldType::OLAP_FIELD_TYPE_VARCHAR>*>(
             dict_builder_ptr));
-    return reset();
+    RETURN_IF_ERROR(reset());
+    if (_options.shared_dict != nullptr) {
+        RETURN_IF_ERROR(_seed_shared_dictionary());
+    }
+    return Status::OK();
+}
+
+Status BinaryDictPageBuilder::_seed_shared_dictionary() {
+    auto words = _options.shared_dict->snapshot();
+    if (words == nullptr) {
+        return Status::OK();
+    }
+    // seed the words in the order of the shared dictionary, so that they get the same
+    // codes as in the other segments of the rowset
+    for (const auto& word : *words) {
+        Slice dict_item(word);
+        if (!word.empty()) {
+            char* item_mem = _arena.alloc(word.size());
+            if (item_mem == nullptr) {
+                return Status::MemoryAllocFailed("memory allocate failed, size:{}", word.size());
+            }
+            dict_item.relocate(item_mem);
+        }
+        uint32_t value_code = _dictionary.size();
+        size_t add_count = 1;
+        RETURN_IF_ERROR(
+                _dict_builder->add(reinterpret_cast<const uint8_t*>(&dict_item), &add_count));
+        if (add_count == 0) {
+            break;
+        }
+        _dictionary.emplace(dict_item, value_code);
+        if (word.empty()) {
+            _has_empty = true;
+            _empty_code = value_code;
+        }
+        _num_seeded_words++;
+        _seeded_checksum = extend_shared_dictionary_checksum(_seeded_checksum, word.data(),
+                                                             word.size());
+    }
+    return Status::OK();
 }
 
 bool BinaryDictPageBuilder::is_page_full() {
@@ -186,6 +226,22 @@ uint64_t BinaryDictPageBuilder::size() const {
 }
 
 Status BinaryDictPageBuilder::get_dictionary_page(OwnedSlice* dictionary_page) {
+    if (_options.shared_dict != nullptr) {
+        if (_encoding_type == DICT_ENCODING) {
+            std::vector<Slice> words(_dictionary.size());
+            for (const auto& [word, code] : _dictionary) {
+                words[code] = word;
+            }
+            _options.shared_dict->publish(words);
+        } else {
+            _options.shared_dict->disable();
+        }
+        if (_options.shared_dict_ref != nullptr) {
+            _options.shared_dict_ref->num_words = _num_seeded_words;
+            _options.shared_dict_ref->checksum = _seeded_checksum;
+            _options.shared_dict_ref->complete = _dictionary.size() == _num_seeded_words;
+        }
+    }
     return _dict_builder->finish(dictionary_page);
 }
 
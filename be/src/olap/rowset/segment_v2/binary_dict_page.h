@@ -85,6 +85,9 @@ public:
 private:
     BinaryDictPageBuilder(const PageBuilderOptions& options);
 
+    // Adds the words of the shared dictionary to the dictionary of this column.
+    Status _seed_shared_dictionary();
+
     PageBuilderOptions _options;
     bool _finished;
 
@@ -106,6 +109,10 @@ private:
 
     bool _has_empty = false;
     uint32_t _empty_code = 0;
+
+    // words of the shared dictionary this dictionary starts with
+    uint32_t _num_seeded_words = 0;
+    uint32_t _seeded_checksum = 0;
 };
 
 class BinaryDictPageDecoder : public PageDecoder {
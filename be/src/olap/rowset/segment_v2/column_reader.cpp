@@ -51,7 +51,8 @@
 #include "olap/rowset/segment_v2/page_decoder.h"
 #include "olap/rowset/segment_v2/page_handle.h" // for PageHandle
 #include "olap/rowset/segment_v2/page_io.h"
-#include "olap/rowset/segment_v2/page_pointer.h" // for PagePointer
+#include "olap/rowset/segment_v2/page_pointer.h"
+#include "olap/rowset/segment_v2/shared_dictionary.h" // for PagePointer
 #include "olap/rowset/segment_v2/row_ranges.h"
 #include "olap/rowset/segment_v2/segment.h"
 #include "olap/rowset/segment_v2/zone_map_index.h"
@@ -619,6 +620,18 @@ Status ColumnReader::_load_zone_map_index(bool use_page_cache, bool kept_in_memo
     return Status::OK();
 }
 
+Status ColumnReader::get_page_sum_stats(const std::vector<PageSumStats>** stats) {
+    RETURN_IF_ERROR(_parse_page_stats_once.call([this] {
+        if (!_opts.page_stats.empty()) {
+            RETURN_IF_ERROR(parse_page_stats(_opts.page_stats, &_page_sum_stats));
+            std::string().swap(_opts.page_stats);
+        }
+        return Status::OK();
+    }));
+    *stats = _page_sum_stats.empty() ? nullptr : &_page_sum_stats;
+    return Status::OK();
+}
+
 Status ColumnReader::_load_bitmap_index(bool use_page_cache, bool kept_in_memory) {
     if (_bitmap_index != nullptr) {
         return _bitmap_index->load(use_page_cache, kept_in_memory);
@@ -1169,7 +1182,10 @@ Status FileColumnIterator::init(const ColumnIteratorOptions& opts) {
     if (!_opts.use_page_cache) {
         _reader->disable_index_meta_cache();
     }
-    RETURN_IF_ERROR(get_block_compression_codec(_reader->get_compression(), &_compress_codec));
+    _compress_codec = _reader->get_zstd_dict_codec();
+    if (_compress_codec == nullptr) {
+        RETURN_IF_ERROR(get_block_compression_codec(_reader->get_compression(), &_compress_codec));
+    }
     if (config::enable_low_cardinality_optimize &&
         opts.io_ctx.reader_type == ReaderType::READER_QUERY &&
         _reader->encoding_info()->encoding() == DICT_ENCODING) {
@@ -1412,12 +1428,12 @@ Status FileColumnIterator::_read_data_page(const OrdinalPageIndexIterator& iter)
     if (_reader->encoding_info()->encoding() == DICT_ENCODING) {
         auto dict_page_decoder = reinterpret_cast<BinaryDictPageDecoder*>(_page.data_decoder.get());
         if (dict_page_decoder->is_dict_encoding()) {
-            if (_dict_decoder == nullptr) {
+            if (_dict == nullptr) {
                 RETURN_IF_ERROR(_read_dict_data());
-                CHECK_NOTNULL(_dict_decoder);
+                CHECK_NOTNULL(_dict);
             }
 
-            dict_page_decoder->set_dict_decoder(_dict_decoder.get(), _dict_word_info.get());
+            dict_page_decoder->set_dict_decoder(_dict->decoder.get(), _dict->word_info.get());
         }
     }
     return Status::OK();
@@ -1425,22 +1441,51 @@ Status FileColumnIterator::_read_data_page(const OrdinalPageIndexIterator& iter)
 
 Status FileColumnIterator::_read_dict_data() {
     CHECK_EQ(_reader->encoding_info()->encoding(), DICT_ENCODING);
+    // the dictionary page holds the same words as the one of another segment of the rowset,
+    // which is already decoded
+    const std::string& shared_dict_id = _reader->shared_dict_id();
+    if (!shared_dict_id.empty()) {
+        _dict = SharedDictionaryCache::instance()->get(shared_dict_id);
+        if (_dict != nullptr) {
+            return Status::OK();
+        }
+    }
+    auto dict = std::make_shared<DecodedDictionary>();
     // read dictionary page
     Slice dict_data;
     PageFooterPB dict_footer;
     _opts.type = INDEX_PAGE;
-    RETURN_IF_ERROR(_reader->read_page(_opts, _reader->get_dict_page_pointer(), &_dict_page_handle,
+    RETURN_IF_ERROR(_reader->read_page(_opts, _reader->get_dict_page_pointer(), &dict->page_handle,
                                        &dict_data, &dict_footer, _compress_codec));
     // ignore dict_footer.dict_page_footer().encoding() due to only
     // PLAIN_ENCODING is supported for dict page right now
-    _dict_decoder =
+    dict->decoder =
             std::make_unique<BinaryPlainPageDecoder<FieldType::OLAP_FIELD_TYPE_VARCHAR>>(dict_data);
-    RETURN_IF_ERROR(_dict_decoder->init());
+    RETURN_IF_ERROR(dict->decoder->init());
 
     auto* pd_decoder =
-            (BinaryPlainPageDecoder<FieldType::OLAP_FIELD_TYPE_VARCHAR>*)_dict_decoder.get();
-    _dict_word_info.reset(new StringRef[pd_decoder->_num_elems]);
-    RETURN_IF_ERROR(pd_decoder->get_dict_word_info(_dict_word_info.get()));
+            (BinaryPlainPageDecoder<FieldType::OLAP_FIELD_TYPE_VARCHAR>*)dict->decoder.get();
+    dict->word_info.reset(new StringRef[pd_decoder->_num_elems]);
+    RETURN_IF_ERROR(pd_decoder->get_dict_word_info(dict->word_info.get()));
+
+    if (!shared_dict_id.empty()) {
+        // only share the words that match the id
+        uint32_t num_words = 0;
+        uint32_t checksum = 0;
+        static_cast<void>(parse_shared_dictionary_id(shared_dict_id, &num_words, &checksum));
+        uint32_t words_checksum = 0;
+        for (uint32_t i = 0; i < pd_decoder->_num_elems; ++i) {
+            words_checksum = extend_shared_dictionary_checksum(
+                    words_checksum, dict->word_info[i].data, dict->word_info[i].size);
+        }
+        if (num_words == pd_decoder->_num_elems && checksum == words_checksum) {
+            dict = SharedDictionaryCache::instance()->insert(shared_dict_id, std::move(dict));
+        } else {
+            LOG(WARNING) << "dictionary page of " << _opts.file_reader->path().native()
+                         << " does not match shared dictionary " << shared_dict_id;
+        }
+    }
+    _dict = std::move(dict);
     return Status::OK();
 }
 
@@ -1469,12 +1514,12 @@ Status FileColumnIterator::get_row_ranges_by_dict(const AndBlockColumnPredicate*
         return Status::OK();
     }
 
-    if (!_dict_decoder) {
+    if (!_dict) {
         RETURN_IF_ERROR(_read_dict_data());
-        CHECK_NOTNULL(_dict_decoder);
+        CHECK_NOTNULL(_dict);
     }
 
-    if (!col_predicates->evaluate_and(_dict_word_info.get(), _dict_decoder->count())) {
+    if (!col_predicates->evaluate_and(_dict->word_info.get(), _dict->decoder->count())) {
         row_ranges->clear();
     }
     return Status::OK();
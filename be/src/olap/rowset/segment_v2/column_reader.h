@@ -41,6 +41,7 @@
 #include "olap/rowset/segment_v2/ordinal_page_index.h" // for OrdinalPageIndexIterator
 #include "olap/rowset/segment_v2/page_handle.h"        // for PageHandle
 #include "olap/rowset/segment_v2/page_pointer.h"
+#include "olap/rowset/segment_v2/page_stats.h"
 #include "olap/rowset/segment_v2/parsed_page.h" // for ParsedPage
 #include "olap/types.h"
 #include "olap/utils.h"
@@ -88,6 +89,17 @@ struct ColumnReaderOptions {
     bool kept_in_memory = false;
 
     int be_exec_version = -1;
+
+    // codec of the ZSTD dictionary the data pages of the column are compressed with,
+    // shared by all the iterators of the column
+    std::shared_ptr<BlockCompressionCodec> zstd_dict_codec;
+
+    // set when the dictionary page of the column holds only words of the shared dictionary
+    // of its rowset, see shared_dictionary_id()
+    std::string shared_dict_id;
+
+    // serialized sum and counts of the data pages of a numeric column, see PageStatsWriter
+    std::string page_stats;
 };
 
 struct ColumnIteratorOptions {
@@ -192,6 +204,15 @@ public:
 
     CompressionTypePB get_compression() const { return _meta_compression; }
 
+    BlockCompressionCodec* get_zstd_dict_codec() const { return _opts.zstd_dict_codec.get(); }
+
+    const std::string& shared_dict_id() const { return _opts.shared_dict_id; }
+
+    // Sum and counts of the data pages of a numeric column, in the order of the ordinal index.
+    // They are parsed on the first call, *stats is nullptr if the segment has no page stats
+    // of the column.
+    Status get_page_sum_stats(const std::vector<PageSumStats>** stats);
+
     uint64_t num_rows() const { return _num_rows; }
 
     void set_dict_encoding_type(DictEncodingType type) {
@@ -288,6 +309,9 @@ private:
     std::vector<std::unique_ptr<ColumnReader>> _sub_readers;
 
     DorisCallOnce<Status> _set_dict_encoding_type_once;
+
+    std::vector<PageSumStats> _page_sum_stats;
+    DorisCallOnce<Status> _parse_page_stats_once;
 };
 
 // Base iterator to read one column data
@@ -351,6 +375,15 @@ protected:
 
 // This iterator is used to read column data from file
 // for scalar type
+// A dictionary page read and decoded by a FileColumnIterator, it is not changed once
+// decoded, so it may be shared by iterators of different segments.
+struct DecodedDictionary {
+    // keep dict page handle to avoid released
+    PageHandle page_handle;
+    std::unique_ptr<PageDecoder> decoder;
+    std::unique_ptr<StringRef[]> word_info;
+};
+
 class FileColumnIterator final : public ColumnIterator {
 public:
     explicit FileColumnIterator(ColumnReader* reader);
@@ -406,11 +439,9 @@ private:
     //    If new seek is issued, the _page will be reset.
     ParsedPage _page;
 
-    // keep dict page decoder
-    std::unique_ptr<PageDecoder> _dict_decoder;
-
-    // keep dict page handle to avoid released
-    PageHandle _dict_page_handle;
+    // decoded dictionary page, shared with the iterators of the other segments of the
+    // rowset when the page holds only words of the shared dictionary of the rowset
+    std::shared_ptr<DecodedDictionary> _dict;
 
     // page iterator used to get next page when current page is finished.
     // This value will be reset when a new seek is issued
@@ -420,8 +451,6 @@ private:
     ordinal_t _current_ordinal = 0;
 
     bool _is_all_dict_encoding = false;
-
-    std::unique_ptr<StringRef[]> _dict_word_info;
 };
 
 class EmptyFileColumnIterator final : public ColumnIterator {
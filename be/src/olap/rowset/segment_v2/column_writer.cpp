@@ -36,6 +36,7 @@
 #include "olap/rowset/segment_v2/page_builder.h"
 #include "olap/rowset/segment_v2/page_io.h"
 #include "olap/rowset/segment_v2/page_pointer.h"
+#include "olap/rowset/segment_v2/page_stats.h"
 #include "olap/rowset/segment_v2/zone_map_index.h"
 #include "olap/tablet_schema.h"
 #include "olap/types.h"
@@ -416,24 +417,16 @@ ScalarColumnWriter::~ScalarColumnWriter() {
 Status ScalarColumnWriter::init() {
     RETURN_IF_ERROR(get_block_compression_codec(_opts.meta->compression(), &_compress_codec));
 
-    PageBuilder* page_builder = nullptr;
-
     RETURN_IF_ERROR(
             EncodingInfo::get(get_field()->type_info(), _opts.meta->encoding(), &_encoding_info));
     _opts.meta->set_encoding(_encoding_info->encoding());
     // create page builder
-    PageBuilderOptions opts;
-    opts.data_page_size = _opts.data_page_size;
-    opts.dict_page_size = _opts.dict_page_size;
-    RETURN_IF_ERROR(_encoding_info->create_page_builder(opts, &page_builder));
-    if (page_builder == nullptr) {
-        return Status::NotSupported("Failed to create page builder for type {} and encoding {}",
-                                    get_field()->type(), _opts.meta->encoding());
-    }
+    RETURN_IF_ERROR(_create_page_builder(_opts.data_page_size));
+    _collecting_zstd_dict_samples = _opts.zstd_dict_capacity > 0 && _opts.zstd_dict != nullptr &&
+                                    _compress_codec != nullptr;
     // should store more concrete encoding type instead of DEFAULT_ENCODING
     // because the default encoding of a data type can be changed in the future
     DCHECK_NE(_opts.meta->encoding(), DEFAULT_ENCODING);
-    _page_builder.reset(page_builder);
     // create ordinal builder
     _ordinal_index_builder = std::make_unique<OrdinalIndexWriter>();
     // create null bitmap builder
@@ -443,6 +436,9 @@ Status ScalarColumnWriter::init() {
     if (_opts.need_zone_map) {
         RETURN_IF_ERROR(ZoneMapIndexWriter::create(get_field(), _zone_map_index_builder));
     }
+    if (_opts.page_stats != nullptr) {
+        PageStatsWriter::create(get_field()->type(), &_page_stats_builder);
+    }
     if (_opts.need_bitmap_index) {
         RETURN_IF_ERROR(
                 BitmapIndexWriter::create(get_field()->type_info(), &_bitmap_index_builder));
@@ -505,6 +501,9 @@ Status ScalarColumnWriter::append_nulls(size_t num_rows) {
     if (_opts.need_zone_map) {
         _zone_map_index_builder->add_nulls(num_rows);
     }
+    if (_page_stats_builder) {
+        _page_stats_builder->add_nulls(num_rows);
+    }
     if (_opts.need_bitmap_index) {
         _bitmap_index_builder->add_nulls(num_rows);
     }
@@ -517,6 +516,103 @@ Status ScalarColumnWriter::append_nulls(size_t num_rows) {
     return Status::OK();
 }
 
+Status ScalarColumnWriter::_create_page_builder(size_t data_page_size) {
+    PageBuilder* page_builder = nullptr;
+    PageBuilderOptions opts;
+    opts.data_page_size = data_page_size;
+    opts.dict_page_size = _opts.dict_page_size;
+    opts.shared_dict = _opts.shared_dict;
+    opts.shared_dict_ref = _opts.shared_dict_ref;
+    RETURN_IF_ERROR(_encoding_info->create_page_builder(opts, &page_builder));
+    if (page_builder == nullptr) {
+        return Status::NotSupported("Failed to create page builder for type {} and encoding {}",
+                                    get_field()->type(), _opts.meta->encoding());
+    }
+    _page_builder.reset(page_builder);
+    _data_page_size = data_page_size;
+    return Status::OK();
+}
+
+// Resize the next data pages of the column, so that their compressed size gets close to
+// _opts.target_compressed_page_size. Narrow values are capped by a number of rows per page,
+// to keep the granularity of the zone maps.
+Status ScalarColumnWriter::_adapt_data_page_size(size_t uncompressed_size, size_t stored_size,
+                                                 size_t num_values) {
+    // a dictionary page builder keeps its dictionary across pages, it can not be replaced
+    if (_opts.target_compressed_page_size == 0 || _encoding_info->encoding() == DICT_ENCODING) {
+        return Status::OK();
+    }
+    _total_uncompressed_size += uncompressed_size;
+    _total_stored_size += stored_size;
+    _total_num_values += num_values;
+    if (_total_stored_size == 0 || _total_num_values == 0) {
+        return Status::OK();
+    }
+    static constexpr size_t MIN_ADAPTIVE_PAGE_SIZE = 4096;
+    static constexpr size_t MAX_ADAPTIVE_PAGE_ROWS = 65536;
+    double compression_ratio =
+            static_cast<double>(_total_uncompressed_size) / static_cast<double>(_total_stored_size);
+    auto page_size = static_cast<size_t>(
+            static_cast<double>(_opts.target_compressed_page_size) * compression_ratio);
+    size_t value_width = std::max<uint64_t>(1, _total_uncompressed_size / _total_num_values);
+    page_size = std::min(page_size, value_width * MAX_ADAPTIVE_PAGE_ROWS);
+    page_size = std::min(page_size, _opts.data_page_size * 16);
+    page_size = std::max(page_size, MIN_ADAPTIVE_PAGE_SIZE);
+    // the page builder is empty after a page is finished, it is only replaced when the page
+    // size changes by more than a quarter
+    if (page_size * 4 < _data_page_size * 3 || page_size * 4 > _data_page_size * 5) {
+        RETURN_IF_ERROR(_create_page_builder(page_size));
+    }
+    return Status::OK();
+}
+
+// A dictionary stored in the footer has to be paid back by the pages of the segment,
+// so it is not trained for a handful of pages.
+static constexpr int64_t MIN_ZSTD_DICT_SAMPLES_PER_BYTE = 4;
+
+Status ScalarColumnWriter::_train_zstd_dict() {
+    _collecting_zstd_dict_samples = false;
+    if (_zstd_dict_sample_size >= _opts.zstd_dict_capacity * MIN_ZSTD_DICT_SAMPLES_PER_BYTE) {
+        std::vector<Slice> samples;
+        samples.reserve(_pages.size());
+        for (auto& page : _pages) {
+            samples.push_back(page->data[0].slice());
+        }
+        Status st = train_zstd_dictionary(samples, _opts.zstd_dict_capacity, _opts.zstd_dict);
+        if (st.ok()) {
+            st = create_zstd_dict_codec(*_opts.zstd_dict, &_zstd_dict_codec);
+        }
+        if (st.ok()) {
+            _compress_codec = _zstd_dict_codec.get();
+        } else {
+            // samples too uniform or too small, keep compressing without a dictionary
+            VLOG_DEBUG << "failed to train zstd dictionary for column "
+                       << _opts.meta->unique_id() << ": " << st;
+            _opts.zstd_dict->clear();
+            _zstd_dict_codec.reset();
+        }
+    }
+    // compress the pages that were kept uncompressed as samples
+    for (auto& page : _pages) {
+        std::vector<Slice> body;
+        for (auto& data : page->data) {
+            if (!data.slice().empty()) {
+                body.push_back(data.slice());
+            }
+        }
+        OwnedSlice compressed_body;
+        RETURN_IF_ERROR(PageIO::compress_page_body(
+                _compress_codec, _opts.compression_min_space_saving, body, &compressed_body));
+        if (!compressed_body.slice().empty()) {
+            _data_size -= Slice::compute_total_size(body);
+            _data_size += compressed_body.slice().size;
+            page->data.clear();
+            page->data.emplace_back(std::move(compressed_body));
+        }
+    }
+    return Status::OK();
+}
+
 // append data to page builder. this function will make sure that
 // num_rows must be written before return. And ptr will be modified
 // to next data should be written
@@ -541,6 +637,9 @@ Status ScalarColumnWriter::_internal_append_data_in_current_page(const uint8_t*
     if (_opts.need_zone_map) {
         _zone_map_index_builder->add_values(data, *num_written);
     }
+    if (_page_stats_builder) {
+        _page_stats_builder->add_values(data, *num_written);
+    }
     if (_opts.need_bitmap_index) {
         _bitmap_index_builder->add_values(data, *num_written);
     }
@@ -594,10 +693,16 @@ Status ScalarColumnWriter::finish() {
 }
 
 Status ScalarColumnWriter::write_data() {
+    if (_collecting_zstd_dict_samples) {
+        RETURN_IF_ERROR(_train_zstd_dict());
+    }
     for (auto& page : _pages) {
         RETURN_IF_ERROR(_write_data_page(page.get()));
     }
     _pages.clear();
+    if (_page_stats_builder) {
+        _page_stats_builder->finish(_opts.page_stats);
+    }
     // write column dict
     if (_encoding_info->encoding() == DICT_ENCODING) {
         OwnedSlice dict_body;
@@ -672,6 +777,9 @@ Status ScalarColumnWriter::finish_current_page() {
         }
         RETURN_IF_ERROR(_zone_map_index_builder->flush());
     }
+    if (_page_stats_builder) {
+        _page_stats_builder->flush();
+    }
 
     if (_opts.need_bloom_filter) {
         RETURN_IF_ERROR(_bloom_filter_index_builder->flush());
@@ -704,22 +812,37 @@ Status ScalarColumnWriter::finish_current_page() {
     if (_new_page_callback != nullptr) {
         _new_page_callback->put_extra_info_in_page(data_page_footer);
     }
-    // trying to compress page body
+    // trying to compress page body, unless it is kept as a sample of the ZSTD dictionary
     OwnedSlice compressed_body;
-    RETURN_IF_ERROR(PageIO::compress_page_body(_compress_codec, _opts.compression_min_space_saving,
-                                               body, &compressed_body));
+    if (!_collecting_zstd_dict_samples) {
+        RETURN_IF_ERROR(PageIO::compress_page_body(
+                _compress_codec, _opts.compression_min_space_saving, body, &compressed_body));
+    }
+    size_t uncompressed_size = page->footer.uncompressed_size();
+    size_t stored_size = uncompressed_size;
     if (compressed_body.slice().empty()) {
         // page body is uncompressed
         page->data.emplace_back(std::move(encoded_values));
         page->data.emplace_back(std::move(nullmap));
     } else {
         // page body is compressed
+        stored_size = compressed_body.slice().size;
         page->data.emplace_back(std::move(compressed_body));
     }
 
     _push_back_page(std::move(page));
+    size_t num_values = _next_rowid - _first_rowid;
     _first_rowid = _next_rowid;
-    return Status::OK();
+    if (_collecting_zstd_dict_samples) {
+        _zstd_dict_sample_size += uncompressed_size;
+        // a smaller ratio would stop the sampling before there are enough samples to train
+        auto sample_ratio = std::max<int64_t>(config::zstd_dict_training_sample_ratio,
+                                              MIN_ZSTD_DICT_SAMPLES_PER_BYTE);
+        if (_zstd_dict_sample_size >= _opts.zstd_dict_capacity * sample_ratio) {
+            RETURN_IF_ERROR(_train_zstd_dict());
+        }
+    }
+    return _adapt_data_page_size(uncompressed_size, stored_size, num_values);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
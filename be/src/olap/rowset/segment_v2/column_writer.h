@@ -47,6 +47,8 @@ class FileWriter;
 }
 
 namespace segment_v2 {
+class SharedDictionary;
+struct SharedDictionaryRef;
 
 struct ColumnWriterOptions {
     // input and output parameter:
@@ -55,6 +57,21 @@ struct ColumnWriterOptions {
     ColumnMetaPB* meta = nullptr;
     size_t data_page_size = STORAGE_PAGE_SIZE_DEFAULT_VALUE;
     size_t dict_page_size = STORAGE_DICT_PAGE_SIZE_DEFAULT_VALUE;
+    // when not 0, the data page size is adapted to the observed compression ratio and value
+    // width of the column, so that compressed data pages get close to this size
+    size_t target_compressed_page_size = 0;
+    // when not 0, a ZSTD dictionary of at most this size is trained from the first data
+    // pages of the column and all data pages are compressed with it, the dictionary is
+    // returned in zstd_dict, which is left empty if it could not be trained
+    size_t zstd_dict_capacity = 0;
+    std::string* zstd_dict = nullptr;
+    // dictionary shared with the other segments of the rowset, the shared words the
+    // dictionary page is seeded with are returned in shared_dict_ref
+    SharedDictionary* shared_dict = nullptr;
+    SharedDictionaryRef* shared_dict_ref = nullptr;
+    // when not null, the sum, non-null count and null count of the values of each data
+    // page of a numeric column are serialized into page_stats, see PageStatsWriter
+    std::string* page_stats = nullptr;
     // store compressed page only when space saving is above the threshold.
     // space saving = 1 - compressed_size / uncompressed_size
     double compression_min_space_saving = 0.1;
@@ -85,6 +102,7 @@ class EncodingInfo;
 class NullBitmapBuilder;
 class OrdinalIndexWriter;
 class PageBuilder;
+class PageStatsWriter;
 class BloomFilterIndexWriter;
 class ZoneMapIndexWriter;
 
@@ -229,6 +247,9 @@ public:
 
 private:
     Status _internal_append_data_in_current_page(const uint8_t* ptr, size_t* num_written);
+    Status _create_page_builder(size_t data_page_size);
+    Status _adapt_data_page_size(size_t uncompressed_size, size_t stored_size, size_t num_values);
+    Status _train_zstd_dict();
 
 private:
     std::unique_ptr<PageBuilder> _page_builder;
@@ -239,6 +260,12 @@ private:
 
     const EncodingInfo* _encoding_info = nullptr;
 
+    // data page size of _page_builder, and the sizes of the finished pages it is adapted from
+    size_t _data_page_size = 0;
+    uint64_t _total_uncompressed_size = 0;
+    uint64_t _total_stored_size = 0;
+    uint64_t _total_num_values = 0;
+
     ordinal_t _next_rowid = 0;
 
     // All Pages will be organized into a linked list
@@ -274,9 +301,14 @@ private:
     ordinal_t _first_rowid = 0;
 
     BlockCompressionCodec* _compress_codec;
+    // pages are kept uncompressed while samples for the ZSTD dictionary are collected
+    bool _collecting_zstd_dict_samples = false;
+    size_t _zstd_dict_sample_size = 0;
+    std::unique_ptr<BlockCompressionCodec> _zstd_dict_codec;
 
     std::unique_ptr<OrdinalIndexWriter> _ordinal_index_builder;
     std::unique_ptr<ZoneMapIndexWriter> _zone_map_index_builder;
+    std::unique_ptr<PageStatsWriter> _page_stats_builder;
     std::unique_ptr<BitmapIndexWriter> _bitmap_index_builder;
     std::unique_ptr<InvertedIndexColumnWriter> _inverted_index_builder;
     std::unique_ptr<BloomFilterIndexWriter> _bloom_filter_index_builder;
@@ -21,12 +21,24 @@
 
 namespace doris {
 namespace segment_v2 {
+class SharedDictionary;
+struct SharedDictionaryRef;
 
 static constexpr size_t STORAGE_PAGE_SIZE_DEFAULT_VALUE = 65536;
 static constexpr size_t STORAGE_DICT_PAGE_SIZE_DEFAULT_VALUE = 256 * 1024l;
 
 constexpr long ROW_STORE_PAGE_SIZE_DEFAULT_VALUE = 16384; // default row store page size: 16KB
 
+// key prefix of the segment footer's file meta datas that hold the ZSTD dictionary of a
+// column, followed by the ordinal of the column in the footer
+static constexpr char ZSTD_DICT_FILE_META_KEY_PREFIX[] = "zstd_dict.";
+// key prefix of the segment footer's file meta datas that hold the id of the shared
+// dictionary words the dictionary page of a column holds, followed by the ordinal of the
+// column in the footer
+static constexpr char SHARED_DICT_FILE_META_KEY_PREFIX[] = "shared_dict.";
+// key prefix of the file meta datas that hold the page stats of a column, see PageStatsWriter
+static constexpr char PAGE_STATS_FILE_META_KEY_PREFIX[] = "page_stats.";
+
 struct PageBuilderOptions {
     size_t data_page_size = STORAGE_PAGE_SIZE_DEFAULT_VALUE;
 
@@ -35,6 +47,11 @@ struct PageBuilderOptions {
     bool need_check_bitmap = true;
 
     bool is_dict_page = false; // page used for saving dictionary
+
+    // dictionary shared with the other segments of the rowset, only used by dict encoding
+    SharedDictionary* shared_dict = nullptr;
+    // returns the shared words the dictionary page was seeded with
+    SharedDictionaryRef* shared_dict_ref = nullptr;
 };
 
 struct PageDecoderOptions {
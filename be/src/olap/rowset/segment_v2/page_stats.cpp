@@ -0,0 +1,154 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/page_stats.h"
+
+#include <cstring>
+#include <type_traits>
+
+#include "util/coding.h"
+#include "vec/common/unaligned.h"
+
+namespace doris {
+namespace segment_v2 {
+
+static constexpr uint8_t PAGE_STATS_VERSION = 1;
+
+namespace {
+
+template <typename T>
+class TypedPageStatsWriter final : public PageStatsWriter {
+public:
+    TypedPageStatsWriter() : PageStatsWriter(std::is_floating_point_v<T>) {}
+
+    void add_values(const void* values, size_t count) override {
+        const T* vals = reinterpret_cast<const T*>(values);
+        if constexpr (std::is_floating_point_v<T>) {
+            double sum = 0;
+            for (size_t i = 0; i < count; ++i) {
+                sum += static_cast<double>(unaligned_load<T>(vals + i));
+            }
+            _page.double_sum += sum;
+        } else {
+            for (size_t i = 0; i < count && _page.has_sum; ++i) {
+                _page.has_sum = !__builtin_add_overflow(
+                        _page.int_sum, static_cast<__int128>(unaligned_load<T>(vals + i)),
+                        &_page.int_sum);
+            }
+        }
+        _page.num_not_nulls += count;
+    }
+};
+
+} // namespace
+
+void PageStatsWriter::create(FieldType type, std::unique_ptr<PageStatsWriter>* res) {
+    switch (type) {
+    case FieldType::OLAP_FIELD_TYPE_TINYINT:
+        *res = std::make_unique<TypedPageStatsWriter<int8_t>>();
+        break;
+    case FieldType::OLAP_FIELD_TYPE_SMALLINT:
+        *res = std::make_unique<TypedPageStatsWriter<int16_t>>();
+        break;
+    case FieldType::OLAP_FIELD_TYPE_INT:
+    case FieldType::OLAP_FIELD_TYPE_DECIMAL32:
+        *res = std::make_unique<TypedPageStatsWriter<int32_t>>();
+        break;
+    case FieldType::OLAP_FIELD_TYPE_BIGINT:
+    case FieldType::OLAP_FIELD_TYPE_DECIMAL64:
+        *res = std::make_unique<TypedPageStatsWriter<int64_t>>();
+        break;
+    case FieldType::OLAP_FIELD_TYPE_LARGEINT:
+    case FieldType::OLAP_FIELD_TYPE_DECIMAL128I:
+        *res = std::make_unique<TypedPageStatsWriter<__int128>>();
+        break;
+    case FieldType::OLAP_FIELD_TYPE_FLOAT:
+        *res = std::make_unique<TypedPageStatsWriter<float>>();
+        break;
+    case FieldType::OLAP_FIELD_TYPE_DOUBLE:
+        *res = std::make_unique<TypedPageStatsWriter<double>>();
+        break;
+    default:
+        res->reset();
+        break;
+    }
+}
+
+bool has_page_stats(FieldType type) {
+    std::unique_ptr<PageStatsWriter> writer;
+    PageStatsWriter::create(type, &writer);
+    return writer != nullptr;
+}
+
+void PageStatsWriter::finish(std::string* buf) const {
+    buf->clear();
+    buf->push_back(static_cast<char>(PAGE_STATS_VERSION));
+    buf->push_back(static_cast<char>(_is_float));
+    put_varint64(buf, _pages.size());
+    for (const auto& page : _pages) {
+        buf->push_back(static_cast<char>(page.has_sum));
+        if (_is_float) {
+            uint64_t bits;
+            memcpy(&bits, &page.double_sum, sizeof(bits));
+            put_fixed64_le(buf, bits);
+        } else {
+            put_fixed128_le(buf, static_cast<uint128_t>(page.int_sum));
+        }
+        put_varint64(buf, page.num_not_nulls);
+        put_varint64(buf, page.num_nulls);
+    }
+}
+
+Status parse_page_stats(const Slice& buf, std::vector<PageSumStats>* pages) {
+    Slice input = buf;
+    if (input.size < 2 || static_cast<uint8_t>(input.data[0]) != PAGE_STATS_VERSION) {
+        return Status::Corruption("invalid page stats, size={}", buf.size);
+    }
+    bool is_float = input.data[1] != 0;
+    input.remove_prefix(2);
+    uint64_t num_pages = 0;
+    if (!get_varint64(&input, &num_pages)) {
+        return Status::Corruption("invalid page stats, failed to read number of pages");
+    }
+    pages->clear();
+    pages->reserve(num_pages);
+    size_t sum_size = is_float ? sizeof(uint64_t) : sizeof(uint128_t);
+    for (uint64_t i = 0; i < num_pages; ++i) {
+        if (input.size < 1 + sum_size) {
+            return Status::Corruption("invalid page stats, truncated at page {}", i);
+        }
+        PageSumStats page;
+        page.has_sum = input.data[0] != 0;
+        const auto* sum_ptr = reinterpret_cast<const uint8_t*>(input.data + 1);
+        if (is_float) {
+            uint64_t bits = decode_fixed64_le(sum_ptr);
+            memcpy(&page.double_sum, &bits, sizeof(bits));
+        } else {
+            page.int_sum = static_cast<__int128>(decode_fixed128_le(sum_ptr));
+        }
+        input.remove_prefix(1 + sum_size);
+        if (!get_varint64(&input, &page.num_not_nulls) ||
+            !get_varint64(&input, &page.num_nulls)) {
+            return Status::Corruption("invalid page stats, truncated at page {}", i);
+        }
+        pages->push_back(page);
+    }
+    return Status::OK();
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -0,0 +1,83 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "olap/olap_common.h"
+#include "util/slice.h"
+
+namespace doris {
+namespace segment_v2 {
+
+// Sum, non-null count and null count of the values of a data page of a numeric column,
+// with them an aggregation over whole pages does not need to decode the pages.
+struct PageSumStats {
+    // sum of integers and of the unscaled values of decimals
+    __int128 int_sum = 0;
+    // sum of floats and doubles
+    double double_sum = 0;
+    uint64_t num_not_nulls = 0;
+    uint64_t num_nulls = 0;
+    // false if the integer sum overflowed
+    bool has_sum = true;
+};
+
+// The page stats of a column are serialized as
+//   Version(1) IsFloat(1) NumPages(varint64)
+//   { HasSum(1) Sum(16 or 8) NumNotNulls(varint64) NumNulls(varint64) } * NumPages
+// and kept in the file meta datas of the segment footer, keyed by
+// PAGE_STATS_FILE_META_KEY_PREFIX and the ordinal of the column in the footer.
+class PageStatsWriter {
+public:
+    // Return nullptr in res if the type has no page stats.
+    static void create(FieldType type, std::unique_ptr<PageStatsWriter>* res);
+
+    explicit PageStatsWriter(bool is_float) : _is_float(is_float) {}
+    virtual ~PageStatsWriter() = default;
+
+    virtual void add_values(const void* values, size_t count) = 0;
+
+    void add_nulls(size_t count) { _page.num_nulls += count; }
+
+    // mark the end of one data page
+    void flush() {
+        _pages.push_back(_page);
+        _page = PageSumStats {};
+    }
+
+    void finish(std::string* buf) const;
+
+protected:
+    bool _is_float;
+    PageSumStats _page;
+    std::vector<PageSumStats> _pages;
+};
+
+// Whether the columns of type have page stats.
+bool has_page_stats(FieldType type);
+
+Status parse_page_stats(const Slice& buf, std::vector<PageSumStats>* pages);
+
+} // namespace segment_v2
+} // namespace doris
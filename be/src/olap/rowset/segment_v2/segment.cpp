@@ -21,8 +21,10 @@
 #include <gen_cpp/olap_file.pb.h>
 #include <gen_cpp/segment_v2.pb.h>
 
+#include <charconv>
 #include <cstring>
 #include <memory>
+#include <string_view>
 #include <utility>
 
 #include "cloud/config.h"
@@ -51,6 +53,7 @@
 #include "olap/rowset/segment_v2/page_pointer.h"
 #include "olap/rowset/segment_v2/segment_iterator.h"
 #include "olap/rowset/segment_v2/segment_writer.h" // k_segment_magic_length
+#include "olap/rowset/segment_v2/shared_dictionary.h"
 #include "olap/rowset/segment_v2/stream_reader.h"
 #include "olap/schema.h"
 #include "olap/short_key_index.h"
@@ -61,6 +64,7 @@
 #include "runtime/query_context.h"
 #include "runtime/runtime_predicate.h"
 #include "runtime/runtime_state.h"
+#include "util/block_compression.h"
 #include "util/coding.h"
 #include "util/crc32c.h"
 #include "util/slice.h" // Slice
@@ -631,6 +635,49 @@ Status Segment::_create_column_readers(const SegmentFooterPB& footer) {
             column_id_to_footer_ordinal.emplace(column_pb.unique_id(), ordinal);
         }
     }
+    std::unordered_map<uint32_t, std::shared_ptr<BlockCompressionCodec>> zstd_dict_codecs;
+    std::unordered_map<uint32_t, std::string> shared_dict_ids;
+    // parsed by the column readers when asked for
+    std::unordered_map<uint32_t, std::string> page_stats;
+    for (const auto& file_meta : footer.file_meta_datas()) {
+        std::string_view key = file_meta.key();
+        if (key.starts_with(SHARED_DICT_FILE_META_KEY_PREFIX)) {
+            key.remove_prefix(sizeof(SHARED_DICT_FILE_META_KEY_PREFIX) - 1);
+            uint32_t ordinal = 0;
+            uint32_t num_words = 0;
+            uint32_t checksum = 0;
+            auto [ptr, ec] = std::from_chars(key.data(), key.data() + key.size(), ordinal);
+            if (ec != std::errc() || ptr != key.data() + key.size() ||
+                !parse_shared_dictionary_id(file_meta.value(), &num_words, &checksum)) {
+                return Status::Corruption("invalid shared dictionary {}={} in segment {}",
+                                          file_meta.key(), file_meta.value(),
+                                          _file_reader->path().native());
+            }
+            shared_dict_ids.emplace(ordinal, file_meta.value());
+            continue;
+        }
+        bool is_zstd_dict = key.starts_with(ZSTD_DICT_FILE_META_KEY_PREFIX);
+        if (is_zstd_dict) {
+            key.remove_prefix(sizeof(ZSTD_DICT_FILE_META_KEY_PREFIX) - 1);
+        } else if (key.starts_with(PAGE_STATS_FILE_META_KEY_PREFIX)) {
+            key.remove_prefix(sizeof(PAGE_STATS_FILE_META_KEY_PREFIX) - 1);
+        } else {
+            continue;
+        }
+        uint32_t ordinal = 0;
+        auto [ptr, ec] = std::from_chars(key.data(), key.data() + key.size(), ordinal);
+        if (ec != std::errc() || ptr != key.data() + key.size()) {
+            return Status::Corruption("invalid file meta key {} in segment {}", file_meta.key(),
+                                      _file_reader->path().native());
+        }
+        if (is_zstd_dict) {
+            std::unique_ptr<BlockCompressionCodec> codec;
+            RETURN_IF_ERROR(create_zstd_dict_decompression_codec(file_meta.value(), &codec));
+            zstd_dict_codecs.emplace(ordinal, std::move(codec));
+        } else {
+            page_stats.emplace(ordinal, file_meta.value());
+        }
+    }
     // init by unique_id
     for (uint32_t ordinal = 0; ordinal < _tablet_schema->num_columns(); ++ordinal) {
         const auto& column = _tablet_schema->column(ordinal);
@@ -643,6 +690,16 @@ Status Segment::_create_column_readers(const SegmentFooterPB& footer) {
                 .kept_in_memory = _tablet_schema->is_in_memory(),
                 .be_exec_version = _be_exec_version,
         };
+        if (auto codec_iter = zstd_dict_codecs.find(iter->second);
+            codec_iter != zstd_dict_codecs.end()) {
+            opts.zstd_dict_codec = codec_iter->second;
+        }
+        if (auto id_iter = shared_dict_ids.find(iter->second); id_iter != shared_dict_ids.end()) {
+            opts.shared_dict_id = id_iter->second;
+        }
+        if (auto stats_iter = page_stats.find(iter->second); stats_iter != page_stats.end()) {
+            opts.page_stats = stats_iter->second;
+        }
         std::unique_ptr<ColumnReader> reader;
         RETURN_IF_ERROR(ColumnReader::create(opts, footer.columns(iter->second), footer.num_rows(),
                                              _file_reader, &reader));
@@ -46,6 +46,8 @@
 #include "olap/rowset/segment_v2/inverted_index_writer.h"
 #include "olap/rowset/segment_v2/page_io.h"
 #include "olap/rowset/segment_v2/page_pointer.h"
+#include "olap/rowset/segment_v2/page_stats.h"
+#include "olap/rowset/segment_v2/shared_dictionary.h"
 #include "olap/segment_loader.h"
 #include "olap/short_key_index.h"
 #include "olap/storage_engine.h"
@@ -248,12 +250,26 @@ Status SegmentWriter::_create_column_writer(uint32_t cid, const TabletColumn& co
 
 #undef DISABLE_INDEX_IF_FIELD_TYPE
 
+    if (config::enable_page_sum_stats && has_page_stats(column.type())) {
+        opts.page_stats = &_file_meta_datas[PAGE_STATS_FILE_META_KEY_PREFIX +
+                                            std::to_string(_footer.columns_size() - 1)];
+    }
+
     int64_t storage_page_size = _tablet_schema->storage_page_size();
     // storage_page_size must be between 4KB and 10MB.
     if (storage_page_size >= 4096 && storage_page_size <= 10485760) {
         opts.data_page_size = storage_page_size;
     }
     opts.dict_page_size = _tablet_schema->storage_dict_page_size();
+    if (config::enable_rowset_shared_dictionary && _opts.rowset_ctx != nullptr &&
+        column.unique_id() >= 0 &&
+        (column.type() == FieldType::OLAP_FIELD_TYPE_CHAR ||
+         column.type() == FieldType::OLAP_FIELD_TYPE_VARCHAR ||
+         column.type() == FieldType::OLAP_FIELD_TYPE_STRING)) {
+        opts.shared_dict = _opts.rowset_ctx->shared_dictionaries->get(column.unique_id(),
+                                                                      opts.dict_page_size);
+        opts.shared_dict_ref = &_shared_dict_refs[_footer.columns_size() - 1];
+    }
     DBUG_EXECUTE_IF("VerticalSegmentWriter._create_column_writer.storage_page_size", {
         auto table_id = DebugPoints::instance()->get_debug_param_or_default<int64_t>(
                 "VerticalSegmentWriter._create_column_writer.storage_page_size", "table_id",
@@ -281,6 +297,19 @@ Status SegmentWriter::_create_column_writer(uint32_t cid, const TabletColumn& co
         auto page_size = _tablet_schema->row_store_page_size();
         opts.data_page_size =
                 (page_size > 0) ? page_size : segment_v2::ROW_STORE_PAGE_SIZE_DEFAULT_VALUE;
+        if (config::enable_row_store_zstd_dict && opts.meta->compression() == ZSTD) {
+            opts.zstd_dict_capacity = config::row_store_zstd_dict_capacity;
+            opts.zstd_dict = &_file_meta_datas[ZSTD_DICT_FILE_META_KEY_PREFIX +
+                                               std::to_string(_footer.columns_size() - 1)];
+        }
+    } else if (config::enable_adaptive_page_size &&
+               opts.data_page_size == segment_v2::STORAGE_PAGE_SIZE_DEFAULT_VALUE) {
+        // merge-on-write tables without a full row store serve point lookups from the column
+        // pages, a hit decompresses a whole page, so their pages are kept smaller
+        bool lookup_heavy = _is_mow() && !_tablet_schema->has_row_store_for_all_columns();
+        opts.target_compressed_page_size =
+                lookup_heavy ? config::adaptive_page_size_lookup_target_bytes
+                             : config::adaptive_page_size_scan_target_bytes;
     }
 
     std::unique_ptr<ColumnWriter> writer;
@@ -1195,6 +1224,21 @@ Status SegmentWriter::_write_primary_key_index() {
 
 Status SegmentWriter::_write_footer() {
     _footer.set_num_rows(_row_count);
+    for (const auto& [key, value] : _file_meta_datas) {
+        if (!value.empty()) {
+            auto* meta = _footer.add_file_meta_datas();
+            meta->set_key(key);
+            meta->set_value(value);
+        }
+    }
+    for (const auto& [ordinal, ref] : _shared_dict_refs) {
+        if (ref.complete && ref.num_words > 0) {
+            auto* meta = _footer.add_file_meta_datas();
+            meta->set_key(SHARED_DICT_FILE_META_KEY_PREFIX + std::to_string(ordinal));
+            meta->set_value(shared_dictionary_id(_opts.rowset_ctx->rowset_id.to_string(),
+                                                 _footer.columns(ordinal).unique_id(), ref));
+        }
+    }
 
     // Footer := SegmentFooterPB, FooterPBSize(4), FooterPBChecksum(4), MagicNumber(4)
     std::string footer_buf;
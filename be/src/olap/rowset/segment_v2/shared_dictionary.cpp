@@ -0,0 +1,137 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/shared_dictionary.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <charconv>
+
+#include "util/coding.h"
+#include "util/crc32c.h"
+
+namespace doris {
+namespace segment_v2 {
+
+std::shared_ptr<const SharedDictionary::Words> SharedDictionary::snapshot() const {
+    std::lock_guard<std::mutex> l(_lock);
+    if (_disabled) {
+        return nullptr;
+    }
+    return _words;
+}
+
+void SharedDictionary::publish(const std::vector<Slice>& words) {
+    std::lock_guard<std::mutex> l(_lock);
+    if (_disabled || _bytes >= _max_bytes) {
+        return;
+    }
+    std::shared_ptr<Words> new_words;
+    for (const auto& word : words) {
+        std::string word_str = word.to_string();
+        if (_word_set.contains(word_str)) {
+            continue;
+        }
+        // every word is stored with a 4-byte offset in the dict page
+        if (_bytes + word_str.size() + sizeof(uint32_t) > _max_bytes) {
+            break;
+        }
+        if (new_words == nullptr) {
+            // segments may still be reading the old snapshot, copy on write
+            new_words = std::make_shared<Words>(*_words);
+        }
+        _bytes += word_str.size() + sizeof(uint32_t);
+        _word_set.insert(word_str);
+        new_words->push_back(std::move(word_str));
+    }
+    if (new_words != nullptr) {
+        _words = std::move(new_words);
+    }
+}
+
+void SharedDictionary::disable() {
+    std::lock_guard<std::mutex> l(_lock);
+    _disabled = true;
+    _words = std::make_shared<Words>();
+    _word_set.clear();
+}
+
+SharedDictionary* RowsetSharedDictionaries::get(int32_t column_unique_id, size_t dict_page_size) {
+    std::lock_guard<std::mutex> l(_lock);
+    auto& dictionary = _dictionaries[column_unique_id];
+    if (dictionary == nullptr) {
+        dictionary = std::make_unique<SharedDictionary>(dict_page_size);
+    }
+    return dictionary.get();
+}
+
+uint32_t extend_shared_dictionary_checksum(uint32_t checksum, const char* word, size_t size) {
+    uint8_t size_buf[4];
+    encode_fixed32_le(size_buf, static_cast<uint32_t>(size));
+    checksum = crc32c::Extend(checksum, reinterpret_cast<const char*>(size_buf), sizeof(size_buf));
+    return crc32c::Extend(checksum, word, size);
+}
+
+std::string shared_dictionary_id(std::string_view rowset_id, int32_t column_unique_id,
+                                 const SharedDictionaryRef& ref) {
+    return fmt::format("{}.{}.{}.{}", rowset_id, column_unique_id, ref.num_words, ref.checksum);
+}
+
+bool parse_shared_dictionary_id(std::string_view id, uint32_t* num_words, uint32_t* checksum) {
+    auto parse_last = [&id](uint32_t* value) {
+        auto pos = id.rfind('.');
+        if (pos == std::string_view::npos) {
+            return false;
+        }
+        const char* end = id.data() + id.size();
+        auto [ptr, ec] = std::from_chars(id.data() + pos + 1, end, *value);
+        id.remove_suffix(id.size() - pos);
+        return ec == std::errc() && ptr == end;
+    };
+    // rowset id and column unique id are followed by the number of words and the checksum
+    return parse_last(checksum) && parse_last(num_words) && id.find('.') != std::string_view::npos;
+}
+
+SharedDictionaryCache* SharedDictionaryCache::instance() {
+    static SharedDictionaryCache instance;
+    return &instance;
+}
+
+std::shared_ptr<DecodedDictionary> SharedDictionaryCache::get(const std::string& id) {
+    std::lock_guard<std::mutex> l(_lock);
+    auto iter = _dictionaries.find(id);
+    return iter == _dictionaries.end() ? nullptr : iter->second.lock();
+}
+
+std::shared_ptr<DecodedDictionary> SharedDictionaryCache::insert(
+        const std::string& id, std::shared_ptr<DecodedDictionary> dictionary) {
+    std::lock_guard<std::mutex> l(_lock);
+    auto& cached = _dictionaries[id];
+    if (auto cached_dictionary = cached.lock(); cached_dictionary != nullptr) {
+        return cached_dictionary;
+    }
+    cached = dictionary;
+    if (_dictionaries.size() > _sweep_size) {
+        std::erase_if(_dictionaries, [](const auto& entry) { return entry.second.expired(); });
+        _sweep_size = std::max<size_t>(1024, _dictionaries.size() * 2);
+    }
+    return dictionary;
+}
+
+} // namespace segment_v2
+} // namespace doris
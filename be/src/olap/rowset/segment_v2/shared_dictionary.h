@@ -0,0 +1,129 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <parallel_hashmap/phmap.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "util/slice.h"
+
+namespace doris {
+namespace segment_v2 {
+
+// Dictionary of a low-cardinality string column shared by all the segments of a rowset.
+//
+// Every segment still stores its own dictionary page, but the dictionary page builder
+// of a new segment is seeded with the words published by the segments finished before,
+// so a word keeps the same code in all the segments of the rowset once it is published.
+// Words are only appended, a snapshot taken by a segment is never changed.
+//
+// When the dictionary page of a segment holds only seeded words, the segment footer
+// records the id of these words (see shared_dictionary_id()), and readers decode the
+// dictionary page once for all the segments of the rowset with the same id.
+//
+// The dictionary stops growing once the words take half of the dict page size, so that
+// the seeded segments still have room for their own words, and is disabled once any
+// segment falls back to plain encoding, which means the column is not low-cardinality.
+class SharedDictionary {
+public:
+    using Words = std::vector<std::string>;
+
+    explicit SharedDictionary(size_t dict_page_size) : _max_bytes(dict_page_size / 2) {}
+
+    // Returns nullptr if the dictionary is disabled.
+    std::shared_ptr<const Words> snapshot() const;
+
+    // Publishes the dictionary of a finished segment, in code order.
+    void publish(const std::vector<Slice>& words);
+
+    void disable();
+
+private:
+    mutable std::mutex _lock;
+    const size_t _max_bytes;
+    size_t _bytes = 0;
+    bool _disabled = false;
+    std::shared_ptr<const Words> _words = std::make_shared<Words>();
+    phmap::flat_hash_set<std::string> _word_set;
+};
+
+// The words of the shared dictionary the dictionary page of a segment column was seeded
+// with, filled by the dictionary page builder when the page is finished.
+struct SharedDictionaryRef {
+    uint32_t num_words = 0;
+    // see extend_shared_dictionary_checksum()
+    uint32_t checksum = 0;
+    // whether the dictionary page holds no other word than the seeded ones
+    bool complete = false;
+};
+
+// The shared dictionaries of the string columns of a rowset, by column unique id.
+class RowsetSharedDictionaries {
+public:
+    SharedDictionary* get(int32_t column_unique_id, size_t dict_page_size);
+
+private:
+    std::mutex _lock;
+    phmap::flat_hash_map<int32_t, std::unique_ptr<SharedDictionary>> _dictionaries;
+};
+
+// Checksum of the words of a dictionary, extended word by word in code order from 0.
+uint32_t extend_shared_dictionary_checksum(uint32_t checksum, const char* word, size_t size);
+
+// Returns the id the segment footer records for the dictionary page of a column that
+// holds only the words of the shared dictionary of its rowset described by ref.
+std::string shared_dictionary_id(std::string_view rowset_id, int32_t column_unique_id,
+                                 const SharedDictionaryRef& ref);
+
+// Parses the number of words and the checksum of an id returned by shared_dictionary_id().
+bool parse_shared_dictionary_id(std::string_view id, uint32_t* num_words, uint32_t* checksum);
+
+struct DecodedDictionary;
+
+// Dictionary pages decoded by the column iterators, by shared dictionary id, so that the
+// segments of a rowset holding the same shared words read and decode them only once.
+// A dictionary is kept as long as an iterator uses it.
+class SharedDictionaryCache {
+public:
+    static SharedDictionaryCache* instance();
+
+    // Returns nullptr if no iterator uses the dictionary of this id.
+    std::shared_ptr<DecodedDictionary> get(const std::string& id);
+
+    // Caches a dictionary decoded from a page whose words match the id, returns the
+    // dictionary cached by a concurrent iterator if any.
+    std::shared_ptr<DecodedDictionary> insert(const std::string& id,
+                                              std::shared_ptr<DecodedDictionary> dictionary);
+
+private:
+    std::mutex _lock;
+    std::unordered_map<std::string, std::weak_ptr<DecodedDictionary>> _dictionaries;
+    // expired entries are swept when the map grows beyond this size
+    size_t _sweep_size = 1024;
+};
+
+} // namespace segment_v2
+} // namespace doris
@@ -33,6 +33,7 @@
 #include "olap/olap_define.h"
 #include "olap/rowset/segment_v2/column_writer.h"
 #include "olap/rowset/segment_v2/index_file_writer.h"
+#include "olap/rowset/segment_v2/shared_dictionary.h"
 #include "olap/tablet.h"
 #include "olap/tablet_schema.h"
 #include "util/faststring.h"
@@ -224,6 +225,12 @@ private:
     IndexFileWriter* _index_file_writer = nullptr;
 
     SegmentFooterPB _footer;
+    // per column data kept in the file meta datas of the footer, such as ZSTD
+    // dictionaries and page stats, keyed by their file meta key
+    std::map<std::string, std::string> _file_meta_datas;
+    // shared dictionary words of the dictionary pages of the columns, keyed by their ordinal
+    // in the footer
+    std::map<uint32_t, SharedDictionaryRef> _shared_dict_refs;
     // for mow tables with cluster key, the sort key is the cluster keys not unique keys
     // for other tables, the sort key is the keys
     size_t _num_sort_key_columns;
@@ -319,6 +319,7 @@ Status Tablet::_init_once_action() {
         }
         _stale_rs_version_map[version] = std::move(rowset);
     }
+    _publish_rowset_snapshot();
 
     return res;
 }
@@ -341,6 +342,13 @@ Status Tablet::revise_tablet_meta(const std::vector<RowsetSharedPtr>& to_add,
                                   const std::vector<RowsetSharedPtr>& to_delete,
                                   bool is_incremental_clone) {
     LOG(INFO) << "begin to revise tablet. tablet_id=" << tablet_id();
+    // Queries capture the published rowsets without `_meta_lock`, they must not see the cloned
+    // rowsets before their delete bitmaps, nor the tablet between deleting and adding rowsets.
+    _defer_rowset_snapshot_publish = true;
+    Defer publish_snapshot {[this]() {
+        _defer_rowset_snapshot_publish = false;
+        _publish_rowset_snapshot();
+    }};
     // 1. for incremental clone, we have to add the rowsets first to make it easy to compute
     //    all the delete bitmaps, and it's easy to delete them if we end up with a failure
     // 2. for full clone, we can calculate delete bitmaps on the cloned rowsets directly.
@@ -414,6 +422,7 @@ Status Tablet::revise_tablet_meta(const std::vector<RowsetSharedPtr>& to_add,
         }
         break; // while (keys_type() == UNIQUE_KEYS && enable_unique_key_merge_on_write())
     }
+    DBUG_EXECUTE_IF("Tablet.revise_tablet_meta.delete_bitmap_calculated", DBUG_RUN_CALLBACK(this));
 
     DBUG_EXECUTE_IF("Tablet.revise_tablet_meta_fail", {
         auto ptablet_id = dp->param("tablet_id", 0);
@@ -504,8 +513,13 @@ Status Tablet::add_rowset(RowsetSharedPtr rowset) {
             rowsets_to_delete.push_back(it.second);
         }
     }
-    std::vector<RowsetSharedPtr> empty_vec;
-    RETURN_IF_ERROR(modify_rowsets(empty_vec, rowsets_to_delete));
+    if (rowsets_to_delete.empty()) {
+        _publish_rowset_snapshot();
+    } else {
+        // modify_rowsets() publishes the snapshot with the added rowset
+        std::vector<RowsetSharedPtr> empty_vec;
+        RETURN_IF_ERROR(modify_rowsets(empty_vec, rowsets_to_delete));
+    }
     ++_newly_created_rowset_num;
     return Status::OK();
 }
@@ -592,6 +606,7 @@ Status Tablet::modify_rowsets(std::vector<RowsetSharedPtr>& to_add,
     }
 
     _tablet_meta->modify_rs_metas(rs_metas_to_add, rs_metas_to_delete, same_version);
+    _publish_rowset_snapshot();
 
     if (!same_version) {
         // add rs_metas_to_delete to tracker
@@ -631,6 +646,7 @@ void Tablet::add_rowsets(const std::vector<RowsetSharedPtr>& to_add) {
         rs_metas.push_back(rs->rowset_meta());
     }
     _tablet_meta->modify_rs_metas(rs_metas, {});
+    _publish_rowset_snapshot();
 }
 
 Status Tablet::delete_rowsets(const std::vector<RowsetSharedPtr>& to_delete, bool move_to_stale) {
@@ -644,6 +660,7 @@ Status Tablet::delete_rowsets(const std::vector<RowsetSharedPtr>& to_delete, boo
         _rs_version_map.erase(rs->version());
     }
     _tablet_meta->modify_rs_metas({}, rs_metas, !move_to_stale);
+    _publish_rowset_snapshot();
     if (move_to_stale) {
         for (const auto& rs : to_delete) {
             _stale_rs_version_map[rs->version()] = rs;
@@ -689,6 +706,7 @@ Status Tablet::add_inc_rowset(const RowsetSharedPtr& rowset) {
 
     RETURN_IF_ERROR(_tablet_meta->add_rs_meta(rowset->rowset_meta()));
     _rs_version_map[rowset->version()] = rowset;
+    _publish_rowset_snapshot();
 
     _timestamped_version_tracker.add_version(rowset->version());
 
@@ -993,8 +1011,109 @@ Status Tablet::capture_consistent_rowsets_unlocked(const Version& spec_version,
     return Status::OK();
 }
 
+void Tablet::_publish_rowset_snapshot() {
+    if (_defer_rowset_snapshot_publish) {
+        return;
+    }
+    auto prev_snapshot = _rowset_snapshot.get();
+    if (!config::enable_lock_free_rowset_capture) {
+        // drop the snapshot, it would be stale when the capture is enabled again
+        if (prev_snapshot != nullptr) {
+            _rowset_snapshot.set(nullptr);
+        }
+        return;
+    }
+    auto version_less = [](const RowsetSharedPtr& a, const RowsetSharedPtr& b) {
+        return a->start_version() < b->start_version() ||
+               (a->start_version() == b->start_version() && a->end_version() < b->end_version());
+    };
+    // the rowsets of the previous snapshot still in _rs_version_map are kept in order, only the
+    // few added rowsets are sorted and merged into them
+    std::vector<RowsetSharedPtr> kept_rowsets;
+    kept_rowsets.reserve(_rs_version_map.size());
+    if (prev_snapshot != nullptr) {
+        for (const auto& rowset : prev_snapshot->rowsets) {
+            auto it = _rs_version_map.find(rowset->version());
+            if (it != _rs_version_map.end() && it->second == rowset) {
+                kept_rowsets.push_back(rowset);
+            }
+        }
+    }
+    std::vector<RowsetSharedPtr> added_rowsets;
+    if (kept_rowsets.size() != _rs_version_map.size()) {
+        std::unordered_set<const Rowset*> kept(kept_rowsets.size());
+        for (const auto& rowset : kept_rowsets) {
+            kept.insert(rowset.get());
+        }
+        for (const auto& [_, rowset] : _rs_version_map) {
+            if (!kept.contains(rowset.get())) {
+                added_rowsets.push_back(rowset);
+            }
+        }
+        std::sort(added_rowsets.begin(), added_rowsets.end(), version_less);
+    }
+    auto snapshot = std::make_unique<RowsetSnapshot>();
+    snapshot->rowsets.reserve(_rs_version_map.size());
+    std::merge(std::make_move_iterator(kept_rowsets.begin()),
+               std::make_move_iterator(kept_rowsets.end()),
+               std::make_move_iterator(added_rowsets.begin()),
+               std::make_move_iterator(added_rowsets.end()),
+               std::back_inserter(snapshot->rowsets), version_less);
+    _rowset_snapshot.set(std::move(snapshot));
+}
+
+bool Tablet::_capture_consistent_rowsets_from_snapshot(
+        const Version& spec_version, std::vector<RowsetSharedPtr>* rowsets) const {
+    DBUG_EXECUTE_IF("TTablet::capture_consistent_versions.inject_failure", {
+        auto tablet_id = dp->param<int64_t>("tablet_id", -1);
+        if (tablet_id != -1 && tablet_id == _tablet_meta->tablet_id()) {
+            return false;
+        }
+    });
+    auto snapshot = _rowset_snapshot.get();
+    if (snapshot == nullptr || spec_version.first > spec_version.second) {
+        return false;
+    }
+    const auto& all_rowsets = snapshot->rowsets;
+    // The rowsets of _rs_version_map do not overlap, the path of spec_version is the run of
+    // contiguous rowsets from the one starting at spec_version.first to the one ending at
+    // spec_version.second.
+    auto it = std::lower_bound(all_rowsets.begin(), all_rowsets.end(), spec_version.first,
+                               [](const RowsetSharedPtr& rowset, int64_t start_version) {
+                                   return rowset->start_version() < start_version;
+                               });
+    int64_t next_version = spec_version.first;
+    size_t begin = it - all_rowsets.begin();
+    for (; it != all_rowsets.end() && (*it)->start_version() == next_version; ++it) {
+        next_version = (*it)->end_version() + 1;
+        if (next_version > spec_version.second) {
+            break;
+        }
+    }
+    if (next_version != spec_version.second + 1 || it == all_rowsets.end()) {
+        return false;
+    }
+    rowsets->assign(all_rowsets.begin() + begin, it + 1);
+    return true;
+}
+
 Status Tablet::capture_rs_readers(const Version& spec_version, std::vector<RowSetSplits>* rs_splits,
                                   bool skip_missing_version) {
+    std::vector<RowsetSharedPtr> rowsets;
+    if (config::enable_lock_free_rowset_capture &&
+        _capture_consistent_rowsets_from_snapshot(spec_version, &rowsets)) {
+        DCHECK(rs_splits != nullptr && rs_splits->empty());
+        for (const auto& rowset : rowsets) {
+            RowsetReaderSharedPtr rs_reader;
+            auto res = rowset->create_reader(&rs_reader);
+            if (!res.ok()) {
+                return Status::Error<CAPTURE_ROWSET_READER_ERROR>(
+                        "failed to create reader for rowset:{}", rowset->rowset_id().to_string());
+            }
+            rs_splits->emplace_back(std::move(rs_reader));
+        }
+        return Status::OK();
+    }
     std::shared_lock rlock(_meta_lock);
     std::vector<Version> version_path;
     RETURN_IF_ERROR(capture_consistent_versions_unlocked(spec_version, &version_path,
@@ -1221,6 +1340,7 @@ void Tablet::delete_all_files() {
         static_cast<void>(it.second->remove());
     }
     _rs_version_map.clear();
+    _publish_rowset_snapshot();
 
     for (auto it : _stale_rs_version_map) {
         static_cast<void>(it.second->remove());
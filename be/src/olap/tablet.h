@@ -35,6 +35,7 @@
 #include <vector>
 
 #include "common/config.h"
+#include "common/multi_version.h"
 #include "common/status.h"
 #include "olap/base_tablet.h"
 #include "olap/binlog_config.h"
@@ -519,6 +520,14 @@ private:
     void _max_continuous_version_from_beginning_unlocked(Version* version, Version* max_version,
                                                          bool* has_version_cross) const;
     RowsetSharedPtr _rowset_with_largest_size();
+    // Publish a new snapshot of _rs_version_map, unless revise_tablet_meta() defers it.
+    // MUST hold EXCLUSIVE `_meta_lock`, or be called before the tablet is visible to readers.
+    void _publish_rowset_snapshot();
+    // Capture the rowsets of spec_version from the published snapshot without `_meta_lock`.
+    // Return false if they can not be captured from the snapshot, e.g. the version path goes
+    // through stale rowsets or some versions are missing.
+    bool _capture_consistent_rowsets_from_snapshot(const Version& spec_version,
+                                                   std::vector<RowsetSharedPtr>* rowsets) const;
     /// Delete stale rowset by version. This method not only delete the version in expired rowset map,
     /// but also delete the version in rowset meta vector.
     void _delete_stale_rowset_by_version(const Version& version);
@@ -641,6 +650,17 @@ private:
     // partition's visible version. it sync from fe, but not real-time.
     std::shared_ptr<const VersionWithTime> _visible_version;
 
+    // An immutable copy of the rowsets in _rs_version_map sorted by version, which is published
+    // on every change of _rs_version_map when enable_lock_free_rowset_capture is on, so that
+    // queries capture their rowsets without waiting for the writers holding `_meta_lock`.
+    struct RowsetSnapshot {
+        std::vector<RowsetSharedPtr> rowsets;
+    };
+    MultiVersion<RowsetSnapshot> _rowset_snapshot;
+    // Set by revise_tablet_meta() under `_meta_lock`, so that the rowsets of a clone are
+    // published once, after their delete bitmaps are calculated.
+    bool _defer_rowset_snapshot_publish = false;
+
     std::atomic_bool _is_full_compaction_running = false;
 
     int32_t _compaction_score = -1;
@@ -543,6 +543,9 @@ Status TabletMeta::_save_meta(DataDir* data_dir) {
         LOG(FATAL) << "tablet_uid is invalid"
                    << " tablet=" << tablet_id() << " _tablet_uid=" << _tablet_uid.to_string();
     }
+    if (config::enable_incremental_tablet_meta_save && !config::is_cloud_mode()) {
+        return _save_meta_incrementally(data_dir);
+    }
     string meta_binary;
 
     auto t1 = MonotonicMicros();
@@ -553,6 +556,7 @@ Status TabletMeta::_save_meta(DataDir* data_dir) {
         LOG(FATAL) << "fail to save tablet_meta. status=" << status << ", tablet_id=" << tablet_id()
                    << ", schema_hash=" << schema_hash();
     }
+    reset_separately_saved_rs_metas();
     auto t3 = MonotonicMicros();
     auto cost = t3 - t1;
     if (cost > 1 * 1000 * 1000) {
@@ -563,6 +567,95 @@ Status TabletMeta::_save_meta(DataDir* data_dir) {
     return status;
 }
 
+Status TabletMeta::_save_meta_incrementally(DataDir* data_dir) {
+    auto t1 = MonotonicMicros();
+    TabletRsMetaDelta delta;
+    // The first incremental save of the tablet saves all its rowset metas, which also converts
+    // a tablet meta saved as a whole.
+    delta.save_all = !_rs_metas_saved_separately;
+    auto diff = [&delta](const std::vector<RowsetMetaSharedPtr>& rs_metas,
+                         const std::unordered_map<RowsetId, RowsetMetaSharedPtr>& saved,
+                         std::vector<RowsetMetaSharedPtr>* to_save,
+                         std::vector<RowsetId>* to_remove) {
+        std::unordered_map<RowsetId, RowsetMetaSharedPtr> current;
+        current.reserve(rs_metas.size());
+        for (const auto& rs_meta : rs_metas) {
+            auto it = saved.find(rs_meta->rowset_id());
+            if (delta.save_all || it == saved.end() || it->second != rs_meta) {
+                to_save->push_back(rs_meta);
+            }
+            current.emplace(rs_meta->rowset_id(), rs_meta);
+        }
+        if (!delta.save_all) {
+            for (const auto& [rowset_id, _] : saved) {
+                if (!current.contains(rowset_id)) {
+                    to_remove->push_back(rowset_id);
+                }
+            }
+        }
+        return current;
+    };
+    auto rs_metas = diff(_rs_metas, _saved_rs_metas, &delta.rs_metas_to_save,
+                         &delta.rs_ids_to_remove);
+    auto stale_rs_metas = diff(_stale_rs_metas, _saved_stale_rs_metas,
+                               &delta.stale_rs_metas_to_save, &delta.stale_rs_ids_to_remove);
+
+    TabletMetaPB tablet_meta_pb;
+    _to_meta_pb(&tablet_meta_pb, false);
+    string meta_binary;
+    if (!tablet_meta_pb.SerializeToString(&meta_binary)) {
+        LOG(FATAL) << "failed to serialize meta " << tablet_id();
+    }
+    auto t2 = MonotonicMicros();
+    Status status = TabletMetaManager::save_with_separate_rs_metas(
+            data_dir, tablet_id(), schema_hash(), meta_binary, delta);
+    if (!status.ok()) {
+        LOG(FATAL) << "fail to save tablet_meta. status=" << status << ", tablet_id=" << tablet_id()
+                   << ", schema_hash=" << schema_hash();
+    }
+    _saved_rs_metas = std::move(rs_metas);
+    _saved_stale_rs_metas = std::move(stale_rs_metas);
+    _rs_metas_saved_separately = true;
+    auto t3 = MonotonicMicros();
+    if (t3 - t1 > 1 * 1000 * 1000) {
+        LOG(INFO) << "save tablet(" << tablet_id() << ") meta too slow. serialize cost " << t2 - t1
+                  << "(us), serialized binary size: " << meta_binary.length()
+                  << "(bytes), saved rowsets: "
+                  << delta.rs_metas_to_save.size() + delta.stale_rs_metas_to_save.size()
+                  << ", write rocksdb cost " << t3 - t2 << "(us)";
+    }
+    return status;
+}
+
+void TabletMeta::reset_separately_saved_rs_metas() {
+    _saved_rs_metas.clear();
+    _saved_stale_rs_metas.clear();
+    _rs_metas_saved_separately = false;
+}
+
+void TabletMeta::init_separately_saved_rs_metas(const TabletSeparateRsIds& rs_ids) {
+    // A saved rowset id without a rowset meta is removed by the next save, and a rowset meta
+    // without a saved rowset id is saved by it.
+    auto init_saved = [](const std::vector<RowsetMetaSharedPtr>& rs_metas,
+                         const std::vector<RowsetId>& saved_ids,
+                         std::unordered_map<RowsetId, RowsetMetaSharedPtr>* saved) {
+        saved->clear();
+        for (const auto& rowset_id : saved_ids) {
+            saved->emplace(rowset_id, nullptr);
+        }
+        for (const auto& rs_meta : rs_metas) {
+            auto it = saved->find(rs_meta->rowset_id());
+            if (it != saved->end()) {
+                it->second = rs_meta;
+            }
+        }
+    };
+    std::lock_guard<std::shared_mutex> wrlock(_meta_lock);
+    init_saved(_rs_metas, rs_ids.rs_ids, &_saved_rs_metas);
+    init_saved(_stale_rs_metas, rs_ids.stale_rs_ids, &_saved_stale_rs_metas);
+    _rs_metas_saved_separately = true;
+}
+
 void TabletMeta::serialize(string* meta_binary) {
     TabletMetaPB tablet_meta_pb;
     to_meta_pb(&tablet_meta_pb);
@@ -731,6 +824,10 @@ void TabletMeta::init_from_pb(const TabletMetaPB& tablet_meta_pb) {
 }
 
 void TabletMeta::to_meta_pb(TabletMetaPB* tablet_meta_pb) {
+    _to_meta_pb(tablet_meta_pb, true);
+}
+
+void TabletMeta::_to_meta_pb(TabletMetaPB* tablet_meta_pb, bool with_rs_metas) {
     tablet_meta_pb->set_table_id(table_id());
     tablet_meta_pb->set_index_id(index_id());
     tablet_meta_pb->set_partition_id(partition_id());
@@ -762,7 +859,7 @@ void TabletMeta::to_meta_pb(TabletMetaPB* tablet_meta_pb) {
     }
 
     // RowsetMetaPB is separated from TabletMetaPB
-    if (!config::is_cloud_mode()) {
+    if (!config::is_cloud_mode() && with_rs_metas) {
         for (auto& rs : _rs_metas) {
             rs->to_rowset_pb(tablet_meta_pb->add_rs_metas());
         }
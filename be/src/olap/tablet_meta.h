@@ -86,6 +86,7 @@ enum TabletState {
 
 class DataDir;
 class TabletMeta;
+struct TabletSeparateRsIds;
 class DeleteBitmap;
 class TBinlogConfig;
 
@@ -299,8 +300,19 @@ public:
 
     int64_t avg_rs_meta_serialize_size() const { return _avg_rs_meta_serialize_size; }
 
+    // Called once the full tablet meta is saved, which removes the rowset metas saved under
+    // separate keys, so that the next incremental save saves all the rowset metas again.
+    void reset_separately_saved_rs_metas();
+    // Called once the tablet meta is loaded with rowset metas saved under separate keys, so
+    // that the next incremental save only writes what changed since they were saved.
+    void init_separately_saved_rs_metas(const TabletSeparateRsIds& rs_ids);
+
 private:
     Status _save_meta(DataDir* data_dir);
+    // Save the tablet meta without its rowset metas, and the rowset metas changed since the
+    // last save under separate keys.
+    Status _save_meta_incrementally(DataDir* data_dir);
+    void _to_meta_pb(TabletMetaPB* tablet_meta_pb, bool with_rs_metas);
     void _check_mow_rowset_cache_version_size(size_t rowset_cache_version_size);
 
     // _del_predicates is ignored to compare.
@@ -331,6 +343,11 @@ private:
     // These stale rowsets meta are been removed when rowsets' pathVersion is expired,
     // this policy is judged and computed by TimestampedVersionTracker.
     std::vector<RowsetMetaSharedPtr> _stale_rs_metas;
+    // The rowset metas saved under separate keys by the last incremental save, a rowset meta
+    // is saved again once it is replaced by another object.
+    std::unordered_map<RowsetId, RowsetMetaSharedPtr> _saved_rs_metas;
+    std::unordered_map<RowsetId, RowsetMetaSharedPtr> _saved_stale_rs_metas;
+    bool _rs_metas_saved_separately = false;
     bool _in_restore_mode = false;
     RowsetTypePB _preferred_rowset_type = BETA_ROWSET;
 
@@ -25,6 +25,7 @@
 #include <boost/algorithm/string/trim.hpp>
 #include <fstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "common/logging.h"
@@ -36,6 +37,7 @@
 #include "olap/olap_define.h"
 #include "olap/olap_meta.h"
 #include "olap/utils.h"
+#include "util/coding.h"
 
 namespace rocksdb {
 class Iterator;
@@ -68,6 +70,9 @@ Status TabletMetaManager::get_meta(DataDir* store, TTabletId tablet_id, TSchemaH
                      << " failed.";
         return s;
     }
+    if (store->may_have_separate_rs_metas()) {
+        RETURN_IF_ERROR(_append_separate_rs_metas(meta, tablet_id, schema_hash, &value));
+    }
     return tablet_meta->deserialize(value);
 }
 
@@ -89,7 +94,6 @@ Status TabletMetaManager::get_json_meta(DataDir* store, TTabletId tablet_id,
 // 2. save to local meta store
 Status TabletMetaManager::save(DataDir* store, TTabletId tablet_id, TSchemaHash schema_hash,
                                TabletMetaSharedPtr tablet_meta, std::string_view header_prefix) {
-    std::string key = fmt::format("{}{}_{}", header_prefix, tablet_id, schema_hash);
     std::string value;
     tablet_meta->serialize(&value);
     if (tablet_meta->partition_id() <= 0) {
@@ -99,10 +103,12 @@ Status TabletMetaManager::save(DataDir* store, TTabletId tablet_id, TSchemaHash
         // return Status::InternalError("invaid partition id {} tablet {}",
         //  tablet_meta->partition_id(), tablet_meta->tablet_id());
     }
-    OlapMeta* meta = store->get_meta();
-    VLOG_NOTICE << "save tablet meta"
-                << ", key:" << key << ", meta length:" << value.length();
-    return meta->put(META_COLUMN_FAMILY_INDEX, key, value);
+    RETURN_IF_ERROR(save(store, tablet_id, schema_hash, value, header_prefix));
+    if (header_prefix == HEADER_PREFIX) {
+        // the rowset metas saved under separate keys are removed by the full save
+        tablet_meta->reset_separately_saved_rs_metas();
+    }
+    return Status::OK();
 }
 
 Status TabletMetaManager::save(DataDir* store, TTabletId tablet_id, TSchemaHash schema_hash,
@@ -111,7 +117,159 @@ Status TabletMetaManager::save(DataDir* store, TTabletId tablet_id, TSchemaHash
     OlapMeta* meta = store->get_meta();
     VLOG_NOTICE << "save tablet meta "
                 << ", key:" << key << " meta_size=" << meta_binary.length();
-    return meta->put(META_COLUMN_FAMILY_INDEX, key, meta_binary);
+    if (header_prefix != HEADER_PREFIX || !store->may_have_separate_rs_metas()) {
+        return meta->put(META_COLUMN_FAMILY_INDEX, key, meta_binary);
+    }
+    // the full tablet meta replaces the rowset metas saved under separate keys
+    rocksdb::WriteBatch batch;
+    rocksdb::ColumnFamilyHandle* handle = meta->get_handle(META_COLUMN_FAMILY_INDEX);
+    RETURN_IF_ERROR(_remove_separate_rs_metas(meta, tablet_id, schema_hash, &batch));
+    if (batch.Count() == 0) {
+        return meta->put(META_COLUMN_FAMILY_INDEX, key, meta_binary);
+    }
+    rocksdb::Status s = batch.Put(handle, key, meta_binary);
+    if (!s.ok()) {
+        return Status::Error<META_PUT_ERROR>("rocksdb write batch put failed, reason: {}",
+                                             s.ToString());
+    }
+    return meta->put(&batch);
+}
+
+Status TabletMetaManager::save_with_separate_rs_metas(DataDir* store, TTabletId tablet_id,
+                                                      TSchemaHash schema_hash,
+                                                      const std::string& meta_binary,
+                                                      const TabletRsMetaDelta& delta) {
+    std::string key = fmt::format("{}{}_{}", HEADER_PREFIX, tablet_id, schema_hash);
+    OlapMeta* meta = store->get_meta();
+    // set before the write, so that a full save or a remove never misses the separate keys
+    store->set_may_have_separate_rs_metas();
+    rocksdb::WriteBatch batch;
+    rocksdb::ColumnFamilyHandle* handle = meta->get_handle(META_COLUMN_FAMILY_INDEX);
+    rocksdb::Status s = batch.Put(handle, key, meta_binary);
+    if (delta.save_all) {
+        RETURN_IF_ERROR(_remove_separate_rs_metas(meta, tablet_id, schema_hash, &batch));
+    }
+    for (const auto& rowset_id : delta.rs_ids_to_remove) {
+        if (s.ok()) {
+            s = batch.Delete(handle, _rs_meta_key(TABLET_RS_META_PREFIX, tablet_id, schema_hash,
+                                                  rowset_id));
+        }
+    }
+    for (const auto& rowset_id : delta.stale_rs_ids_to_remove) {
+        if (s.ok()) {
+            s = batch.Delete(handle, _rs_meta_key(TABLET_STALE_RS_META_PREFIX, tablet_id,
+                                                  schema_hash, rowset_id));
+        }
+    }
+    size_t rs_meta_bytes = 0;
+    auto put_rs_metas = [&](std::string_view prefix,
+                            const std::vector<RowsetMetaSharedPtr>& rs_metas) -> Status {
+        std::string value;
+        for (const auto& rs_meta : rs_metas) {
+            RowsetMetaPB rs_meta_pb;
+            rs_meta->to_rowset_pb(&rs_meta_pb);
+            value.clear();
+            if (!rs_meta_pb.SerializeToString(&value)) {
+                return Status::Error<SERIALIZE_PROTOBUF_ERROR>(
+                        "failed to serialize rowset meta, tablet_id: {}, rowset_id: {}",
+                        tablet_id, rs_meta->rowset_id().to_string());
+            }
+            rs_meta_bytes += value.size();
+            if (s.ok()) {
+                s = batch.Put(handle,
+                              _rs_meta_key(prefix, tablet_id, schema_hash, rs_meta->rowset_id()),
+                              value);
+            }
+        }
+        return Status::OK();
+    };
+    RETURN_IF_ERROR(put_rs_metas(TABLET_RS_META_PREFIX, delta.rs_metas_to_save));
+    RETURN_IF_ERROR(put_rs_metas(TABLET_STALE_RS_META_PREFIX, delta.stale_rs_metas_to_save));
+    if (!s.ok()) {
+        return Status::Error<META_PUT_ERROR>("rocksdb write batch failed, reason: {}",
+                                             s.ToString());
+    }
+    VLOG_NOTICE << "save tablet meta with separate rowset metas, key:" << key
+                << " meta_size=" << meta_binary.length()
+                << " saved_rowsets=" << delta.rs_metas_to_save.size()
+                << " saved_stale_rowsets=" << delta.stale_rs_metas_to_save.size()
+                << " removed_rowsets=" << delta.rs_ids_to_remove.size()
+                << " removed_stale_rowsets=" << delta.stale_rs_ids_to_remove.size()
+                << " rowset_meta_size=" << rs_meta_bytes << " save_all=" << delta.save_all;
+    return meta->put(&batch);
+}
+
+std::string TabletMetaManager::_rs_meta_key(std::string_view prefix, TTabletId tablet_id,
+                                            TSchemaHash schema_hash, const RowsetId& rowset_id) {
+    return fmt::format("{}{}_{}_{}", prefix, tablet_id, schema_hash, rowset_id.to_string());
+}
+
+Status TabletMetaManager::_remove_separate_rs_metas(OlapMeta* meta, TTabletId tablet_id,
+                                                    TSchemaHash schema_hash,
+                                                    rocksdb::WriteBatch* batch) {
+    rocksdb::ColumnFamilyHandle* handle = meta->get_handle(META_COLUMN_FAMILY_INDEX);
+    rocksdb::Status s;
+    auto remove_func = [&](std::string_view key, std::string_view value) -> bool {
+        s = batch->Delete(handle, rocksdb::Slice(key.data(), key.size()));
+        return s.ok();
+    };
+    for (std::string_view prefix : {TABLET_RS_META_PREFIX, TABLET_STALE_RS_META_PREFIX}) {
+        std::string tablet_prefix = fmt::format("{}{}_{}_", prefix, tablet_id, schema_hash);
+        RETURN_IF_ERROR(meta->iterate(META_COLUMN_FAMILY_INDEX, tablet_prefix, remove_func));
+        if (!s.ok()) {
+            return Status::Error<META_DELETE_ERROR>("rocksdb write batch delete failed, reason: {}",
+                                                    s.ToString());
+        }
+    }
+    return Status::OK();
+}
+
+Status TabletMetaManager::_append_separate_rs_metas(OlapMeta* meta, TTabletId tablet_id,
+                                                    TSchemaHash schema_hash,
+                                                    std::string* meta_binary,
+                                                    TabletSeparateRsIds* rs_ids) {
+    for (bool stale : {false, true}) {
+        std::string tablet_prefix =
+                fmt::format("{}{}_{}_", stale ? TABLET_STALE_RS_META_PREFIX : TABLET_RS_META_PREFIX,
+                            tablet_id, schema_hash);
+        RETURN_IF_ERROR(meta->iterate(
+                META_COLUMN_FAMILY_INDEX, tablet_prefix,
+                [&](std::string_view key, std::string_view value) {
+                    _append_rs_meta_field(meta_binary, stale, value);
+                    if (rs_ids != nullptr) {
+                        RowsetId rowset_id;
+                        rowset_id.init(key.substr(tablet_prefix.size()));
+                        (stale ? rs_ids->stale_rs_ids : rs_ids->rs_ids).push_back(rowset_id);
+                    }
+                    return true;
+                }));
+    }
+    return Status::OK();
+}
+
+Status TabletMetaManager::has_separate_rs_metas(OlapMeta* meta, bool* has_separate_rs_metas) {
+    *has_separate_rs_metas = false;
+    for (std::string_view prefix : {TABLET_RS_META_PREFIX, TABLET_STALE_RS_META_PREFIX}) {
+        RETURN_IF_ERROR(meta->iterate(META_COLUMN_FAMILY_INDEX, prefix,
+                                      [&](std::string_view key, std::string_view value) {
+                                          *has_separate_rs_metas = true;
+                                          return false;
+                                      }));
+        if (*has_separate_rs_metas) {
+            break;
+        }
+    }
+    return Status::OK();
+}
+
+void TabletMetaManager::_append_rs_meta_field(std::string* meta_binary, bool stale,
+                                              std::string_view rs_meta_binary) {
+    // the tag of a length-delimited field is (field_number << 3) | 2
+    uint32_t field_number = stale ? TabletMetaPB::kStaleRsMetasFieldNumber
+                                  : TabletMetaPB::kRsMetasFieldNumber;
+    put_varint32(meta_binary, (field_number << 3) | 2);
+    put_varint32(meta_binary, static_cast<uint32_t>(rs_meta_binary.size()));
+    meta_binary->append(rs_meta_binary.data(), rs_meta_binary.size());
 }
 
 // TODO(ygl):
@@ -121,7 +279,19 @@ Status TabletMetaManager::remove(DataDir* store, TTabletId tablet_id, TSchemaHas
                                  std::string_view header_prefix) {
     std::string key = fmt::format("{}{}_{}", header_prefix, tablet_id, schema_hash);
     OlapMeta* meta = store->get_meta();
-    Status res = meta->remove(META_COLUMN_FAMILY_INDEX, key);
+    Status res;
+    if (header_prefix == HEADER_PREFIX && store->may_have_separate_rs_metas()) {
+        rocksdb::WriteBatch batch;
+        res = _remove_separate_rs_metas(meta, tablet_id, schema_hash, &batch);
+        if (res.ok()) {
+            rocksdb::Status s = batch.Delete(meta->get_handle(META_COLUMN_FAMILY_INDEX), key);
+            res = s.ok() ? meta->put(&batch)
+                         : Status::Error<META_DELETE_ERROR>(
+                                   "rocksdb write batch delete failed, reason: {}", s.ToString());
+        }
+    } else {
+        res = meta->remove(META_COLUMN_FAMILY_INDEX, key);
+    }
     VLOG_NOTICE << "remove tablet_meta, key:" << key << ", res:" << res;
     return res;
 }
@@ -129,7 +299,25 @@ Status TabletMetaManager::remove(DataDir* store, TTabletId tablet_id, TSchemaHas
 Status TabletMetaManager::traverse_headers(
         OlapMeta* meta, std::function<bool(long, long, std::string_view)> const& func,
         std::string_view header_prefix) {
-    auto traverse_header_func = [&func](std::string_view key, std::string_view value) -> bool {
+    return traverse_headers(
+            meta,
+            [&func](long tablet_id, long schema_hash, std::string_view value,
+                    const TabletSeparateRsIds&) { return func(tablet_id, schema_hash, value); },
+            header_prefix);
+}
+
+Status TabletMetaManager::traverse_headers(
+        OlapMeta* meta,
+        std::function<bool(long, long, std::string_view, const TabletSeparateRsIds&)> const& func,
+        std::string_view header_prefix) {
+    // Look up the rowset metas saved under separate keys tablet by tablet, only if there are
+    // any, instead of keeping all of them in memory while the tablets are loaded.
+    bool has_separate = false;
+    if (header_prefix == HEADER_PREFIX) {
+        RETURN_IF_ERROR(has_separate_rs_metas(meta, &has_separate));
+    }
+    Status append_status;
+    auto traverse_header_func = [&](std::string_view key, std::string_view value) -> bool {
         std::vector<std::string> parts;
         // old format key format: "hdr_" + tablet_id + "_" + schema_hash  0.11
         // new format key format: "tabletmeta_" + tablet_id + "_" + schema_hash  0.10
@@ -140,10 +328,26 @@ Status TabletMetaManager::traverse_headers(
         }
         TTabletId tablet_id = std::stol(parts[1], nullptr, 10);
         TSchemaHash schema_hash = std::stol(parts[2], nullptr, 10);
-        return func(tablet_id, schema_hash, value);
+        TabletSeparateRsIds rs_ids;
+        if (has_separate) {
+            std::string rs_meta_fields;
+            append_status = _append_separate_rs_metas(meta, tablet_id, schema_hash,
+                                                      &rs_meta_fields, &rs_ids);
+            if (!append_status.ok()) {
+                return false;
+            }
+            if (!rs_meta_fields.empty()) {
+                std::string meta_binary;
+                meta_binary.reserve(value.size() + rs_meta_fields.size());
+                meta_binary.append(value);
+                meta_binary.append(rs_meta_fields);
+                return func(tablet_id, schema_hash, meta_binary, rs_ids);
+            }
+        }
+        return func(tablet_id, schema_hash, value, rs_ids);
     };
-    Status status = meta->iterate(META_COLUMN_FAMILY_INDEX, header_prefix, traverse_header_func);
-    return status;
+    RETURN_IF_ERROR(meta->iterate(META_COLUMN_FAMILY_INDEX, header_prefix, traverse_header_func));
+    return append_status;
 }
 
 Status TabletMetaManager::load_json_meta(DataDir* store, const std::string& meta_path) {
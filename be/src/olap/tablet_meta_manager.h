@@ -21,10 +21,16 @@
 
 #include <functional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "common/status.h"
 #include "olap/tablet_meta.h"
 
+namespace rocksdb {
+class WriteBatch;
+} // namespace rocksdb
+
 namespace doris {
 class DataDir;
 class OlapMeta;
@@ -37,6 +43,30 @@ constexpr std::string_view PENDING_PUBLISH_INFO = "ppi_";
 
 constexpr std::string_view DELETE_BITMAP = "dlb_";
 
+// key: "tabletrs_" + tablet_id + "_" + schema_hash + "_" + rowset_id
+constexpr std::string_view TABLET_RS_META_PREFIX = "tabletrs_";
+
+constexpr std::string_view TABLET_STALE_RS_META_PREFIX = "tabletstalers_";
+
+// The rowset metas of a tablet changed since they were last saved under separate keys.
+struct TabletRsMetaDelta {
+    std::vector<RowsetMetaSharedPtr> rs_metas_to_save;
+    std::vector<RowsetMetaSharedPtr> stale_rs_metas_to_save;
+    std::vector<RowsetId> rs_ids_to_remove;
+    std::vector<RowsetId> stale_rs_ids_to_remove;
+    // If true, the rowset metas to save are all the rowset metas of the tablet, and the others
+    // saved under separate keys are removed.
+    bool save_all = false;
+};
+
+// The rowset ids of the rowset metas of a tablet saved under separate keys.
+struct TabletSeparateRsIds {
+    std::vector<RowsetId> rs_ids;
+    std::vector<RowsetId> stale_rs_ids;
+
+    bool empty() const { return rs_ids.empty() && stale_rs_ids.empty(); }
+};
+
 // Helper Class for managing tablet headers of one root path.
 class TabletMetaManager {
 public:
@@ -53,12 +83,29 @@ public:
                        const std::string& meta_binary,
                        std::string_view header_prefix = HEADER_PREFIX);
 
+    // Save the tablet meta serialized without its rowset metas, and the changed rowset metas
+    // under separate keys, in one write.
+    static Status save_with_separate_rs_metas(DataDir* store, TTabletId tablet_id,
+                                              TSchemaHash schema_hash,
+                                              const std::string& meta_binary,
+                                              const TabletRsMetaDelta& delta);
+
     static Status remove(DataDir* store, TTabletId tablet_id, TSchemaHash schema_hash,
                          std::string_view header_prefix = HEADER_PREFIX);
 
     static Status traverse_headers(OlapMeta* meta,
                                    std::function<bool(long, long, std::string_view)> const& func,
                                    std::string_view header_prefix = HEADER_PREFIX);
+    // Also pass the rowset ids of the rowset metas of the tablet saved under separate keys,
+    // which are merged into its tablet meta one tablet at a time.
+    static Status traverse_headers(
+            OlapMeta* meta,
+            std::function<bool(long, long, std::string_view, const TabletSeparateRsIds&)> const&
+                    func,
+            std::string_view header_prefix = HEADER_PREFIX);
+
+    // Whether any rowset meta is saved under a separate key in the meta.
+    static Status has_separate_rs_metas(OlapMeta* meta, bool* has_separate_rs_metas);
 
     static Status load_json_meta(DataDir* store, const std::string& meta_path);
 
@@ -85,6 +132,22 @@ public:
                                          int64_t* version);
     static Status remove_old_version_delete_bitmap(DataDir* store, TTabletId tablet_id,
                                                    int64_t version);
+
+private:
+    static std::string _rs_meta_key(std::string_view prefix, TTabletId tablet_id,
+                                    TSchemaHash schema_hash, const RowsetId& rowset_id);
+    // Add the removal of all the rowset metas saved under separate keys of the tablet to batch.
+    static Status _remove_separate_rs_metas(OlapMeta* meta, TTabletId tablet_id,
+                                            TSchemaHash schema_hash, rocksdb::WriteBatch* batch);
+    // Append the rowset metas saved under separate keys of the tablet to the serialized
+    // tablet meta, and their rowset ids to rs_ids if it is not null.
+    static Status _append_separate_rs_metas(OlapMeta* meta, TTabletId tablet_id,
+                                            TSchemaHash schema_hash, std::string* meta_binary,
+                                            TabletSeparateRsIds* rs_ids = nullptr);
+    // Append a serialized rowset meta to a serialized TabletMetaPB as an element of its
+    // rs_metas or stale_rs_metas, as a parsed message merges the repeated fields.
+    static void _append_rs_meta_field(std::string* meta_binary, bool stale,
+                                      std::string_view rs_meta_binary);
 };
 
 } // namespace doris
@@ -43,6 +43,7 @@
 #include "olap/tablet_manager.h"
 #include "olap/txn_manager.h"
 #include "util/doris_metrics.h"
+#include "util/threadpool.h"
 #include "util/uid_util.h"
 
 namespace doris {
@@ -365,9 +366,42 @@ void EngineStorageMigrationTask::_generate_new_header(
 Status EngineStorageMigrationTask::_copy_index_and_data_files(
         const std::string& full_path, const std::vector<RowsetSharedPtr>& consistent_rowsets,
         RowsetBinlogMetasPB* all_binlog_metas_pb) const {
+    // Files are copied concurrently by the copy pool, the first failure is kept in copy_status.
+    // They are declared before the pool, so that they outlive the tasks of the pool.
+    std::mutex copy_status_lock;
+    Status copy_status;
+    auto set_copy_status = [&](Status st) {
+        std::lock_guard<std::mutex> l(copy_status_lock);
+        if (copy_status.ok()) {
+            copy_status = std::move(st);
+        }
+    };
+    std::unique_ptr<ThreadPool> copy_pool;
+    RETURN_IF_ERROR(ThreadPoolBuilder("MigrationCopyPool")
+                            .set_min_threads(1)
+                            .set_max_threads(std::max(1, config::migration_copy_file_threads))
+                            .build(&copy_pool));
+    auto copy_file = [&](std::string src, std::string dest) {
+        return copy_pool->submit_func([&set_copy_status, src = std::move(src),
+                                       dest = std::move(dest)]() {
+            VLOG_DEBUG << "copy " << src << " to " << dest;
+            Status status = io::global_local_filesystem()->copy_path(src, dest);
+            if (!status.ok()) {
+                LOG(WARNING) << "fail to copy file. [src=" << src << ", dest=" << dest << "]"
+                             << status;
+                set_copy_status(std::move(status));
+            }
+        });
+    };
+
     RowsetBinlogMetasPB rowset_binlog_metas_pb;
     for (const auto& rs : consistent_rowsets) {
-        RETURN_IF_ERROR(rs->copy_files_to(full_path, rs->rowset_id()));
+        RETURN_IF_ERROR(copy_pool->submit_func([&set_copy_status, &full_path, rs]() {
+            Status status = rs->copy_files_to(full_path, rs->rowset_id());
+            if (!status.ok()) {
+                set_copy_status(std::move(status));
+            }
+        }));
 
         Version binlog_versions = rs->version();
         RETURN_IF_ERROR(_tablet->get_rowset_binlog_metas(binlog_versions, &rowset_binlog_metas_pb));
@@ -394,15 +428,7 @@ Status EngineStorageMigrationTask::_copy_index_and_data_files(
             std::string segment_file_path = _tablet->get_segment_filepath(rowset_id, segment_index);
             auto snapshot_segment_file_path =
                     fmt::format("{}/{}_{}.binlog", full_path, rowset_id, segment_index);
-
-            Status status = io::global_local_filesystem()->copy_path(segment_file_path,
-                                                                     snapshot_segment_file_path);
-            if (!status.ok()) {
-                LOG(WARNING) << "fail to copy binlog segment file. [src=" << segment_file_path
-                             << ", dest=" << snapshot_segment_file_path << "]" << status;
-                return status;
-            }
-            VLOG_DEBUG << "copy " << segment_file_path << " to " << snapshot_segment_file_path;
+            RETURN_IF_ERROR(copy_file(segment_file_path, snapshot_segment_file_path));
 
             if (tablet_schema.get_inverted_index_storage_format() ==
                 InvertedIndexStorageFormatPB::V1) {
@@ -414,34 +440,21 @@ Status EngineStorageMigrationTask::_copy_index_and_data_files(
                     auto snapshot_segment_index_file_path =
                             fmt::format("{}/{}_{}_{}.binlog-index", full_path, rowset_id,
                                         segment_index, index_id);
-                    VLOG_DEBUG << "copy " << index_file << " to "
-                               << snapshot_segment_index_file_path;
-                    status = io::global_local_filesystem()->copy_path(
-                            index_file, snapshot_segment_index_file_path);
-                    if (!status.ok()) {
-                        LOG(WARNING)
-                                << "fail to copy binlog index file. [src=" << index_file
-                                << ", dest=" << snapshot_segment_index_file_path << "]" << status;
-                        return status;
-                    }
+                    RETURN_IF_ERROR(copy_file(index_file, snapshot_segment_index_file_path));
                 }
             } else if (tablet_schema.has_inverted_index()) {
                 auto index_file = InvertedIndexDescriptor::get_index_file_path_v2(
                         InvertedIndexDescriptor::get_index_file_path_prefix(segment_file_path));
                 auto snapshot_segment_index_file_path =
                         fmt::format("{}/{}_{}.binlog-index", full_path, rowset_id, segment_index);
-                VLOG_DEBUG << "copy " << index_file << " to " << snapshot_segment_index_file_path;
-                status = io::global_local_filesystem()->copy_path(index_file,
-                                                                  snapshot_segment_index_file_path);
-                if (!status.ok()) {
-                    LOG(WARNING) << "fail to copy binlog index file. [src=" << index_file
-                                 << ", dest=" << snapshot_segment_index_file_path << "]" << status;
-                    return status;
-                }
+                RETURN_IF_ERROR(copy_file(index_file, snapshot_segment_index_file_path));
             }
         }
     }
 
+    copy_pool->wait();
+    RETURN_IF_ERROR(copy_status);
+
     std::move(rowset_binlog_metas_pb.mutable_rowset_binlog_metas()->begin(),
               rowset_binlog_metas_pb.mutable_rowset_binlog_metas()->end(),
               google::protobuf::RepeatedFieldBackInserter(
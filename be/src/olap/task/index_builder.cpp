@@ -19,6 +19,7 @@
 
 #include <mutex>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "olap/olap_define.h"
 #include "olap/rowset/beta_rowset.h"
@@ -30,7 +31,9 @@
 #include "olap/segment_loader.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet_schema.h"
+#include "runtime/thread_context.h"
 #include "util/debug_points.h"
+#include "util/threadpool.h"
 #include "util/trace.h"
 
 namespace doris {
@@ -43,14 +46,9 @@ IndexBuilder::IndexBuilder(StorageEngine& engine, TabletSharedPtr tablet,
           _tablet(std::move(tablet)),
           _columns(columns),
           _alter_inverted_indexes(alter_inverted_indexes),
-          _is_drop_op(is_drop_op) {
-    _olap_data_convertor = std::make_unique<vectorized::OlapBlockDataConvertor>();
-}
+          _is_drop_op(is_drop_op) {}
 
-IndexBuilder::~IndexBuilder() {
-    _olap_data_convertor.reset();
-    _inverted_index_builders.clear();
-}
+IndexBuilder::~IndexBuilder() = default;
 
 Status IndexBuilder::init() {
     for (auto inverted_index : _alter_inverted_indexes) {
@@ -348,215 +346,277 @@ Status IndexBuilder::handle_single_rowset(RowsetMetaSharedPtr output_rowset_meta
         LOG(INFO) << "all row nums. source_rows=" << output_rowset_meta->num_rows();
         return Status::OK();
     } else {
-        // create inverted index writer
-        const auto& fs = io::global_local_filesystem();
         auto output_rowset_schema = output_rowset_meta->tablet_schema();
-        size_t inverted_index_size = 0;
-        for (auto& seg_ptr : segments) {
-            std::string index_path_prefix {
-                    InvertedIndexDescriptor::get_index_file_path_prefix(local_segment_path(
-                            _tablet->tablet_path(), output_rowset_meta->rowset_id().to_string(),
-                            seg_ptr->id()))};
-            std::vector<ColumnId> return_columns;
-            std::vector<std::pair<int64_t, int64_t>> inverted_index_writer_signs;
-            _olap_data_convertor->reserve(_alter_inverted_indexes.size());
-
-            std::unique_ptr<IndexFileWriter> index_file_writer = nullptr;
-            if (output_rowset_schema->get_inverted_index_storage_format() >=
-                InvertedIndexStorageFormatPB::V2) {
-                auto idx_file_reader_iter = _index_file_readers.find(
-                        std::make_pair(output_rowset_meta->rowset_id().to_string(), seg_ptr->id()));
-                DBUG_EXECUTE_IF("IndexBuilder::handle_single_rowset_can_not_find_reader",
-                                { idx_file_reader_iter = _index_file_readers.end(); })
-                if (idx_file_reader_iter == _index_file_readers.end()) {
-                    LOG(ERROR) << "idx_file_reader_iter" << output_rowset_meta->rowset_id() << ":"
-                               << seg_ptr->id() << " cannot be found";
-                    continue;
+        // Segments of the rowset are built concurrently, each one with its own convertor,
+        // column writers and index file writer. The output rowset is only published by
+        // modify_rowsets() after all of them succeeded.
+        std::vector<SegmentIndexBuildContext> contexts(segments.size());
+        std::mutex build_status_lock;
+        Status build_status;
+        auto build_segment = [&](size_t i) {
+            {
+                // skip the remaining segments once one of them failed
+                std::lock_guard<std::mutex> l(build_status_lock);
+                if (!build_status.ok()) {
+                    return;
                 }
-                std::string index_path =
-                        InvertedIndexDescriptor::get_index_file_path_v2(index_path_prefix);
-                io::FileWriterPtr file_writer;
-                Status st = fs->create_file(index_path, &file_writer);
+            }
+            auto st = _build_segment_index(output_rowset_meta, segments[i], &contexts[i]);
+            if (!st.ok()) {
+                std::lock_guard<std::mutex> l(build_status_lock);
+                if (build_status.ok()) {
+                    build_status = std::move(st);
+                }
+            }
+        };
+        int parallelism = _segment_build_parallelism(segments.size());
+        if (parallelism <= 1) {
+            for (size_t i = 0; i < segments.size(); ++i) {
+                build_segment(i);
+            }
+        } else {
+            std::unique_ptr<ThreadPool> build_pool;
+            RETURN_IF_ERROR(ThreadPoolBuilder("IndexBuildSegmentPool")
+                                    .set_min_threads(1)
+                                    .set_max_threads(parallelism)
+                                    .build(&build_pool));
+            // the segments are charged to the tracker of the index change task, as when they
+            // are built in the calling thread
+            auto mem_tracker = thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker_sptr();
+            for (size_t i = 0; i < segments.size(); ++i) {
+                auto st = build_pool->submit_func([&build_segment, mem_tracker, i]() {
+                    SCOPED_ATTACH_TASK(mem_tracker);
+                    build_segment(i);
+                });
                 if (!st.ok()) {
-                    LOG(WARNING) << "failed to create writable file. path=" << index_path
-                                 << ", err: " << st;
+                    build_pool->wait();
                     return st;
                 }
-                auto dirs = DORIS_TRY(idx_file_reader_iter->second->get_all_directories());
-                index_file_writer = std::make_unique<IndexFileWriter>(
-                        fs, index_path_prefix, output_rowset_meta->rowset_id().to_string(),
-                        seg_ptr->id(), output_rowset_schema->get_inverted_index_storage_format(),
-                        std::move(file_writer));
-                RETURN_IF_ERROR(index_file_writer->initialize(dirs));
-            } else {
-                index_file_writer = std::make_unique<IndexFileWriter>(
-                        fs, index_path_prefix, output_rowset_meta->rowset_id().to_string(),
-                        seg_ptr->id(), output_rowset_schema->get_inverted_index_storage_format());
             }
-            // create inverted index writer
-            for (auto inverted_index : _alter_inverted_indexes) {
-                DCHECK_EQ(inverted_index.columns.size(), 1);
-                auto index_id = inverted_index.index_id;
-                auto column_name = inverted_index.columns[0];
-                auto column_idx = output_rowset_schema->field_index(column_name);
-                if (column_idx < 0) {
-                    if (inverted_index.__isset.column_unique_ids &&
-                        !inverted_index.column_unique_ids.empty()) {
-                        column_idx = output_rowset_schema->field_index(
-                                inverted_index.column_unique_ids[0]);
-                    }
-                    if (column_idx < 0) {
-                        LOG(WARNING) << "referenced column was missing. "
-                                     << "[column=" << column_name
-                                     << " referenced_column=" << column_idx << "]";
-                        continue;
-                    }
-                }
-                auto column = output_rowset_schema->column(column_idx);
-                // variant column is not support for building index
-                auto is_support_inverted_index =
-                        InvertedIndexColumnWriter::check_support_inverted_index(column);
-                DBUG_EXECUTE_IF("IndexBuilder::handle_single_rowset_support_inverted_index",
-                                { is_support_inverted_index = false; })
-                if (!is_support_inverted_index) {
-                    continue;
-                }
-                DCHECK(output_rowset_schema->has_inverted_index_with_index_id(index_id));
-                _olap_data_convertor->add_column_data_convertor(column);
-                return_columns.emplace_back(column_idx);
-                std::unique_ptr<Field> field(FieldFactory::create(column));
-                const auto* index_meta = output_rowset_schema->inverted_index(column);
-                std::unique_ptr<segment_v2::InvertedIndexColumnWriter> inverted_index_builder;
-                try {
-                    RETURN_IF_ERROR(segment_v2::InvertedIndexColumnWriter::create(
-                            field.get(), &inverted_index_builder, index_file_writer.get(),
-                            index_meta));
-                    DBUG_EXECUTE_IF(
-                            "IndexBuilder::handle_single_rowset_index_column_writer_create_error", {
-                                _CLTHROWA(CL_ERR_IO,
-                                          "debug point: "
-                                          "handle_single_rowset_index_column_writer_create_error");
-                            })
-                } catch (const std::exception& e) {
-                    return Status::Error<ErrorCode::INVERTED_INDEX_CLUCENE_ERROR>(
-                            "CLuceneError occured: {}", e.what());
-                }
+            build_pool->wait();
+        }
+        RETURN_IF_ERROR(build_status);
 
-                if (inverted_index_builder) {
-                    auto writer_sign = std::make_pair(seg_ptr->id(), index_id);
-                    _inverted_index_builders.insert(
-                            std::make_pair(writer_sign, std::move(inverted_index_builder)));
-                    inverted_index_writer_signs.emplace_back(writer_sign);
-                }
+        size_t inverted_index_size = 0;
+        for (auto& ctx : contexts) {
+            if (ctx.index_file_writer) {
+                inverted_index_size += ctx.index_file_writer->get_index_file_total_size();
             }
+        }
+        output_rowset_meta->set_data_disk_size(output_rowset_meta->data_disk_size());
+        output_rowset_meta->set_total_disk_size(output_rowset_meta->total_disk_size() +
+                                                inverted_index_size);
+        output_rowset_meta->set_index_disk_size(output_rowset_meta->index_disk_size() +
+                                                inverted_index_size);
+        LOG(INFO) << "all row nums. source_rows=" << output_rowset_meta->num_rows()
+                  << ", segments=" << segments.size() << ", parallelism=" << parallelism;
+    }
 
-            // DO NOT forget index_file_writer for the segment, otherwise, original inverted index will be deleted.
-            _index_file_writers.emplace(seg_ptr->id(), std::move(index_file_writer));
-            if (return_columns.empty()) {
-                // no columns to read
-                continue;
+    return Status::OK();
+}
+
+int IndexBuilder::_segment_build_parallelism(size_t num_segments) const {
+    int parallelism = std::min(config::index_builder_segment_parallelism,
+                               static_cast<int>(std::min<size_t>(num_segments, INT32_MAX)));
+    // Every index being built buffers up to inverted_index_ram_buffer_size MB before it flushes,
+    // so the segments built at the same time share the memory budget of one schema change thread.
+    auto segment_mem_bytes = static_cast<int64_t>(config::inverted_index_ram_buffer_size * 1024 *
+                                                  1024 * (double)_alter_inverted_indexes.size());
+    if (segment_mem_bytes > 0) {
+        auto budget_parallelism =
+                config::memory_limitation_per_thread_for_schema_change_bytes / segment_mem_bytes;
+        parallelism = static_cast<int>(std::min<int64_t>(parallelism, budget_parallelism));
+    }
+    return std::max(1, parallelism);
+}
+
+Status IndexBuilder::_build_segment_index(const RowsetMetaSharedPtr& output_rowset_meta,
+                                          const segment_v2::SegmentSharedPtr& seg_ptr,
+                                          SegmentIndexBuildContext* ctx) {
+    // create inverted index writer
+    const auto& fs = io::global_local_filesystem();
+    auto output_rowset_schema = output_rowset_meta->tablet_schema();
+    std::string index_path_prefix {InvertedIndexDescriptor::get_index_file_path_prefix(
+            local_segment_path(_tablet->tablet_path(), output_rowset_meta->rowset_id().to_string(),
+                               seg_ptr->id()))};
+    std::vector<ColumnId> return_columns;
+    std::vector<std::pair<int64_t, int64_t>> inverted_index_writer_signs;
+    ctx->olap_data_convertor.reserve(_alter_inverted_indexes.size());
+
+    std::unique_ptr<IndexFileWriter> index_file_writer = nullptr;
+    if (output_rowset_schema->get_inverted_index_storage_format() >=
+        InvertedIndexStorageFormatPB::V2) {
+        auto idx_file_reader_iter = _index_file_readers.find(
+                std::make_pair(output_rowset_meta->rowset_id().to_string(), seg_ptr->id()));
+        DBUG_EXECUTE_IF("IndexBuilder::handle_single_rowset_can_not_find_reader",
+                        { idx_file_reader_iter = _index_file_readers.end(); })
+        if (idx_file_reader_iter == _index_file_readers.end()) {
+            LOG(ERROR) << "idx_file_reader_iter" << output_rowset_meta->rowset_id() << ":"
+                       << seg_ptr->id() << " cannot be found";
+            return Status::OK();
+        }
+        std::string index_path = InvertedIndexDescriptor::get_index_file_path_v2(index_path_prefix);
+        io::FileWriterPtr file_writer;
+        Status st = fs->create_file(index_path, &file_writer);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to create writable file. path=" << index_path
+                         << ", err: " << st;
+            return st;
+        }
+        auto dirs = DORIS_TRY(idx_file_reader_iter->second->get_all_directories());
+        index_file_writer = std::make_unique<IndexFileWriter>(
+                fs, index_path_prefix, output_rowset_meta->rowset_id().to_string(), seg_ptr->id(),
+                output_rowset_schema->get_inverted_index_storage_format(), std::move(file_writer));
+        RETURN_IF_ERROR(index_file_writer->initialize(dirs));
+    } else {
+        index_file_writer = std::make_unique<IndexFileWriter>(
+                fs, index_path_prefix, output_rowset_meta->rowset_id().to_string(), seg_ptr->id(),
+                output_rowset_schema->get_inverted_index_storage_format());
+    }
+    // create inverted index writer
+    for (auto inverted_index : _alter_inverted_indexes) {
+        DCHECK_EQ(inverted_index.columns.size(), 1);
+        auto index_id = inverted_index.index_id;
+        auto column_name = inverted_index.columns[0];
+        auto column_idx = output_rowset_schema->field_index(column_name);
+        if (column_idx < 0) {
+            if (inverted_index.__isset.column_unique_ids &&
+                !inverted_index.column_unique_ids.empty()) {
+                column_idx = output_rowset_schema->field_index(inverted_index.column_unique_ids[0]);
             }
-            // create iterator for each segment
-            StorageReadOptions read_options;
-            OlapReaderStatistics stats;
-            read_options.stats = &stats;
-            read_options.tablet_schema = output_rowset_schema;
-            std::shared_ptr<Schema> schema =
-                    std::make_shared<Schema>(output_rowset_schema->columns(), return_columns);
-            std::unique_ptr<RowwiseIterator> iter;
-            auto res = seg_ptr->new_iterator(schema, read_options, &iter);
-            DBUG_EXECUTE_IF("IndexBuilder::handle_single_rowset_create_iterator_error", {
-                res = Status::Error<ErrorCode::INTERNAL_ERROR>(
-                        "debug point: handle_single_rowset_create_iterator_error");
-            })
-            if (!res.ok()) {
-                LOG(WARNING) << "failed to create iterator[" << seg_ptr->id()
-                             << "]: " << res.to_string();
-                return Status::Error<ErrorCode::ROWSET_READER_INIT>(res.to_string());
+            if (column_idx < 0) {
+                LOG(WARNING) << "referenced column was missing. "
+                             << "[column=" << column_name << " referenced_column=" << column_idx
+                             << "]";
+                continue;
             }
+        }
+        auto column = output_rowset_schema->column(column_idx);
+        // variant column is not support for building index
+        auto is_support_inverted_index =
+                InvertedIndexColumnWriter::check_support_inverted_index(column);
+        DBUG_EXECUTE_IF("IndexBuilder::handle_single_rowset_support_inverted_index",
+                        { is_support_inverted_index = false; })
+        if (!is_support_inverted_index) {
+            continue;
+        }
+        DCHECK(output_rowset_schema->has_inverted_index_with_index_id(index_id));
+        ctx->olap_data_convertor.add_column_data_convertor(column);
+        return_columns.emplace_back(column_idx);
+        std::unique_ptr<Field> field(FieldFactory::create(column));
+        const auto* index_meta = output_rowset_schema->inverted_index(column);
+        std::unique_ptr<segment_v2::InvertedIndexColumnWriter> inverted_index_builder;
+        try {
+            RETURN_IF_ERROR(segment_v2::InvertedIndexColumnWriter::create(
+                    field.get(), &inverted_index_builder, index_file_writer.get(), index_meta));
+            DBUG_EXECUTE_IF("IndexBuilder::handle_single_rowset_index_column_writer_create_error",
+                            {
+                                _CLTHROWA(CL_ERR_IO,
+                                          "debug point: "
+                                          "handle_single_rowset_index_column_writer_create_error");
+                            })
+        } catch (const std::exception& e) {
+            return Status::Error<ErrorCode::INVERTED_INDEX_CLUCENE_ERROR>(
+                    "CLuceneError occured: {}", e.what());
+        }
 
-            auto block = vectorized::Block::create_unique(
-                    output_rowset_schema->create_block(return_columns));
-            while (true) {
-                auto status = iter->next_batch(block.get());
-                DBUG_EXECUTE_IF("IndexBuilder::handle_single_rowset_iterator_next_batch_error", {
-                    status = Status::Error<ErrorCode::SCHEMA_CHANGE_INFO_INVALID>(
-                            "next_batch fault injection");
-                });
-                if (!status.ok()) {
-                    if (status.is<ErrorCode::END_OF_FILE>()) {
-                        break;
-                    }
-                    LOG(WARNING)
-                            << "failed to read next block when schema change for inverted index."
-                            << ", err=" << status.to_string();
-                    return status;
-                }
+        if (inverted_index_builder) {
+            auto writer_sign = std::make_pair(seg_ptr->id(), index_id);
+            ctx->inverted_index_builders.insert(
+                    std::make_pair(writer_sign, std::move(inverted_index_builder)));
+            inverted_index_writer_signs.emplace_back(writer_sign);
+        }
+    }
 
-                // write inverted index data
-                status = _write_inverted_index_data(output_rowset_schema, iter->data_id(),
-                                                    block.get());
-                DBUG_EXECUTE_IF(
-                        "IndexBuilder::handle_single_rowset_write_inverted_index_data_error", {
-                            status = Status::Error<ErrorCode::INTERNAL_ERROR>(
-                                    "debug point: "
-                                    "handle_single_rowset_write_inverted_index_data_error");
-                        })
-                if (!status.ok()) {
-                    return Status::Error<ErrorCode::SCHEMA_CHANGE_INFO_INVALID>(
-                            "failed to write block.");
-                }
-                block->clear_column_data();
-            }
+    // DO NOT forget index_file_writer for the segment, otherwise, original inverted index will be deleted.
+    ctx->index_file_writer = std::move(index_file_writer);
+    if (!return_columns.empty()) {
+        // create iterator for each segment
+        StorageReadOptions read_options;
+        OlapReaderStatistics stats;
+        read_options.stats = &stats;
+        read_options.tablet_schema = output_rowset_schema;
+        std::shared_ptr<Schema> schema =
+                std::make_shared<Schema>(output_rowset_schema->columns(), return_columns);
+        std::unique_ptr<RowwiseIterator> iter;
+        auto res = seg_ptr->new_iterator(schema, read_options, &iter);
+        DBUG_EXECUTE_IF("IndexBuilder::handle_single_rowset_create_iterator_error", {
+            res = Status::Error<ErrorCode::INTERNAL_ERROR>(
+                    "debug point: handle_single_rowset_create_iterator_error");
+        })
+        if (!res.ok()) {
+            LOG(WARNING) << "failed to create iterator[" << seg_ptr->id()
+                         << "]: " << res.to_string();
+            return Status::Error<ErrorCode::ROWSET_READER_INIT>(res.to_string());
+        }
 
-            // finish write inverted index, flush data to compound file
-            for (auto& writer_sign : inverted_index_writer_signs) {
-                try {
-                    if (_inverted_index_builders[writer_sign]) {
-                        RETURN_IF_ERROR(_inverted_index_builders[writer_sign]->finish());
-                    }
-                    DBUG_EXECUTE_IF("IndexBuilder::handle_single_rowset_index_build_finish_error", {
-                        _CLTHROWA(CL_ERR_IO,
-                                  "debug point: handle_single_rowset_index_build_finish_error");
-                    })
-                } catch (const std::exception& e) {
-                    return Status::Error<ErrorCode::INVERTED_INDEX_CLUCENE_ERROR>(
-                            "CLuceneError occured: {}", e.what());
+        auto block = vectorized::Block::create_unique(
+                output_rowset_schema->create_block(return_columns));
+        while (true) {
+            auto status = iter->next_batch(block.get());
+            DBUG_EXECUTE_IF("IndexBuilder::handle_single_rowset_iterator_next_batch_error", {
+                status = Status::Error<ErrorCode::SCHEMA_CHANGE_INFO_INVALID>(
+                        "next_batch fault injection");
+            });
+            if (!status.ok()) {
+                if (status.is<ErrorCode::END_OF_FILE>()) {
+                    break;
                 }
+                LOG(WARNING) << "failed to read next block when schema change for inverted index."
+                             << ", err=" << status.to_string();
+                return status;
             }
 
-            _olap_data_convertor->reset();
-        }
-        for (auto&& [seg_id, index_file_writer] : _index_file_writers) {
-            auto st = index_file_writer->close();
-            DBUG_EXECUTE_IF("IndexBuilder::handle_single_rowset_file_writer_close_error", {
-                st = Status::Error<ErrorCode::INVERTED_INDEX_CLUCENE_ERROR>(
-                        "debug point: handle_single_rowset_file_writer_close_error");
+            // write inverted index data
+            status = _write_inverted_index_data(output_rowset_schema, iter->data_id(), block.get(),
+                                                ctx);
+            DBUG_EXECUTE_IF("IndexBuilder::handle_single_rowset_write_inverted_index_data_error", {
+                status = Status::Error<ErrorCode::INTERNAL_ERROR>(
+                        "debug point: "
+                        "handle_single_rowset_write_inverted_index_data_error");
             })
-            if (!st.ok()) {
-                LOG(ERROR) << "close index_file_writer error:" << st;
-                return st;
+            if (!status.ok()) {
+                return Status::Error<ErrorCode::SCHEMA_CHANGE_INFO_INVALID>(
+                        "failed to write block.");
+            }
+            block->clear_column_data();
+        }
+
+        // finish write inverted index, flush data to compound file
+        for (auto& writer_sign : inverted_index_writer_signs) {
+            try {
+                if (ctx->inverted_index_builders[writer_sign]) {
+                    RETURN_IF_ERROR(ctx->inverted_index_builders[writer_sign]->finish());
+                }
+                DBUG_EXECUTE_IF("IndexBuilder::handle_single_rowset_index_build_finish_error", {
+                    _CLTHROWA(CL_ERR_IO,
+                              "debug point: handle_single_rowset_index_build_finish_error");
+                })
+            } catch (const std::exception& e) {
+                return Status::Error<ErrorCode::INVERTED_INDEX_CLUCENE_ERROR>(
+                        "CLuceneError occured: {}", e.what());
             }
-            inverted_index_size += index_file_writer->get_index_file_total_size();
         }
-        _inverted_index_builders.clear();
-        _index_file_writers.clear();
-        output_rowset_meta->set_data_disk_size(output_rowset_meta->data_disk_size());
-        output_rowset_meta->set_total_disk_size(output_rowset_meta->total_disk_size() +
-                                                inverted_index_size);
-        output_rowset_meta->set_index_disk_size(output_rowset_meta->index_disk_size() +
-                                                inverted_index_size);
-        LOG(INFO) << "all row nums. source_rows=" << output_rowset_meta->num_rows();
     }
 
+    auto st = ctx->index_file_writer->close();
+    DBUG_EXECUTE_IF("IndexBuilder::handle_single_rowset_file_writer_close_error", {
+        st = Status::Error<ErrorCode::INVERTED_INDEX_CLUCENE_ERROR>(
+                "debug point: handle_single_rowset_file_writer_close_error");
+    })
+    if (!st.ok()) {
+        LOG(ERROR) << "close index_file_writer error:" << st;
+        return st;
+    }
     return Status::OK();
 }
 
 Status IndexBuilder::_write_inverted_index_data(TabletSchemaSPtr tablet_schema, int32_t segment_idx,
-                                                vectorized::Block* block) {
+                                                vectorized::Block* block,
+                                                SegmentIndexBuildContext* ctx) {
     VLOG_DEBUG << "begin to write inverted index";
     // converter block data
-    _olap_data_convertor->set_source_content(block, 0, block->rows());
+    ctx->olap_data_convertor.set_source_content(block, 0, block->rows());
     for (auto i = 0; i < _alter_inverted_indexes.size(); ++i) {
         auto inverted_index = _alter_inverted_indexes[i];
         auto index_id = inverted_index.index_id;
@@ -579,7 +639,7 @@ Status IndexBuilder::_write_inverted_index_data(TabletSchemaSPtr tablet_schema,
         auto column = tablet_schema->column(column_idx);
         auto writer_sign = std::make_pair(segment_idx, index_id);
         std::unique_ptr<Field> field(FieldFactory::create(column));
-        auto converted_result = _olap_data_convertor->convert_column_data(i);
+        auto converted_result = ctx->olap_data_convertor.convert_column_data(i);
         DBUG_EXECUTE_IF("IndexBuilder::_write_inverted_index_data_convert_column_data_error", {
             converted_result.first = Status::Error<ErrorCode::INTERNAL_ERROR>(
                     "debug point: _write_inverted_index_data_convert_column_data_error");
@@ -592,12 +652,13 @@ Status IndexBuilder::_write_inverted_index_data(TabletSchemaSPtr tablet_schema,
         const auto* null_map = converted_result.second->get_nullmap();
         if (null_map) {
             RETURN_IF_ERROR(_add_nullable(column_name, writer_sign, field.get(), null_map, &ptr,
-                                          block->rows()));
+                                          block->rows(), ctx));
         } else {
-            RETURN_IF_ERROR(_add_data(column_name, writer_sign, field.get(), &ptr, block->rows()));
+            RETURN_IF_ERROR(
+                    _add_data(column_name, writer_sign, field.get(), &ptr, block->rows(), ctx));
         }
     }
-    _olap_data_convertor->clear_source_content();
+    ctx->olap_data_convertor.clear_source_content();
 
     return Status::OK();
 }
@@ -605,7 +666,7 @@ Status IndexBuilder::_write_inverted_index_data(TabletSchemaSPtr tablet_schema,
 Status IndexBuilder::_add_nullable(const std::string& column_name,
                                    const std::pair<int64_t, int64_t>& index_writer_sign,
                                    Field* field, const uint8_t* null_map, const uint8_t** ptr,
-                                   size_t num_rows) {
+                                   size_t num_rows, SegmentIndexBuildContext* ctx) {
     // TODO: need to process null data for inverted index
     if (field->type() == FieldType::OLAP_FIELD_TYPE_ARRAY) {
         DCHECK(field->get_sub_field_count() == 1);
@@ -617,14 +678,14 @@ Status IndexBuilder::_add_nullable(const std::string& column_name,
         try {
             auto data = *(data_ptr + 2);
             auto nested_null_map = *(data_ptr + 3);
-            RETURN_IF_ERROR(_inverted_index_builders[index_writer_sign]->add_array_values(
+            RETURN_IF_ERROR(ctx->inverted_index_builders[index_writer_sign]->add_array_values(
                     field->get_sub_field(0)->size(), reinterpret_cast<const void*>(data),
                     reinterpret_cast<const uint8_t*>(nested_null_map), offsets_ptr, num_rows));
             DBUG_EXECUTE_IF("IndexBuilder::_add_nullable_add_array_values_error", {
                 _CLTHROWA(CL_ERR_IO, "debug point: _add_nullable_add_array_values_error");
             })
-            RETURN_IF_ERROR(_inverted_index_builders[index_writer_sign]->add_array_nulls(null_map,
-                                                                                         num_rows));
+            RETURN_IF_ERROR(ctx->inverted_index_builders[index_writer_sign]->add_array_nulls(
+                    null_map, num_rows));
         } catch (const std::exception& e) {
             return Status::Error<ErrorCode::INVERTED_INDEX_CLUCENE_ERROR>(
                     "CLuceneError occured: {}", e.what());
@@ -648,9 +709,9 @@ Status IndexBuilder::_add_nullable(const std::string& column_name,
         do {
             auto step = next_run_step();
             if (null_map[offset]) {
-                RETURN_IF_ERROR(_inverted_index_builders[index_writer_sign]->add_nulls(step));
+                RETURN_IF_ERROR(ctx->inverted_index_builders[index_writer_sign]->add_nulls(step));
             } else {
-                RETURN_IF_ERROR(_inverted_index_builders[index_writer_sign]->add_values(
+                RETURN_IF_ERROR(ctx->inverted_index_builders[index_writer_sign]->add_values(
                         column_name, *ptr, step));
             }
             *ptr += field->size() * step;
@@ -668,7 +729,8 @@ Status IndexBuilder::_add_nullable(const std::string& column_name,
 
 Status IndexBuilder::_add_data(const std::string& column_name,
                                const std::pair<int64_t, int64_t>& index_writer_sign, Field* field,
-                               const uint8_t** ptr, size_t num_rows) {
+                               const uint8_t** ptr, size_t num_rows,
+                               SegmentIndexBuildContext* ctx) {
     try {
         if (field->type() == FieldType::OLAP_FIELD_TYPE_ARRAY) {
             DCHECK(field->get_sub_field_count() == 1);
@@ -681,12 +743,12 @@ Status IndexBuilder::_add_data(const std::string& column_name,
             if (element_cnt > 0) {
                 auto data = *(data_ptr + 2);
                 auto nested_null_map = *(data_ptr + 3);
-                RETURN_IF_ERROR(_inverted_index_builders[index_writer_sign]->add_array_values(
+                RETURN_IF_ERROR(ctx->inverted_index_builders[index_writer_sign]->add_array_values(
                         field->get_sub_field(0)->size(), reinterpret_cast<const void*>(data),
                         reinterpret_cast<const uint8_t*>(nested_null_map), offsets_ptr, num_rows));
             }
         } else {
-            RETURN_IF_ERROR(_inverted_index_builders[index_writer_sign]->add_values(
+            RETURN_IF_ERROR(ctx->inverted_index_builders[index_writer_sign]->add_values(
                     column_name, *ptr, num_rows));
         }
         DBUG_EXECUTE_IF("IndexBuilder::_add_data_throw_exception",
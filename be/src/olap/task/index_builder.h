@@ -59,14 +59,29 @@ public:
     virtual void gc_output_rowset();
 
 private:
+    // State of building the indexes of one segment, so that segments can be built concurrently.
+    struct SegmentIndexBuildContext {
+        vectorized::OlapBlockDataConvertor olap_data_convertor;
+        // "<segment_id, index_id>" -> InvertedIndexColumnWriter
+        std::unordered_map<std::pair<int64_t, int64_t>,
+                           std::unique_ptr<segment_v2::InvertedIndexColumnWriter>>
+                inverted_index_builders;
+        std::unique_ptr<IndexFileWriter> index_file_writer;
+    };
+
+    int _segment_build_parallelism(size_t num_segments) const;
+    Status _build_segment_index(const RowsetMetaSharedPtr& output_rowset_meta,
+                                const segment_v2::SegmentSharedPtr& seg_ptr,
+                                SegmentIndexBuildContext* ctx);
     Status _write_inverted_index_data(TabletSchemaSPtr tablet_schema, int32_t segment_idx,
-                                      vectorized::Block* block);
+                                      vectorized::Block* block, SegmentIndexBuildContext* ctx);
     Status _add_data(const std::string& column_name,
                      const std::pair<int64_t, int64_t>& index_writer_sign, Field* field,
-                     const uint8_t** ptr, size_t num_rows);
+                     const uint8_t** ptr, size_t num_rows, SegmentIndexBuildContext* ctx);
     Status _add_nullable(const std::string& column_name,
                          const std::pair<int64_t, int64_t>& index_writer_sign, Field* field,
-                         const uint8_t* null_map, const uint8_t** ptr, size_t num_rows);
+                         const uint8_t* null_map, const uint8_t** ptr, size_t num_rows,
+                         SegmentIndexBuildContext* ctx);
 
 private:
     StorageEngine& _engine;
@@ -80,11 +95,6 @@ private:
     std::vector<RowsetSharedPtr> _output_rowsets;
     std::vector<PendingRowsetGuard> _pending_rs_guards;
     std::vector<RowsetReaderSharedPtr> _input_rs_readers;
-    std::unique_ptr<vectorized::OlapBlockDataConvertor> _olap_data_convertor;
-    // "<segment_id, index_id>" -> InvertedIndexColumnWriter
-    std::unordered_map<std::pair<int64_t, int64_t>,
-                       std::unique_ptr<segment_v2::InvertedIndexColumnWriter>>
-            _inverted_index_builders;
     std::unordered_map<int64_t, std::unique_ptr<IndexFileWriter>> _index_file_writers;
     // <rowset_id, segment_id>
     std::unordered_map<std::pair<std::string, int64_t>, std::unique_ptr<IndexFileReader>>
@@ -571,19 +571,13 @@ Status VersionGraph::capture_consistent_versions(const Version& spec_version,
                 spec_version.second);
     }
 
-    int64_t cur_idx = -1;
-    for (size_t i = 0; i < _version_graph.size(); i++) {
-        if (_version_graph[i].value == spec_version.first) {
-            cur_idx = i;
-            break;
-        }
-    }
-
-    if (cur_idx < 0) {
+    auto start_it = _vertex_index_map.find(spec_version.first);
+    if (start_it == _vertex_index_map.end()) {
         return Status::InternalError<false>(
                 "failed to find path in version_graph. spec_version: {}-{}", spec_version.first,
                 spec_version.second);
     }
+    int64_t cur_idx = start_it->second;
 
     int64_t end_value = spec_version.second + 1;
     while (_version_graph[cur_idx].value < end_value) {
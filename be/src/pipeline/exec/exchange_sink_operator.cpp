@@ -92,6 +92,16 @@ Status ExchangeSinkLocalState::init(RuntimeState* state, LocalSinkStateInfo& inf
 
     auto& p = _parent->cast<ExchangeSinkOperatorX>();
     _part_type = p._part_type;
+    if (!p._runtime_filter_descs.empty()) {
+        _runtime_filter_helper =
+                std::make_unique<RuntimeFilterConsumerHelper>(p._runtime_filter_descs);
+        RETURN_IF_ERROR(_runtime_filter_helper->init(state, false, p._dest_node_id,
+                                                     p.operator_id(), _filter_dependencies,
+                                                     p.get_name() + "_FILTER_DEPENDENCY"));
+        _runtime_filter_timer = ADD_TIMER(custom_profile(), "RuntimeFilterTime");
+        _rows_filtered_by_runtime_filter =
+                ADD_COUNTER(custom_profile(), "RowsFilteredByRuntimeFilter", TUnit::UNIT);
+    }
     // Shuffle the channels randomly
     if (_part_type == TPartitionType::UNPARTITIONED || _part_type == TPartitionType::RANDOM ||
         _part_type == TPartitionType::HIVE_TABLE_SINK_UNPARTITIONED) {
@@ -216,6 +226,10 @@ Status ExchangeSinkLocalState::open(RuntimeState* state) {
     RETURN_IF_ERROR(Base::open(state));
     _writer.reset(new Writer());
     auto& p = _parent->cast<ExchangeSinkOperatorX>();
+    if (_runtime_filter_helper) {
+        RETURN_IF_ERROR(_runtime_filter_helper->acquire_runtime_filter(
+                state, _runtime_filter_conjuncts, p._row_desc));
+    }
 
     for (int i = 0; i < channels.size(); ++i) {
         RETURN_IF_ERROR(channels[i]->open(state));
@@ -322,6 +336,12 @@ Status ExchangeSinkOperatorX::init(const TDataSink& tsink) {
         RETURN_IF_ERROR(vectorized::VExpr::create_expr_trees(*_t_tablet_sink_exprs,
                                                              _tablet_sink_expr_ctxs));
     }
+    // The runtime filters of the sinks of a multi cast sink are applied by
+    // MultiCastDataStreamerSourceOperatorX. The planner has to set stream_sink.runtime_filters
+    // for a plain exchange sink as well, until then the list is empty and nothing is filtered.
+    if (tsink.type == TDataSinkType::DATA_STREAM_SINK) {
+        _runtime_filter_descs = tsink.stream_sink.runtime_filters;
+    }
     return Status::OK();
 }
 
@@ -377,6 +397,10 @@ Status ExchangeSinkOperatorX::sink(RuntimeState* state, vectorized::Block* block
         return Status::EndOfFile("all data stream channels EOF");
     }
 
+    if (local_state._runtime_filter_helper) {
+        RETURN_IF_ERROR(local_state._filter_by_runtime_filters(state, block));
+    }
+
     if (local_state.low_memory_mode()) {
         set_low_memory_mode(state);
     }
@@ -570,9 +594,30 @@ Status ExchangeSinkLocalState::close(RuntimeState* state, Status exec_status) {
         _sink_buffer->update_profile(custom_profile());
         _sink_buffer->close();
     }
+    if (_runtime_filter_helper) {
+        _runtime_filter_helper->collect_realtime_profile(custom_profile());
+    }
     return Base::close(state, exec_status);
 }
 
+Status ExchangeSinkLocalState::_filter_by_runtime_filters(RuntimeState* state,
+                                                          vectorized::Block* block) {
+    auto& p = _parent->cast<ExchangeSinkOperatorX>();
+    int arrived_rf_num = 0;
+    RETURN_IF_ERROR(_runtime_filter_helper->try_append_late_arrival_runtime_filter(
+            state, &arrived_rf_num, _runtime_filter_conjuncts, p._row_desc));
+    if (_runtime_filter_conjuncts.empty() || block->empty()) {
+        return Status::OK();
+    }
+    SCOPED_TIMER(_runtime_filter_timer);
+    size_t rows = block->rows();
+    RETURN_IF_ERROR(vectorized::VExprContext::filter_block(_runtime_filter_conjuncts, block,
+                                                           block->columns()));
+    COUNTER_UPDATE(_rows_filtered_by_runtime_filter,
+                   static_cast<int64_t>(rows - block->rows()));
+    return Status::OK();
+}
+
 std::shared_ptr<ExchangeSinkBuffer> ExchangeSinkOperatorX::_create_buffer(
         RuntimeState* state, const std::vector<InstanceLoId>& sender_ins_ids) {
     PUniqueId id;
@@ -27,6 +27,7 @@
 #include "exchange_sink_buffer.h"
 #include "operator.h"
 #include "pipeline/shuffle/writer.h"
+#include "runtime_filter/runtime_filter_consumer_helper.h"
 #include "vec/sink/scale_writer_partitioning_exchanger.hpp"
 #include "vec/sink/vdata_stream_sender.h"
 
@@ -116,6 +117,8 @@ private:
     friend class vectorized::BlockSerializer;
 
     MOCK_FUNCTION void _create_channels();
+    // Drop the rows of block rejected by the arrived runtime filters.
+    Status _filter_by_runtime_filters(RuntimeState* state, vectorized::Block* block);
 
     std::shared_ptr<ExchangeSinkBuffer> _sink_buffer = nullptr;
     RuntimeProfile::Counter* _serialize_batch_timer = nullptr;
@@ -183,6 +186,14 @@ private:
     std::atomic_int _working_channels_count = 0;
     std::set<InstanceLoId> _finished_channels;
     std::mutex _finished_channels_mutex;
+
+    // The runtime filters targeting the destination exchange node are applied as soon as they
+    // arrive without waiting for them, so that the rejected rows are not serialized and sent.
+    std::unique_ptr<RuntimeFilterConsumerHelper> _runtime_filter_helper;
+    std::vector<std::shared_ptr<Dependency>> _filter_dependencies;
+    vectorized::VExprContextSPtrs _runtime_filter_conjuncts;
+    RuntimeProfile::Counter* _runtime_filter_timer = nullptr;
+    RuntimeProfile::Counter* _rows_filtered_by_runtime_filter = nullptr;
 };
 
 class ExchangeSinkOperatorX MOCK_REMOVE(final) : public DataSinkOperatorX<ExchangeSinkLocalState> {
@@ -283,6 +294,7 @@ private:
     // The receiver will sort the collected data, so the sender must ensure that the data sent is ordered.
     const bool _dest_is_merge;
     const std::vector<TUniqueId>& _fragment_instance_ids;
+    std::vector<TRuntimeFilterDesc> _runtime_filter_descs;
 };
 
 } // namespace pipeline
@@ -234,9 +234,11 @@ struct ProcessHashTableBuild {
         }
 
         hash_table_ctx.hash_table->build(hash_table_ctx.keys, hash_table_ctx.bucket_nums.data(),
-                                         _rows, keep_null_key);
+                                         _rows, keep_null_key, hash_table_ctx.hash_tags.data());
         hash_table_ctx.bucket_nums.resize(_batch_size);
         hash_table_ctx.bucket_nums.shrink_to_fit();
+        hash_table_ctx.hash_tags.clear();
+        hash_table_ctx.hash_tags.shrink_to_fit();
 
         COUNTER_SET(_parent->_hash_table_memory_usage,
                     (int64_t)hash_table_ctx.hash_table->get_byte_size());
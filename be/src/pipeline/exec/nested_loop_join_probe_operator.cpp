@@ -22,6 +22,7 @@
 #include "common/cast_set.h"
 #include "common/exception.h"
 #include "pipeline/exec/operator.h"
+#include "vec/columns/column_const.h"
 #include "vec/columns/column_filter_helper.h"
 #include "vec/core/block.h"
 
@@ -100,11 +101,20 @@ Status NestedLoopJoinProbeLocalState::generate_join_block_data(RuntimeState* sta
     _left_side_process_count = 0;
     DCHECK(!_need_more_input_data || !_matched_rows_done);
 
+    bool filter_before_materialize = false;
+    if constexpr (!set_build_side_flag && !set_probe_side_flag) {
+        filter_before_materialize = _can_filter_before_materialize();
+    }
+    // With filtering before materializing, only matched pairs are added to the join block,
+    // so also bound the number of evaluated pairs to keep the time of one call limited.
+    const size_t max_evaluated_rows = state->batch_size() * 4;
+    size_t evaluated_rows = 0;
+
     if (!_matched_rows_done && !_need_more_input_data) {
         // We should try to join rows if there still are some rows from probe side.
         // _probe_offset_stack and _build_offset_stack use u16 for storage
         // because on the FE side, it is guaranteed that the batch size will not exceed 65535 (the maximum value for u16).s
-        while (_join_block.rows() < state->batch_size()) {
+        while (_join_block.rows() < state->batch_size() && evaluated_rows < max_evaluated_rows) {
             while (_current_build_pos == _shared_state->build_blocks.size() ||
                    _left_block_pos == _child_block->rows()) {
                 // if left block is empty(), do not need disprocess the left block rows
@@ -137,7 +147,13 @@ Status NestedLoopJoinProbeLocalState::generate_join_block_data(RuntimeState* sta
             if constexpr (set_build_side_flag) {
                 _build_offset_stack.push(cast_set<uint16_t, size_t, false>(_join_block.rows()));
             }
-            _process_left_child_block(_join_block, now_process_build_block);
+            if (filter_before_materialize) {
+                RETURN_IF_ERROR(
+                        _process_left_child_block_with_filter(_join_block, now_process_build_block));
+                evaluated_rows += now_process_build_block.rows();
+            } else {
+                _process_left_child_block(_join_block, now_process_build_block);
+            }
         }
 
         {
@@ -164,9 +180,12 @@ Status NestedLoopJoinProbeLocalState::generate_join_block_data(RuntimeState* sta
     }
 
     if constexpr (!set_probe_side_flag) {
-        RETURN_IF_ERROR((_do_filtering_and_update_visited_flags<set_build_side_flag,
-                                                                set_probe_side_flag, ignore_null>(
-                &_join_block, !p._is_right_semi_anti)));
+        if (!filter_before_materialize) {
+            RETURN_IF_ERROR(
+                    (_do_filtering_and_update_visited_flags<set_build_side_flag,
+                                                            set_probe_side_flag, ignore_null>(
+                            &_join_block, !p._is_right_semi_anti)));
+        }
         _update_additional_flags(&_join_block);
     }
 
@@ -383,6 +402,92 @@ void NestedLoopJoinProbeLocalState::_process_left_child_block(
     block.set_columns(std::move(dst_columns));
 }
 
+bool NestedLoopJoinProbeLocalState::_can_filter_before_materialize() const {
+    auto& p = _parent->cast<NestedLoopJoinProbeOperatorX>();
+    if (_join_conjuncts.empty() || p._is_mark_join ||
+        _join_block.columns() != p._num_probe_side_columns + p._num_build_side_columns) {
+        return false;
+    }
+    for (size_t i = 0; i < p._num_probe_side_columns; ++i) {
+        if (_join_block.get_by_position(i).column->is_nullable() !=
+            _child_block->get_by_position(i).column->is_nullable()) {
+            return false;
+        }
+    }
+    if (!_shared_state->build_blocks.empty()) {
+        const auto& build_block = _shared_state->build_blocks[0];
+        for (size_t i = 0; i < p._num_build_side_columns; ++i) {
+            if (_join_block.get_by_position(p._num_probe_side_columns + i).column->is_nullable() !=
+                build_block.get_by_position(i).column->is_nullable()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+Status NestedLoopJoinProbeLocalState::_process_left_child_block_with_filter(
+        vectorized::Block& block, const vectorized::Block& now_process_build_block) {
+    auto& p = _parent->cast<NestedLoopJoinProbeOperatorX>();
+    const size_t build_rows = now_process_build_block.rows();
+    if (build_rows == 0) {
+        return Status::OK();
+    }
+
+    vectorized::Block tmp_block;
+    for (size_t i = 0; i < p._num_probe_side_columns; ++i) {
+        const auto& src_column = _child_block->get_by_position(i).column;
+        const auto& dst_column = block.get_by_position(i);
+        vectorized::ColumnPtr probe_row =
+                is_column_const(*src_column)
+                        ? assert_cast<const vectorized::ColumnConst&>(*src_column)
+                                  .get_data_column_ptr()
+                        : src_column->cut(_left_block_pos, 1);
+        tmp_block.insert({vectorized::ColumnConst::create(probe_row, build_rows), dst_column.type,
+                          dst_column.name});
+    }
+    for (size_t i = 0; i < p._num_build_side_columns; ++i) {
+        const auto& dst_column = block.get_by_position(p._num_probe_side_columns + i);
+        tmp_block.insert({now_process_build_block.get_by_position(i).column, dst_column.type,
+                          dst_column.name});
+    }
+
+    vectorized::IColumn::Filter filter(build_rows, 1);
+    bool can_filter_all = false;
+    {
+        SCOPED_TIMER(_join_conjuncts_evaluation_timer);
+        RETURN_IF_ERROR(vectorized::VExprContext::execute_conjuncts(
+                _join_conjuncts, nullptr, false, &tmp_block, &filter, &can_filter_all));
+    }
+    if (can_filter_all) {
+        return Status::OK();
+    }
+
+    SCOPED_TIMER(_filtered_by_join_conjuncts_timer);
+    std::vector<uint32_t> selector;
+    selector.reserve(build_rows);
+    for (uint32_t j = 0; j < build_rows; ++j) {
+        if (filter[j]) {
+            selector.push_back(j);
+        }
+    }
+    if (selector.empty()) {
+        return Status::OK();
+    }
+    auto dst_columns = block.mutate_columns();
+    for (size_t i = 0; i < p._num_probe_side_columns; ++i) {
+        dst_columns[i]->insert_many_from(*_child_block->get_by_position(i).column, _left_block_pos,
+                                         selector.size());
+    }
+    for (size_t i = 0; i < p._num_build_side_columns; ++i) {
+        dst_columns[p._num_probe_side_columns + i]->insert_indices_from(
+                *now_process_build_block.get_by_position(i).column, selector.data(),
+                selector.data() + selector.size());
+    }
+    block.set_columns(std::move(dst_columns));
+    return Status::OK();
+}
+
 NestedLoopJoinProbeOperatorX::NestedLoopJoinProbeOperatorX(ObjectPool* pool, const TPlanNode& tnode,
                                                            int operator_id,
                                                            const DescriptorTbl& descs)
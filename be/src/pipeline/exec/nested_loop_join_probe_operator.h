@@ -60,6 +60,13 @@ private:
     void _append_left_data_with_null(vectorized::Block& block) const;
     void _process_left_child_block(vectorized::Block& block,
                                    const vectorized::Block& now_process_build_block) const;
+    // Join conjuncts can be evaluated before materializing the cross product if the visited
+    // flags are not needed and the columns of the join block need no nullable conversion.
+    bool _can_filter_before_materialize() const;
+    // Evaluates the join conjuncts with the current probe row as constant columns against
+    // the build block, and only materializes the matched pairs into the join block.
+    Status _process_left_child_block_with_filter(vectorized::Block& block,
+                                                 const vectorized::Block& now_process_build_block);
     template <typename Filter, bool SetBuildSideFlag, bool SetProbeSideFlag>
     void _do_filtering_and_update_visited_flags_impl(vectorized::Block* block,
                                                      uint32_t column_to_keep,
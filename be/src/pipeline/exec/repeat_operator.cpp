@@ -114,6 +114,24 @@ Status RepeatLocalState::get_repeated_block(vectorized::Block* input_block, int
     size_t input_column_size = input_block->columns();
     size_t output_column_size = p._output_slots.size();
     DCHECK_LT(input_column_size, output_column_size);
+    if (!output_block->mem_reuse()) {
+        // Columns that are not repeated pass through in the type of the child column rather
+        // than the slot type. Below a rollup shape Agg(serialize) -> Repeat -> Agg(merge) they
+        // hold serialized aggregate states (e.g. ColumnFixedLengthObject with its item size),
+        // which the slot type of the intermediate tuple cannot describe.
+        for (size_t i = 0; i < output_column_size; i++) {
+            const auto* slot = p._output_slots[i];
+            if (i < input_column_size && !p._all_slot_ids.contains(slot->id())) {
+                const auto& src_column = input_block->get_by_position(i);
+                output_block->insert(vectorized::ColumnWithTypeAndName(
+                        src_column.column->clone_empty(), src_column.type, slot->col_name()));
+            } else {
+                output_block->insert(vectorized::ColumnWithTypeAndName(
+                        slot->get_empty_mutable_column(), slot->get_data_type_ptr(),
+                        slot->col_name()));
+            }
+        }
+    }
     auto m_block = vectorized::VectorizedUtils::build_mutable_mem_reuse_block(output_block,
                                                                               p._output_slots);
     auto& output_columns = m_block.mutable_columns();
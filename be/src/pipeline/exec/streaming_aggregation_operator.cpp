@@ -19,12 +19,15 @@
 
 #include <gen_cpp/Metrics_types.h>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
 #include "common/cast_set.h"
 #include "common/compiler_util.h" // IWYU pragma: keep
+#include "common/config.h"
 #include "pipeline/exec/operator.h"
+#include "util/defer_op.h"
 #include "vec/exprs/vectorized_agg_fn.h"
 #include "vec/exprs/vslot_ref.h"
 
@@ -109,6 +112,7 @@ Status StreamingAggLocalState::init(RuntimeState* state, LocalStateInfo& info) {
     _get_results_timer = ADD_TIMER(custom_profile(), "GetResultsTime");
     _hash_table_iterate_timer = ADD_TIMER(custom_profile(), "HashTableIterateTime");
     _insert_keys_to_column_timer = ADD_TIMER(custom_profile(), "InsertKeysToColumnTime");
+    _sorted_agg_timer = ADD_TIMER(custom_profile(), "SortedAggTime");
 
     return Status::OK();
 }
@@ -159,6 +163,7 @@ Status StreamingAggLocalState::open(RuntimeState* state) {
                 p._is_merge, p._needs_finalize);
     }
 
+    _sorted_input = config::enable_streaming_agg_sorted_input;
     _should_limit_output = p._limit != -1 &&       // has limit
                            (!p._have_conjuncts) && // no having conjunct
                            p._needs_finalize;      // agg's finalize step
@@ -189,7 +194,8 @@ void StreamingAggLocalState::_update_memusage_with_serialized_key() {
                            int64_t hash_table_memory_usage = data.get_buffer_size_in_bytes();
 
                            COUNTER_SET(_memory_used_counter,
-                                       arena_memory_usage + hash_table_memory_usage);
+                                       arena_memory_usage + hash_table_memory_usage +
+                                               int64_t(_sorted_agg_memory_usage()));
 
                            COUNTER_SET(_serialize_key_arena_memory_usage, arena_memory_usage);
                            COUNTER_SET(_hash_table_memory_usage, hash_table_memory_usage);
@@ -301,6 +307,18 @@ size_t StreamingAggLocalState::_memory_usage() const {
                                      }},
                _agg_data->method_variant);
 
+    usage += _sorted_agg_memory_usage();
+    return usage;
+}
+
+size_t StreamingAggLocalState::_sorted_agg_memory_usage() const {
+    size_t usage = _sorted_agg_arena_memory_usage;
+    usage += _run_starts.capacity() * sizeof(uint32_t);
+    usage += _run_values.capacity() * sizeof(vectorized::AggregateDataPtr);
+    usage += _key_cmp.capacity() * sizeof(int8_t);
+    for (const auto& column : _last_sorted_keys) {
+        usage += column->allocated_bytes();
+    }
     return usage;
 }
 
@@ -361,6 +379,18 @@ Status StreamingAggLocalState::_pre_agg_with_serialized_key(doris::vectorized::B
     size_t rows = in_block->rows();
     _places.resize(rows);
 
+    // The rows of a pre-aggregation may be emitted at any time, since the merge phase
+    // combines the rows of the same keys. So while the input is ordered by the keys, each
+    // run of equal keys is aggregated into one row without the hash table, and the rows
+    // are emitted with the block.
+    if (_sorted_input) {
+        if (_find_key_runs(key_columns, rows)) {
+            return _pre_agg_with_sorted_key(in_block, key_columns, out_block);
+        }
+        _sorted_input = false;
+        _last_sorted_keys.clear();
+    }
+
     if (_should_not_do_pre_agg(rows)) {
         bool mem_reuse = p._make_nullable_keys.empty() && out_block->mem_reuse();
 
@@ -415,6 +445,112 @@ Status StreamingAggLocalState::_pre_agg_with_serialized_key(doris::vectorized::B
     return Status::OK();
 }
 
+bool StreamingAggLocalState::_find_key_runs(const vectorized::ColumnRawPtrs& key_columns,
+                                            size_t rows) {
+    SCOPED_TIMER(_sorted_agg_timer);
+    // _key_cmp[i] is the sign of comparing the keys of row i with the keys of row i - 1,
+    // the keys of row 0 are compared with the last keys of the previous block.
+    // The columns are compared one by one, only on the rows whose previous keys are equal.
+    _key_cmp.assign(rows, 0);
+    if (_last_sorted_keys.empty()) {
+        _key_cmp[0] = 1;
+    }
+    auto sign = [](int res) { return static_cast<int8_t>((res > 0) - (res < 0)); };
+    for (size_t k = 0; k < key_columns.size(); ++k) {
+        const auto& column = *key_columns[k];
+        if (_key_cmp[0] == 0) {
+            _key_cmp[0] = sign(column.compare_at(0, 0, *_last_sorted_keys[k], -1));
+        }
+        for (size_t i = 1; i < rows; ++i) {
+            if (_key_cmp[i] == 0) {
+                _key_cmp[i] = sign(column.compare_at(i, i - 1, column, -1));
+            }
+        }
+    }
+
+    // every block starts a new run, as the runs of a block are all emitted with the block
+    _run_starts.clear();
+    _run_starts.push_back(0);
+    if (_key_cmp[0] < 0) {
+        return false;
+    }
+    for (size_t i = 1; i < rows; ++i) {
+        if (_key_cmp[i] < 0) {
+            return false;
+        }
+        if (_key_cmp[i] > 0) {
+            _run_starts.push_back(cast_set<uint32_t>(i));
+        }
+    }
+
+    _last_sorted_keys.resize(key_columns.size());
+    for (size_t k = 0; k < key_columns.size(); ++k) {
+        _last_sorted_keys[k] = key_columns[k]->clone_empty();
+        _last_sorted_keys[k]->insert_from(*key_columns[k], rows - 1);
+    }
+    return true;
+}
+
+Status StreamingAggLocalState::_pre_agg_with_sorted_key(
+        vectorized::Block* in_block, const vectorized::ColumnRawPtrs& key_columns,
+        vectorized::Block* out_block) {
+    SCOPED_TIMER(_sorted_agg_timer);
+    auto& p = Base::_parent->template cast<StreamingAggOperatorX>();
+    const size_t rows = in_block->rows();
+    const size_t num_runs = _run_starts.size();
+
+    // the aggregate states of the runs only live until the block is emitted
+    _run_values.resize(num_runs);
+    size_t num_created = 0;
+    Defer destroy_agg_status {[&]() {
+        for (size_t i = 0; i < num_created; ++i) {
+            _destroy_agg_status(_run_values[i]);
+        }
+        _sorted_agg_arena_memory_usage = _sorted_agg_arena.size();
+        _sorted_agg_arena.clear();
+    }};
+    for (; num_created < num_runs; ++num_created) {
+        auto* place = _sorted_agg_arena.aligned_alloc(p._total_size_of_aggregate_states,
+                                                      p._align_aggregate_states);
+        RETURN_IF_ERROR(_create_agg_status(place));
+        _run_values[num_created] = place;
+    }
+    for (size_t run = 0; run < num_runs; ++run) {
+        const size_t end = run + 1 < num_runs ? _run_starts[run + 1] : rows;
+        std::fill(_places.data() + _run_starts[run], _places.data() + end, _run_values[run]);
+    }
+    for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+        RETURN_IF_ERROR(_aggregate_evaluators[i]->execute_batch_add(
+                in_block, p._offsets_of_aggregate_states[i], _places.data(), _sorted_agg_arena));
+    }
+
+    vectorized::ColumnsWithTypeAndName columns_with_schema;
+    {
+        SCOPED_TIMER(_insert_keys_to_column_timer);
+        for (size_t i = 0; i < key_columns.size(); ++i) {
+            auto column = key_columns[i]->clone_empty();
+            column->insert_indices_from(*key_columns[i], _run_starts.data(),
+                                        _run_starts.data() + num_runs);
+            columns_with_schema.emplace_back(std::move(column),
+                                             _probe_expr_ctxs[i]->root()->data_type(),
+                                             _probe_expr_ctxs[i]->root()->expr_name());
+        }
+    }
+    {
+        SCOPED_TIMER(_insert_values_to_column_timer);
+        for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+            const auto& function = _aggregate_evaluators[i]->function();
+            auto column = function->create_serialize_column();
+            function->serialize_to_column(_run_values, p._offsets_of_aggregate_states[i], column,
+                                          num_runs);
+            columns_with_schema.emplace_back(std::move(column), function->get_serialized_type(),
+                                             "");
+        }
+    }
+    out_block->swap(vectorized::Block(columns_with_schema));
+    return Status::OK();
+}
+
 Status StreamingAggLocalState::_create_agg_status(vectorized::AggregateDataPtr data) {
     auto& p = Base::_parent->template cast<StreamingAggOperatorX>();
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
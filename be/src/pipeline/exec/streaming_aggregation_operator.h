@@ -57,6 +57,15 @@ private:
     size_t _memory_usage() const;
     Status _pre_agg_with_serialized_key(doris::vectorized::Block* in_block,
                                         doris::vectorized::Block* out_block);
+    // Find the first rows of the runs of equal keys into _run_starts. Return false if the
+    // rows are not ordered by the keys, including across the previous block.
+    bool _find_key_runs(const vectorized::ColumnRawPtrs& key_columns, size_t rows);
+    // Aggregate each run of _run_starts into one row of out_block, without the hash table.
+    Status _pre_agg_with_sorted_key(vectorized::Block* in_block,
+                                    const vectorized::ColumnRawPtrs& key_columns,
+                                    vectorized::Block* out_block);
+    // The memory of the run states of the last block and of the keys kept across blocks.
+    size_t _sorted_agg_memory_usage() const;
     bool _should_expand_preagg_hash_tables();
 
     MOCK_FUNCTION bool _should_not_do_pre_agg(size_t rows);
@@ -86,6 +95,7 @@ private:
     RuntimeProfile::Counter* _get_results_timer = nullptr;
     RuntimeProfile::Counter* _hash_table_iterate_timer = nullptr;
     RuntimeProfile::Counter* _insert_keys_to_column_timer = nullptr;
+    RuntimeProfile::Counter* _sorted_agg_timer = nullptr;
 
     bool _should_expand_hash_table = true;
     int64_t _cur_num_rows_returned = 0;
@@ -109,6 +119,17 @@ private:
     std::vector<vectorized::AggregateDataPtr> _values;
     bool _opened = false;
 
+    // Whether the input is ordered by the keys so far. The last key of the previous block
+    // is kept to check the order across blocks.
+    bool _sorted_input = false;
+    vectorized::MutableColumns _last_sorted_keys;
+    std::vector<int8_t> _key_cmp;
+    std::vector<uint32_t> _run_starts;
+    std::vector<vectorized::AggregateDataPtr> _run_values;
+    vectorized::Arena _sorted_agg_arena;
+    // the size of _sorted_agg_arena before it is cleared at the end of a block
+    size_t _sorted_agg_arena_memory_usage = 0;
+
     void _destroy_agg_status(vectorized::AggregateDataPtr data);
 
     void _close_with_serialized_key() {
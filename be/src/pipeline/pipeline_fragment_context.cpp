@@ -1154,6 +1154,7 @@ Status PipelineFragmentContext::_create_data_sink(ObjectPool* pool, const TDataS
             RETURN_IF_ERROR(new_pipeline->set_sink(sink_op));
             {
                 TDataSink* t = pool->add(new TDataSink());
+                t->type = TDataSinkType::MULTI_CAST_DATA_STREAM_SINK;
                 t->stream_sink = thrift_sink.multi_cast_stream_sink.sinks[i];
                 RETURN_IF_ERROR(sink_op->init(*t));
             }
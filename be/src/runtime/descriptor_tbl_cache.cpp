@@ -0,0 +1,74 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "runtime/descriptor_tbl_cache.h"
+
+#include "bvar/bvar.h"
+#include "runtime/descriptors.h"
+#include "runtime/memory/mem_tracker_limiter.h"
+#include "runtime/thread_context.h"
+#include "util/defer_op.h"
+#include "util/sha.h"
+#include "util/thrift_util.h"
+
+bvar::Adder<int64_t> g_descriptor_tbl_cache_hit_count("descriptor_tbl_cache_hit_count");
+bvar::Adder<int64_t> g_descriptor_tbl_cache_miss_count("descriptor_tbl_cache_miss_count");
+
+namespace doris {
+
+CachedDescriptorTbl::~CachedDescriptorTbl() {
+    if (mem_tracker != nullptr) {
+        SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(mem_tracker);
+        obj_pool.clear();
+    }
+}
+
+Status DescriptorTblCache::get_or_create(const TDescriptorTable& thrift_tbl,
+                                         std::shared_ptr<CachedDescriptorTbl>* desc_tbl) {
+    std::string serialized;
+    ThriftSerializer ser(false, 4096);
+    RETURN_IF_ERROR(ser.serialize(const_cast<TDescriptorTable*>(&thrift_tbl), &serialized));
+    // use sha256 to prevent from hash collision
+    SHA256Digest digest;
+    digest.reset(serialized.data(), serialized.length());
+    std::string key {digest.digest()};
+
+    auto* lru_handle = lookup(key);
+    if (lru_handle) {
+        Defer release([cache = this, lru_handle] { cache->release(lru_handle); });
+        *desc_tbl = ((CacheValue*)LRUCachePolicy::value(lru_handle))->desc_tbl;
+        g_descriptor_tbl_cache_hit_count << 1;
+        return Status::OK();
+    }
+
+    std::shared_ptr<CachedDescriptorTbl> cached;
+    {
+        SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(mem_tracker());
+        cached = std::make_shared<CachedDescriptorTbl>();
+        cached->mem_tracker = mem_tracker();
+        RETURN_IF_ERROR(DescriptorTbl::create(&cached->obj_pool, thrift_tbl, &cached->desc_tbl));
+    }
+    auto* value = new CacheValue;
+    value->desc_tbl = cached;
+    // the descriptors are already consumed by the tracker of the cache when they are built
+    lru_handle = insert(key, value, 1, 0, CachePriority::NORMAL);
+    release(lru_handle);
+    g_descriptor_tbl_cache_miss_count << 1;
+    *desc_tbl = std::move(cached);
+    return Status::OK();
+}
+
+} // namespace doris
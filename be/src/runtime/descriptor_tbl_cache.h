@@ -0,0 +1,75 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#pragma once
+
+#include <gen_cpp/Descriptors_types.h>
+
+#include <memory>
+
+#include "common/object_pool.h"
+#include "common/status.h"
+#include "runtime/exec_env.h"
+#include "runtime/memory/lru_cache_policy.h"
+
+namespace doris {
+
+class DescriptorTbl;
+class MemTrackerLimiter;
+
+// Descriptors built from one TDescriptorTable, shared by the queries that send the same one.
+// They are read only once built.
+// They are allocated and freed under the tracker of the cache, whichever query built them or
+// released them last.
+struct CachedDescriptorTbl {
+    ~CachedDescriptorTbl();
+
+    std::shared_ptr<MemTrackerLimiter> mem_tracker;
+    ObjectPool obj_pool;
+    DescriptorTbl* desc_tbl = nullptr;
+};
+
+// Cache of the descriptor tables of the queries, so that repeated short queries with the same
+// plan skip building their slot, tuple and table descriptors again.
+// The key is the signature of the serialized TDescriptorTable. A schema change, or any other
+// change of the plan, changes the thrift descriptors and yields another key, the stale entries
+// are evicted by the LRU policy.
+class DescriptorTblCache : public LRUCachePolicy {
+public:
+    DescriptorTblCache(size_t capacity)
+            : LRUCachePolicy(CachePolicy::CacheType::DESCRIPTOR_TBL_CACHE, capacity,
+                             LRUCacheType::NUMBER, config::descriptor_tbl_cache_recycle_interval) {}
+
+    static DescriptorTblCache* create_global_instance(size_t capacity) {
+        return new DescriptorTblCache(capacity);
+    }
+
+    static DescriptorTblCache* instance() {
+        return ExecEnv::GetInstance()->get_descriptor_tbl_cache();
+    }
+
+    // Get the descriptors of `thrift_tbl`, they are built and cached if they are not cached yet.
+    Status get_or_create(const TDescriptorTable& thrift_tbl,
+                         std::shared_ptr<CachedDescriptorTbl>* desc_tbl);
+
+private:
+    class CacheValue : public LRUCacheValueBase {
+    public:
+        std::shared_ptr<CachedDescriptorTbl> desc_tbl;
+    };
+};
+
+} // namespace doris
@@ -118,6 +118,7 @@ class SchemaCache;
 class StoragePageCache;
 class SegmentLoader;
 class LookupConnectionCache;
+class DescriptorTblCache;
 class RowCache;
 class DummyLRUCache;
 class CacheManager;
@@ -238,6 +239,8 @@ public:
     }
     ThreadPool* send_table_stats_thread_pool() { return _send_table_stats_thread_pool.get(); }
     ThreadPool* s3_file_upload_thread_pool() { return _s3_file_upload_thread_pool.get(); }
+    // built on first use
+    ThreadPool* decompression_thread_pool();
     ThreadPool* lazy_release_obj_pool() { return _lazy_release_obj_pool.get(); }
     ThreadPool* non_block_close_thread_pool();
     ThreadPool* s3_file_system_thread_pool() { return _s3_file_system_thread_pool.get(); }
@@ -343,6 +346,7 @@ public:
     StoragePageCache* get_storage_page_cache() { return _storage_page_cache; }
     SegmentLoader* segment_loader() { return _segment_loader; }
     LookupConnectionCache* get_lookup_connection_cache() { return _lookup_connection_cache; }
+    DescriptorTblCache* get_descriptor_tbl_cache() { return _descriptor_tbl_cache; }
     RowCache* get_row_cache() { return _row_cache; }
     CacheManager* get_cache_manager() { return _cache_manager; }
     IdManager* get_id_manager() { return _id_manager; }
@@ -444,6 +448,9 @@ private:
     std::unique_ptr<ThreadPool> _send_table_stats_thread_pool;
     // Threadpool used to upload local file to s3
     std::unique_ptr<ThreadPool> _s3_file_upload_thread_pool;
+    // Threadpool used to decompress the frames of compressed load files
+    std::unique_ptr<ThreadPool> _decompression_thread_pool;
+    std::once_flag _decompression_thread_pool_once;
     // Pool used by join node to build hash table
     // Pool to use a new thread to release object
     std::unique_ptr<ThreadPool> _lazy_release_obj_pool;
@@ -497,6 +504,7 @@ private:
     StoragePageCache* _storage_page_cache = nullptr;
     SegmentLoader* _segment_loader = nullptr;
     LookupConnectionCache* _lookup_connection_cache = nullptr;
+    DescriptorTblCache* _descriptor_tbl_cache = nullptr;
     RowCache* _row_cache = nullptr;
     CacheManager* _cache_manager = nullptr;
     IdManager* _id_manager = nullptr;
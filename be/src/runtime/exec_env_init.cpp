@@ -68,6 +68,7 @@
 #include "runtime/broker_mgr.h"
 #include "runtime/cache/result_cache.h"
 #include "runtime/client_cache.h"
+#include "runtime/descriptor_tbl_cache.h"
 #include "runtime/exec_env.h"
 #include "runtime/external_scan_context_mgr.h"
 #include "runtime/fragment_mgr.h"
@@ -175,6 +176,20 @@ ThreadPool* ExecEnv::non_block_close_thread_pool() {
     return _non_block_close_thread_pool.get();
 }
 
+ThreadPool* ExecEnv::decompression_thread_pool() {
+    // only built once a load file is decompressed in parallel, which is off by default
+    std::call_once(_decompression_thread_pool_once, [this]() {
+        auto [min_threads, max_threads] =
+                get_num_threads(config::num_decompression_thread_pool_min_thread,
+                                config::num_decompression_thread_pool_max_thread);
+        static_cast<void>(ThreadPoolBuilder("DecompressionThreadPool")
+                                  .set_min_threads(cast_set<int>(min_threads))
+                                  .set_max_threads(cast_set<int>(max_threads))
+                                  .build(&_decompression_thread_pool));
+    });
+    return _decompression_thread_pool.get();
+}
+
 ExecEnv::ExecEnv() = default;
 
 ExecEnv::~ExecEnv() {
@@ -574,6 +589,9 @@ Status ExecEnv::_init_mem_env() {
     _lookup_connection_cache =
             LookupConnectionCache::create_global_instance(config::lookup_connection_cache_capacity);
 
+    _descriptor_tbl_cache =
+            DescriptorTblCache::create_global_instance(config::descriptor_tbl_cache_capacity);
+
     // use memory limit
     int64_t inverted_index_cache_limit =
             ParseUtil::parse_mem_spec(config::inverted_index_searcher_cache_limit,
@@ -773,6 +791,7 @@ void ExecEnv::destroy() {
     }
     SAFE_SHUTDOWN(_buffered_reader_prefetch_thread_pool);
     SAFE_SHUTDOWN(_s3_file_upload_thread_pool);
+    SAFE_SHUTDOWN(_decompression_thread_pool);
     SAFE_SHUTDOWN(_lazy_release_obj_pool);
     SAFE_SHUTDOWN(_non_block_close_thread_pool);
     SAFE_SHUTDOWN(_s3_file_system_thread_pool);
@@ -784,6 +803,7 @@ void ExecEnv::destroy() {
     SAFE_DELETE(_inverted_index_query_cache);
     SAFE_DELETE(_inverted_index_searcher_cache);
     SAFE_DELETE(_lookup_connection_cache);
+    SAFE_DELETE(_descriptor_tbl_cache);
     SAFE_DELETE(_schema_cache);
     SAFE_DELETE(_segment_loader);
     SAFE_DELETE(_row_cache);
@@ -831,6 +851,7 @@ void ExecEnv::destroy() {
     _send_table_stats_thread_pool.reset(nullptr);
     _buffered_reader_prefetch_thread_pool.reset(nullptr);
     _s3_file_upload_thread_pool.reset(nullptr);
+    _decompression_thread_pool.reset(nullptr);
     _send_batch_thread_pool.reset(nullptr);
     _write_cooldown_meta_executors.reset(nullptr);
 
@@ -64,6 +64,7 @@
 #include "io/fs/stream_load_pipe.h"
 #include "pipeline/pipeline_fragment_context.h"
 #include "runtime/client_cache.h"
+#include "runtime/descriptor_tbl_cache.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "runtime/frontend_info.h"
@@ -724,8 +725,16 @@ Status FragmentMgr::_get_or_create_query_ctx(const TPipelineFragmentParams& para
                                                          params.coord, params.is_nereids,
                                                          params.current_connect_fe, query_source);
                         SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(query_ctx->query_mem_tracker());
-                        RETURN_IF_ERROR(DescriptorTbl::create(
-                                &(query_ctx->obj_pool), params.desc_tbl, &(query_ctx->desc_tbl)));
+                        if (config::enable_descriptor_tbl_cache &&
+                            DescriptorTblCache::instance() != nullptr) {
+                            RETURN_IF_ERROR(DescriptorTblCache::instance()->get_or_create(
+                                    params.desc_tbl, &query_ctx->cached_desc_tbl));
+                            query_ctx->desc_tbl = query_ctx->cached_desc_tbl->desc_tbl;
+                        } else {
+                            RETURN_IF_ERROR(DescriptorTbl::create(&(query_ctx->obj_pool),
+                                                                  params.desc_tbl,
+                                                                  &(query_ctx->desc_tbl)));
+                        }
                         // set file scan range params
                         if (params.__isset.file_scan_params) {
                             query_ctx->file_scan_range_params_map = params.file_scan_params;
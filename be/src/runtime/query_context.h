@@ -78,6 +78,7 @@ const std::string toString(QuerySource query_source);
 // Some components like DescriptorTbl may be very large
 // that will slow down each execution of fragments when DeSer them every time.
 class DescriptorTbl;
+struct CachedDescriptorTbl;
 class QueryContext : public std::enable_shared_from_this<QueryContext> {
     ENABLE_FACTORY_CREATOR(QueryContext);
 
@@ -218,6 +219,8 @@ public:
     }
 
     DescriptorTbl* desc_tbl = nullptr;
+    // holds desc_tbl when it is shared with other queries by the DescriptorTblCache
+    std::shared_ptr<CachedDescriptorTbl> cached_desc_tbl;
     bool set_rsc_info = false;
     std::string user;
     std::string group;
@@ -37,6 +37,7 @@
 #include <snappy/snappy-sinksource.h>
 #include <snappy/snappy.h>
 #include <zconf.h>
+#include <zdict.h>
 #include <zlib.h>
 #include <zstd.h>
 #include <zstd_errors.h>
@@ -1050,6 +1051,8 @@ private:
         DContext() : ctx(nullptr) {}
         ZSTD_DCtx* ctx;
         ~DContext() {
+            SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(
+                    ExecEnv::GetInstance()->block_compression_mem_tracker());
             if (ctx) {
                 ZSTD_freeDCtx(ctx);
             }
@@ -1061,11 +1064,38 @@ public:
         static ZstdBlockCompression s_instance;
         return &s_instance;
     }
+    ZstdBlockCompression() = default;
     ~ZstdBlockCompression() {
         SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(
                 ExecEnv::GetInstance()->block_compression_mem_tracker());
         _ctx_c_pool.clear();
         _ctx_d_pool.clear();
+        if (_cdict) {
+            ZSTD_freeCDict(_cdict);
+        }
+        if (_ddict) {
+            ZSTD_freeDDict(_ddict);
+        }
+    }
+
+    // Compress and decompress with a dictionary, the contexts of the pools are bound to it.
+    // A codec that only decompresses skips the compression dictionary, which is several times
+    // larger than the decompression one.
+    Status init_dict(const Slice& dict, bool decompress_only) {
+        // freed by the destructor under the same tracker
+        SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(
+                ExecEnv::GetInstance()->block_compression_mem_tracker());
+        if (!decompress_only) {
+            _cdict = ZSTD_createCDict(dict.data, dict.size, ZSTD_CLEVEL_DEFAULT);
+            if (_cdict == nullptr) {
+                return Status::InvalidArgument("Failed to create ZSTD compression dictionary");
+            }
+        }
+        _ddict = ZSTD_createDDict(dict.data, dict.size);
+        if (_ddict == nullptr) {
+            return Status::InvalidArgument("Failed to create ZSTD decompression dictionary");
+        }
+        return Status::OK();
     }
 
     size_t max_compressed_len(size_t len) override { return ZSTD_compressBound(len); }
@@ -1079,6 +1109,9 @@ public:
     //  https://github.com/facebook/zstd/blob/dev/examples/streaming_compression.c
     Status compress(const std::vector<Slice>& inputs, size_t uncompressed_size,
                     faststring* output) override {
+        if (_ddict != nullptr && _cdict == nullptr) {
+            return Status::InternalError("ZSTD dictionary codec can only decompress");
+        }
         std::unique_ptr<CContext> context;
         RETURN_IF_ERROR(_acquire_compression_ctx(context));
         bool compress_failed = false;
@@ -1120,6 +1153,13 @@ public:
                 return Status::InvalidArgument("ZSTD_CCtx_setParameter checksumFlag error: {}",
                                                ZSTD_getErrorString(ZSTD_getErrorCode(ret)));
             }
+            if (_cdict) {
+                ret = ZSTD_CCtx_refCDict(context->ctx, _cdict);
+                if (ZSTD_isError(ret)) {
+                    return Status::InvalidArgument("ZSTD_CCtx_refCDict error: {}",
+                                                   ZSTD_getErrorString(ZSTD_getErrorCode(ret)));
+                }
+            }
 
             ZSTD_outBuffer out_buf = {compressed_buf.data, compressed_buf.size, 0};
 
@@ -1176,8 +1216,10 @@ public:
             }
         }};
 
-        size_t ret = ZSTD_decompressDCtx(context->ctx, output->data, output->size, input.data,
-                                         input.size);
+        size_t ret = _ddict ? ZSTD_decompress_usingDDict(context->ctx, output->data, output->size,
+                                                         input.data, input.size, _ddict)
+                            : ZSTD_decompressDCtx(context->ctx, output->data, output->size,
+                                                  input.data, input.size);
         if (ZSTD_isError(ret)) {
             decompress_failed = true;
             return Status::InternalError("ZSTD_decompressDCtx error: {}",
@@ -1199,7 +1241,12 @@ private:
                 return Status::InvalidArgument("failed to new ZSTD CContext");
             }
             //typedef LZ4F_cctx* LZ4F_compressionContext_t;
-            localCtx->ctx = ZSTD_createCCtx();
+            {
+                // freed by ~CContext under the same tracker
+                SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(
+                        ExecEnv::GetInstance()->block_compression_mem_tracker());
+                localCtx->ctx = ZSTD_createCCtx();
+            }
             if (localCtx->ctx == nullptr) {
                 return Status::InvalidArgument("Failed to create ZSTD compress ctx");
             }
@@ -1225,7 +1272,12 @@ private:
             if (localCtx.get() == nullptr) {
                 return Status::InvalidArgument("failed to new ZSTD DContext");
             }
-            localCtx->ctx = ZSTD_createDCtx();
+            {
+                // freed by ~DContext under the same tracker
+                SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(
+                        ExecEnv::GetInstance()->block_compression_mem_tracker());
+                localCtx->ctx = ZSTD_createDCtx();
+            }
             if (localCtx->ctx == nullptr) {
                 return Status::InvalidArgument("Fail to init ZSTD decompress context");
             }
@@ -1251,6 +1303,9 @@ private:
 
     mutable std::mutex _ctx_d_mutex;
     mutable std::vector<std::unique_ptr<DContext>> _ctx_d_pool;
+
+    ZSTD_CDict* _cdict = nullptr;
+    ZSTD_DDict* _ddict = nullptr;
 };
 
 class GzipBlockCompression : public ZlibBlockCompression {
@@ -1630,6 +1685,43 @@ Status get_block_compression_codec(TFileCompressType::type type, BlockCompressio
     return Status::OK();
 }
 
+Status train_zstd_dictionary(const std::vector<Slice>& samples, size_t dict_capacity,
+                             std::string* dict) {
+    std::string samples_buffer;
+    std::vector<size_t> sample_sizes;
+    sample_sizes.reserve(samples.size());
+    for (const auto& sample : samples) {
+        samples_buffer.append(sample.data, sample.size);
+        sample_sizes.push_back(sample.size);
+    }
+    dict->resize(dict_capacity);
+    size_t ret = ZDICT_trainFromBuffer(dict->data(), dict_capacity, samples_buffer.data(),
+                                       sample_sizes.data(),
+                                       static_cast<unsigned>(sample_sizes.size()));
+    if (ZDICT_isError(ret)) {
+        dict->clear();
+        return Status::InvalidArgument("ZDICT_trainFromBuffer error: {}",
+                                       ZDICT_getErrorName(ret));
+    }
+    dict->resize(ret);
+    return Status::OK();
+}
+
+Status create_zstd_dict_codec(const Slice& dict, std::unique_ptr<BlockCompressionCodec>* codec) {
+    auto zstd_codec = std::make_unique<ZstdBlockCompression>();
+    RETURN_IF_ERROR(zstd_codec->init_dict(dict, false));
+    *codec = std::move(zstd_codec);
+    return Status::OK();
+}
+
+Status create_zstd_dict_decompression_codec(const Slice& dict,
+                                            std::unique_ptr<BlockCompressionCodec>* codec) {
+    auto zstd_codec = std::make_unique<ZstdBlockCompression>();
+    RETURN_IF_ERROR(zstd_codec->init_dict(dict, true));
+    *codec = std::move(zstd_codec);
+    return Status::OK();
+}
+
 Status get_block_compression_codec(tparquet::CompressionCodec::type parquet_codec,
                                    BlockCompressionCodec** codec) {
     switch (parquet_codec) {
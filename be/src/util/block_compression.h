@@ -21,6 +21,8 @@
 #include <gen_cpp/parquet_types.h>
 
 #include <cstddef>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "common/status.h"
@@ -90,4 +92,20 @@ Status get_block_compression_codec(tparquet::CompressionCodec::type parquet_code
 // TODO: refactor code as CompressionOutputStream and CompressionInputStream
 Status get_block_compression_codec(TFileCompressType::type type, BlockCompressionCodec** codec);
 
+// Train a ZSTD dictionary of at most dict_capacity bytes from samples, which should
+// look like the blocks that are going to be compressed with it.
+// Return not OK if the samples are too few or too small to train a dictionary.
+Status train_zstd_dictionary(const std::vector<Slice>& samples, size_t dict_capacity,
+                             std::string* dict);
+
+// Create a ZSTD codec that compresses and decompresses with dict. Unlike the codecs
+// got from get_block_compression_codec, it is owned by the caller. Blocks compressed
+// by it can only be decompressed with the same dictionary.
+Status create_zstd_dict_codec(const Slice& dict, std::unique_ptr<BlockCompressionCodec>* codec);
+
+// Same as create_zstd_dict_codec, but the codec can only decompress, for the readers of the
+// blocks compressed with dict.
+Status create_zstd_dict_decompression_codec(const Slice& dict,
+                                            std::unique_ptr<BlockCompressionCodec>* codec);
+
 } // namespace doris
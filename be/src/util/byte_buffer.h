@@ -39,8 +39,21 @@ struct ByteBuffer : private Allocator<false> {
         return Status::OK();
     }
 
+    // Wrap size bytes at data to be read without copying them. The bytes are owned by
+    // owner, which is kept alive as long as the buffer and released under the mem tracker
+    // of the thread that wrapped them, as the allocated buffers are freed.
+    static Status wrap(char* data, size_t size, std::shared_ptr<void> owner, ByteBufferPtr* ptr) {
+        RETURN_IF_CATCH_EXCEPTION(
+                { *ptr = ByteBufferPtr(new ByteBuffer(data, size, std::move(owner))); });
+        return Status::OK();
+    }
+
     ~ByteBuffer() {
         SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(mem_tracker_);
+        if (owner_ != nullptr) {
+            owner_.reset();
+            return;
+        }
         Allocator<false>::free(ptr, capacity);
     }
 
@@ -78,7 +91,17 @@ private:
         ptr = reinterpret_cast<char*>(Allocator<false>::alloc(capacity_));
     }
 
+    ByteBuffer(char* data, size_t size, std::shared_ptr<void> owner)
+            : ptr(data),
+              pos(0),
+              limit(size),
+              capacity(size),
+              mem_tracker_(
+                      doris::thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker_sptr()),
+              owner_(std::move(owner)) {}
+
     std::shared_ptr<MemTrackerLimiter> mem_tracker_;
+    std::shared_ptr<void> owner_;
 };
 
 } // namespace doris
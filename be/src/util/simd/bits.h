@@ -106,6 +106,40 @@ inline constexpr auto bits_mask_all() {
 #endif
 }
 
+// Return the bits mask of the bytes equal to byte in the bits_mask_length() bytes from data,
+// in the same layout as bytes_mask_to_bits_mask.
+inline auto bytes_equal_to_bits_mask(const uint8_t* data, uint8_t byte) {
+#if defined(__ARM_NEON) && defined(__aarch64__)
+    return get_nibble_mask(vceqq_u8(vld1q_u8(data), vdupq_n_u8(byte)));
+#elif defined(__AVX2__)
+    return static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)),
+                              _mm256_set1_epi8(static_cast<char>(byte)))));
+#elif defined(__SSE2__)
+    auto value16 = _mm_set1_epi8(static_cast<char>(byte));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                   _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), value16))) |
+           (static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), value16)))
+            << 16);
+#else
+    uint32_t mask = 0;
+    for (std::size_t i = 0; i < 32; ++i) {
+        mask |= static_cast<uint32_t>(byte == *(data + i)) << i;
+    }
+    return mask;
+#endif
+}
+
+// Return the index of the first byte set in a non-zero bits mask.
+inline size_t first_index_of_bits_mask(decltype(bytes_mask_to_bits_mask(nullptr)) mask) {
+#if defined(__ARM_NEON) && defined(__aarch64__)
+    return static_cast<size_t>(__builtin_ctzll(mask) >> 2);
+#else
+    return static_cast<size_t>(__builtin_ctzll(mask));
+#endif
+}
+
 template <typename Func>
 void iterate_through_bits_mask(Func func, decltype(bytes_mask_to_bits_mask(nullptr)) mask) {
 #if defined(__ARM_NEON) && defined(__aarch64__)
@@ -52,6 +52,11 @@ struct MethodBaseInner {
 
     // use in join case
     DorisVector<uint32_t> bucket_nums;
+    // one byte tags of the hashes of the keys, only for join hash tables that use them
+    DorisVector<uint8_t> hash_tags;
+
+    // whether the join hash table skips the rows of a chain by the tags of their hashes
+    static constexpr bool use_hash_tags = requires { requires HashMap::USE_HASH_TAGS; };
 
     MethodBaseInner() { hash_table.reset(new HashMap()); }
     virtual ~MethodBaseInner() = default;
@@ -68,20 +73,38 @@ struct MethodBaseInner {
 
     void init_join_bucket_num(uint32_t num_rows, uint32_t bucket_size, const uint8_t* null_map) {
         bucket_nums.resize(num_rows);
+        if constexpr (use_hash_tags) {
+            hash_tags.resize(num_rows);
+        }
 
         if (null_map == nullptr) {
             init_join_bucket_num(num_rows, bucket_size);
             return;
         }
         for (uint32_t k = 0; k < num_rows; ++k) {
-            bucket_nums[k] =
-                    null_map[k] ? bucket_size : hash_table->hash(keys[k]) & (bucket_size - 1);
+            if (null_map[k]) {
+                bucket_nums[k] = bucket_size;
+                if constexpr (use_hash_tags) {
+                    // null keys are only chained with null keys, they share a tag
+                    hash_tags[k] = 0;
+                }
+                continue;
+            }
+            size_t hash_value = hash_table->hash(keys[k]);
+            bucket_nums[k] = hash_value & (bucket_size - 1);
+            if constexpr (use_hash_tags) {
+                hash_tags[k] = HashMap::hash_tag(hash_value);
+            }
         }
     }
 
     void init_join_bucket_num(uint32_t num_rows, uint32_t bucket_size) {
         for (uint32_t k = 0; k < num_rows; ++k) {
-            bucket_nums[k] = hash_table->hash(keys[k]) & (bucket_size - 1);
+            size_t hash_value = hash_table->hash(keys[k]);
+            bucket_nums[k] = hash_value & (bucket_size - 1);
+            if constexpr (use_hash_tags) {
+                hash_tags[k] = HashMap::hash_tag(hash_value);
+            }
         }
     }
 
@@ -218,6 +241,9 @@ struct MethodSerialized : public MethodBase<TData> {
         size += sizeof(StringRef) * num_rows; // stored_keys
         if (is_join) {
             size += sizeof(uint32_t) * num_rows; // bucket_nums
+            if constexpr (Base::use_hash_tags) {
+                size += sizeof(uint8_t) * num_rows; // hash_tags
+            }
         } else {
             size += sizeof(size_t) * num_rows; // hash_values
         }
@@ -314,6 +340,9 @@ struct MethodStringNoCache : public MethodBase<TData> {
         size += sizeof(StringRef) * num_rows; // stored_keys
         if (is_join) {
             size += sizeof(uint32_t) * num_rows; // bucket_nums
+            if constexpr (Base::use_hash_tags) {
+                size += sizeof(uint8_t) * num_rows; // hash_tags
+            }
         } else {
             size += sizeof(size_t) * num_rows; // hash_values
         }
@@ -505,6 +534,9 @@ struct MethodKeysFixed : public MethodBase<TData> {
         size += sizeof(StringRef) * num_rows; // stored_keys
         if (is_join) {
             size += sizeof(uint32_t) * num_rows; // bucket_nums
+            if constexpr (Base::use_hash_tags) {
+                size += sizeof(uint8_t) * num_rows; // hash_tags
+            }
         } else {
             size += sizeof(size_t) * num_rows; // hash_values
         }
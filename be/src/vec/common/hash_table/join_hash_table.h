@@ -19,13 +19,16 @@
 
 #include <gen_cpp/PlanNodes_types.h>
 
+#include <algorithm>
 #include <limits>
+#include <type_traits>
 
 #include "common/exception.h"
 #include "common/status.h"
 #include "vec/columns/column_filter_helper.h"
 #include "vec/common/custom_allocator.h"
 #include "vec/common/hash_table/hash.h"
+#include "vec/common/string_ref.h"
 
 namespace doris {
 template <typename Key, typename Hash = DefaultHash<Key>>
@@ -36,6 +39,16 @@ public:
     using value_type = void*;
     size_t hash(const Key& x) const { return Hash()(x); }
 
+    // StringRef keys (strings and serialized multi-column keys) are compared through a random
+    // access into the key storage. Each build row keeps a one byte tag of its hash, so that the
+    // probe skips most of the rows of a chain that do not match without touching their keys.
+    static constexpr bool USE_HASH_TAGS = std::is_same_v<Key, StringRef>;
+
+    // bucket numbers are the low bits of the hash, the tag mixes in all of them
+    static uint8_t hash_tag(size_t hash_value) {
+        return static_cast<uint8_t>((hash_value * 0x9E3779B97F4A7C15ULL) >> 56);
+    }
+
     static uint32_t calc_bucket_size(size_t num_elem) {
         size_t expect_bucket_size = num_elem + (num_elem - 1) / 7;
         return std::min(phmap::priv::NormalizeCapacity(expect_bucket_size) + 1,
@@ -44,7 +57,8 @@ public:
 
     size_t get_byte_size() const {
         auto cal_vector_mem = [](const auto& vec) { return vec.capacity() * sizeof(vec[0]); };
-        return cal_vector_mem(visited) + cal_vector_mem(first) + cal_vector_mem(next);
+        return cal_vector_mem(visited) + cal_vector_mem(first) + cal_vector_mem(next) +
+               cal_vector_mem(tags);
     }
 
     template <int JoinOpType>
@@ -57,6 +71,9 @@ public:
         bucket_size = calc_bucket_size(num_elem + 1);
         first.resize(bucket_size + 1);
         next.resize(num_elem);
+        if constexpr (USE_HASH_TAGS) {
+            tags.resize(num_elem);
+        }
 
         if constexpr (JoinOpType == TJoinOp::FULL_OUTER_JOIN ||
                       JoinOpType == TJoinOp::RIGHT_OUTER_JOIN ||
@@ -75,8 +92,11 @@ public:
     bool empty_build_side() const { return _empty_build_side; }
 
     void build(const Key* __restrict keys, const uint32_t* __restrict bucket_nums, size_t num_elem,
-               bool keep_null_key) {
+               bool keep_null_key, const uint8_t* __restrict hash_tags = nullptr) {
         build_keys = keys;
+        if constexpr (USE_HASH_TAGS) {
+            std::copy(hash_tags, hash_tags + num_elem, tags.begin());
+        }
         for (size_t i = 1; i < num_elem; i++) {
             uint32_t bucket_num = bucket_nums[i];
             next[i] = first[bucket_num];
@@ -88,10 +108,11 @@ public:
         _keep_null_key = keep_null_key;
     }
 
+    // probe_tags are the hash tags of the probe keys, only used if USE_HASH_TAGS
     template <int JoinOpType>
-    auto find_batch(const Key* __restrict keys, const uint32_t* __restrict build_idx_map,
-                    int probe_idx, uint32_t build_idx, int probe_rows,
-                    uint32_t* __restrict probe_idxs, bool& probe_visited,
+    auto find_batch(const Key* __restrict keys, const uint8_t* __restrict probe_tags,
+                    const uint32_t* __restrict build_idx_map, int probe_idx, uint32_t build_idx,
+                    int probe_rows, uint32_t* __restrict probe_idxs, bool& probe_visited,
                     uint32_t* __restrict build_idxs, const uint8_t* null_map,
                     bool with_other_conjuncts, bool is_mark_join, bool has_mark_join_conjunct) {
         if ((JoinOpType == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN ||
@@ -103,7 +124,8 @@ public:
 
         if (with_other_conjuncts) {
             return _find_batch_conjunct<JoinOpType, false>(
-                    keys, build_idx_map, probe_idx, build_idx, probe_rows, probe_idxs, build_idxs);
+                    keys, probe_tags, build_idx_map, probe_idx, build_idx, probe_rows, probe_idxs,
+                    build_idxs);
         }
 
         if (is_mark_join) {
@@ -117,33 +139,37 @@ public:
             /// If one row on probe side has one match in build side, we should stop searching the
             /// hash table for this row.
             if (is_null_aware_join || (is_left_half_join && !has_mark_join_conjunct)) {
-                return _find_batch_conjunct<JoinOpType, true>(keys, build_idx_map, probe_idx,
-                                                              build_idx, probe_rows, probe_idxs,
-                                                              build_idxs);
+                return _find_batch_conjunct<JoinOpType, true>(keys, probe_tags, build_idx_map,
+                                                              probe_idx, build_idx, probe_rows,
+                                                              probe_idxs, build_idxs);
             }
 
             return _find_batch_conjunct<JoinOpType, false>(
-                    keys, build_idx_map, probe_idx, build_idx, probe_rows, probe_idxs, build_idxs);
+                    keys, probe_tags, build_idx_map, probe_idx, build_idx, probe_rows, probe_idxs,
+                    build_idxs);
         }
 
         if (JoinOpType == TJoinOp::INNER_JOIN || JoinOpType == TJoinOp::FULL_OUTER_JOIN ||
             JoinOpType == TJoinOp::LEFT_OUTER_JOIN || JoinOpType == TJoinOp::RIGHT_OUTER_JOIN) {
-            return _find_batch_inner_outer_join<JoinOpType>(keys, build_idx_map, probe_idx,
-                                                            build_idx, probe_rows, probe_idxs,
-                                                            probe_visited, build_idxs);
+            return _find_batch_inner_outer_join<JoinOpType>(keys, probe_tags, build_idx_map,
+                                                            probe_idx, build_idx, probe_rows,
+                                                            probe_idxs, probe_visited, build_idxs);
         }
         if (JoinOpType == TJoinOp::LEFT_ANTI_JOIN || JoinOpType == TJoinOp::LEFT_SEMI_JOIN ||
             JoinOpType == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN) {
             if (null_map) {
-                return _find_batch_left_semi_anti<JoinOpType, true>(
-                        keys, build_idx_map, probe_idx, probe_rows, probe_idxs, null_map);
+                return _find_batch_left_semi_anti<JoinOpType, true>(keys, probe_tags, build_idx_map,
+                                                                    probe_idx, probe_rows,
+                                                                    probe_idxs, null_map);
             } else {
                 return _find_batch_left_semi_anti<JoinOpType, false>(
-                        keys, build_idx_map, probe_idx, probe_rows, probe_idxs, nullptr);
+                        keys, probe_tags, build_idx_map, probe_idx, probe_rows, probe_idxs,
+                        nullptr);
             }
         }
         if (JoinOpType == TJoinOp::RIGHT_ANTI_JOIN || JoinOpType == TJoinOp::RIGHT_SEMI_JOIN) {
-            return _find_batch_right_semi_anti(keys, build_idx_map, probe_idx, probe_rows);
+            return _find_batch_right_semi_anti(keys, probe_tags, build_idx_map, probe_idx,
+                                               probe_rows);
         }
         throw Exception(ErrorCode::INTERNAL_ERROR, "meet invalid hash join input");
     }
@@ -160,6 +186,7 @@ public:
      * select 'a' not in ('a', 'b', null) => false
      */
     auto find_null_aware_with_other_conjuncts(const Key* __restrict keys,
+                                              const uint8_t* __restrict probe_tags,
                                               const uint32_t* __restrict build_idx_map,
                                               int probe_idx, uint32_t build_idx, int probe_rows,
                                               uint32_t* __restrict probe_idxs,
@@ -168,12 +195,12 @@ public:
                                               bool picking_null_keys, const uint8_t* null_map) {
         if (null_map) {
             return _find_null_aware_with_other_conjuncts_impl<true>(
-                    keys, build_idx_map, probe_idx, build_idx, probe_rows, probe_idxs, build_idxs,
-                    null_flags, picking_null_keys, null_map);
+                    keys, probe_tags, build_idx_map, probe_idx, build_idx, probe_rows, probe_idxs,
+                    build_idxs, null_flags, picking_null_keys, null_map);
         } else {
             return _find_null_aware_with_other_conjuncts_impl<false>(
-                    keys, build_idx_map, probe_idx, build_idx, probe_rows, probe_idxs, build_idxs,
-                    null_flags, picking_null_keys, nullptr);
+                    keys, probe_tags, build_idx_map, probe_idx, build_idx, probe_rows, probe_idxs,
+                    build_idxs, null_flags, picking_null_keys, nullptr);
         }
     }
 
@@ -216,6 +243,16 @@ public:
     }
 
 private:
+    bool _eq(const Key* __restrict keys, const uint8_t* __restrict probe_tags, int probe_idx,
+             uint32_t build_idx) const {
+        if constexpr (USE_HASH_TAGS) {
+            if (probe_tags[probe_idx] != tags[build_idx]) {
+                return false;
+            }
+        }
+        return keys[probe_idx] == build_keys[build_idx];
+    }
+
     template <int JoinOpType>
     auto _process_null_aware_left_half_join_for_empty_build_side(int probe_idx, int probe_rows,
                                                                  uint32_t* __restrict probe_idxs,
@@ -239,13 +276,14 @@ private:
     }
 
     auto _find_batch_right_semi_anti(const Key* __restrict keys,
+                                     const uint8_t* __restrict probe_tags,
                                      const uint32_t* __restrict build_idx_map, int probe_idx,
                                      int probe_rows) {
         while (probe_idx < probe_rows) {
             auto build_idx = build_idx_map[probe_idx];
 
             while (build_idx) {
-                if (!visited[build_idx] && keys[probe_idx] == build_keys[build_idx]) {
+                if (!visited[build_idx] && _eq(keys, probe_tags, probe_idx, build_idx)) {
                     visited[build_idx] = 1;
                 }
                 build_idx = next[build_idx];
@@ -257,6 +295,7 @@ private:
 
     template <int JoinOpType, bool has_null_map>
     auto _find_batch_left_semi_anti(const Key* __restrict keys,
+                                    const uint8_t* __restrict probe_tags,
                                     const uint32_t* __restrict build_idx_map, int probe_idx,
                                     int probe_rows, uint32_t* __restrict probe_idxs,
                                     const uint8_t* null_map) {
@@ -273,7 +312,7 @@ private:
 
             auto build_idx = build_idx_map[probe_idx];
 
-            while (build_idx && keys[probe_idx] != build_keys[build_idx]) {
+            while (build_idx && !_eq(keys, probe_tags, probe_idx, build_idx)) {
                 build_idx = next[build_idx];
             }
             bool matched = JoinOpType == TJoinOp::LEFT_SEMI_JOIN ? build_idx != 0 : build_idx == 0;
@@ -284,15 +323,16 @@ private:
     }
 
     template <int JoinOpType, bool only_need_to_match_one>
-    auto _find_batch_conjunct(const Key* __restrict keys, const uint32_t* __restrict build_idx_map,
-                              int probe_idx, uint32_t build_idx, int probe_rows,
+    auto _find_batch_conjunct(const Key* __restrict keys, const uint8_t* __restrict probe_tags,
+                              const uint32_t* __restrict build_idx_map, int probe_idx,
+                              uint32_t build_idx, int probe_rows,
                               uint32_t* __restrict probe_idxs, uint32_t* __restrict build_idxs) {
         uint32_t matched_cnt = 0;
         const auto batch_size = max_batch_size;
 
         auto do_the_probe = [&]() {
             while (build_idx && matched_cnt < batch_size) {
-                if (keys[probe_idx] == build_keys[build_idx]) {
+                if (_eq(keys, probe_tags, probe_idx, build_idx)) {
                     build_idxs[matched_cnt] = build_idx;
                     probe_idxs[matched_cnt] = probe_idx;
                     matched_cnt++;
@@ -337,6 +377,7 @@ private:
 
     template <int JoinOpType>
     auto _find_batch_inner_outer_join(const Key* __restrict keys,
+                                      const uint8_t* __restrict probe_tags,
                                       const uint32_t* __restrict build_idx_map, int probe_idx,
                                       uint32_t build_idx, int probe_rows,
                                       uint32_t* __restrict probe_idxs, bool& probe_visited,
@@ -346,7 +387,7 @@ private:
 
         auto do_the_probe = [&]() {
             while (build_idx && matched_cnt < batch_size) {
-                if (keys[probe_idx] == build_keys[build_idx]) {
+                if (_eq(keys, probe_tags, probe_idx, build_idx)) {
                     probe_idxs[matched_cnt] = probe_idx;
                     build_idxs[matched_cnt] = build_idx;
                     matched_cnt++;
@@ -391,10 +432,10 @@ private:
 
     template <bool has_null_map>
     auto _find_null_aware_with_other_conjuncts_impl(
-            const Key* __restrict keys, const uint32_t* __restrict build_idx_map, int probe_idx,
-            uint32_t build_idx, int probe_rows, uint32_t* __restrict probe_idxs,
-            uint32_t* __restrict build_idxs, uint8_t* __restrict null_flags, bool picking_null_keys,
-            const uint8_t* null_map) {
+            const Key* __restrict keys, const uint8_t* __restrict probe_tags,
+            const uint32_t* __restrict build_idx_map, int probe_idx, uint32_t build_idx,
+            int probe_rows, uint32_t* __restrict probe_idxs, uint32_t* __restrict build_idxs,
+            uint8_t* __restrict null_flags, bool picking_null_keys, const uint8_t* null_map) {
         uint32_t matched_cnt = 0;
         const auto batch_size = max_batch_size;
 
@@ -407,7 +448,7 @@ private:
             }
 
             while (build_idx && matched_cnt < batch_size) {
-                if (picking_null_keys || keys[probe_idx] == build_keys[build_idx]) {
+                if (picking_null_keys || _eq(keys, probe_tags, probe_idx, build_idx)) {
                     build_idxs[matched_cnt] = build_idx;
                     probe_idxs[matched_cnt] = probe_idx;
                     null_flags[matched_cnt] = picking_null_keys;
@@ -467,6 +508,8 @@ private:
 
     DorisVector<uint32_t> first = {0};
     DorisVector<uint32_t> next = {0};
+    // hash tags of the build rows, only if USE_HASH_TAGS
+    DorisVector<uint8_t> tags;
 
     // use in iter hash map
     mutable uint32_t iter_idx = 1;
@@ -30,6 +30,7 @@
 #include <utility>
 
 #include "common/compiler_util.h" // IWYU pragma: keep
+#include "common/config.h"
 #include "common/consts.h"
 #include "common/status.h"
 #include "exec/decompressor.h"
@@ -40,7 +41,9 @@
 #include "io/fs/file_reader.h"
 #include "io/fs/s3_file_reader.h"
 #include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
+#include "util/simd/bits.h"
 #include "util/string_util.h"
 #include "util/utf8_check.h"
 #include "vec/core/block.h"
@@ -48,6 +51,7 @@
 #include "vec/data_types/data_type_factory.hpp"
 #include "vec/exec/format/file_reader/new_plain_binary_line_reader.h"
 #include "vec/exec/format/file_reader/new_plain_text_line_reader.h"
+#include "vec/exec/format/file_reader/parallel_decompression_reader.h"
 #include "vec/exec/scan/scanner.h"
 
 namespace doris {
@@ -80,12 +84,37 @@ void EncloseCsvTextFieldSplitter::do_split(const Slice& line, std::vector<Slice>
     }
 }
 
+void PlainCsvTextFieldSplitter::_split_field_by_positions(const Slice& line,
+                                                          std::vector<Slice>* splitted_values) {
+    const char* data = line.data;
+    size_t value_start = 0;
+    for (auto idx : _text_line_reader_ctx->column_sep_positions()) {
+        process_value_func(data, value_start, idx - value_start, _trimming_char, splitted_values);
+        value_start = idx + _value_sep_len;
+    }
+    process_value_func(data, value_start, line.size - value_start, _trimming_char,
+                       splitted_values);
+}
+
 void PlainCsvTextFieldSplitter::_split_field_single_char(const Slice& line,
                                                          std::vector<Slice>* splitted_values) {
     const char* data = line.data;
     const size_t size = line.size;
     size_t value_start = 0;
-    for (size_t i = 0; i < size; ++i) {
+    size_t i = 0;
+    // find the separators of a vector of bytes at a time by the bits mask of the comparison
+    static constexpr size_t SIMD_BYTES = simd::bits_mask_length();
+    const auto sep = static_cast<uint8_t>(_value_sep[0]);
+    for (; i + SIMD_BYTES <= size; i += SIMD_BYTES) {
+        simd::iterate_through_bits_mask(
+                [&](size_t idx) {
+                    process_value_func(data, value_start, i + idx - value_start, _trimming_char,
+                                       splitted_values);
+                    value_start = i + idx + _value_sep_len;
+                },
+                simd::bytes_equal_to_bits_mask(reinterpret_cast<const uint8_t*>(data + i), sep));
+    }
+    for (; i < size; ++i) {
         if (data[i] == _value_sep[0]) {
             process_value_func(data, value_start, i - value_start, _trimming_char, splitted_values);
             value_start = i + _value_sep_len;
@@ -162,7 +191,13 @@ void PlainCsvTextFieldSplitter::_split_field_multi_char(const Slice& line,
 }
 
 void PlainCsvTextFieldSplitter::do_split(const Slice& line, std::vector<Slice>* splitted_values) {
-    if (is_single_char_delim) {
+    // the line is not the one just read when its bom is removed, or it is the last line of the
+    // file without a line delimiter
+    if (_text_line_reader_ctx != nullptr &&
+        _text_line_reader_ctx->is_last_line(reinterpret_cast<const uint8_t*>(line.data),
+                                            line.size)) {
+        _split_field_by_positions(line, splitted_values);
+    } else if (is_single_char_delim) {
         _split_field_single_char(line, splitted_values);
     } else {
         _split_field_multi_char(line, splitted_values);
@@ -525,6 +560,17 @@ Status CsvReader::_create_decompressor() {
     } else {
         RETURN_IF_ERROR(Decompressor::create_decompressor(_file_format_type, &_decompressor));
     }
+    if (config::enable_parallel_decompression && _decompressor != nullptr &&
+        ParallelDecompressionReader::support(_decompressor->get_type())) {
+        // the reader returns the decompressed content, which is read to the end
+        _file_reader = std::make_shared<ParallelDecompressionReader>(
+                _file_reader, _decompressor->get_type(),
+                ExecEnv::GetInstance()->decompression_thread_pool(),
+                config::parallel_decompression_max_frame_bytes,
+                config::parallel_decompression_queue_bytes);
+        _decompressor.reset();
+        _size = -1;
+    }
 
     return Status::OK();
 }
@@ -551,15 +597,23 @@ Status CsvReader::_create_file_reader(bool need_schema) {
 
 Status CsvReader::_create_line_reader() {
     std::shared_ptr<TextLineReaderContextIf> text_line_reader_ctx;
-    if (_enclose == 0) {
+    // in load task, the _file_slot_descs is empty vector, so we need to set col_sep_num to 0
+    size_t col_sep_num = _file_slot_descs.size() > 1 ? _file_slot_descs.size() - 1 : 0;
+    if (_enclose == 0 &&
+        PlainCsvLineReaderCtx::is_supported(_line_delimiter, _value_separator, _keep_cr)) {
+        auto plain_csv_line_reader_ctx = std::make_shared<PlainCsvLineReaderCtx>(
+                _line_delimiter, _line_delimiter_length, _value_separator, col_sep_num, _keep_cr);
+        _fields_splitter = std::make_unique<PlainCsvTextFieldSplitter>(
+                _trim_tailing_spaces, false, _value_separator, _value_separator_length, -1,
+                plain_csv_line_reader_ctx);
+        text_line_reader_ctx = std::move(plain_csv_line_reader_ctx);
+    } else if (_enclose == 0) {
         text_line_reader_ctx = std::make_shared<PlainTextLineReaderCtx>(
                 _line_delimiter, _line_delimiter_length, _keep_cr);
         _fields_splitter = std::make_unique<PlainCsvTextFieldSplitter>(
                 _trim_tailing_spaces, false, _value_separator, _value_separator_length, -1);
 
     } else {
-        // in load task, the _file_slot_descs is empty vector, so we need to set col_sep_num to 0
-        size_t col_sep_num = _file_slot_descs.size() > 1 ? _file_slot_descs.size() - 1 : 0;
         text_line_reader_ctx = std::make_shared<EncloseCsvLineReaderCtx>(
                 _line_delimiter, _line_delimiter_length, _value_separator, _value_separator_length,
                 col_sep_num, _enclose, _escape, _keep_cr);
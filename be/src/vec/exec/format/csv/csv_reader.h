@@ -149,22 +149,27 @@ private:
 
 class PlainCsvTextFieldSplitter : public BaseCsvTextFieldSplitter<PlainCsvTextFieldSplitter> {
 public:
-    explicit PlainCsvTextFieldSplitter(bool trim_tailing_space, bool trim_ends,
-                                       std::string value_sep, size_t value_sep_len = 1,
-                                       char trimming_char = 0)
+    // The lines read by line_reader_ctx are split by the separator positions it found.
+    explicit PlainCsvTextFieldSplitter(
+            bool trim_tailing_space, bool trim_ends, std::string value_sep,
+            size_t value_sep_len = 1, char trimming_char = 0,
+            std::shared_ptr<PlainCsvLineReaderCtx> line_reader_ctx = nullptr)
             : BaseCsvTextFieldSplitter(trim_tailing_space, trim_ends, value_sep_len, trimming_char),
-              _value_sep(std::move(value_sep)) {
+              _value_sep(std::move(value_sep)),
+              _text_line_reader_ctx(std::move(line_reader_ctx)) {
         is_single_char_delim = (value_sep_len == 1);
     }
 
     void do_split(const Slice& line, std::vector<Slice>* splitted_values);
 
 private:
+    void _split_field_by_positions(const Slice& line, std::vector<Slice>* splitted_values);
     void _split_field_single_char(const Slice& line, std::vector<Slice>* splitted_values);
     void _split_field_multi_char(const Slice& line, std::vector<Slice>* splitted_values);
 
     bool is_single_char_delim;
     std::string _value_sep;
+    std::shared_ptr<PlainCsvLineReaderCtx> _text_line_reader_ctx;
 };
 
 class CsvReader : public GenericReader {
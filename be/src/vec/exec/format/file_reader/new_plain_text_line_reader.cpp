@@ -30,6 +30,7 @@
 
 #include "exec/decompressor.h"
 #include "io/fs/file_reader.h"
+#include "util/simd/bits.h"
 #include "util/slice.h"
 
 // INPUT_CHUNK must
@@ -44,8 +45,98 @@
 
 namespace doris {
 #include "common/compile_check_begin.h"
+void CsvStructuralIndex::reset(const uint8_t* start, size_t length, size_t from) {
+    _start = start;
+    _length = length;
+    _indexed = from;
+    for (size_t i = 0; i < _num_classes; ++i) {
+        _positions[i].clear();
+        _cursors[i] = 0;
+    }
+}
+
+size_t CsvStructuralIndex::next(CharClass char_class, size_t from, size_t to) {
+    auto& positions = _positions[char_class];
+    auto& cursor = _cursors[char_class];
+    while (true) {
+        while (cursor < positions.size() && positions[cursor] < from) {
+            ++cursor;
+        }
+        if (cursor < positions.size()) {
+            return std::min(positions[cursor], to);
+        }
+        if (_indexed >= to || _indexed == _length) {
+            return to;
+        }
+        _index_window();
+    }
+}
+
+void CsvStructuralIndex::_index_window() {
+    // a window keeps the positions of a buffer of long lines small
+    static constexpr size_t WINDOW_BYTES = 64 * 1024;
+    static constexpr size_t SIMD_BYTES = simd::bits_mask_length();
+    for (size_t i = 0; i < _num_classes; ++i) {
+        // the positions before the cursors will never be asked for
+        _positions[i].erase(_positions[i].begin(), _positions[i].begin() + _cursors[i]);
+        _cursors[i] = 0;
+    }
+    const size_t end = std::min(_length, _indexed + WINDOW_BYTES);
+    size_t pos = _indexed;
+    for (; pos + SIMD_BYTES <= end; pos += SIMD_BYTES) {
+        for (size_t i = 0; i < _num_classes; ++i) {
+            simd::iterate_through_bits_mask(
+                    [&](size_t idx) { _positions[i].push_back(pos + idx); },
+                    simd::bytes_equal_to_bits_mask(_start + pos, _chars[i]));
+        }
+    }
+    for (; pos < end; ++pos) {
+        for (size_t i = 0; i < _num_classes; ++i) {
+            if (_start[pos] == _chars[i]) {
+                _positions[i].push_back(pos);
+            }
+        }
+    }
+    _indexed = end;
+}
+
+const uint8_t* PlainCsvLineReaderCtx::read_line_impl(const uint8_t* start, const size_t length) {
+    _column_sep_positions.clear();
+    _line_start = nullptr;
+    if (!_index.covers(start, length)) {
+        _index.reset(start, length);
+    }
+    const size_t line_begin = start - _index.start();
+    const size_t end = line_begin + length;
+    const size_t line_feed = _index.next(CsvStructuralIndex::LINE_FEED, line_begin, end);
+    if (line_feed == end) {
+        // the buffer may be moved before the rest of the line is read
+        _index.invalidate();
+        return nullptr;
+    }
+    size_t line_end = line_feed;
+    line_crlf = line_feed > line_begin && _index.start()[line_feed - 1] == '\r';
+    if (line_crlf) {
+        --line_end;
+    }
+    for (size_t pos = _index.next(CsvStructuralIndex::COLUMN_SEP, line_begin, line_end);
+         pos != line_end; pos = _index.next(CsvStructuralIndex::COLUMN_SEP, pos + 1, line_end)) {
+        _column_sep_positions.push_back(pos - line_begin);
+    }
+    _line_start = start;
+    _line_size = line_end - line_begin;
+    return start + _line_size;
+}
+
 const uint8_t* EncloseCsvLineReaderCtx::read_line_impl(const uint8_t* start, const size_t length) {
     _total_len = length;
+    if (_use_index) {
+        if (!_index.covers(start, length)) {
+            // a line not found in the last buffer is read again from where it stopped
+            _index.reset(start, length, _idx);
+        }
+        _line_offset = start - _index.start();
+    }
     size_t bound = update_reading_bound(start);
 
     while (_idx != bound) {
@@ -69,6 +160,10 @@ const uint8_t* EncloseCsvLineReaderCtx::read_line_impl(const uint8_t* start, con
         }
     }
 
+    if (_use_index && _result == nullptr) {
+        // the buffer may be moved before the rest of the line is read
+        _index.invalidate();
+    }
     return _result;
 }
 
@@ -81,6 +176,16 @@ void EncloseCsvLineReaderCtx::on_col_sep_found(const uint8_t* start, const uint8
 }
 
 size_t EncloseCsvLineReaderCtx::update_reading_bound(const uint8_t* start) {
+    if (_use_index) {
+        size_t line_feed = _next_in_index(CsvStructuralIndex::LINE_FEED, _idx, _total_len);
+        if (line_feed == _total_len) {
+            _result = nullptr;
+            return _total_len;
+        }
+        line_crlf = line_feed > _idx && start[line_feed - 1] == '\r';
+        _result = start + line_feed - line_crlf;
+        return _result - start + line_delimiter_length();
+    }
     _result = call_find_line_sep(start + _idx, _total_len - _idx);
     if (_result == nullptr) {
         return _total_len;
@@ -126,10 +231,7 @@ void EncloseCsvLineReaderCtx::_on_start(const uint8_t* start, size_t& len) {
 }
 
 void EncloseCsvLineReaderCtx::_on_normal(const uint8_t* start, size_t& len) {
-    const uint8_t* curr_start = start + _idx;
-    size_t curr_len = len - _idx;
-    const uint8_t* col_sep_pos =
-            find_col_sep_func(curr_start, curr_len, _column_sep.c_str(), _column_sep_len);
+    const uint8_t* col_sep_pos = _find_col_sep(start, len);
 
     if (col_sep_pos != nullptr) [[likely]] {
         on_col_sep_found(start, col_sep_pos);
@@ -143,6 +245,13 @@ void EncloseCsvLineReaderCtx::_on_normal(const uint8_t* start, size_t& len) {
 void EncloseCsvLineReaderCtx::_on_pre_match_enclose(const uint8_t* start, size_t& len) {
     do {
         do {
+            if (!_should_escape && !_quote_escape) {
+                // only the escape and enclose change the state here, skip the other bytes
+                _idx = _find_enclose_or_escape(start, _idx, len);
+                if (_idx == len) {
+                    break;
+                }
+            }
             if (start[_idx] == _escape) [[unlikely]] {
                 _should_escape = !_should_escape;
             } else if (_should_escape) [[unlikely]] {
@@ -180,11 +289,36 @@ void EncloseCsvLineReaderCtx::_on_pre_match_enclose(const uint8_t* start, size_t
     } while (true);
 }
 
+const uint8_t* EncloseCsvLineReaderCtx::_find_col_sep(const uint8_t* start, size_t len) {
+    if (_use_index) {
+        size_t pos = _next_in_index(CsvStructuralIndex::COLUMN_SEP, _idx, len);
+        return pos == len ? nullptr : start + pos;
+    }
+    return find_col_sep_func(start + _idx, len - _idx, _column_sep.c_str(), _column_sep_len);
+}
+
+size_t EncloseCsvLineReaderCtx::_find_enclose_or_escape(const uint8_t* start, size_t from,
+                                                        size_t to) {
+    if (_use_index) {
+        return std::min(_next_in_index(CsvStructuralIndex::ENCLOSE, from, to),
+                        _next_in_index(CsvStructuralIndex::ESCAPE, from, to));
+    }
+    static constexpr size_t SIMD_BYTES = simd::bits_mask_length();
+    for (; from + SIMD_BYTES <= to; from += SIMD_BYTES) {
+        auto mask = simd::bytes_equal_to_bits_mask(start + from, static_cast<uint8_t>(_enclose)) |
+                    simd::bytes_equal_to_bits_mask(start + from, static_cast<uint8_t>(_escape));
+        if (mask != 0) {
+            return from + simd::first_index_of_bits_mask(mask);
+        }
+    }
+    while (from < to && start[from] != _enclose && start[from] != _escape) {
+        ++from;
+    }
+    return from;
+}
+
 void EncloseCsvLineReaderCtx::_on_match_enclose(const uint8_t* start, size_t& len) {
-    const uint8_t* curr_start = start + _idx;
-    size_t curr_len = len - _idx;
-    const uint8_t* delim_pos =
-            find_col_sep_func(curr_start, curr_len, _column_sep.c_str(), _column_sep_len);
+    const uint8_t* delim_pos = _find_col_sep(start, len);
 
     if (delim_pos != nullptr) [[likely]] {
         on_col_sep_found(start, delim_pos);
@@ -176,6 +176,92 @@ public:
     inline void refresh_impl() {}
 };
 
+// The positions of the structural chars of csv text in the buffer of the line reader: line feeds,
+// column separators, and the enclose and escape chars of enclosed csv.
+// The buffer is indexed a window at a time, every char class of a vector of bytes is found by one
+// comparison into a bits mask. The contexts then read the lines and fields from the positions
+// instead of scanning every line.
+class CsvStructuralIndex {
+public:
+    enum CharClass : uint8_t { LINE_FEED = 0, COLUMN_SEP, ENCLOSE, ESCAPE, NUM_CHAR_CLASSES };
+
+    // Index the first num_classes of line feed, column_sep, enclose and escape.
+    CsvStructuralIndex(char column_sep, char enclose, char escape, size_t num_classes)
+            : _chars {'\n', static_cast<uint8_t>(column_sep), static_cast<uint8_t>(enclose),
+                      static_cast<uint8_t>(escape)},
+              _num_classes(num_classes) {}
+
+    // Index [start, start + length), no position before from will be asked for.
+    void reset(const uint8_t* start, size_t length, size_t from = 0);
+
+    // Whether the buffer [start, start + length) is the rest of the indexed buffer.
+    [[nodiscard]] bool covers(const uint8_t* start, size_t length) const {
+        return _start != nullptr && start >= _start && start + length == _start + _length;
+    }
+
+    // Should be called when the indexed buffer may be moved or changed.
+    void invalidate() { _start = nullptr; }
+
+    [[nodiscard]] const uint8_t* start() const { return _start; }
+
+    // Return the offset of the first char of the class in [from, to), or to if not found.
+    // The from of a class must not go backwards until the next reset.
+    size_t next(CharClass char_class, size_t from, size_t to);
+
+private:
+    void _index_window();
+
+    const uint8_t _chars[NUM_CHAR_CLASSES];
+    const size_t _num_classes;
+
+    const uint8_t* _start = nullptr;
+    size_t _length = 0;
+    // the end of the indexed bytes
+    size_t _indexed = 0;
+    std::vector<size_t> _positions[NUM_CHAR_CLASSES];
+    // the first position of each class not before the last from asked for
+    size_t _cursors[NUM_CHAR_CLASSES] {};
+};
+
+// The context of csv without enclose. The lines end with \n or \r\n and the column separator is
+// one char, so the line ends and the separators of each line are read from the structural index.
+class PlainCsvLineReaderCtx final : public BaseTextLineReaderContext<PlainCsvLineReaderCtx> {
+public:
+    explicit PlainCsvLineReaderCtx(const std::string& line_delimiter_,
+                                   const size_t line_delimiter_len_, const std::string& column_sep,
+                                   size_t col_sep_num, const bool keep_cr_)
+            : BaseTextLineReaderContext(line_delimiter_, line_delimiter_len_, keep_cr_),
+              _index(column_sep[0], 0, 0, CsvStructuralIndex::COLUMN_SEP + 1) {
+        _column_sep_positions.reserve(col_sep_num);
+    }
+
+    static bool is_supported(const std::string& line_delimiter, const std::string& column_sep,
+                             bool keep_cr) {
+        return line_delimiter == "\n" && !keep_cr && column_sep.size() == 1 &&
+               column_sep[0] != '\n' && column_sep[0] != '\r';
+    }
+
+    const uint8_t* read_line_impl(const uint8_t* start, size_t length);
+
+    inline void refresh_impl() {}
+
+    // The separator positions of the last line found, relative to the start of the line.
+    [[nodiscard]] inline const std::vector<size_t>& column_sep_positions() const {
+        return _column_sep_positions;
+    }
+
+    // Whether line is the last line found, the separator positions only belong to it.
+    [[nodiscard]] inline bool is_last_line(const uint8_t* line, size_t size) const {
+        return line == _line_start && size == _line_size;
+    }
+
+private:
+    CsvStructuralIndex _index;
+    const uint8_t* _line_start = nullptr;
+    size_t _line_size = 0;
+    std::vector<size_t> _column_sep_positions;
+};
+
 enum class ReaderState { START, NORMAL, PRE_MATCH_ENCLOSE, MATCH_ENCLOSE };
 struct ReaderStateWrapper {
     inline void forward_to(ReaderState state) {
@@ -207,13 +293,18 @@ public:
               _enclose(enclose),
               _escape(escape),
               _column_sep_len(column_sep_len_),
-              _column_sep(std::move(column_sep_)) {
+              _column_sep(std::move(column_sep_)),
+              _index(_column_sep[0], enclose, escape, CsvStructuralIndex::NUM_CHAR_CLASSES) {
         if (column_sep_len_ == 1) {
             find_col_sep_func = &EncloseCsvLineReaderCtx::look_for_column_sep_pos<true>;
         } else {
             find_col_sep_func = &EncloseCsvLineReaderCtx::look_for_column_sep_pos<false>;
         }
         _column_sep_positions.reserve(col_sep_num);
+        // the structural index only knows \n and \r\n lines and one char separators
+        auto is_line_char = [](char c) { return c == '\n' || c == '\r'; };
+        _use_index = !use_memmem && column_sep_len_ == 1 && !is_line_char(_column_sep[0]) &&
+                     !is_line_char(enclose) && !is_line_char(escape);
     }
 
     inline void refresh_impl() {
@@ -225,7 +316,7 @@ public:
         _state.reset();
     }
 
-    [[nodiscard]] inline std::vector<size_t> column_sep_positions() const {
+    [[nodiscard]] inline const std::vector<size_t>& column_sep_positions() const {
         return _column_sep_positions;
     }
 
@@ -243,6 +334,14 @@ private:
     void _on_normal(const uint8_t* start, size_t& len);
     void _on_pre_match_enclose(const uint8_t* start, size_t& len);
     void _on_match_enclose(const uint8_t* start, size_t& len);
+    // Return the position of the first enclose or escape in [from, to), or to if not found.
+    size_t _find_enclose_or_escape(const uint8_t* start, size_t from, size_t to);
+    const uint8_t* _find_col_sep(const uint8_t* start, size_t len);
+    // Return the position of the first char of the class in [from, to) of the current line from
+    // the structural index, or to if not found.
+    size_t _next_in_index(CsvStructuralIndex::CharClass char_class, size_t from, size_t to) {
+        return _index.next(char_class, _line_offset + from, _line_offset + to) - _line_offset;
+    }
 
     ReaderStateWrapper _state;
     const char _enclose;
@@ -261,6 +360,11 @@ private:
     std::vector<size_t> _column_sep_positions;
 
     FindDelimiterFunc find_col_sep_func;
+
+    bool _use_index = false;
+    CsvStructuralIndex _index;
+    // the offset of the current line in the structural index
+    size_t _line_offset = 0;
 };
 
 using TextLineReaderCtxPtr = std::shared_ptr<TextLineReaderContextIf>;
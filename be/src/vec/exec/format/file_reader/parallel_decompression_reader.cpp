@@ -0,0 +1,438 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/format/file_reader/parallel_decompression_reader.h"
+
+#include <zstd.h>
+#include <zstd_errors.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "runtime/thread_context.h"
+#include "util/coding.h"
+#include "util/threadpool.h"
+
+namespace doris {
+#include "common/compile_check_begin.h"
+
+static constexpr size_t INPUT_CHUNK = 1024 * 1024;
+static constexpr size_t MIN_OUTPUT_SIZE = 64 * 1024;
+
+// skippable frames of both zstd and lz4 frame use the magic numbers 0x184D2A50 ~ 0x184D2A5F
+static constexpr uint32_t SKIPPABLE_FRAME_MAGIC = 0x184D2A50;
+static constexpr uint32_t SKIPPABLE_FRAME_MAGIC_MASK = 0xFFFFFFF0;
+static constexpr uint32_t LZ4_FRAME_MAGIC = 0x184D2204;
+
+// The frame format is
+//   Magic(4) FLG(1) BD(1) [ContentSize(8)] [DictID(4)] HC(1)
+//   { BlockSize(4) Data [BlockChecksum(4)] } * N  EndMark(4) [ContentChecksum(4)]
+static bool get_lz4_frame_size(const uint8_t* data, size_t size, size_t* frame_size,
+                               size_t* content_size, bool* has_data) {
+    if (size < 6) {
+        return true;
+    }
+    uint8_t flg = data[4];
+    if ((flg >> 6) != 1) {
+        return false;
+    }
+    bool block_checksum = flg & 0x10;
+    bool has_content_size = flg & 0x08;
+    bool content_checksum = flg & 0x04;
+    bool dict_id = flg & 0x01;
+    if (has_content_size) {
+        if (size < 6 + 8) {
+            return true;
+        }
+        *content_size = decode_fixed64_le(data + 6);
+    }
+    size_t pos = 4 + 2 + (has_content_size ? 8 : 0) + (dict_id ? 4 : 0) + 1;
+    *has_data = false;
+    while (true) {
+        if (size < pos + 4) {
+            return true;
+        }
+        uint32_t block_size = decode_fixed32_le(data + pos);
+        pos += 4;
+        if (block_size == 0) {
+            break;
+        }
+        *has_data = true;
+        // the highest bit marks an uncompressed block
+        pos += (block_size & 0x7FFFFFFF) + (block_checksum ? 4 : 0);
+    }
+    pos += content_checksum ? 4 : 0;
+    if (size >= pos) {
+        *frame_size = pos;
+    }
+    return true;
+}
+
+// A bgzf block is a gzip member whose extra field holds the subfield 'B' 'C' of the
+// block size minus 1.
+static bool get_bgzf_block_size(const uint8_t* data, size_t size, size_t* frame_size,
+                                size_t* content_size, bool* has_data) {
+    if (size < 4) {
+        return true;
+    }
+    constexpr uint8_t FEXTRA = 0x04;
+    if (data[0] != 0x1f || data[1] != 0x8b || data[2] != 8 || !(data[3] & FEXTRA)) {
+        return false;
+    }
+    if (size < 12) {
+        return true;
+    }
+    size_t extra_end = 12 + decode_fixed16_le(data + 10);
+    if (size < extra_end) {
+        return true;
+    }
+    size_t block_size = 0;
+    for (size_t pos = 12; pos + 4 <= extra_end;) {
+        uint16_t subfield_size = decode_fixed16_le(data + pos + 2);
+        if (data[pos] == 'B' && data[pos + 1] == 'C' && subfield_size == 2 &&
+            pos + 6 <= extra_end) {
+            block_size = decode_fixed16_le(data + pos + 4) + 1;
+            break;
+        }
+        pos += 4 + subfield_size;
+    }
+    // the trailer CRC32(4) ISIZE(4) follows the compressed data
+    if (block_size < extra_end + 8) {
+        return false;
+    }
+    if (size >= block_size) {
+        *frame_size = block_size;
+        *content_size = decode_fixed32_le(data + block_size - 4);
+        *has_data = *content_size != 0;
+    }
+    return true;
+}
+
+bool ParallelDecompressionReader::get_frame_size(CompressType type, const uint8_t* data,
+                                                 size_t size, size_t* frame_size,
+                                                 size_t* content_size, bool* has_data) {
+    *frame_size = 0;
+    *content_size = 0;
+    *has_data = true;
+    if (type == CompressType::GZIP) {
+        return get_bgzf_block_size(data, size, frame_size, content_size, has_data);
+    }
+    if (size < 8) {
+        return true;
+    }
+    uint32_t magic = decode_fixed32_le(data);
+    if ((magic & SKIPPABLE_FRAME_MAGIC_MASK) == SKIPPABLE_FRAME_MAGIC) {
+        size_t skippable_size = 8 + decode_fixed32_le(data + 4);
+        if (size >= skippable_size) {
+            *frame_size = skippable_size;
+            *has_data = false;
+        }
+        return true;
+    }
+    switch (type) {
+    case CompressType::ZSTD: {
+        if (magic != ZSTD_MAGICNUMBER) {
+            return false;
+        }
+        size_t ret = ZSTD_findFrameCompressedSize(data, size);
+        if (ZSTD_isError(ret)) {
+            // srcSize_wrong means the frame is not complete yet
+            return ZSTD_getErrorCode(ret) == ZSTD_error_srcSize_wrong;
+        }
+        *frame_size = ret;
+        unsigned long long frame_content_size = ZSTD_getFrameContentSize(data, size);
+        if (frame_content_size == 0) {
+            *has_data = false;
+        } else if (frame_content_size != ZSTD_CONTENTSIZE_UNKNOWN &&
+                   frame_content_size != ZSTD_CONTENTSIZE_ERROR) {
+            *content_size = frame_content_size;
+        }
+        return true;
+    }
+    case CompressType::LZ4FRAME:
+        if (magic != LZ4_FRAME_MAGIC) {
+            return false;
+        }
+        return get_lz4_frame_size(data, size, frame_size, content_size, has_data);
+    default:
+        return false;
+    }
+}
+
+bool ParallelDecompressionReader::support(CompressType type) {
+    return type == CompressType::GZIP || type == CompressType::ZSTD ||
+           type == CompressType::LZ4FRAME;
+}
+
+ParallelDecompressionReader::ParallelDecompressionReader(io::FileReaderSPtr reader,
+                                                         CompressType type, ThreadPool* pool,
+                                                         size_t max_frame_bytes,
+                                                         size_t max_queue_bytes)
+        : _reader(std::move(reader)),
+          _type(type),
+          _pool(pool),
+          _max_frame_bytes(max_frame_bytes),
+          _max_queue_bytes(max_queue_bytes),
+          _resource_ctx(thread_context()->resource_ctx()) {}
+
+ParallelDecompressionReader::~ParallelDecompressionReader() {
+    static_cast<void>(close());
+}
+
+Status ParallelDecompressionReader::close() {
+    if (!_closed) {
+        _closed = true;
+        // the submitted frames hold themselves, they are freed once decompressed
+        _frames.clear();
+        _queued_bytes = 0;
+        _current.reset();
+        return _reader->close();
+    }
+    return Status::OK();
+}
+
+Status ParallelDecompressionReader::read_at_impl(size_t offset, Slice result, size_t* bytes_read,
+                                                 const io::IOContext* io_ctx) {
+    *bytes_read = 0;
+    while (*bytes_read < result.size) {
+        if (_current != nullptr && _current_pos < _current->output.size()) {
+            size_t copy_size =
+                    std::min(result.size - *bytes_read, _current->output.size() - _current_pos);
+            memcpy(result.data + *bytes_read, _current->output.data() + _current_pos, copy_size);
+            _current_pos += copy_size;
+            *bytes_read += copy_size;
+            continue;
+        }
+        if (_current != nullptr && !_frame_finished(*_current)) {
+            // the rest of a frame larger than max_frame_bytes
+            RETURN_IF_ERROR(_decompress_frame(_type, _max_frame_bytes, _current.get()));
+            _current_pos = 0;
+            continue;
+        }
+        if (_serial_output_pos < _serial_output_len) {
+            size_t copy_size =
+                    std::min(result.size - *bytes_read, _serial_output_len - _serial_output_pos);
+            memcpy(result.data + *bytes_read, _serial_output.data() + _serial_output_pos,
+                   copy_size);
+            _serial_output_pos += copy_size;
+            *bytes_read += copy_size;
+            continue;
+        }
+        _current.reset();
+        RETURN_IF_ERROR(_fill_queue(io_ctx));
+        if (!_frames.empty()) {
+            _current = std::move(_frames.front());
+            _frames.pop_front();
+            _queued_bytes -= _current->reserved_bytes;
+            _current_pos = 0;
+            std::unique_lock lock(_current->lock);
+            _current->cv.wait(lock, [this] { return _current->done; });
+            RETURN_IF_ERROR(_current->status);
+            continue;
+        }
+        if (!_serial) {
+            break;
+        }
+        RETURN_IF_ERROR(_decompress_serially(io_ctx));
+        if (_serial_output_len == 0) {
+            break;
+        }
+    }
+    return Status::OK();
+}
+
+Status ParallelDecompressionReader::_read_input(const io::IOContext* io_ctx) {
+    if (_input_pos > 0) {
+        _input.erase(0, _input_pos);
+        _input_pos = 0;
+    }
+    size_t input_size = _input.size();
+    _input.resize(input_size + INPUT_CHUNK);
+    size_t read_len = 0;
+    Status st = _reader->read_at(_reader_offset, Slice(_input.data() + input_size, INPUT_CHUNK),
+                                 &read_len, io_ctx);
+    _input.resize(input_size + read_len);
+    RETURN_IF_ERROR(st);
+    _reader_offset += read_len;
+    _reader_eof = read_len == 0;
+    return Status::OK();
+}
+
+Status ParallelDecompressionReader::_fill_queue(const io::IOContext* io_ctx) {
+    while (!_serial) {
+        const auto* data = reinterpret_cast<const uint8_t*>(_input.data()) + _input_pos;
+        size_t size = _input.size() - _input_pos;
+        size_t frame_size = 0;
+        size_t content_size = 0;
+        bool has_data = true;
+        if (size > 0 &&
+            (!get_frame_size(_type, data, size, &frame_size, &content_size, &has_data) ||
+             frame_size > _max_frame_bytes || (frame_size == 0 && size > _max_frame_bytes))) {
+            _serial = true;
+            break;
+        }
+        if (frame_size == 0) {
+            if (_reader_eof) {
+                // a truncated frame is left to the decompressor to report
+                _serial = size > 0;
+                break;
+            }
+            RETURN_IF_ERROR(_read_input(io_ctx));
+            continue;
+        }
+        if (has_data) {
+            size_t reserved_bytes = content_size > 0 ? std::min(content_size, _max_frame_bytes)
+                                                     : _max_frame_bytes;
+            if (!_frames.empty() && _queued_bytes + reserved_bytes > _max_queue_bytes) {
+                break;
+            }
+            auto frame = std::make_shared<Frame>();
+            frame->input.assign(reinterpret_cast<const char*>(data), frame_size);
+            frame->content_size = content_size;
+            frame->reserved_bytes = reserved_bytes;
+            _queued_bytes += reserved_bytes;
+            _submit(frame);
+            _frames.push_back(std::move(frame));
+        }
+        _input_pos += frame_size;
+    }
+    return Status::OK();
+}
+
+void ParallelDecompressionReader::_submit(std::shared_ptr<Frame> frame) {
+    auto decompress = [type = _type, max_output_bytes = _max_frame_bytes](Frame* frame) {
+        Status st = _decompress_frame(type, max_output_bytes, frame);
+        std::lock_guard lock(frame->lock);
+        frame->status = std::move(st);
+        frame->done = true;
+        frame->cv.notify_all();
+    };
+    if (_pool != nullptr && _pool->submit_func([decompress, frame, resource_ctx = _resource_ctx]() {
+                                         SCOPED_ATTACH_TASK(resource_ctx);
+                                         decompress(frame.get());
+                                     })
+                                    .ok()) {
+        return;
+    }
+    decompress(frame.get());
+}
+
+Status ParallelDecompressionReader::_decompress_frame(CompressType type, size_t max_output_bytes,
+                                                      Frame* frame) {
+    if (frame->decompressor == nullptr) {
+        RETURN_IF_ERROR(Decompressor::create_decompressor(type, &frame->decompressor));
+    }
+    auto* input = reinterpret_cast<uint8_t*>(frame->input.data());
+    size_t input_size = frame->input.size();
+    size_t output_pos = 0;
+    // the content size is exact, else guess a ratio and grow up to max_output_bytes
+    size_t output_size = frame->content_size > 0
+                                 ? frame->content_size
+                                 : std::max((input_size - frame->input_pos) * 4, MIN_OUTPUT_SIZE);
+    frame->output.resize(std::min(output_size, max_output_bytes));
+    while (!_frame_finished(*frame)) {
+        if (output_pos == frame->output.size()) {
+            if (output_pos >= max_output_bytes) {
+                // the rest is decompressed once this piece is read
+                break;
+            }
+            frame->output.resize(std::min(frame->output.size() * 2, max_output_bytes));
+        }
+        size_t input_read = 0;
+        size_t decompressed_len = 0;
+        size_t more_input_bytes = 0;
+        size_t more_output_bytes = 0;
+        RETURN_IF_ERROR(frame->decompressor->decompress(
+                input + frame->input_pos, input_size - frame->input_pos, &input_read,
+                reinterpret_cast<uint8_t*>(frame->output.data()) + output_pos,
+                frame->output.size() - output_pos, &decompressed_len, &frame->stream_end,
+                &more_input_bytes, &more_output_bytes));
+        frame->input_pos += input_read;
+        output_pos += decompressed_len;
+        if (more_output_bytes > 0) {
+            // a block is decompressed at once, even if it is larger than max_output_bytes
+            frame->output.resize(std::max(frame->output.size() * 2, output_pos + more_output_bytes));
+            continue;
+        }
+        if (input_read == 0 && decompressed_len == 0) {
+            return Status::InternalError("failed to decompress a frame of {} bytes, {}",
+                                         input_size, frame->decompressor->debug_info());
+        }
+    }
+    frame->output.resize(output_pos);
+    if (_frame_finished(*frame)) {
+        frame->decompressor.reset();
+        std::string().swap(frame->input);
+        frame->input_pos = 0;
+    }
+    return Status::OK();
+}
+
+Status ParallelDecompressionReader::_decompress_serially(const io::IOContext* io_ctx) {
+    if (_serial_decompressor == nullptr) {
+        RETURN_IF_ERROR(Decompressor::create_decompressor(_type, &_serial_decompressor));
+        _serial_output.resize(INPUT_CHUNK);
+    }
+    _serial_output_len = 0;
+    _serial_output_pos = 0;
+    while (true) {
+        size_t size = _input.size() - _input_pos;
+        if (size < INPUT_CHUNK && !_reader_eof) {
+            RETURN_IF_ERROR(_read_input(io_ctx));
+            continue;
+        }
+        if (size == 0 && _serial_stream_end) {
+            return Status::OK();
+        }
+        size_t input_read = 0;
+        size_t decompressed_len = 0;
+        size_t more_input_bytes = 0;
+        size_t more_output_bytes = 0;
+        bool stream_end = false;
+        RETURN_IF_ERROR(_serial_decompressor->decompress(
+                reinterpret_cast<uint8_t*>(_input.data()) + _input_pos, size, &input_read,
+                reinterpret_cast<uint8_t*>(_serial_output.data()), _serial_output.size(),
+                &decompressed_len, &stream_end, &more_input_bytes, &more_output_bytes));
+        _input_pos += input_read;
+        if (input_read > 0 || decompressed_len > 0) {
+            _serial_stream_end = stream_end;
+        }
+        if (decompressed_len > 0) {
+            _serial_output_len = decompressed_len;
+            return Status::OK();
+        }
+        if (more_output_bytes > 0) {
+            _serial_output.resize(std::max(_serial_output.size() * 2, more_output_bytes));
+            continue;
+        }
+        if (input_read == 0) {
+            if (!_reader_eof) {
+                // a block larger than the buffered input
+                RETURN_IF_ERROR(_read_input(io_ctx));
+                continue;
+            }
+            // all the input is buffered, no progress means the file is truncated
+            return Status::InternalError("failed to decompress the rest of {}, {}",
+                                         _reader->path().native(),
+                                         _serial_decompressor->debug_info());
+        }
+    }
+}
+
+#include "common/compile_check_end.h"
+} // namespace doris
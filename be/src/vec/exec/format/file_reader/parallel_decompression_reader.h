@@ -0,0 +1,151 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "common/status.h"
+#include "exec/decompressor.h"
+#include "io/fs/file_reader.h"
+#include "io/fs/path.h"
+#include "util/slice.h"
+
+namespace doris {
+#include "common/compile_check_begin.h"
+class ResourceContext;
+class ThreadPool;
+
+namespace io {
+struct IOContext;
+} // namespace io
+
+// A file reader which returns the decompressed content of a compressed file.
+//
+// The compressed file is read sequentially and split into its independently decodable
+// frames: the frames of zstd and lz4 frame files and the members of bgzf files. Each frame
+// is decompressed on the thread pool as soon as it is read, and the frames are returned in
+// order. The frames ahead of the caller hold at most about max_queue_bytes decompressed bytes:
+// each of them reserves its content size if the frame header has it, else max_frame_bytes.
+//
+// A worker decompresses at most max_frame_bytes of a frame. The rest of a larger frame is
+// decompressed by the reading thread a piece at a time, once the first piece is read.
+//
+// Once a frame can not be split, e.g. the member of a plain gzip file whose compressed size
+// is unknown until it is decompressed, or its compressed size is larger than max_frame_bytes,
+// the rest of the file is decompressed serially by the reading thread, as without this reader.
+//
+// The offset of read_at is ignored, the reader must be read from the beginning to the end.
+class ParallelDecompressionReader final : public io::FileReader {
+public:
+    ParallelDecompressionReader(io::FileReaderSPtr reader, CompressType type, ThreadPool* pool,
+                                size_t max_frame_bytes, size_t max_queue_bytes);
+    ~ParallelDecompressionReader() override;
+
+    // Whether the frames of a file compressed by type can be split.
+    static bool support(CompressType type);
+
+    Status close() override;
+
+    const io::Path& path() const override { return _reader->path(); }
+
+    // the decompressed size is unknown
+    size_t size() const override { return static_cast<size_t>(-1); }
+
+    bool closed() const override { return _closed; }
+
+    // Get the compressed size of the frame at the beginning of data into *frame_size, its
+    // decompressed size into *content_size if the frame header has it, else 0, and whether
+    // the frame holds any data, e.g. skippable frames do not. *frame_size is 0 if more than
+    // size bytes are needed. Return false if the frame can not be split.
+    static bool get_frame_size(CompressType type, const uint8_t* data, size_t size,
+                               size_t* frame_size, size_t* content_size, bool* has_data);
+
+protected:
+    Status read_at_impl(size_t offset, Slice result, size_t* bytes_read,
+                        const io::IOContext* io_ctx) override;
+
+private:
+    struct Frame {
+        std::string input;
+        size_t input_pos = 0;
+        // 0 if unknown
+        size_t content_size = 0;
+        // decompressed bytes of the frame reserved in the queue
+        size_t reserved_bytes = 0;
+        // the next piece of the decompressed frame
+        std::string output;
+        // kept until the whole frame is decompressed
+        std::unique_ptr<Decompressor> decompressor;
+        bool stream_end = false;
+        Status status;
+        bool done = false;
+        std::mutex lock;
+        std::condition_variable cv;
+    };
+
+    // Read more compressed bytes from the inner reader into _input.
+    Status _read_input(const io::IOContext* io_ctx);
+    // Split the buffered input into frames and submit them until the queue is full.
+    Status _fill_queue(const io::IOContext* io_ctx);
+    // Decompress the next piece of the rest of the file into _serial_output.
+    Status _decompress_serially(const io::IOContext* io_ctx);
+    void _submit(std::shared_ptr<Frame> frame);
+    // Decompress the next piece of at most max_output_bytes of frame into frame->output.
+    static Status _decompress_frame(CompressType type, size_t max_output_bytes, Frame* frame);
+    static bool _frame_finished(const Frame& frame) {
+        return frame.stream_end && frame.input_pos == frame.input.size();
+    }
+
+    io::FileReaderSPtr _reader;
+    const CompressType _type;
+    ThreadPool* _pool = nullptr;
+    const size_t _max_frame_bytes;
+    const size_t _max_queue_bytes;
+    // the memory of the frames decompressed on the thread pool is tracked by the task of the
+    // reading thread
+    std::shared_ptr<ResourceContext> _resource_ctx;
+
+    size_t _reader_offset = 0;
+    bool _reader_eof = false;
+    std::string _input;
+    size_t _input_pos = 0;
+
+    std::deque<std::shared_ptr<Frame>> _frames;
+    size_t _queued_bytes = 0;
+    std::shared_ptr<Frame> _current;
+    size_t _current_pos = 0;
+
+    // set once a frame can not be split
+    bool _serial = false;
+    std::unique_ptr<Decompressor> _serial_decompressor;
+    std::string _serial_output;
+    size_t _serial_output_len = 0;
+    size_t _serial_output_pos = 0;
+    bool _serial_stream_end = true;
+
+    bool _closed = false;
+};
+
+#include "common/compile_check_end.h"
+} // namespace doris
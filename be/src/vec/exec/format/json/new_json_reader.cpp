@@ -47,6 +47,7 @@
 #include "io/fs/stream_load_pipe.h"
 #include "runtime/define_primitive_type.h"
 #include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
 #include "runtime/types.h"
 #include "util/slice.h"
@@ -63,6 +64,7 @@
 #include "vec/data_types/data_type_map.h"
 #include "vec/data_types/data_type_struct.h"
 #include "vec/exec/format/file_reader/new_plain_text_line_reader.h"
+#include "vec/exec/format/file_reader/parallel_decompression_reader.h"
 #include "vec/exec/scan/scanner.h"
 
 namespace doris::io {
@@ -459,6 +461,17 @@ Status NewJsonReader::_open_line_reader() {
     } else {
         _skip_first_line = false;
     }
+    if (config::enable_parallel_decompression && _decompressor != nullptr &&
+        ParallelDecompressionReader::support(_decompressor->get_type())) {
+        // the reader returns the decompressed content, which is read to the end
+        _file_reader = std::make_shared<ParallelDecompressionReader>(
+                _file_reader, _decompressor->get_type(),
+                ExecEnv::GetInstance()->decompression_thread_pool(),
+                config::parallel_decompression_max_frame_bytes,
+                config::parallel_decompression_queue_bytes);
+        _decompressor.reset();
+        size = -1;
+    }
     _line_reader = NewPlainTextLineReader::create_unique(
             _profile, _file_reader, _decompressor.get(),
             std::make_shared<PlainTextLineReaderCtx>(_line_delimiter, _line_delimiter_length,
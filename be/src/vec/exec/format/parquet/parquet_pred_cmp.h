@@ -29,6 +29,7 @@
 #include "vec/data_types/data_type_decimal.h"
 #include "vec/exec/format/format_common.h"
 #include "vec/exec/format/parquet/schema_desc.h"
+#include "vec/exec/format/parquet/vparquet_bloom_filter.h"
 
 namespace doris::vectorized {
 #include "common/compile_check_begin.h"
@@ -444,6 +445,75 @@ private:
         return predicates;
     }
 
+    template <typename T>
+    static bool _may_contain_value(const ParquetBlockSplitBloomFilter& bloom_filter, T value) {
+        return bloom_filter.find_hash(ParquetBlockSplitBloomFilter::hash(&value, sizeof(T)));
+    }
+
+    // Only equal and in predicates can be answered by bloom filter, values are hashed by
+    // their parquet plain encoding, so only the types whose plain encoding can be rebuilt
+    // exactly from the doris value are supported.
+    template <PrimitiveType primitive_type>
+    static bool _filter_by_bloom_filter(const ColumnValueRange<primitive_type>& col_val_range,
+                                        const FieldSchema* col_schema,
+                                        const ParquetBlockSplitBloomFilter& bloom_filter) {
+        if (!col_val_range.is_fixed_value_range() ||
+            col_val_range.get_fixed_value_set().empty()) {
+            return false;
+        }
+        PrimitiveType src_type = col_schema->data_type->get_primitive_type();
+        if (col_schema->is_type_compatibility) {
+            // unsigned values are widened after reading, the encoding in file differs.
+            return false;
+        }
+        if (src_type != primitive_type &&
+            !(is_string_type(src_type) && is_string_type(primitive_type))) {
+            return false;
+        }
+        tparquet::Type::type physical_type = col_schema->physical_type;
+        for (const auto& value : col_val_range.get_fixed_value_set()) {
+            bool may_contain = true;
+            if constexpr (primitive_type == TYPE_TINYINT || primitive_type == TYPE_SMALLINT ||
+                          primitive_type == TYPE_INT) {
+                if (physical_type != tparquet::Type::INT32) {
+                    return false;
+                }
+                may_contain = _may_contain_value(bloom_filter, static_cast<int32_t>(value));
+            } else if constexpr (primitive_type == TYPE_BIGINT) {
+                if (physical_type != tparquet::Type::INT64) {
+                    return false;
+                }
+                may_contain = _may_contain_value(bloom_filter, static_cast<int64_t>(value));
+            } else if constexpr (primitive_type == TYPE_FLOAT || primitive_type == TYPE_DOUBLE) {
+                using FloatType = std::conditional_t<primitive_type == TYPE_FLOAT, float, double>;
+                if (physical_type != (primitive_type == TYPE_FLOAT ? tparquet::Type::FLOAT
+                                                                   : tparquet::Type::DOUBLE) ||
+                    std::isnan(value)) {
+                    return false;
+                }
+                auto float_value = static_cast<FloatType>(value);
+                may_contain = _may_contain_value(bloom_filter, float_value);
+                // 0.0 and -0.0 are equal but have different plain encoding
+                if (!may_contain && float_value == 0) {
+                    may_contain = _may_contain_value(bloom_filter, -float_value);
+                }
+            } else if constexpr (primitive_type == TYPE_VARCHAR || primitive_type == TYPE_STRING) {
+                // CHAR values may be padded, so the encoding in file can not be rebuilt.
+                if (physical_type != tparquet::Type::BYTE_ARRAY || src_type == TYPE_CHAR) {
+                    return false;
+                }
+                may_contain = bloom_filter.find_hash(
+                        ParquetBlockSplitBloomFilter::hash(value.data, value.size));
+            } else {
+                return false;
+            }
+            if (may_contain) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     static inline bool _is_ascii(uint8_t byte) { return byte < 128; }
 
     static int _common_prefix(const std::string& encoding_min, const std::string& encoding_max) {
@@ -532,6 +602,20 @@ public:
                 col_val_range);
         return need_filter;
     }
+
+    // Return true if none of the values of an equal or in predicate can be found in
+    // the bloom filter, which means the row group can be skipped.
+    static bool filter_by_bloom_filter(const ColumnValueRangeType& col_val_range,
+                                       const FieldSchema* col_schema,
+                                       const ParquetBlockSplitBloomFilter& bloom_filter) {
+        bool need_filter = false;
+        std::visit(
+                [&](auto&& range) {
+                    need_filter = _filter_by_bloom_filter(range, col_schema, bloom_filter);
+                },
+                col_val_range);
+        return need_filter;
+    }
 };
 #include "common/compile_check_end.h"
 
@@ -0,0 +1,145 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vparquet_bloom_filter.h"
+
+#include <gen_cpp/parquet_types.h>
+#include <xxhash.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "io/fs/file_reader.h"
+#include "util/coding.h"
+#include "util/slice.h"
+#include "util/thrift_util.h"
+
+namespace doris::vectorized {
+#include "common/compile_check_begin.h"
+
+namespace {
+// Salt values used to derive the bit to set in each 32-bit word of a block.
+constexpr uint32_t SALT[ParquetBlockSplitBloomFilter::BITS_SET_PER_BLOCK] = {
+        0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+        0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+// The header is a small thrift struct, read it together with the head of the bitset
+// so that a tiny filter needs only one IO.
+constexpr size_t HEADER_PROBE_SIZE = 256;
+} // namespace
+
+Status ParquetBlockSplitBloomFilter::read(const io::FileReaderSPtr& file_reader,
+                                          const tparquet::ColumnMetaData& meta,
+                                          io::IOContext* io_ctx, bool* has_filter,
+                                          int64_t* read_bytes) {
+    *has_filter = false;
+    if (!meta.__isset.bloom_filter_offset) {
+        return Status::OK();
+    }
+    size_t file_size = file_reader->size();
+    if (meta.bloom_filter_offset < 0 ||
+        static_cast<size_t>(meta.bloom_filter_offset) >= file_size) {
+        return Status::Corruption("Invalid bloom filter offset {} in parquet file {}",
+                                  meta.bloom_filter_offset, file_reader->path().native());
+    }
+    auto offset = static_cast<size_t>(meta.bloom_filter_offset);
+    size_t probe_size = std::min(HEADER_PROBE_SIZE, file_size - offset);
+    std::unique_ptr<uint8_t[]> probe(new uint8_t[probe_size]);
+    size_t bytes_read = 0;
+    RETURN_IF_ERROR(file_reader->read_at(offset, Slice(probe.get(), probe_size), &bytes_read,
+                                         io_ctx));
+    *read_bytes += bytes_read;
+
+    tparquet::BloomFilterHeader header;
+    auto header_size = static_cast<uint32_t>(bytes_read);
+    RETURN_IF_ERROR(deserialize_thrift_msg(probe.get(), &header_size, true, &header));
+    if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+        !header.compression.__isset.UNCOMPRESSED) {
+        return Status::OK();
+    }
+    if (header.numBytes <= 0 || static_cast<uint32_t>(header.numBytes) > MAXIMUM_BYTES ||
+        static_cast<size_t>(header.numBytes) + header_size > file_size - offset) {
+        return Status::Corruption("Invalid bloom filter size {} in parquet file {}",
+                                  header.numBytes, file_reader->path().native());
+    }
+
+    auto num_bytes = static_cast<uint32_t>(header.numBytes);
+    std::unique_ptr<uint8_t[]> bitset(new uint8_t[num_bytes]);
+    size_t cached_bytes = std::min<size_t>(bytes_read - header_size, num_bytes);
+    memcpy(bitset.get(), probe.get() + header_size, cached_bytes);
+    if (cached_bytes < num_bytes) {
+        size_t rest = num_bytes - cached_bytes;
+        RETURN_IF_ERROR(file_reader->read_at(offset + header_size + cached_bytes,
+                                             Slice(bitset.get() + cached_bytes, rest),
+                                             &bytes_read, io_ctx));
+        if (bytes_read != rest) {
+            return Status::Corruption("Failed to read bloom filter of parquet file {}",
+                                      file_reader->path().native());
+        }
+        *read_bytes += bytes_read;
+    }
+    RETURN_IF_ERROR(init(std::move(bitset), num_bytes));
+    *has_filter = true;
+    return Status::OK();
+}
+
+Status ParquetBlockSplitBloomFilter::init(std::unique_ptr<uint8_t[]> bitset, uint32_t num_bytes) {
+    if (num_bytes < MINIMUM_BYTES || num_bytes > MAXIMUM_BYTES ||
+        (num_bytes & (num_bytes - 1)) != 0) {
+        return Status::Corruption("Invalid parquet bloom filter size {}", num_bytes);
+    }
+    _bitset = std::move(bitset);
+    _num_bytes = num_bytes;
+    return Status::OK();
+}
+
+bool ParquetBlockSplitBloomFilter::find_hash(uint64_t hash) const {
+    DCHECK(_bitset != nullptr);
+    const uint8_t* block = _bitset.get() + _block_offset(hash);
+    const auto key = static_cast<uint32_t>(hash);
+    for (uint32_t i = 0; i < BITS_SET_PER_BLOCK; ++i) {
+        uint32_t word = decode_fixed32_le(block + i * sizeof(uint32_t));
+        uint32_t mask = 1U << ((key * SALT[i]) >> 27);
+        if ((word & mask) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ParquetBlockSplitBloomFilter::insert_hash(uint64_t hash) {
+    DCHECK(_bitset != nullptr);
+    uint8_t* block = _bitset.get() + _block_offset(hash);
+    const auto key = static_cast<uint32_t>(hash);
+    for (uint32_t i = 0; i < BITS_SET_PER_BLOCK; ++i) {
+        uint8_t* word_ptr = block + i * sizeof(uint32_t);
+        uint32_t mask = 1U << ((key * SALT[i]) >> 27);
+        encode_fixed32_le(word_ptr, decode_fixed32_le(word_ptr) | mask);
+    }
+}
+
+uint64_t ParquetBlockSplitBloomFilter::_block_offset(uint64_t hash) const {
+    const uint64_t num_blocks = _num_bytes / BYTES_PER_BLOCK;
+    return (((hash >> 32) * num_blocks) >> 32) * BYTES_PER_BLOCK;
+}
+
+uint64_t ParquetBlockSplitBloomFilter::hash(const void* data, size_t len) {
+    return XXH64(data, len, 0);
+}
+
+#include "common/compile_check_end.h"
+} // namespace doris::vectorized
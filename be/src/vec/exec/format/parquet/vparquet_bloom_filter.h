@@ -0,0 +1,83 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "common/status.h"
+#include "io/fs/file_reader_writer_fwd.h"
+
+namespace doris {
+namespace io {
+struct IOContext;
+} // namespace io
+} // namespace doris
+namespace tparquet {
+class ColumnMetaData;
+} // namespace tparquet
+
+namespace doris::vectorized {
+#include "common/compile_check_begin.h"
+
+// Split block bloom filter defined by the parquet format spec:
+// https://github.com/apache/parquet-format/blob/master/BloomFilter.md
+// The bitset is divided into 256-bit blocks, a value hashed by XXH64 (seed 0) over its
+// plain encoding selects one block by the upper 32 bits and sets one bit per 32-bit word
+// of that block by the lower 32 bits.
+class ParquetBlockSplitBloomFilter {
+public:
+    static constexpr uint32_t BYTES_PER_BLOCK = 32;
+    static constexpr uint32_t BITS_SET_PER_BLOCK = 8;
+    static constexpr uint32_t MINIMUM_BYTES = BYTES_PER_BLOCK;
+    static constexpr uint32_t MAXIMUM_BYTES = 128 * 1024 * 1024;
+
+    ParquetBlockSplitBloomFilter() = default;
+    ~ParquetBlockSplitBloomFilter() = default;
+
+    // Read the bloom filter header and bitset of the column chunk through `file_reader`,
+    // so that remote files are served by the file cache when it is enabled.
+    // `*has_filter` is false if the column chunk has no bloom filter or the filter
+    // uses an algorithm/hash/compression that is not supported.
+    Status read(const io::FileReaderSPtr& file_reader, const tparquet::ColumnMetaData& meta,
+                io::IOContext* io_ctx, bool* has_filter, int64_t* read_bytes);
+
+    // Take the ownership of a raw bitset, `num_bytes` must be a power of 2 in
+    // [MINIMUM_BYTES, MAXIMUM_BYTES].
+    Status init(std::unique_ptr<uint8_t[]> bitset, uint32_t num_bytes);
+
+    bool find_hash(uint64_t hash) const;
+
+    // Only used to build filters in tests, the reader never writes bloom filters.
+    void insert_hash(uint64_t hash);
+
+    uint32_t num_bytes() const { return _num_bytes; }
+
+    static uint64_t hash(const void* data, size_t len);
+
+private:
+    uint64_t _block_offset(uint64_t hash) const;
+
+    std::unique_ptr<uint8_t[]> _bitset;
+    uint32_t _num_bytes = 0;
+};
+
+#include "common/compile_check_end.h"
+} // namespace doris::vectorized
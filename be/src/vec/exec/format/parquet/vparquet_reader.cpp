@@ -26,6 +26,7 @@
 #include <functional>
 #include <utility>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "exec/schema_scanner.h"
 #include "io/file_factory.h"
@@ -47,6 +48,7 @@
 #include "vec/core/types.h"
 #include "vec/exec/format/parquet/parquet_common.h"
 #include "vec/exec/format/parquet/schema_desc.h"
+#include "vec/exec/format/parquet/vparquet_bloom_filter.h"
 #include "vec/exec/format/parquet/vparquet_file_metadata.h"
 #include "vec/exec/format/parquet/vparquet_group_reader.h"
 #include "vec/exec/format/parquet/vparquet_page_index.h"
@@ -190,6 +192,12 @@ void ParquetReader::_init_profile() {
                 ADD_CHILD_TIMER_WITH_LEVEL(_profile, "PredicateFilterTime", parquet_profile, 1);
         _parquet_profile.dict_filter_rewrite_time =
                 ADD_CHILD_TIMER_WITH_LEVEL(_profile, "DictFilterRewriteTime", parquet_profile, 1);
+        _parquet_profile.filtered_row_groups_by_bloom_filter = ADD_CHILD_COUNTER_WITH_LEVEL(
+                _profile, "FilteredGroupsByBloomFilter", TUnit::UNIT, parquet_profile, 1);
+        _parquet_profile.read_bloom_filter_time =
+                ADD_CHILD_TIMER_WITH_LEVEL(_profile, "BloomFilterReadTime", parquet_profile, 1);
+        _parquet_profile.read_bloom_filter_bytes = ADD_CHILD_COUNTER_WITH_LEVEL(
+                _profile, "BloomFilterReadBytes", TUnit::BYTES, parquet_profile, 1);
     }
 }
 
@@ -908,8 +916,7 @@ Status ParquetReader::_process_row_group_filter(
         RETURN_IF_ERROR(_process_column_stat_filter(row_group.columns, filter_group));
         _init_chunk_dicts();
         RETURN_IF_ERROR(_process_dict_filter(filter_group));
-        _init_bloom_filter();
-        RETURN_IF_ERROR(_process_bloom_filter(filter_group));
+        RETURN_IF_ERROR(_process_bloom_filter(row_group, filter_group));
     }
     return Status::OK();
 }
@@ -1009,9 +1016,65 @@ Status ParquetReader::_process_dict_filter(bool* filter_group) {
     return Status::OK();
 }
 
-void ParquetReader::_init_bloom_filter() {}
+Status ParquetReader::_process_bloom_filter(const tparquet::RowGroup& row_group,
+                                            bool* filter_group) {
+    if (*filter_group || !config::enable_parquet_bloom_filter ||
+        _colname_to_value_range == nullptr || _colname_to_value_range->empty()) {
+        return Status::OK();
+    }
+    SCOPED_RAW_TIMER(&_statistics.read_bloom_filter_time);
+    auto& schema_desc = _file_metadata->schema();
+    for (auto& table_col_name : _read_table_columns) {
+        if (!_table_info_node_ptr->children_column_exists(table_col_name)) {
+            continue;
+        }
+        auto slot_iter = _colname_to_value_range->find(table_col_name);
+        if (slot_iter == _colname_to_value_range->end()) {
+            continue;
+        }
+        // Only equal and in predicates(including in runtime filters which have been
+        // normalized into fixed value ranges) can use bloom filter.
+        bool is_fixed_value_range = std::visit(
+                [](auto&& range) {
+                    return range.is_fixed_value_range() && !range.get_fixed_value_set().empty();
+                },
+                slot_iter->second);
+        if (!is_fixed_value_range) {
+            continue;
+        }
 
-Status ParquetReader::_process_bloom_filter(bool* filter_group) {
+        auto file_col_name = _table_info_node_ptr->children_file_column_name(table_col_name);
+        const FieldSchema* col_schema = schema_desc.get_column(file_col_name);
+        int parquet_col_id = col_schema->physical_column_index;
+        if (parquet_col_id < 0) {
+            // complex type, not support filter yet.
+            continue;
+        }
+        const auto& meta_data = row_group.columns[parquet_col_id].meta_data;
+        if (!meta_data.__isset.bloom_filter_offset) {
+            continue;
+        }
+
+        ParquetBlockSplitBloomFilter bloom_filter;
+        bool has_filter = false;
+        Status st = bloom_filter.read(_file_reader, meta_data, _io_ctx, &has_filter,
+                                      &_statistics.read_bloom_filter_bytes);
+        if (!st.ok()) {
+            // bloom filter is only an optimization, a broken filter should not fail the query
+            LOG(WARNING) << "failed to read parquet bloom filter of column " << file_col_name
+                         << " in file " << _scan_range.path << ": " << st;
+            continue;
+        }
+        if (!has_filter) {
+            continue;
+        }
+        if (ParquetPredicate::filter_by_bloom_filter(slot_iter->second, col_schema,
+                                                     bloom_filter)) {
+            *filter_group = true;
+            _statistics.filtered_row_groups_by_bloom_filter++;
+            break;
+        }
+    }
     return Status::OK();
 }
 
@@ -1050,6 +1113,10 @@ void ParquetReader::_collect_profile() {
                    _column_statistics.parse_page_header_num);
     COUNTER_UPDATE(_parquet_profile.predicate_filter_time, _statistics.predicate_filter_time);
     COUNTER_UPDATE(_parquet_profile.dict_filter_rewrite_time, _statistics.dict_filter_rewrite_time);
+    COUNTER_UPDATE(_parquet_profile.filtered_row_groups_by_bloom_filter,
+                   _statistics.filtered_row_groups_by_bloom_filter);
+    COUNTER_UPDATE(_parquet_profile.read_bloom_filter_time, _statistics.read_bloom_filter_time);
+    COUNTER_UPDATE(_parquet_profile.read_bloom_filter_bytes, _statistics.read_bloom_filter_bytes);
     COUNTER_UPDATE(_parquet_profile.file_read_time, _column_statistics.read_time);
     COUNTER_UPDATE(_parquet_profile.file_read_calls, _column_statistics.read_calls);
     COUNTER_UPDATE(_parquet_profile.file_meta_read_calls, _column_statistics.meta_read_calls);
@@ -93,6 +93,9 @@ public:
         int64_t parse_page_index_time = 0;
         int64_t predicate_filter_time = 0;
         int64_t dict_filter_rewrite_time = 0;
+        int32_t filtered_row_groups_by_bloom_filter = 0;
+        int64_t read_bloom_filter_time = 0;
+        int64_t read_bloom_filter_bytes = 0;
     };
 
     ParquetReader(RuntimeProfile* profile, const TFileScanRangeParams& params,
@@ -195,6 +198,9 @@ private:
         RuntimeProfile::Counter* parse_page_header_num = nullptr;
         RuntimeProfile::Counter* predicate_filter_time = nullptr;
         RuntimeProfile::Counter* dict_filter_rewrite_time = nullptr;
+        RuntimeProfile::Counter* filtered_row_groups_by_bloom_filter = nullptr;
+        RuntimeProfile::Counter* read_bloom_filter_time = nullptr;
+        RuntimeProfile::Counter* read_bloom_filter_bytes = nullptr;
     };
 
     Status _open_file();
@@ -221,8 +227,7 @@ private:
                                      const tparquet::RowGroup& row_group, bool* filter_group);
     void _init_chunk_dicts();
     Status _process_dict_filter(bool* filter_group);
-    void _init_bloom_filter();
-    Status _process_bloom_filter(bool* filter_group);
+    Status _process_bloom_filter(const tparquet::RowGroup& row_group, bool* filter_group);
     int64_t _get_column_start_offset(const tparquet::ColumnMetaData& column_init_column_readers);
     std::string _meta_cache_key(const std::string& path) { return "meta_" + path; }
     std::vector<io::PrefetchRange> _generate_random_access_ranges(
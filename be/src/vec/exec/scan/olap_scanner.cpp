@@ -217,6 +217,17 @@ Status OlapScanner::init() {
                                                    local_state->_push_down_functions));
     }
 
+    if (config::is_cloud_mode() && config::enable_file_cache_selective_warm_up) {
+        // record the read columns, the selective warm-up downloads them
+        std::vector<int32_t> column_unique_ids;
+        column_unique_ids.reserve(_return_columns.size());
+        for (auto index : _return_columns) {
+            column_unique_ids.push_back(tablet_schema->column(index).unique_id());
+        }
+        ExecEnv::GetInstance()->storage_engine().to_cloud().tablet_hotspot().count_columns(
+                *tablet, column_unique_ids);
+    }
+
     // add read columns in profile
     if (_state->enable_profile()) {
         _profile->add_info_string("ReadColumns",
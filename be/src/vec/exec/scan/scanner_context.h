@@ -136,6 +136,11 @@ public:
     // Caller should make sure the pipeline task is still running when calling this function
     void update_peak_running_scanner(int num);
 
+    // Wall time consumed by the scan tasks of this context, used to decide the priority
+    // of its next scan task in the scan scheduler.
+    void update_scan_time(int64_t scan_time_ns) { _scan_time_ns += scan_time_ns; }
+    int64_t scan_time_ns() const { return _scan_time_ns; }
+
     // Get next block from blocks queue. Called by ScanNode/ScanOperator
     // Set eos to true if there is no more data to read.
     Status get_block_from_queue(RuntimeState* state, vectorized::Block* block, bool* eos, int id);
@@ -239,6 +244,7 @@ protected:
     const int _parallism_of_scan_operator;
 
     std::atomic<int64_t> _block_memory_usage = 0;
+    std::atomic<int64_t> _scan_time_ns = 0;
 
     // adaptive scan concurrency related
 
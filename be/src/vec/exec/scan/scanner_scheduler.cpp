@@ -330,6 +330,7 @@ void ScannerScheduler::_scanner_scan(std::shared_ptr<ScannerContext> ctx,
     // as soon as possible, could not update it on close.
     scanner->update_scan_cpu_timer();
     scanner->update_realtime_counters();
+    ctx->update_scan_time(max_run_time_watch.elapsed_time());
 
     if (eos) {
         scanner->mark_to_need_to_close();
@@ -17,13 +17,18 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <cstdint>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 
 #include "common/be_mock_util.h"
 #include "common/status.h"
 #include "util/threadpool.h"
+#include "util/time.h"
 
 namespace doris {
 class ExecEnv;
@@ -91,6 +96,42 @@ struct SimplifiedScanTask {
     std::shared_ptr<vectorized::ScannerContext> scanner_context = nullptr;
 };
 
+// Pending scan tasks of a SimplifiedScanScheduler, organized as a multilevel feedback queue.
+// The level of a task is decided by the scan time its scan operator has consumed so far:
+// short queries stay in the top levels and are not queued behind the many scan tasks of
+// big queries. A task waiting longer than config::scan_task_priority_aging_ms is served
+// first whatever its level, so that big queries do not starve.
+class ScanTaskQueue {
+public:
+    static constexpr int NUM_LEVELS = 5;
+
+    // The clock stamps the enqueue time of the tasks, tests inject a fake one.
+    explicit ScanTaskQueue(std::function<int64_t()> clock = MonotonicNanos)
+            : _clock(std::move(clock)) {}
+
+    // Returns an id which can be used to remove the task before it is popped.
+    uint64_t push(SimplifiedScanTask task, int level);
+    bool pop(SimplifiedScanTask* task);
+    bool remove(uint64_t id);
+    void clear();
+    size_t size();
+
+    static int level_of(int64_t scan_time_ns);
+
+private:
+    struct Entry {
+        SimplifiedScanTask task;
+        int64_t enqueue_time_ns;
+        uint64_t id;
+    };
+
+    const std::function<int64_t()> _clock;
+    std::mutex _lock;
+    std::array<std::deque<Entry>, NUM_LEVELS> _levels;
+    uint64_t _next_id = 0;
+    size_t _size = 0;
+};
+
 class SimplifiedScanScheduler {
 public:
     SimplifiedScanScheduler(std::string sched_name, std::shared_ptr<CgroupCpuCtl> cgroup_cpu_ctl,
@@ -111,6 +152,7 @@ public:
         _is_stop.store(true);
         _scan_thread_pool->shutdown();
         _scan_thread_pool->wait();
+        _pending_tasks.clear();
     }
 
     Status start(int max_thread_num, int min_thread_num, int queue_size) {
@@ -123,13 +165,12 @@ public:
         return Status::OK();
     }
 
-    Status submit_scan_task(SimplifiedScanTask scan_task) {
-        if (!_is_stop) {
-            return _scan_thread_pool->submit_func([scan_task] { scan_task.scan_func(); });
-        } else {
-            return Status::InternalError<false>("scanner pool {} is shutdown.", _sched_name);
-        }
-    }
+    Status submit_scan_task(SimplifiedScanTask scan_task);
+
+    // The level of a scan task in the pending task queue. Tasks without a scanner context, the
+    // rowid fetches of rowid_fetcher and internal_service, are point reads of a few rows and
+    // always run at level 0.
+    static int priority_level(const SimplifiedScanTask& scan_task);
 
     void reset_thread_num(int new_max_thread_num, int new_min_thread_num) {
         int cur_max_thread_num = _scan_thread_pool->max_threads();
@@ -197,7 +238,10 @@ public:
                                             std::unique_lock<std::mutex>& transfer_lock);
 
 private:
+    void _run_pending_tasks();
+
     std::unique_ptr<ThreadPool> _scan_thread_pool;
+    ScanTaskQueue _pending_tasks;
     std::atomic<bool> _is_stop;
     std::weak_ptr<CgroupCpuCtl> _cgroup_cpu_ctl;
     std::string _sched_name;
@@ -15,15 +15,139 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <algorithm>
 #include <memory>
 
+#include "common/config.h"
 #include "scanner_scheduler.h"
+#include "util/time.h"
 #include "vec/exec/scan/scanner_context.h"
 
 namespace doris::vectorized {
 class ScannerDelegate;
 class ScanTask;
 
+uint64_t ScanTaskQueue::push(SimplifiedScanTask task, int level) {
+    level = std::clamp(level, 0, NUM_LEVELS - 1);
+    std::lock_guard<std::mutex> l(_lock);
+    uint64_t id = _next_id++;
+    _levels[level].push_back({std::move(task), _clock(), id});
+    ++_size;
+    return id;
+}
+
+bool ScanTaskQueue::pop(SimplifiedScanTask* task) {
+    const int64_t aging_ns = int64_t(config::scan_task_priority_aging_ms) * 1000 * 1000;
+    std::lock_guard<std::mutex> l(_lock);
+    if (_size == 0) {
+        return false;
+    }
+    // The head of each level is the oldest task of the level, serve the oldest head
+    // which has waited too long (ties broken by arrival order), otherwise the head of
+    // the highest non-empty level.
+    int chosen = -1;
+    int aged = -1;
+    const int64_t aged_before_ns = _clock() - aging_ns;
+    for (int level = 0; level < NUM_LEVELS; ++level) {
+        if (_levels[level].empty()) {
+            continue;
+        }
+        if (chosen == -1) {
+            chosen = level;
+        }
+        const Entry& head = _levels[level].front();
+        if (head.enqueue_time_ns > aged_before_ns) {
+            continue;
+        }
+        if (aged == -1 || head.enqueue_time_ns < _levels[aged].front().enqueue_time_ns ||
+            (head.enqueue_time_ns == _levels[aged].front().enqueue_time_ns &&
+             head.id < _levels[aged].front().id)) {
+            aged = level;
+        }
+    }
+    if (aged != -1) {
+        chosen = aged;
+    }
+    DCHECK_NE(chosen, -1);
+    *task = std::move(_levels[chosen].front().task);
+    _levels[chosen].pop_front();
+    --_size;
+    return true;
+}
+
+bool ScanTaskQueue::remove(uint64_t id) {
+    std::lock_guard<std::mutex> l(_lock);
+    for (auto& level : _levels) {
+        auto it = std::find_if(level.begin(), level.end(),
+                               [id](const Entry& entry) { return entry.id == id; });
+        if (it != level.end()) {
+            level.erase(it);
+            --_size;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ScanTaskQueue::clear() {
+    std::lock_guard<std::mutex> l(_lock);
+    for (auto& level : _levels) {
+        level.clear();
+    }
+    _size = 0;
+}
+
+size_t ScanTaskQueue::size() {
+    std::lock_guard<std::mutex> l(_lock);
+    return _size;
+}
+
+int ScanTaskQueue::level_of(int64_t scan_time_ns) {
+    int64_t quantum_ns =
+            std::max<int64_t>(config::scan_task_priority_level_quantum_ms, 1) * 1000 * 1000;
+    int level = 0;
+    while (level < NUM_LEVELS - 1 && scan_time_ns >= quantum_ns) {
+        ++level;
+        quantum_ns *= 4;
+    }
+    return level;
+}
+
+Status SimplifiedScanScheduler::submit_scan_task(SimplifiedScanTask scan_task) {
+    if (_is_stop) {
+        return Status::InternalError<false>("scanner pool {} is shutdown.", _sched_name);
+    }
+    if (!config::enable_scan_task_priority_scheduling) {
+        return _scan_thread_pool->submit_func([scan_task] { scan_task.scan_func(); });
+    }
+    int level = priority_level(scan_task);
+    uint64_t id = _pending_tasks.push(std::move(scan_task), level);
+    // Every pushed task is paired with a runner in the thread pool, the runner does not
+    // necessarily run the task it is paired with, but the most prior pending one.
+    Status st = _scan_thread_pool->submit_func([this] { _run_pending_tasks(); });
+    if (!st.ok() && _pending_tasks.remove(id)) {
+        return st;
+    }
+    // Runners drain the queue, so if the task has been taken by another runner, the task
+    // left without a runner will be run once that runner finishes.
+    return Status::OK();
+}
+
+int SimplifiedScanScheduler::priority_level(const SimplifiedScanTask& scan_task) {
+    if (scan_task.scanner_context == nullptr) {
+        return 0;
+    }
+    return ScanTaskQueue::level_of(scan_task.scanner_context->scan_time_ns());
+}
+
+void SimplifiedScanScheduler::_run_pending_tasks() {
+    SimplifiedScanTask task;
+    while (!_is_stop && _pending_tasks.pop(&task)) {
+        task.scan_func();
+        task = SimplifiedScanTask();
+    }
+}
+
 Status SimplifiedScanScheduler::schedule_scan_task(std::shared_ptr<ScannerContext> scanner_ctx,
                                                    std::shared_ptr<ScanTask> current_scan_task,
                                                    std::unique_lock<std::mutex>& transfer_lock) {
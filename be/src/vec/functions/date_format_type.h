@@ -17,9 +17,15 @@
 
 #pragma once
 
+#include <cctype>
+#include <cstring>
+#include <string>
+#include <type_traits>
 #include <variant>
+#include <vector>
 
 #include "vec/common/string_ref.h"
+#include "vec/runtime/vdatetime_value.h"
 
 namespace doris::vectorized::time_format_type {
 #include "common/compile_check_begin.h"
@@ -153,5 +159,363 @@ inline FormatImplVariant string_to_impl(const std::string& format) {
         return NoneImpl {};
     }
 }
+
+// A general format string compiled once into a program of tokens, so that the format string is
+// not interpreted again for every row. Only the specifiers which are cheap to compute are
+// compiled, format strings with other specifiers (names and numbers of weekdays, weeks, days of
+// year, abbreviated month names) are still processed by to_format_string_conservative.
+class FormatProgram {
+public:
+    // Output longer than this makes to_format_string_conservative fail, keep such formats to it.
+    static constexpr size_t MAX_OUTPUT_LENGTH = 100;
+
+    bool compile(const std::string& format) {
+        _tokens.clear();
+        _literals.clear();
+        _max_length = 0;
+        _compiled = false;
+        const char* ptr = format.data();
+        const char* end = ptr + format.size();
+        while (ptr < end) {
+            if (*ptr != '%' || ptr + 1 == end) {
+                _add_literal(*ptr++);
+                continue;
+            }
+            char spec = ptr[1];
+            ptr += 2;
+            size_t length = _spec_max_length(spec);
+            if (length == 0) {
+                // unknown specifiers are output as literal
+                _add_literal(spec);
+            } else if (length == NOT_COMPILED) {
+                return false;
+            } else {
+                _tokens.push_back({spec, 0, 0});
+                _max_length += length;
+            }
+        }
+        _compiled = _max_length <= MAX_OUTPUT_LENGTH;
+        return _compiled;
+    }
+
+    bool compiled() const { return _compiled; }
+
+    size_t max_length() const { return _max_length; }
+
+    // Returns nullptr if the value can not be formatted, like to_format_string_conservative.
+    template <typename DateType>
+    char* execute(const DateType& dt, char* to) const {
+        if constexpr (std::is_same_v<DateType, VecDateTimeValue>) {
+            if (VecDateTimeValue::check_range(dt.year(), dt.month(), dt.day(), dt.hour(),
+                                              dt.minute(), dt.second(), cast_set<uint16_t>(dt.type()))) {
+                return nullptr;
+            }
+        } else {
+            if (DateType::is_invalid(dt.year(), dt.month(), dt.day(), dt.hour(), dt.minute(),
+                                     dt.second(), dt.microsecond())) {
+                return nullptr;
+            }
+        }
+        for (const auto& token : _tokens) {
+            switch (token.spec) {
+            case '\0':
+                memcpy(to, _literals.data() + token.literal_offset, token.literal_len);
+                to += token.literal_len;
+                break;
+            case 'y':
+                to = _put_two_digits(dt.year() % 100, to);
+                break;
+            case 'Y':
+                to = _put_two_digits(dt.year() / 100, to);
+                to = _put_two_digits(dt.year() % 100, to);
+                break;
+            case 'm':
+                to = _put_two_digits(dt.month(), to);
+                break;
+            case 'd':
+                to = _put_two_digits(dt.day(), to);
+                break;
+            case 'H':
+                to = _put_two_digits(dt.hour(), to);
+                break;
+            case 'h':
+            case 'I':
+                to = _put_two_digits((dt.hour() % 24 + 11) % 12 + 1, to);
+                break;
+            case 'i':
+                to = _put_two_digits(dt.minute(), to);
+                break;
+            case 's':
+            case 'S':
+                to = _put_two_digits(dt.second(), to);
+                break;
+            case 'c':
+                to = _put_number(dt.month(), to);
+                break;
+            case 'e':
+                to = _put_number(dt.day(), to);
+                break;
+            case 'k':
+                to = _put_number(dt.hour(), to);
+                break;
+            case 'l':
+                to = _put_number((dt.hour() % 24 + 11) % 12 + 1, to);
+                break;
+            case 'f': {
+                uint32_t microsecond = 0;
+                if constexpr (!std::is_same_v<DateType, VecDateTimeValue>) {
+                    microsecond = dt.microsecond();
+                }
+                to = _put_two_digits(microsecond / 10000, to);
+                to = _put_two_digits(microsecond / 100 % 100, to);
+                to = _put_two_digits(microsecond % 100, to);
+                break;
+            }
+            case 'p':
+                memcpy(to, dt.hour() % 24 >= 12 ? "PM" : "AM", 2);
+                to += 2;
+                break;
+            case 'M': {
+                if (dt.month() == 0) {
+                    return nullptr;
+                }
+                const char* name = s_month_name[dt.month()];
+                size_t len = strlen(name);
+                memcpy(to, name, len);
+                to += len;
+                break;
+            }
+            case 'T':
+                to = _put_two_digits(dt.hour() % 24, to);
+                *to++ = ':';
+                to = _put_two_digits(dt.minute(), to);
+                *to++ = ':';
+                to = _put_two_digits(dt.second(), to);
+                break;
+            case 'r':
+                to = _put_two_digits((dt.hour() + 11) % 12 + 1, to);
+                *to++ = ':';
+                to = _put_two_digits(dt.minute(), to);
+                *to++ = ':';
+                to = _put_two_digits(dt.second(), to);
+                memcpy(to, dt.hour() % 24 >= 12 ? " PM" : " AM", 3);
+                to += 3;
+                break;
+            default:
+                DCHECK(false) << "unexpected format specifier " << token.spec;
+                break;
+            }
+        }
+        return to;
+    }
+
+private:
+    static constexpr size_t NOT_COMPILED = SIZE_MAX;
+
+    struct Token {
+        // '\0' for literal
+        char spec;
+        uint16_t literal_offset;
+        uint16_t literal_len;
+    };
+
+    static size_t _spec_max_length(char spec) {
+        switch (spec) {
+        case 'y':
+        case 'm':
+        case 'd':
+        case 'H':
+        case 'h':
+        case 'I':
+        case 'i':
+        case 's':
+        case 'S':
+        case 'c':
+        case 'e':
+        case 'l':
+        case 'p':
+            return 2;
+        case 'k':
+            // hour of time values may be three digits
+            return 3;
+        case 'Y':
+            return 4;
+        case 'f':
+            return 6;
+        case 'T':
+            return 8;
+        case 'M':
+            return MAX_MONTH_NAME_LEN;
+        case 'r':
+            return 11;
+        case 'a':
+        case 'b':
+        case 'D':
+        case 'j':
+        case 'u':
+        case 'U':
+        case 'v':
+        case 'V':
+        case 'w':
+        case 'W':
+        case 'x':
+        case 'X':
+            return NOT_COMPILED;
+        default:
+            return 0;
+        }
+    }
+
+    void _add_literal(char ch) {
+        if (_tokens.empty() || _tokens.back().spec != '\0') {
+            _tokens.push_back({'\0', cast_set<uint16_t>(_literals.size()), 0});
+        }
+        _literals.push_back(ch);
+        _tokens.back().literal_len++;
+        _max_length++;
+    }
+
+    static char* _put_two_digits(uint32_t number, char* to) {
+        *to++ = cast_set<char, uint32_t, false>('0' + number / 10 % 10);
+        *to++ = cast_set<char, uint32_t, false>('0' + number % 10);
+        return to;
+    }
+
+    static char* _put_number(uint32_t number, char* to) {
+        if (number >= 100) {
+            *to++ = cast_set<char, uint32_t, false>('0' + number / 100);
+            number %= 100;
+            *to++ = cast_set<char, uint32_t, false>('0' + number / 10);
+        } else if (number >= 10) {
+            *to++ = cast_set<char, uint32_t, false>('0' + number / 10);
+        }
+        *to++ = cast_set<char, uint32_t, false>('0' + number % 10);
+        return to;
+    }
+
+    std::vector<Token> _tokens;
+    std::string _literals;
+    size_t _max_length = 0;
+    bool _compiled = false;
+};
+
+// A constant str_to_date format compiled once into a program of fixed width numeric fields and
+// literals. It only accepts the values whose fields are all exactly as wide as the specifiers
+// print them (%Y four digits, the others two) and which are consumed entirely by the format.
+// For them the result is the same as DateV2Value::from_date_format_str, everything else
+// (shorter fields, names, AM/PM, partial dates, trailing content, invalid dates) must be
+// parsed again by from_date_format_str.
+class ParseProgram {
+public:
+    // with_time is false for the date result type, from_date_format_str fails on time parts then.
+    bool compile(const char* format, size_t format_len, bool with_time) {
+        _tokens.clear();
+        _compiled = false;
+        uint32_t parts = 0;
+        const char* ptr = format;
+        const char* end = format + format_len;
+        while (ptr < end) {
+            if (isspace(*ptr)) {
+                // spaces of the format are skipped, spaces of the value before every token
+                ptr++;
+                continue;
+            }
+            if (*ptr != '%') {
+                _tokens.push_back({LITERAL, *ptr++});
+                continue;
+            }
+            if (ptr + 1 == end) {
+                return false;
+            }
+            Field field;
+            switch (ptr[1]) {
+            case 'Y':
+                field = YEAR;
+                break;
+            case 'm':
+                field = MONTH;
+                break;
+            case 'd':
+                field = DAY;
+                break;
+            case 'H':
+                field = HOUR;
+                break;
+            case 'i':
+                field = MINUTE;
+                break;
+            case 's':
+                field = SECOND;
+                break;
+            default:
+                return false;
+            }
+            if ((parts & (1U << field)) || (!with_time && field >= HOUR)) {
+                return false;
+            }
+            parts |= 1U << field;
+            _tokens.push_back({field, 0});
+            ptr += 2;
+        }
+        constexpr uint32_t DATE_PARTS = (1U << YEAR) | (1U << MONTH) | (1U << DAY);
+        _compiled = (parts & DATE_PARTS) == DATE_PARTS;
+        return _compiled;
+    }
+
+    bool compiled() const { return _compiled; }
+
+    // Returns false if the value must be parsed by from_date_format_str.
+    template <typename T>
+    bool execute(const char* val, size_t len, DateV2Value<T>& dt) const {
+        const char* val_end = val + len;
+        uint32_t fields[SECOND + 1] = {0, 0, 0, 0, 0, 0};
+        for (const auto& token : _tokens) {
+            while (val < val_end && _is_space(*val)) {
+                val++;
+            }
+            if (token.field == LITERAL) {
+                if (val == val_end || *val != token.literal) {
+                    return false;
+                }
+                val++;
+                continue;
+            }
+            int width = token.field == YEAR ? 4 : 2;
+            if (val_end - val < width) {
+                return false;
+            }
+            uint32_t number = 0;
+            for (int i = 0; i < width; ++i) {
+                if (val[i] < '0' || val[i] > '9') {
+                    return false;
+                }
+                number = number * 10 + (val[i] - '0');
+            }
+            fields[token.field] = number;
+            val += width;
+        }
+        if (val != val_end) {
+            return false;
+        }
+        return dt.check_range_and_set_time(
+                cast_set<uint16_t>(fields[YEAR]), cast_set<uint8_t>(fields[MONTH]),
+                cast_set<uint8_t>(fields[DAY]), cast_set<uint8_t>(fields[HOUR]),
+                cast_set<uint8_t>(fields[MINUTE]), cast_set<uint8_t>(fields[SECOND]), 0);
+    }
+
+private:
+    enum Field : uint8_t { YEAR, MONTH, DAY, HOUR, MINUTE, SECOND, LITERAL };
+
+    struct Token {
+        Field field;
+        char literal;
+    };
+
+    // same as the space check of from_date_format_str
+    static bool _is_space(char ch) { return ch == ' ' || (ch >= 9 && ch <= 13); }
+
+    std::vector<Token> _tokens;
+    bool _compiled = false;
+};
 #include "common/compile_check_end.h"
 } // namespace doris::vectorized::time_format_type
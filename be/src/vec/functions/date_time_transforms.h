@@ -219,6 +219,20 @@ struct MonthNameImpl {
     }
 };
 
+// Formats by a compiled format program, returns true if the result is null.
+template <typename DateType>
+bool execute_program(const DateType& dt, const time_format_type::FormatProgram& program,
+                     ColumnString::Chars& res_data, size_t& offset) {
+    // Sufficient memory for the max length of the program has already been reserved.
+    char* begin = (char*)res_data.data() + offset;
+    char* end = program.execute(dt, begin);
+    if (end == nullptr) {
+        return true;
+    }
+    offset += static_cast<size_t>(end - begin);
+    return false;
+}
+
 template <PrimitiveType PType>
 struct DateFormatImpl {
     using DateType = typename PrimitiveTypeTraits<PType>::CppType;
@@ -229,11 +243,16 @@ struct DateFormatImpl {
     static constexpr auto name = "date_format";
 
     template <typename Impl>
-    static bool execute(const FromType& t, StringRef format, ColumnString::Chars& res_data,
-                        size_t& offset, const cctz::time_zone& time_zone) {
+    static bool execute(const FromType& t, StringRef format,
+                        const time_format_type::FormatProgram& program,
+                        ColumnString::Chars& res_data, size_t& offset,
+                        const cctz::time_zone& time_zone) {
         if constexpr (std::is_same_v<Impl, time_format_type::NoneImpl>) {
             // Handle non-special formats.
             const auto& dt = (DateType&)t;
+            if (program.compiled()) {
+                return execute_program(dt, program, res_data, offset);
+            }
             char buf[100 + SAFE_FORMAT_STRING_MARGIN];
             if (!dt.to_format_string_conservative(format.data, format.size, buf,
                                                   100 + SAFE_FORMAT_STRING_MARGIN)) {
@@ -275,14 +294,19 @@ struct FromUnixTimeImpl {
     static constexpr auto name = "from_unixtime";
 
     template <typename Impl>
-    static bool execute(const FromType& val, StringRef format, ColumnString::Chars& res_data,
-                        size_t& offset, const cctz::time_zone& time_zone) {
+    static bool execute(const FromType& val, StringRef format,
+                        const time_format_type::FormatProgram& program,
+                        ColumnString::Chars& res_data, size_t& offset,
+                        const cctz::time_zone& time_zone) {
         if constexpr (std::is_same_v<Impl, time_format_type::NoneImpl>) {
             DateV2Value<DateTimeV2ValueType> dt;
             if (val < 0 || val > TIMESTAMP_VALID_MAX) {
                 return true;
             }
             dt.from_unixtime(val, time_zone);
+            if (program.compiled()) {
+                return execute_program(dt, program, res_data, offset);
+            }
 
             char buf[100 + SAFE_FORMAT_STRING_MARGIN];
             if (!dt.to_format_string_conservative(format.data, format.size, buf,
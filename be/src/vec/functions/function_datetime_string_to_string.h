@@ -19,6 +19,7 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <variant>
@@ -76,6 +77,8 @@ public:
         // Check if the format string is null or exceeds the length limit.
         bool is_valid = true;
         time_format_type::FormatImplVariant format_type;
+        // Compiled from format_str if it has no specially optimized implementation.
+        time_format_type::FormatProgram program;
     };
 
     Status open(FunctionContext* context, FunctionContext::FunctionStateScope scope) override {
@@ -118,6 +121,9 @@ public:
         // Preprocess special format strings.
         state->format_str = format_str;
         state->format_type = time_format_type::string_to_impl(state->format_str);
+        if (std::holds_alternative<time_format_type::NoneImpl>(state->format_type)) {
+            state->program.compile(state->format_str);
+        }
 
         return IFunction::open(context, scope);
     }
@@ -181,7 +187,8 @@ public:
             return Status::OK();
         }
         res_offsets.resize(len);
-        res_data.reserve(len * format.size + len);
+        const auto& program = format_state->program;
+        res_data.reserve(len * std::max(format.size, program.max_length()) + len);
         null_map.resize_fill(len, false);
 
         std::visit(
@@ -190,7 +197,8 @@ public:
                     size_t offset = 0;
                     for (int i = 0; i < len; ++i) {
                         null_map[i] = Transform::template execute<Impl>(
-                                ts[i], format, res_data, offset, context->state()->timezone_obj());
+                                ts[i], format, program, res_data, offset,
+                                context->state()->timezone_obj());
                         res_offsets[i] = cast_set<uint32_t>(offset);
                     }
                     res_data.resize(offset);
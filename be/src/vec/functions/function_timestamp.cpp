@@ -63,6 +63,7 @@
 #include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_number.h"
 #include "vec/data_types/data_type_string.h"
+#include "vec/functions/date_format_type.h"
 #include "vec/functions/function.h"
 #include "vec/functions/simple_function_factory.h"
 #include "vec/runtime/vdatetime_value.h"
@@ -213,10 +214,22 @@ private:
         size_t size = loffsets.size();
         res.resize(size);
         const StringRef format_str = rewrite_specific_format(rdata.data, rdata.size);
+        time_format_type::ParseProgram program;
+        if constexpr (!std::is_same_v<DateValueType, VecDateTimeValue>) {
+            program.compile(format_str.data, format_str.size,
+                            std::is_same_v<ArgDateType, DataTypeDateTimeV2>);
+        }
         for (size_t i = 0; i < size; ++i) {
             const char* l_raw_str = reinterpret_cast<const char*>(&ldata[loffsets[i - 1]]);
             size_t l_str_size = loffsets[i] - loffsets[i - 1];
 
+            if constexpr (!std::is_same_v<DateValueType, VecDateTimeValue>) {
+                if (program.compiled() &&
+                    program.execute(l_raw_str, l_str_size,
+                                    *reinterpret_cast<DateValueType*>(&res[i]))) {
+                    continue;
+                }
+            }
             _execute_inner_loop<DateValueType, NativeType>(l_raw_str, l_str_size, format_str.data,
                                                            format_str.size, context, res, null_map,
                                                            i);
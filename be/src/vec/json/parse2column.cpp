@@ -130,9 +130,8 @@ private:
 };
 
 template <typename ParserImpl>
-void parse_json_to_variant(IColumn& column, const char* src, size_t length,
-                           JSONDataParser<ParserImpl>* parser, const ParseConfig& config) {
-    auto& column_variant = assert_cast<ColumnVariant&>(column);
+ParseResult parse_json(const char* src, size_t length, JSONDataParser<ParserImpl>* parser,
+                       const ParseConfig& config) {
     std::optional<ParseResult> result;
     /// Treat empty string as an empty object
     /// for better CAST from String to Object.
@@ -152,8 +151,25 @@ void parse_json_to_variant(IColumn& column, const char* src, size_t length,
         Field field = Field::create_field<TYPE_STRING>(String(src, length));
         result = ParseResult {{root_path}, {field}};
     }
-    auto& [paths, values] = *result;
-    assert(paths.size() == values.size());
+    assert(result->paths.size() == result->values.size());
+    return std::move(*result);
+}
+
+static void check_subcolumn_size(const ColumnVariant::Subcolumn* subcolumn, const PathInData& path,
+                                 size_t expected_size) {
+    if (!subcolumn) {
+        throw doris::Exception(ErrorCode::INVALID_ARGUMENT, "Failed to find sub column {}",
+                               path.get_path());
+    }
+    if (subcolumn->size() != expected_size) {
+        throw doris::Exception(ErrorCode::INVALID_ARGUMENT,
+                               "subcolumn {} size missmatched, may contains duplicated entry",
+                               path.get_path());
+    }
+}
+
+static void insert_parse_result(ColumnVariant& column_variant, ParseResult& result) {
+    auto& [paths, values] = result;
     size_t old_num_rows = column_variant.size();
     for (size_t i = 0; i < paths.size(); ++i) {
         FieldInfo field_info;
@@ -169,15 +185,7 @@ void parse_json_to_variant(IColumn& column, const char* src, size_t length,
             }
         }
         auto* subcolumn = column_variant.get_subcolumn(paths[i], i);
-        if (!subcolumn) {
-            throw doris::Exception(ErrorCode::INVALID_ARGUMENT, "Failed to find sub column {}",
-                                   paths[i].get_path());
-        }
-        if (subcolumn->size() != old_num_rows) {
-            throw doris::Exception(ErrorCode::INVALID_ARGUMENT,
-                                   "subcolumn {} size missmatched, may contains duplicated entry",
-                                   paths[i].get_path());
-        }
+        check_subcolumn_size(subcolumn, paths[i], old_num_rows);
         subcolumn->insert(std::move(values[i]), std::move(field_info));
     }
     // /// Insert default values to missed subcolumns.
@@ -193,19 +201,127 @@ void parse_json_to_variant(IColumn& column, const char* src, size_t length,
     column_variant.incr_num_rows();
 }
 
+/// Inserts the rows of a batch into a ColumnVariant. Subcolumns are resolved once per
+/// path and cached across rows, and missing values are not appended row by row: a
+/// subcolumn is brought up to date with a single insert_many_defaults right before its
+/// next value is inserted, and all of them are padded to the row count in finish().
+/// Default values of Nested subcolumns depend on the array sizes of their siblings, so
+/// once a Nested path shows up the remaining rows go through insert_parse_result.
+class VariantBatchInserter {
+public:
+    explicit VariantBatchInserter(ColumnVariant& column_variant)
+            : _column(column_variant), _num_rows(column_variant.size()) {
+        for (const auto& entry : _column.get_subcolumns()) {
+            if (entry->path.has_nested_part()) {
+                _lazy_defaults = false;
+                break;
+            }
+        }
+    }
+
+    void insert(ParseResult& result) {
+        if (_lazy_defaults && std::any_of(result.paths.begin(), result.paths.end(),
+                                          [](const auto& p) { return p.has_nested_part(); })) {
+            _fill_defaults();
+            _lazy_defaults = false;
+        }
+        if (!_lazy_defaults) {
+            insert_parse_result(_column, result);
+            ++_num_rows;
+            return;
+        }
+        auto& [paths, values] = result;
+        // ColumnVariant::size() checks that every subcolumn has all the rows in debug builds,
+        // which is not the case before finish()
+        size_t old_num_rows = _num_rows;
+        for (size_t i = 0; i < paths.size(); ++i) {
+            FieldInfo field_info;
+            get_field_info(values[i], &field_info);
+            if (field_info.scalar_type_id == PrimitiveType::INVALID_TYPE) {
+                continue;
+            }
+            auto* subcolumn = _find_or_add(paths[i], i, old_num_rows);
+            if (subcolumn && subcolumn->size() < old_num_rows) {
+                subcolumn->insert_many_defaults(old_num_rows - subcolumn->size());
+            }
+            check_subcolumn_size(subcolumn, paths[i], old_num_rows);
+            subcolumn->insert(std::move(values[i]), std::move(field_info));
+        }
+        _column.incr_num_rows();
+        ++_num_rows;
+    }
+
+    void finish() {
+        if (_lazy_defaults) {
+            _fill_defaults();
+        }
+    }
+
+private:
+    ColumnVariant::Subcolumn* _find_or_add(const PathInData& path, size_t index,
+                                           size_t num_rows) {
+        // Rows of a load usually share their key order, so check the path seen at the
+        // same position in the previous row before hashing it.
+        if (index < _positions.size() && _positions[index].second != nullptr &&
+            _positions[index].first == path) {
+            return _positions[index].second;
+        }
+        ColumnVariant::Subcolumn* subcolumn = nullptr;
+        if (auto it = _paths.find(path); it != _paths.end()) {
+            subcolumn = it->second;
+        } else {
+            subcolumn = _column.get_subcolumn(path);
+            if (subcolumn == nullptr) {
+                _column.add_sub_column(path, num_rows);
+                subcolumn = _column.get_subcolumn(path);
+            }
+            if (subcolumn == nullptr) {
+                return nullptr;
+            }
+            // Subcolumns are owned by the nodes of the tree, their addresses are stable
+            // while new paths are added.
+            _paths.emplace(path, subcolumn);
+        }
+        if (index >= _positions.size()) {
+            _positions.resize(index + 1);
+        }
+        _positions[index] = std::make_pair(path, subcolumn);
+        return subcolumn;
+    }
+
+    void _fill_defaults() {
+        for (const auto& entry : _column.get_subcolumns()) {
+            if (entry->data.size() < _num_rows) {
+                entry->data.insert_many_defaults(_num_rows - entry->data.size());
+            }
+        }
+    }
+
+    ColumnVariant& _column;
+    // rows of _column, including the ones whose defaults are not inserted yet
+    size_t _num_rows;
+    bool _lazy_defaults = true;
+    std::vector<std::pair<PathInData, ColumnVariant::Subcolumn*>> _positions;
+    phmap::flat_hash_map<PathInData, ColumnVariant::Subcolumn*, PathInData::Hash> _paths;
+};
+
 // exposed interfaces
 void parse_json_to_variant(IColumn& column, const StringRef& json, JsonParser* parser,
                            const ParseConfig& config) {
-    return parse_json_to_variant(column, json.data, json.size, parser, config);
+    auto result = parse_json(json.data, json.size, parser, config);
+    insert_parse_result(assert_cast<ColumnVariant&>(column), result);
 }
 
 void parse_json_to_variant(IColumn& column, const ColumnString& raw_json_column,
                            const ParseConfig& config) {
     auto parser = parsers_pool.get([] { return new JsonParser(); });
+    VariantBatchInserter inserter(assert_cast<ColumnVariant&>(column));
     for (size_t i = 0; i < raw_json_column.size(); ++i) {
         StringRef raw_json = raw_json_column.get_data_at(i);
-        parse_json_to_variant(column, raw_json.data, raw_json.size, parser.get(), config);
+        auto result = parse_json(raw_json.data, raw_json.size, parser.get(), config);
+        inserter.insert(result);
     }
+    inserter.finish();
 }
 
 } // namespace doris::vectorized
@@ -17,6 +17,9 @@
 
 #include "viceberg_table_writer.h"
 
+#include <numeric>
+
+#include "common/cast_set.h"
 #include "runtime/runtime_state.h"
 #include "vec/core/block.h"
 #include "vec/core/column_with_type_and_name.h"
@@ -118,7 +121,8 @@ Status VIcebergTableWriter::write(RuntimeState* state, vectorized::Block& block)
             _vec_output_expr_ctxs, block, &output_block, false));
     materialize_block_inplace(output_block);
 
-    std::unordered_map<std::shared_ptr<VIcebergPartitionWriter>, IColumn::Filter> writer_positions;
+    std::unordered_map<std::shared_ptr<VIcebergPartitionWriter>, IColumn::Selector>
+            writer_positions;
     _row_count += output_block.rows();
 
     if (_iceberg_partition_columns.empty()) {
@@ -170,107 +174,113 @@ Status VIcebergTableWriter::write(RuntimeState* state, vectorized::Block& block)
             transformed_block.insert(iceberg_partition_columns.partition_column_transform().apply(
                     output_block, iceberg_partition_columns.source_idx()));
         }
-        for (int i = 0; i < output_block.rows(); ++i) {
-            std::optional<PartitionData> partition_data;
-            try {
-                partition_data = _get_partition_data(&transformed_block, i);
-            } catch (doris::Exception& e) {
-                return e.to_status();
-            }
+        ++_write_block_seq;
+        std::vector<int> transformed_columns(transformed_block.columns());
+        std::iota(transformed_columns.begin(), transformed_columns.end(), 0);
+        std::vector<IColumn::Selector> partition_rows;
+        std::unordered_map<std::string, std::shared_ptr<VIcebergPartitionWriter>> block_writers;
+        VHiveUtils::group_rows_by_columns(transformed_block, transformed_columns, &partition_rows);
+        for (const auto& rows : partition_rows) {
+            int position = cast_set<int>(rows[0]);
             std::string partition_name;
             try {
-                partition_name = _partition_to_path(partition_data.value());
+                partition_name =
+                        _partition_to_path(_get_partition_data(&transformed_block, position));
             } catch (doris::Exception& e) {
                 return e.to_status();
             }
-            auto create_and_open_writer =
-                    [&](const std::string& partition_name, int position,
-                        const std::string* file_name, int file_name_index,
-                        std::shared_ptr<VIcebergPartitionWriter>& writer_ptr) -> Status {
-                try {
-                    auto writer = _create_partition_writer(&transformed_block, position, file_name,
-                                                           file_name_index);
-                    RETURN_IF_ERROR(writer->open(_state, _operator_profile));
-                    IColumn::Filter filter(output_block.rows(), 0);
-                    filter[position] = 1;
-                    writer_positions.insert({writer, std::move(filter)});
-                    _partitions_to_writers.insert({partition_name, writer});
-                    writer_ptr = writer;
-                } catch (doris::Exception& e) {
-                    return e.to_status();
-                }
-                return Status::OK();
-            };
-
-            auto writer_iter = _partitions_to_writers.find(partition_name);
-            if (writer_iter == _partitions_to_writers.end()) {
-                std::shared_ptr<VIcebergPartitionWriter> writer;
-                if (_partitions_to_writers.size() + 1 >
-                    config::table_sink_partition_write_max_partition_nums_per_writer) {
-                    return Status::InternalError(
-                            "Too many open partitions {}",
-                            config::table_sink_partition_write_max_partition_nums_per_writer);
-                }
-                RETURN_IF_ERROR(create_and_open_writer(partition_name, i, nullptr, 0, writer));
-            } else {
-                std::shared_ptr<VIcebergPartitionWriter> writer;
-                if (writer_iter->second->written_len() > config::iceberg_sink_max_file_size) {
-                    std::string file_name(writer_iter->second->file_name());
-                    int file_name_index = writer_iter->second->file_name_index();
-                    {
-                        SCOPED_RAW_TIMER(&_close_ns);
-                        static_cast<void>(writer_iter->second->close(Status::OK()));
-                    }
-                    writer_positions.erase(writer_iter->second);
-                    _partitions_to_writers.erase(writer_iter);
-                    RETURN_IF_ERROR(create_and_open_writer(partition_name, i, &file_name,
-                                                           file_name_index + 1, writer));
-                } else {
-                    writer = writer_iter->second;
-                }
-                auto writer_pos_iter = writer_positions.find(writer);
-                if (writer_pos_iter == writer_positions.end()) {
-                    IColumn::Filter filter(output_block.rows(), 0);
-                    filter[i] = 1;
-                    writer_positions.insert({writer, std::move(filter)});
-                } else {
-                    writer_pos_iter->second[i] = 1;
-                }
+            // Several groups may get the same partition name, the writer is looked up once per
+            // block so that a file rolled over by a later group is never one of writer_positions.
+            auto& writer = block_writers[partition_name];
+            if (writer == nullptr) {
+                RETURN_IF_ERROR(_get_partition_writer(&transformed_block, partition_name, position,
+                                                      &writer));
             }
+            auto& selector = writer_positions[writer];
+            selector.insert(rows.begin(), rows.end());
         }
     }
     SCOPED_RAW_TIMER(&_partition_writers_write_ns);
     output_block.erase(_non_write_columns_indices);
-    for (auto it = writer_positions.begin(); it != writer_positions.end(); ++it) {
-        Block filtered_block;
-        RETURN_IF_ERROR(_filter_block(output_block, &it->second, &filtered_block));
-        RETURN_IF_ERROR(it->first->write(filtered_block));
+    for (const auto& [writer, selector] : writer_positions) {
+        auto mutable_block = MutableBlock::create_unique(output_block.clone_empty());
+        RETURN_IF_ERROR(output_block.append_to_block_by_selector(mutable_block.get(), selector));
+        Block partition_block = mutable_block->to_block();
+        RETURN_IF_ERROR(writer->write(partition_block));
     }
     return Status::OK();
 }
 
-Status VIcebergTableWriter::_filter_block(doris::vectorized::Block& block,
-                                          const vectorized::IColumn::Filter* filter,
-                                          doris::vectorized::Block* output_block) {
-    const ColumnsWithTypeAndName& columns_with_type_and_name =
-            block.get_columns_with_type_and_name();
-    vectorized::ColumnsWithTypeAndName result_columns;
-    for (int i = 0; i < columns_with_type_and_name.size(); ++i) {
-        const auto& col = columns_with_type_and_name[i];
-        result_columns.emplace_back(col.column->clone_resized(col.column->size()), col.type,
-                                    col.name);
+Status VIcebergTableWriter::_get_partition_writer(
+        vectorized::Block* transformed_block, const std::string& partition_name, int position,
+        std::shared_ptr<VIcebergPartitionWriter>* writer) {
+    auto create_and_open_writer = [&](const std::string* file_name,
+                                      int file_name_index) -> Status {
+        try {
+            *writer = _create_partition_writer(transformed_block, position, file_name,
+                                               file_name_index);
+        } catch (doris::Exception& e) {
+            return e.to_status();
+        }
+        RETURN_IF_ERROR((*writer)->open(_state, _operator_profile));
+        _partitions_to_writers.insert({partition_name, *writer});
+        return Status::OK();
+    };
+
+    auto writer_iter = _partitions_to_writers.find(partition_name);
+    if (writer_iter == _partitions_to_writers.end()) {
+        if (_partitions_to_writers.size() + 1 >
+            config::table_sink_partition_write_max_partition_nums_per_writer) {
+            bool closed = false;
+            if (config::enable_table_sink_close_cold_partition_writers) {
+                RETURN_IF_ERROR(_close_cold_partition_writer(&closed));
+            }
+            if (!closed) {
+                return Status::InternalError(
+                        "Too many open partitions {}",
+                        config::table_sink_partition_write_max_partition_nums_per_writer);
+            }
+        }
+        RETURN_IF_ERROR(create_and_open_writer(nullptr, 0));
+    } else if (writer_iter->second->written_len() > config::iceberg_sink_max_file_size) {
+        std::string file_name(writer_iter->second->file_name());
+        int file_name_index = writer_iter->second->file_name_index();
+        {
+            SCOPED_RAW_TIMER(&_close_ns);
+            static_cast<void>(writer_iter->second->close(Status::OK()));
+        }
+        _partitions_to_writers.erase(writer_iter);
+        RETURN_IF_ERROR(create_and_open_writer(&file_name, file_name_index + 1));
+    } else {
+        *writer = writer_iter->second;
     }
-    *output_block = {std::move(result_columns)};
+    _partition_last_write_seqs[partition_name] = _write_block_seq;
+    return Status::OK();
+}
 
-    std::vector<uint32_t> columns_to_filter;
-    int column_to_keep = output_block->columns();
-    columns_to_filter.resize(column_to_keep);
-    for (uint32_t i = 0; i < column_to_keep; ++i) {
-        columns_to_filter[i] = i;
+Status VIcebergTableWriter::_close_cold_partition_writer(bool* closed) {
+    // the writers of the partitions in the current block are never closed
+    auto coldest = _partitions_to_writers.end();
+    int64_t coldest_seq = _write_block_seq;
+    for (auto it = _partitions_to_writers.begin(); it != _partitions_to_writers.end(); ++it) {
+        int64_t seq = _partition_last_write_seqs[it->first];
+        if (seq < coldest_seq) {
+            coldest = it;
+            coldest_seq = seq;
+        }
     }
-
-    Block::filter_block_internal(output_block, columns_to_filter, *filter);
-    return Status::OK();
+    *closed = coldest != _partitions_to_writers.end();
+    if (!*closed) {
+        return Status::OK();
+    }
+    Status st;
+    {
+        SCOPED_RAW_TIMER(&_close_ns);
+        st = coldest->second->close(Status::OK());
+    }
+    _partition_last_write_seqs.erase(coldest->first);
+    _partitions_to_writers.erase(coldest);
+    return st;
 }
 
 Status VIcebergTableWriter::close(Status status) {
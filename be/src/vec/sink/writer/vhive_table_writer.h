@@ -64,8 +64,14 @@ private:
 
     std::string _compute_file_name();
 
-    Status _filter_block(doris::vectorized::Block& block, const vectorized::IColumn::Filter* filter,
-                         doris::vectorized::Block* output_block);
+    // Get the writer of the partition, creating it or rolling it over to a new file if needed.
+    // The row at position of block is one of the rows of the partition.
+    Status _get_partition_writer(vectorized::Block& block, const std::string& partition_name,
+                                 int position, std::shared_ptr<VHivePartitionWriter>* writer);
+
+    // Close the writer of the least recently written partition, closed is false if all the
+    // writers are written by the current block.
+    Status _close_cold_partition_writer(bool* closed);
 
     // Currently it is a copy, maybe it is better to use move semantics to eliminate it.
     TDataSink _t_sink;
@@ -73,6 +79,9 @@ private:
     std::vector<int> _partition_columns_input_index;
     std::set<size_t> _non_write_columns_indices;
     std::unordered_map<std::string, std::shared_ptr<VHivePartitionWriter>> _partitions_to_writers;
+    // the sequence number of the block which last wrote each partition
+    std::unordered_map<std::string, int64_t> _partition_last_write_seqs;
+    int64_t _write_block_seq = 0;
 
     VExprContextSPtrs _write_output_vexpr_ctxs;
 
@@ -20,6 +20,9 @@
 #include <algorithm>
 #include <regex>
 #include <sstream>
+#include <unordered_map>
+
+#include "vec/core/block.h"
 
 namespace doris {
 namespace vectorized {
@@ -74,5 +77,52 @@ std::string VHiveUtils::escape_path_name(const std::string& path) {
     }
     return ss.str();
 }
+
+void VHiveUtils::group_rows_by_columns(const Block& block, const std::vector<int>& column_indices,
+                                       std::vector<IColumn::Selector>* groups) {
+    groups->clear();
+    size_t rows = block.rows();
+    if (rows == 0) {
+        return;
+    }
+    std::vector<ColumnPtr> columns;
+    columns.reserve(column_indices.size());
+    for (int idx : column_indices) {
+        columns.emplace_back(block.get_by_position(idx).column->convert_to_full_column_if_const());
+    }
+    std::vector<uint64_t> hashes(rows, 0);
+    for (const auto& column : columns) {
+        column->update_hashes_with_value(hashes.data());
+    }
+    auto rows_equal = [&](size_t lhs, size_t rhs) {
+        for (const auto& column : columns) {
+            if (column->compare_at(lhs, rhs, *column, 1) != 0) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<size_t> first_rows;
+    std::unordered_map<uint64_t, std::vector<size_t>> hash_to_groups;
+    size_t group = 0;
+    for (size_t row = 0; row < rows; ++row) {
+        // the rows of a partition often come together
+        if (row == 0 || hashes[row] != hashes[row - 1] || !rows_equal(row, row - 1)) {
+            auto& candidates = hash_to_groups[hashes[row]];
+            auto it = std::find_if(candidates.begin(), candidates.end(),
+                                   [&](size_t g) { return rows_equal(row, first_rows[g]); });
+            if (it == candidates.end()) {
+                group = groups->size();
+                candidates.push_back(group);
+                first_rows.push_back(row);
+                groups->emplace_back();
+            } else {
+                group = *it;
+            }
+        }
+        (*groups)[group].push_back(row);
+    }
+}
 } // namespace vectorized
-} // namespace doris
\ No newline at end of file
+} // namespace doris
@@ -26,9 +26,13 @@
 #include <string>
 #include <vector>
 
+#include "vec/columns/column.h"
+
 namespace doris {
 namespace vectorized {
 
+class Block;
+
 class VHiveUtils {
 private:
     VHiveUtils();
@@ -41,6 +45,13 @@ public:
                                            const std::vector<std::string>& values);
 
     static std::string escape_path_name(const std::string& path);
+
+    // Group the rows of block by the values of the columns at column_indices. The rows are
+    // hashed column by column and compared only within a hash, so the cost is linear in the
+    // rows whatever the number of groups. The row indices of each group are returned in groups,
+    // and the groups are in the order of their first rows.
+    static void group_rows_by_columns(const Block& block, const std::vector<int>& column_indices,
+                                      std::vector<IColumn::Selector>* groups);
 };
 } // namespace vectorized
 } // namespace doris
@@ -0,0 +1,181 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "cloud/cloud_warm_up_manager.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cloud/cloud_tablet_hotspot.h"
+#include "io/fs/file_reader.h"
+#include "io/fs/file_writer.h"
+#include "io/fs/local_file_system.h"
+#include "olap/row_cursor.h"
+#include "olap/rowset/segment_v2/segment_writer.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet_schema.h"
+#include "olap/tablet_schema_helper.h"
+#include "runtime/exec_env.h"
+#include "util/time.h"
+
+namespace doris {
+
+static const std::string kSegmentDir = "./ut_dir/cloud_warm_up_manager_test";
+
+class CloudWarmUpManagerTest : public testing::Test {
+public:
+    void SetUp() override {
+        auto st = io::global_local_filesystem()->delete_directory(kSegmentDir);
+        ASSERT_TRUE(st.ok()) << st;
+        st = io::global_local_filesystem()->create_directory(kSegmentDir);
+        ASSERT_TRUE(st.ok()) << st;
+        ExecEnv::GetInstance()->set_storage_engine(
+                std::make_unique<StorageEngine>(EngineOptions {}));
+    }
+
+    void TearDown() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(kSegmentDir).ok());
+        ExecEnv::GetInstance()->set_storage_engine(nullptr);
+    }
+
+    // One key column (unique id 0) and two value columns (unique ids 1 and 2) of random values,
+    // so that the data pages of every column take about 4 bytes per row.
+    io::FileReaderSPtr build_segment(size_t nrows) {
+        TabletSchemaSPtr schema = std::make_shared<TabletSchema>();
+        schema->append_column(*create_int_key(0, false));
+        schema->append_column(*create_int_value(
+                1, FieldAggregationMethod::OLAP_FIELD_AGGREGATION_NONE, false));
+        schema->append_column(*create_int_value(
+                2, FieldAggregationMethod::OLAP_FIELD_AGGREGATION_NONE, false));
+        schema->_keys_type = DUP_KEYS;
+
+        std::string path = kSegmentDir + "/0.dat";
+        auto fs = io::global_local_filesystem();
+        io::FileWriterPtr file_writer;
+        EXPECT_TRUE(fs->create_file(path, &file_writer).ok());
+        segment_v2::SegmentWriterOptions opts;
+        segment_v2::SegmentWriter writer(file_writer.get(), 0, schema, nullptr, nullptr, opts,
+                                         nullptr);
+        EXPECT_TRUE(writer.init().ok());
+
+        RowCursor row;
+        EXPECT_TRUE(row.init(schema).ok());
+        std::mt19937 rng(42);
+        for (size_t rid = 0; rid < nrows; ++rid) {
+            for (int cid = 0; cid < 3; ++cid) {
+                RowCursorCell cell = row.cell(cid);
+                cell.set_not_null();
+                *(int*)cell.mutable_cell_ptr() = cid == 0 ? static_cast<int>(rid)
+                                                          : static_cast<int>(rng());
+            }
+            EXPECT_TRUE(writer.append_row(row).ok());
+        }
+        uint64_t file_size = 0;
+        uint64_t index_size = 0;
+        EXPECT_TRUE(writer.finalize(&file_size, &index_size).ok());
+        EXPECT_TRUE(file_writer->close().ok());
+
+        io::FileReaderSPtr file_reader;
+        EXPECT_TRUE(fs->open_file(path, &file_reader).ok());
+        return file_reader;
+    }
+};
+
+static int64_t check_ranges(const std::vector<std::pair<int64_t, int64_t>>& ranges,
+                            int64_t file_size) {
+    int64_t total_size = 0;
+    int64_t last_end = -1;
+    for (const auto& [offset, size] : ranges) {
+        EXPECT_GT(size, 0);
+        // sorted and not adjacent, adjacent ranges are merged
+        EXPECT_GT(offset, last_end);
+        last_end = offset + size;
+        total_size += size;
+    }
+    // the footer at the end of the file is always downloaded
+    EXPECT_FALSE(ranges.empty());
+    if (!ranges.empty()) {
+        EXPECT_EQ(ranges.back().first + ranges.back().second, file_size);
+    }
+    return total_size;
+}
+
+TEST_F(CloudWarmUpManagerTest, SelectiveDownloadRanges) {
+    const size_t nrows = 64 * 1024;
+    auto file_reader = build_segment(nrows);
+    auto file_size = static_cast<int64_t>(file_reader->size());
+
+    // all the columns, the whole file
+    std::vector<std::pair<int64_t, int64_t>> ranges;
+    ASSERT_TRUE(
+            CloudWarmUpManager::get_selective_download_ranges(file_reader, {0, 1, 2}, &ranges).ok());
+    ASSERT_EQ(ranges.size(), 1);
+    EXPECT_EQ(ranges[0], std::make_pair(int64_t(0), file_size));
+
+    // the data pages of the random values of column 2 are skipped
+    ranges.clear();
+    ASSERT_TRUE(
+            CloudWarmUpManager::get_selective_download_ranges(file_reader, {0, 1}, &ranges).ok());
+    int64_t two_columns_size = check_ranges(ranges, file_size);
+    EXPECT_LE(two_columns_size, file_size - static_cast<int64_t>(nrows * 3));
+
+    // and those of column 1 as well
+    ranges.clear();
+    ASSERT_TRUE(CloudWarmUpManager::get_selective_download_ranges(file_reader, {0}, &ranges).ok());
+    int64_t key_column_size = check_ranges(ranges, file_size);
+    EXPECT_LE(key_column_size, two_columns_size - static_cast<int64_t>(nrows * 3));
+
+    // not a segment file
+    std::string path = kSegmentDir + "/not_a_segment";
+    io::FileWriterPtr file_writer;
+    ASSERT_TRUE(io::global_local_filesystem()->create_file(path, &file_writer).ok());
+    ASSERT_TRUE(file_writer->append(Slice(std::string(64, 'a'))).ok());
+    ASSERT_TRUE(file_writer->close().ok());
+    io::FileReaderSPtr bad_reader;
+    ASSERT_TRUE(io::global_local_filesystem()->open_file(path, &bad_reader).ok());
+    ranges.clear();
+    EXPECT_FALSE(CloudWarmUpManager::get_selective_download_ranges(bad_reader, {0}, &ranges).ok());
+}
+
+TEST_F(CloudWarmUpManagerTest, EvictColumnAccess) {
+    TabletHotspot hotspot;
+    int64_t now = UnixSeconds();
+    {
+        auto& slot = hotspot._columns_access[1 % TabletHotspot::s_column_slot_size];
+        std::lock_guard lock(slot.mtx);
+        slot.map[1][10] = now;
+        slot.map[1][11] = now - 1000;
+    }
+    {
+        auto& slot = hotspot._columns_access[2 % TabletHotspot::s_column_slot_size];
+        std::lock_guard lock(slot.mtx);
+        slot.map[2][20] = now - 1000;
+    }
+    EXPECT_EQ(hotspot.get_accessed_columns(1, 100000), (std::unordered_set<int32_t> {10, 11}));
+
+    hotspot.evict_column_access(100);
+    EXPECT_EQ(hotspot.get_accessed_columns(1, 100000), (std::unordered_set<int32_t> {10}));
+    // the tables left without any column are removed
+    EXPECT_EQ(hotspot._columns_access[2 % TabletHotspot::s_column_slot_size].map.count(2), 0);
+}
+
+} // namespace doris
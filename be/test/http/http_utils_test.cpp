@@ -15,6 +15,7 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <event2/buffer.h>
 #include <event2/http.h>
 #include <gtest/gtest-message.h>
 #include <gtest/gtest-test-part.h>
@@ -25,6 +26,9 @@
 #include "http/http_headers.h"
 #include "http/http_request.h"
 #include "http/utils.h"
+#include "io/fs/stream_load_pipe.h"
+#include "runtime/memory/mem_tracker_limiter.h"
+#include "runtime/thread_context.h"
 #include "util/string_util.h"
 #include "util/url_coding.h"
 
@@ -96,4 +100,40 @@ TEST_F(HttpUtilsTest, parse_basic_auth) {
     }
 }
 
+TEST_F(HttpUtilsTest, move_evbuffer_to_sink) {
+    std::string expected;
+    evbuffer* evbuf = evbuffer_new();
+    for (int i = 0; i < 100; ++i) {
+        std::string line = "line " + std::to_string(i) + "\n";
+        evbuffer_add(evbuf, line.data(), line.size());
+        expected += line;
+    }
+
+    auto pipe = std::make_shared<io::StreamLoadPipe>();
+    auto tracker = MemTrackerLimiter::create_shared(MemTrackerLimiter::Type::LOAD,
+                                                    "move_evbuffer_to_sink");
+    {
+        SCOPED_ATTACH_TASK(tracker);
+        size_t moved_bytes = 0;
+        EXPECT_TRUE(move_evbuffer_to_sink(evbuf, pipe.get(), &moved_bytes).ok());
+        EXPECT_EQ(moved_bytes, expected.size());
+    }
+    EXPECT_EQ(evbuffer_get_length(evbuf), 0);
+    // the chains are released under the tracker of the thread that moved them
+    ASSERT_GT(pipe->get_queue_size(), 0U);
+    for (const auto& buf : pipe->_buf_queue) {
+        EXPECT_EQ(buf->mem_tracker_, tracker);
+    }
+    // the pipe keeps the moved chains alive
+    evbuffer_free(evbuf);
+    EXPECT_TRUE(pipe->finish().ok());
+
+    std::string actual(expected.size() + 10, '\0');
+    size_t bytes_read = 0;
+    EXPECT_TRUE(pipe->read_at(0, Slice(actual.data(), actual.size()), &bytes_read).ok());
+    EXPECT_EQ(bytes_read, expected.size());
+    actual.resize(bytes_read);
+    EXPECT_EQ(actual, expected);
+}
+
 } // namespace doris
@@ -467,4 +467,40 @@ TEST_F(LocalFileSystemTest, TestConvertToAbsPath) {
     st = doris::io::LocalFileSystem::convert_to_abs_path("hdfs:/abc", abs_path);
     ASSERT_TRUE(!st.ok());
 }
+
+TEST_F(LocalFileSystemTest, CopyPath) {
+    std::string content;
+    for (int i = 0; i < 1024 * 1024; ++i) {
+        content.push_back((char)(i % 251));
+    }
+    auto src = fmt::format("{}/src", test_dir);
+    auto dest = fmt::format("{}/dest", test_dir);
+    ASSERT_TRUE(save_string_file(src, content).ok());
+    auto st = io::global_local_filesystem()->copy_path(src, dest);
+    ASSERT_TRUE(st.ok()) << st;
+
+    int64_t fsize = 0;
+    ASSERT_TRUE(io::global_local_filesystem()->file_size(dest, &fsize).ok());
+    ASSERT_EQ((int64_t)content.size(), fsize);
+    io::FileReaderSPtr file_reader;
+    ASSERT_TRUE(io::global_local_filesystem()->open_file(dest, &file_reader).ok());
+    std::string buf(content.size(), '\0');
+    size_t bytes_read = 0;
+    ASSERT_TRUE(file_reader->read_at(0, Slice(buf.data(), buf.size()), &bytes_read).ok());
+    ASSERT_EQ(content.size(), bytes_read);
+    EXPECT_EQ(content, buf);
+    ASSERT_TRUE(file_reader->close().ok());
+
+    // copying to an existing file fails
+    EXPECT_FALSE(io::global_local_filesystem()->copy_path(src, dest).ok());
+
+    // copying a directory copies its files recursively
+    auto src_dir = fmt::format("{}/dir", test_dir);
+    ASSERT_TRUE(io::global_local_filesystem()->create_directory(src_dir).ok());
+    ASSERT_TRUE(save_string_file(src_dir + "/abc", "abc").ok());
+    auto dest_dir = fmt::format("{}/dir2", test_dir);
+    st = io::global_local_filesystem()->copy_path(src_dir, dest_dir);
+    ASSERT_TRUE(st.ok()) << st;
+    ASSERT_TRUE(check_exist(dest_dir + "/abc"));
+}
 } // namespace doris
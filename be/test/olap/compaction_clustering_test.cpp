@@ -0,0 +1,490 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/compaction_clustering.h"
+
+#include <gen_cpp/olap_file.pb.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "io/fs/local_file_system.h"
+#include "olap/base_compaction.h"
+#include "olap/data_dir.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/beta_rowset.h"
+#include "olap/rowset/rowset_factory.h"
+#include "olap/rowset/rowset_reader.h"
+#include "olap/rowset/rowset_reader_context.h"
+#include "olap/rowset/rowset_writer.h"
+#include "olap/rowset/rowset_writer_context.h"
+#include "olap/rowset/segment_v2/column_reader.h"
+#include "olap/rowset/segment_v2/segment.h"
+#include "olap/rowset/segment_v2/zone_map_index.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet.h"
+#include "olap/tablet_meta.h"
+#include "olap/tablet_schema.h"
+#include "runtime/exec_env.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/assert_cast.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris {
+
+namespace {
+
+vectorized::Block create_grid_block(int32_t begin_x, int32_t end_x, int32_t side) {
+    auto x = vectorized::ColumnInt32::create();
+    auto y = vectorized::ColumnInt32::create();
+    // rows in load order: x major
+    for (int32_t i = begin_x; i < end_x; ++i) {
+        for (int32_t j = 0; j < side; ++j) {
+            x->insert_value(i);
+            y->insert_value(j);
+        }
+    }
+    auto type = std::make_shared<vectorized::DataTypeInt32>();
+    return vectorized::Block({{std::move(x), type, "x"}, {std::move(y), type, "y"}});
+}
+
+using Rows = std::vector<std::pair<int32_t, int32_t>>;
+
+Rows block_rows(const vectorized::Block& block) {
+    Rows rows;
+    for (size_t row = 0; row < block.rows(); ++row) {
+        rows.emplace_back(block.get_by_position(0).column->get_int(row),
+                          block.get_by_position(1).column->get_int(row));
+    }
+    return rows;
+}
+
+// max - min of x and of y in rows [begin, end)
+std::pair<int32_t, int32_t> value_ranges(const Rows& rows, size_t begin, size_t end) {
+    int32_t min_x = INT32_MAX, max_x = INT32_MIN, min_y = INT32_MAX, max_y = INT32_MIN;
+    for (size_t row = begin; row < end; ++row) {
+        min_x = std::min(min_x, rows[row].first);
+        max_x = std::max(max_x, rows[row].first);
+        min_y = std::min(min_y, rows[row].second);
+        max_y = std::max(max_y, rows[row].second);
+    }
+    return {max_x - min_x, max_y - min_y};
+}
+
+} // namespace
+
+TEST(CompactionClusteringTest, ZorderIndex) {
+    EXPECT_EQ(zorder_index({0b11, 0b00}, 2), 0b1010U);
+    EXPECT_EQ(zorder_index({0b01, 0b10}, 2), 0b0110U);
+    EXPECT_EQ(zorder_index({5}, 32), 5U);
+}
+
+TEST(CompactionClusteringTest, HilbertIndex) {
+    constexpr uint32_t bits = 3;
+    constexpr uint32_t side = 1U << bits;
+    // the curve visits every cell once, and consecutive cells are neighbours
+    std::vector<std::vector<uint32_t>> cells(side * side);
+    for (uint32_t x = 0; x < side; ++x) {
+        for (uint32_t y = 0; y < side; ++y) {
+            uint64_t index = hilbert_index({x, y}, bits);
+            ASSERT_LT(index, cells.size());
+            ASSERT_TRUE(cells[index].empty());
+            cells[index] = {x, y};
+        }
+    }
+    for (size_t i = 1; i < cells.size(); ++i) {
+        int distance = std::abs(static_cast<int>(cells[i][0]) - static_cast<int>(cells[i - 1][0])) +
+                       std::abs(static_cast<int>(cells[i][1]) - static_cast<int>(cells[i - 1][1]));
+        EXPECT_EQ(distance, 1) << "index " << i;
+    }
+}
+
+TEST(CompactionClusteringTest, ClusterBlock) {
+    auto x = vectorized::ColumnInt32::create();
+    auto y = vectorized::ColumnInt32::create();
+    // rows in load order: x major
+    for (int32_t i = 0; i < 4; ++i) {
+        for (int32_t j = 0; j < 4; ++j) {
+            x->insert_value(i * 100);
+            y->insert_value(j);
+        }
+    }
+    auto type = std::make_shared<vectorized::DataTypeInt32>();
+    vectorized::Block block({{std::move(x), type, "x"}, {std::move(y), type, "y"}});
+
+    ClusteringSpec spec;
+    spec.column_ids = {0, 1};
+    ASSERT_TRUE(cluster_block(spec, &block).ok());
+    ASSERT_EQ(block.rows(), 16U);
+
+    // each quarter of the rows covers one quadrant of both dimensions
+    const auto& xs = assert_cast<const vectorized::ColumnInt32&>(*block.get_by_position(0).column);
+    const auto& ys = assert_cast<const vectorized::ColumnInt32&>(*block.get_by_position(1).column);
+    for (size_t quarter = 0; quarter < 4; ++quarter) {
+        int32_t min_x = INT32_MAX, max_x = INT32_MIN, min_y = INT32_MAX, max_y = INT32_MIN;
+        for (size_t row = quarter * 4; row < quarter * 4 + 4; ++row) {
+            min_x = std::min(min_x, xs.get_element(row));
+            max_x = std::max(max_x, xs.get_element(row));
+            min_y = std::min(min_y, ys.get_element(row));
+            max_y = std::max(max_y, ys.get_element(row));
+        }
+        EXPECT_EQ(max_x - min_x, 100);
+        EXPECT_EQ(max_y - min_y, 1);
+    }
+}
+
+TEST(CompactionClusteringTest, ClusteringBufferRows) {
+    int64_t buffer_rows = config::compaction_clustering_buffer_rows;
+    config::compaction_clustering_buffer_rows = 64;
+    ClusteringSpec spec;
+    spec.column_ids = {0, 1};
+    ClusteringBuffer buffer(spec, create_grid_block(0, 0, 8), 1);
+
+    std::vector<Rows> batches;
+    auto write_block = [&](vectorized::Block* block) {
+        batches.push_back(block_rows(*block));
+        return Status::OK();
+    };
+    // 16 x 8 rows in blocks of 8 rows, flushed every 64 rows
+    for (int32_t x = 0; x < 16; ++x) {
+        vectorized::Block block = create_grid_block(x, x + 1, 8);
+        ASSERT_TRUE(buffer.add_block(&block, write_block).ok());
+        if (x % 8 != 7) {
+            EXPECT_GT(buffer.mem_tracker().consumption(), 0);
+        }
+    }
+    EXPECT_GT(buffer.mem_tracker().peak_consumption(), 0);
+    ASSERT_TRUE(buffer.flush(write_block).ok());
+    config::compaction_clustering_buffer_rows = buffer_rows;
+
+    // nothing is left to flush
+    ASSERT_EQ(batches.size(), 2U);
+    for (size_t batch = 0; batch < batches.size(); ++batch) {
+        ASSERT_EQ(batches[batch].size(), 64U);
+        // each batch is clustered on its own: an 8 x 8 cell, whose quarters are 4 x 4 cells
+        for (size_t quarter = 0; quarter < 4; ++quarter) {
+            EXPECT_EQ(value_ranges(batches[batch], quarter * 16, quarter * 16 + 16),
+                      std::make_pair(3, 3));
+        }
+    }
+}
+
+TEST(CompactionClusteringTest, ClusteringBufferBytes) {
+    int64_t buffer_bytes = config::compaction_clustering_buffer_bytes;
+    // two columns of 4 bytes values, 32 rows
+    config::compaction_clustering_buffer_bytes = 256;
+    ClusteringSpec spec;
+    spec.column_ids = {0, 1};
+    ClusteringBuffer buffer(spec, create_grid_block(0, 0, 8), 1);
+
+    std::vector<size_t> batch_rows;
+    auto write_block = [&](vectorized::Block* block) {
+        batch_rows.push_back(block->rows());
+        return Status::OK();
+    };
+    for (int32_t x = 0; x < 8; ++x) {
+        vectorized::Block block = create_grid_block(x, x + 1, 8);
+        ASSERT_TRUE(buffer.add_block(&block, write_block).ok());
+    }
+    ASSERT_TRUE(buffer.flush(write_block).ok());
+    config::compaction_clustering_buffer_bytes = buffer_bytes;
+    EXPECT_EQ(batch_rows, std::vector<size_t>({32, 32}));
+}
+
+static const uint32_t MAX_PATH_LEN = 1024;
+static const std::string kTestDir = "/ut_dir/compaction_clustering_test";
+static const int32_t kTableId = 2;
+static StorageEngine* engine_ref = nullptr;
+
+class CompactionClusteringTabletTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char buffer[MAX_PATH_LEN];
+        EXPECT_NE(getcwd(buffer, MAX_PATH_LEN), nullptr);
+        _absolute_dir = std::string(buffer) + kTestDir;
+        auto st = io::global_local_filesystem()->delete_directory(_absolute_dir);
+        ASSERT_TRUE(st.ok()) << st;
+        st = io::global_local_filesystem()->create_directory(_absolute_dir);
+        ASSERT_TRUE(st.ok()) << st;
+        EXPECT_TRUE(io::global_local_filesystem()
+                            ->create_directory(_absolute_dir + "/tablet_path")
+                            .ok());
+
+        doris::EngineOptions options;
+        auto engine = std::make_unique<StorageEngine>(options);
+        engine_ref = engine.get();
+        _data_dir = std::make_unique<DataDir>(*engine_ref, _absolute_dir);
+        static_cast<void>(_data_dir->update_capacity());
+        ExecEnv::GetInstance()->set_storage_engine(std::move(engine));
+
+        _clustering_columns = config::compaction_clustering_columns;
+        _clustering_curve = config::compaction_clustering_curve;
+        _enable_ordered_data_compaction = config::enable_ordered_data_compaction;
+    }
+
+    void TearDown() override {
+        config::compaction_clustering_columns = _clustering_columns;
+        config::compaction_clustering_curve = _clustering_curve;
+        config::enable_ordered_data_compaction = _enable_ordered_data_compaction;
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(_absolute_dir).ok());
+        engine_ref = nullptr;
+        ExecEnv::GetInstance()->set_storage_engine(nullptr);
+    }
+
+    // columns x and y, x is a key column if `with_key`, and a jsonb column j if `with_jsonb`
+    TabletSchemaSPtr create_schema(bool with_key = false, bool with_jsonb = false) {
+        TabletSchemaSPtr tablet_schema = std::make_shared<TabletSchema>();
+        TabletSchemaPB tablet_schema_pb;
+        tablet_schema_pb.set_keys_type(DUP_KEYS);
+        tablet_schema_pb.set_num_short_key_columns(with_key ? 1 : 0);
+        tablet_schema_pb.set_num_rows_per_row_block(1024);
+        tablet_schema_pb.set_compress_kind(COMPRESS_NONE);
+        tablet_schema_pb.set_next_column_unique_id(4);
+        // the smallest page size, 1024 int values a page
+        tablet_schema_pb.set_storage_page_size(4096);
+
+        ColumnPB* column_1 = tablet_schema_pb.add_column();
+        column_1->set_unique_id(1);
+        column_1->set_name("x");
+        column_1->set_type("INT");
+        column_1->set_is_key(with_key);
+        column_1->set_length(4);
+        column_1->set_index_length(4);
+        column_1->set_is_nullable(false);
+        column_1->set_is_bf_column(false);
+
+        ColumnPB* column_2 = tablet_schema_pb.add_column();
+        column_2->set_unique_id(2);
+        column_2->set_name("y");
+        column_2->set_type("INT");
+        column_2->set_is_key(false);
+        column_2->set_length(4);
+        column_2->set_index_length(4);
+        column_2->set_is_nullable(false);
+        column_2->set_is_bf_column(false);
+
+        if (with_jsonb) {
+            ColumnPB* column_3 = tablet_schema_pb.add_column();
+            column_3->set_unique_id(3);
+            column_3->set_name("j");
+            column_3->set_type("JSONB");
+            column_3->set_is_key(false);
+            column_3->set_is_nullable(true);
+            column_3->set_is_bf_column(false);
+        }
+
+        tablet_schema->init_from_pb(tablet_schema_pb);
+        return tablet_schema;
+    }
+
+    TabletSharedPtr create_tablet(const TabletSchema& tablet_schema, int64_t table_id) {
+        std::vector<TColumn> cols;
+        std::unordered_map<uint32_t, uint32_t> col_ordinal_to_unique_id;
+        for (auto i = 0; i < tablet_schema.num_columns(); i++) {
+            const TabletColumn& column = tablet_schema.column(i);
+            TColumn col;
+            col.column_type.type = TPrimitiveType::INT;
+            col.__set_column_name(column.name());
+            col.__set_is_key(column.is_key());
+            cols.push_back(col);
+            col_ordinal_to_unique_id[i] = column.unique_id();
+        }
+
+        TTabletSchema t_tablet_schema;
+        t_tablet_schema.__set_short_key_column_count(tablet_schema.num_short_key_columns());
+        t_tablet_schema.__set_schema_hash(3333);
+        t_tablet_schema.__set_keys_type(TKeysType::DUP_KEYS);
+        t_tablet_schema.__set_storage_type(TStorageType::COLUMN);
+        t_tablet_schema.__set_storage_page_size(4096);
+        t_tablet_schema.__set_columns(cols);
+        TabletMetaSharedPtr tablet_meta(new TabletMeta(
+                table_id, 2, 2, 2, 2, 2, t_tablet_schema, 2, col_ordinal_to_unique_id,
+                UniqueId(1, 2), TTabletType::TABLET_TYPE_DISK, TCompressionType::LZ4F, 0, false));
+
+        TabletSharedPtr tablet(new Tablet(*engine_ref, tablet_meta, _data_dir.get()));
+        static_cast<void>(tablet->init());
+        return tablet;
+    }
+
+    RowsetSharedPtr create_rowset(TabletSchemaSPtr tablet_schema, TabletSharedPtr tablet,
+                                  vectorized::Block* block, int64_t version) {
+        RowsetWriterContext writer_context;
+        RowsetId rowset_id;
+        rowset_id.init(1000 + version);
+        writer_context.rowset_id = rowset_id;
+        writer_context.rowset_type = BETA_ROWSET;
+        writer_context.data_dir = _data_dir.get();
+        writer_context.rowset_state = VISIBLE;
+        writer_context.tablet_schema = tablet_schema;
+        writer_context.tablet_path = tablet->tablet_path();
+        writer_context.tablet_id = tablet->tablet_id();
+        writer_context.version = Version(version, version);
+        writer_context.segments_overlap = NONOVERLAPPING;
+
+        auto res = RowsetFactory::create_rowset_writer(*engine_ref, writer_context, true);
+        EXPECT_TRUE(res.has_value()) << res.error();
+        auto rowset_writer = std::move(res).value();
+        EXPECT_TRUE(rowset_writer->add_block(block).ok());
+        EXPECT_TRUE(rowset_writer->flush().ok());
+        RowsetSharedPtr rowset;
+        EXPECT_EQ(Status::OK(), rowset_writer->build(rowset));
+        return rowset;
+    }
+
+    // number of pages of the column in the segments of rowset whose min value is below `bound`
+    size_t pages_below(const RowsetSharedPtr& rowset, const TabletColumn& column, int32_t bound) {
+        std::vector<segment_v2::SegmentSharedPtr> segments;
+        EXPECT_TRUE(std::static_pointer_cast<BetaRowset>(rowset)->load_segments(&segments).ok());
+        size_t pages = 0;
+        for (auto& segment : segments) {
+            OlapReaderStatistics stats;
+            EXPECT_TRUE(segment->_create_column_readers_once(&stats).ok());
+            segment_v2::ColumnReader* reader = segment->_get_column_reader(column);
+            EXPECT_NE(reader, nullptr);
+            segment_v2::ColumnIteratorOptions iter_opts;
+            iter_opts.stats = &stats;
+            EXPECT_TRUE(reader->_load_zone_map_index(false, false, iter_opts).ok());
+            for (const auto& zone_map : reader->_zone_map_index->page_zone_maps()) {
+                pages += std::stoi(zone_map.min()) < bound;
+            }
+        }
+        return pages;
+    }
+
+    std::string _absolute_dir;
+    std::unique_ptr<DataDir> _data_dir;
+    std::string _clustering_columns;
+    std::string _clustering_curve;
+    bool _enable_ordered_data_compaction;
+};
+
+TEST_F(CompactionClusteringTabletTest, GetClusteringSpec) {
+    TabletSchemaSPtr tablet_schema = create_schema(false, true);
+    TabletSharedPtr tablet = create_tablet(*create_schema(), kTableId);
+    ClusteringSpec spec;
+
+    config::compaction_clustering_columns = "";
+    EXPECT_FALSE(get_clustering_spec(*tablet, *tablet_schema, &spec));
+
+    config::compaction_clustering_columns = "3:x,y";
+    EXPECT_FALSE(get_clustering_spec(*tablet, *tablet_schema, &spec));
+
+    config::compaction_clustering_columns = "3:x; 2:y, x";
+    config::compaction_clustering_curve = "hilbert";
+    ASSERT_TRUE(get_clustering_spec(*tablet, *tablet_schema, &spec));
+    EXPECT_EQ(spec.column_ids, std::vector<uint32_t>({1, 0}));
+    EXPECT_EQ(spec.curve, ClusteringCurve::HILBERT);
+
+    config::compaction_clustering_curve = "zorder";
+    ASSERT_TRUE(get_clustering_spec(*tablet, *tablet_schema, &spec));
+    EXPECT_EQ(spec.curve, ClusteringCurve::ZORDER);
+
+    // unknown and unsupported columns are ignored
+    config::compaction_clustering_columns = "2:z,j,x";
+    ASSERT_TRUE(get_clustering_spec(*tablet, *tablet_schema, &spec));
+    EXPECT_EQ(spec.column_ids, std::vector<uint32_t>({0}));
+
+    config::compaction_clustering_columns = "2:z,j";
+    EXPECT_FALSE(get_clustering_spec(*tablet, *tablet_schema, &spec));
+
+    // at most 8 dimensions
+    config::compaction_clustering_columns = "2:x,y,x,y,x,y,x,y,x";
+    EXPECT_FALSE(get_clustering_spec(*tablet, *tablet_schema, &spec));
+
+    // rows of a table with sort keys stay in key order
+    TabletSchemaSPtr key_schema = create_schema(true);
+    ASSERT_EQ(key_schema->num_key_columns(), 1U);
+    config::compaction_clustering_columns = "2:x,y";
+    EXPECT_FALSE(get_clustering_spec(*tablet, *key_schema, &spec));
+}
+
+TEST_F(CompactionClusteringTabletTest, ClusteredCompaction) {
+    config::compaction_clustering_columns = "2:x,y";
+    config::enable_ordered_data_compaction = true;
+    TabletSchemaSPtr tablet_schema = create_schema();
+    TabletSharedPtr tablet = create_tablet(*tablet_schema, kTableId);
+
+    // a 64 x 64 grid loaded x major in two rowsets of 2 pages
+    std::vector<RowsetSharedPtr> input_rowsets;
+    for (int32_t i = 0; i < 2; ++i) {
+        vectorized::Block block = tablet_schema->create_block();
+        auto columns = block.mutate_columns();
+        for (int32_t x = i * 32; x < i * 32 + 32; ++x) {
+            for (int32_t y = 0; y < 64; ++y) {
+                columns[0]->insert_data((const char*)&x, sizeof(x));
+                columns[1]->insert_data((const char*)&y, sizeof(y));
+            }
+        }
+        input_rowsets.push_back(create_rowset(tablet_schema, tablet, &block, i + 2));
+    }
+    // every input page covers all of y
+    EXPECT_EQ(pages_below(input_rowsets[0], tablet_schema->column(1), 16) +
+                      pages_below(input_rowsets[1], tablet_schema->column(1), 16),
+              4U);
+
+    BaseCompaction compaction(*engine_ref, tablet);
+    compaction._input_rowsets = input_rowsets;
+    compaction.build_basic_info();
+    // the input rowsets are ordered, but linking them would not cluster them
+    EXPECT_FALSE(compaction.handle_ordered_data_compaction());
+    EXPECT_EQ(compaction._input_rowsets.size(), 2U);
+
+    compaction._is_vertical = true;
+    auto st = compaction.merge_input_rowsets();
+    ASSERT_TRUE(st.ok()) << st;
+    EXPECT_FALSE(compaction._is_vertical);
+    RowsetSharedPtr output_rowset = compaction._output_rowset;
+    ASSERT_NE(output_rowset, nullptr);
+    ASSERT_EQ(output_rowset->num_rows(), 4096U);
+
+    // the rows come out on the curve: each page of the output is a 32 x 32 quadrant
+    RowsetReaderContext reader_context;
+    reader_context.tablet_schema = tablet_schema;
+    reader_context.need_ordered_result = false;
+    std::vector<uint32_t> return_columns = {0, 1};
+    reader_context.return_columns = &return_columns;
+    RowsetReaderSharedPtr output_reader;
+    ASSERT_TRUE(output_rowset->create_reader(&output_reader).ok());
+    ASSERT_TRUE(output_reader->init(&reader_context).ok());
+    Rows output_data;
+    do {
+        vectorized::Block output_block = tablet_schema->create_block(return_columns);
+        st = output_reader->next_block(&output_block);
+        Rows rows = block_rows(output_block);
+        output_data.insert(output_data.end(), rows.begin(), rows.end());
+    } while (st.ok());
+    EXPECT_TRUE(st.is<ErrorCode::END_OF_FILE>()) << st;
+    ASSERT_EQ(output_data.size(), 4096U);
+    for (size_t row = 0; row < output_data.size(); ++row) {
+        size_t quadrant = row / 1024;
+        EXPECT_EQ(output_data[row].first / 32, quadrant < 2 ? 0 : 1) << "row " << row;
+        EXPECT_EQ(output_data[row].second / 32, quadrant % 2 == 0 ? 0 : 1) << "row " << row;
+    }
+
+    // so a filter on y < 16 reads half of the pages
+    EXPECT_EQ(pages_below(output_rowset, tablet_schema->column(1), 16), 2U);
+}
+
+} // namespace doris
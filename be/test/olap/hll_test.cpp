@@ -206,4 +206,64 @@ TEST_F(TestHll, InvalidPtr) {
     }
 }
 
+TEST_F(TestHll, SparseInMemory) {
+    uint8_t buf[HLL_REGISTERS_COUNT + 1] = {0};
+    // a few hundreds of values are kept in sparse registers
+    HyperLogLog sparse_hll;
+    HyperLogLog full_hll;
+    for (int i = 0; i < 500; ++i) {
+        sparse_hll.update(hash(i));
+    }
+    EXPECT_LT(sparse_hll.memory_consumed(), sizeof(HyperLogLog) + HLL_REGISTERS_COUNT / 2);
+
+    // the estimate is the same as the one of full registers
+    {
+        int len = sparse_hll.serialize(buf);
+        EXPECT_EQ(HLL_DATA_SPARSE, buf[0]);
+        HyperLogLog test_hll(Slice((char*)buf, len));
+        EXPECT_EQ(sparse_hll.estimate_cardinality(), test_hll.estimate_cardinality());
+
+        for (int i = 0; i < 64 * 1024; ++i) {
+            full_hll.update(hash(64 * 1024 + i));
+        }
+        HyperLogLog expected_hll = full_hll;
+        HyperLogLog merged_full_hll = full_hll;
+        merged_full_hll.merge(sparse_hll);
+        expected_hll.merge(test_hll);
+        for (int i = 0; i < 500; ++i) {
+            full_hll.update(hash(i));
+        }
+        EXPECT_EQ(full_hll.estimate_cardinality(), merged_full_hll.estimate_cardinality());
+        EXPECT_EQ(full_hll.estimate_cardinality(), expected_hll.estimate_cardinality());
+    }
+
+    // merge sparse into sparse without converting to full registers
+    {
+        HyperLogLog other_hll;
+        for (int i = 250; i < 750; ++i) {
+            other_hll.update(hash(i));
+        }
+        HyperLogLog expected_hll;
+        for (int i = 0; i < 750; ++i) {
+            expected_hll.update(hash(i));
+        }
+        HyperLogLog merged_hll = sparse_hll;
+        merged_hll.merge(other_hll);
+        EXPECT_EQ(expected_hll.estimate_cardinality(), merged_hll.estimate_cardinality());
+        EXPECT_LT(merged_hll.memory_consumed(), sizeof(HyperLogLog) + HLL_REGISTERS_COUNT / 2);
+        EXPECT_EQ(expected_hll.max_serialized_size(), merged_hll.max_serialized_size());
+    }
+
+    // too many non-zero registers are converted to full registers lazily
+    {
+        HyperLogLog hll = sparse_hll;
+        for (int i = 500; i < 10000; ++i) {
+            hll.update(hash(i));
+        }
+        EXPECT_GE(hll.memory_consumed(), sizeof(HyperLogLog) + HLL_REGISTERS_COUNT);
+        auto cardinality = hll.estimate_cardinality();
+        EXPECT_TRUE(cardinality > 9700 && cardinality < 10300);
+    }
+}
+
 } // namespace doris
@@ -27,6 +27,9 @@
 #include "olap/storage_engine.h"
 #include "olap/tablet_fwd.h"
 #include "olap/tablet_schema.h"
+#include "runtime/memory/mem_tracker_limiter.h"
+#include "runtime/thread_context.h"
+#include "util/defer_op.h"
 
 namespace doris {
 using namespace testing;
@@ -933,6 +936,118 @@ TEST_F(IndexBuilderTest, MultiSegmentBuildIndexTest) {
             << "New directory should contain exactly " << num_segments << " .dat files";
 }
 
+TEST_F(IndexBuilderTest, ParallelMultiRowsetBuildIndexTest) {
+    auto tablet_path = _absolute_dir + "/" + std::to_string(14678);
+    _tablet->_tablet_path = tablet_path;
+    ASSERT_TRUE(io::global_local_filesystem()->delete_directory(tablet_path).ok());
+    ASSERT_TRUE(io::global_local_filesystem()->create_directory(tablet_path).ok());
+
+    // build every segment of a rowset on its own thread
+    auto old_parallelism = config::index_builder_segment_parallelism;
+    auto old_ram_buffer_size = config::inverted_index_ram_buffer_size;
+    config::index_builder_segment_parallelism = 4;
+    config::inverted_index_ram_buffer_size = 16;
+    Defer defer {[&]() {
+        config::index_builder_segment_parallelism = old_parallelism;
+        config::inverted_index_ram_buffer_size = old_ram_buffer_size;
+    }};
+
+    const int rows_per_segment = 200;
+    const int num_segments = 4;
+    const int num_rowsets = 2;
+    auto old_tablet_path = _absolute_dir + "/" + std::to_string(16677);
+    ASSERT_TRUE(io::global_local_filesystem()->create_directory(old_tablet_path).ok());
+    for (int r = 0; r < num_rowsets; ++r) {
+        RowsetWriterContext writer_context;
+        writer_context.rowset_id.init(16677 + r);
+        writer_context.tablet_id = 16677;
+        writer_context.tablet_schema_hash = 567997577;
+        writer_context.partition_id = 10;
+        writer_context.rowset_type = BETA_ROWSET;
+        writer_context.tablet_path = old_tablet_path;
+        writer_context.rowset_state = VISIBLE;
+        writer_context.tablet_schema = _tablet_schema;
+        writer_context.version.first = 10 + r;
+        writer_context.version.second = 10 + r;
+        writer_context.max_rows_per_segment = rows_per_segment;
+
+        auto res = RowsetFactory::create_rowset_writer(*_engine_ref, writer_context, false);
+        ASSERT_TRUE(res.has_value()) << res.error();
+        auto rowset_writer = std::move(res).value();
+        for (int segment = 0; segment < num_segments; segment++) {
+            vectorized::Block block = _tablet_schema->create_block();
+            auto columns = block.mutate_columns();
+            for (int i = 0; i < rows_per_segment; ++i) {
+                int32_t k1 = ((r * num_segments + segment) * rows_per_segment + i) * 10;
+                columns[0]->insert_data((const char*)&k1, sizeof(k1));
+                int32_t k2 = i % 100;
+                columns[1]->insert_data((const char*)&k2, sizeof(k2));
+            }
+            auto s = rowset_writer->add_block(&block);
+            ASSERT_TRUE(s.ok()) << s.to_string();
+            s = rowset_writer->flush();
+            ASSERT_TRUE(s.ok()) << s.to_string();
+        }
+        RowsetSharedPtr rowset;
+        ASSERT_TRUE(rowset_writer->build(rowset).ok());
+        ASSERT_EQ(rowset->num_segments(), num_segments);
+        ASSERT_TRUE(_tablet->add_rowset(rowset).ok());
+    }
+
+    TOlapTableIndex index1;
+    index1.index_id = 1;
+    index1.columns.emplace_back("k1");
+    index1.index_name = "k1_index";
+    index1.index_type = TIndexType::INVERTED;
+    _alter_indexes.push_back(index1);
+
+    TOlapTableIndex index2;
+    index2.index_id = 2;
+    index2.columns.emplace_back("k2");
+    index2.index_name = "k2_index";
+    index2.index_type = TIndexType::INVERTED;
+    _alter_indexes.push_back(index2);
+
+    IndexBuilder builder(ExecEnv::GetInstance()->storage_engine().to_local(), _tablet, _columns,
+                         _alter_indexes, false);
+    auto status = builder.init();
+    ASSERT_TRUE(status.ok()) << status.to_string();
+    ASSERT_EQ(builder._segment_build_parallelism(num_segments), num_segments);
+
+    // the segment tasks are charged to the tracker of the calling thread
+    auto mem_tracker = MemTrackerLimiter::create_shared(MemTrackerLimiter::Type::SCHEMA_CHANGE,
+                                                        "ParallelMultiRowsetBuildIndexTest");
+    {
+        SCOPED_ATTACH_TASK(mem_tracker);
+        status = builder.do_build_inverted_index();
+    }
+    ASSERT_TRUE(status.ok()) << status.to_string();
+
+    std::vector<io::FileInfo> new_files;
+    bool new_dir_exists = false;
+    ASSERT_TRUE(
+            io::global_local_filesystem()->list(tablet_path, true, &new_files, &new_dir_exists).ok());
+    ASSERT_TRUE(new_dir_exists);
+    int new_idx_file_count = 0;
+    int new_dat_file_count = 0;
+    for (const auto& file : new_files) {
+        if (file.file_name.find(".idx") != std::string::npos) {
+            new_idx_file_count++;
+        }
+        if (file.file_name.find(".dat") != std::string::npos) {
+            new_dat_file_count++;
+        }
+    }
+    EXPECT_EQ(new_idx_file_count, num_rowsets * num_segments);
+    EXPECT_EQ(new_dat_file_count, num_rowsets * num_segments);
+
+    // every output rowset accounts the index files of all of its segments
+    for (const auto& [version, rowset] : _tablet->rowset_map()) {
+        EXPECT_EQ(rowset->num_segments(), num_segments);
+        EXPECT_GT(rowset->rowset_meta()->index_disk_size(), 0) << version.to_string();
+    }
+}
+
 TEST_F(IndexBuilderTest, NonExistentColumnIndexTest) {
     // 0. prepare tablet path
     auto tablet_path = _absolute_dir + "/" + std::to_string(14678);
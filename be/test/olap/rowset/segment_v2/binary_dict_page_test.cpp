@@ -28,6 +28,7 @@
 #include "olap/rowset/segment_v2/bitshuffle_page_pre_decoder.h"
 #include "olap/rowset/segment_v2/page_builder.h"
 #include "olap/rowset/segment_v2/page_decoder.h"
+#include "olap/rowset/segment_v2/shared_dictionary.h"
 #include "olap/types.h"
 #include "testutil/test_util.h"
 #include "util/debug_util.h"
@@ -259,5 +260,56 @@ TEST_F(BinaryDictPageTest, TestEncodingRatio) {
     test_with_large_data_size(slices);
 }
 
+TEST_F(BinaryDictPageTest, TestSharedDictionary) {
+    SharedDictionary shared_dict(256 * 1024);
+    PageBuilderOptions options;
+    options.data_page_size = 256 * 1024;
+    options.dict_page_size = 256 * 1024;
+    options.shared_dict = &shared_dict;
+
+    auto build_dict = [&](std::vector<Slice> slices) {
+        BinaryDictPageBuilder page_builder(options);
+        EXPECT_TRUE(page_builder.init().ok());
+        size_t count = slices.size();
+        EXPECT_TRUE(page_builder.add(reinterpret_cast<const uint8_t*>(slices.data()), &count).ok());
+        OwnedSlice data = page_builder.finish();
+        OwnedSlice dict_slice;
+        EXPECT_TRUE(page_builder.get_dictionary_page(&dict_slice).ok());
+
+        PageDecoderOptions dict_decoder_options;
+        BinaryPlainPageDecoder<FieldType::OLAP_FIELD_TYPE_VARCHAR> dict_decoder(
+                dict_slice.slice(), dict_decoder_options);
+        EXPECT_TRUE(dict_decoder.init().ok());
+        std::vector<StringRef> dict_word_info(dict_decoder.count());
+        EXPECT_TRUE(dict_decoder.get_dict_word_info(dict_word_info.data()).ok());
+        std::vector<std::string> words;
+        for (const auto& word : dict_word_info) {
+            words.emplace_back(word.data, word.size);
+        }
+        return words;
+    };
+
+    EXPECT_EQ(build_dict({"beta", "alpha", "beta", ""}),
+              (std::vector<std::string> {"beta", "alpha", ""}));
+    // the words of the first segment keep their codes in the second one
+    EXPECT_EQ(build_dict({"gamma", "alpha", ""}),
+              (std::vector<std::string> {"beta", "alpha", "", "gamma"}));
+    EXPECT_EQ(shared_dict.snapshot()->size(), 4U);
+
+    shared_dict.disable();
+    EXPECT_EQ(shared_dict.snapshot(), nullptr);
+    EXPECT_EQ(build_dict({"gamma"}), (std::vector<std::string> {"gamma"}));
+    EXPECT_EQ(shared_dict.snapshot(), nullptr);
+}
+
+TEST_F(BinaryDictPageTest, TestSharedDictionaryLimit) {
+    // words stop being published once they take half of the dict page size
+    SharedDictionary shared_dict(32);
+    shared_dict.publish({"aaaa", "bbbb", "cccc"});
+    EXPECT_EQ(*shared_dict.snapshot(), (std::vector<std::string> {"aaaa", "bbbb"}));
+    shared_dict.publish({"aaaa", "dd"});
+    EXPECT_EQ(*shared_dict.snapshot(), (std::vector<std::string> {"aaaa", "bbbb"}));
+}
+
 } // namespace segment_v2
 } // namespace doris
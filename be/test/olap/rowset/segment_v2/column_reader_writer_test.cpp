@@ -18,6 +18,8 @@
 #include <gtest/gtest.h>
 
 #include <iostream>
+#include <random>
+#include <vector>
 
 #include "io/fs/file_system.h"
 #include "io/fs/file_writer.h"
@@ -27,9 +29,11 @@
 #include "olap/olap_common.h"
 #include "olap/rowset/segment_v2/column_reader.h"
 #include "olap/rowset/segment_v2/column_writer.h"
+#include "olap/rowset/segment_v2/shared_dictionary.h"
 #include "olap/tablet_schema_helper.h"
 #include "olap/types.h"
 #include "testutil/test_util.h"
+#include "vec/columns/column_string.h"
 #include "vec/core/types.h"
 #include "vec/data_types/data_type_date.h"
 #include "vec/data_types/data_type_date_time.h"
@@ -69,7 +73,8 @@ private:
 
 template <FieldType type, EncodingTypePB encoding>
 void test_nullable_data(uint8_t* src_data, uint8_t* src_is_null, int num_rows,
-                        std::string test_name) {
+                        std::string test_name, size_t target_compressed_page_size = 0,
+                        size_t* num_pages = nullptr, size_t* data_page_size = nullptr) {
     using Type = typename TypeTraits<type>::CppType;
     Type* src = (Type*)src_data;
 
@@ -97,6 +102,7 @@ void test_nullable_data(uint8_t* src_data, uint8_t* src_is_null, int num_rows,
         writer_opts.meta->set_compression(segment_v2::CompressionTypePB::LZ4F);
         writer_opts.meta->set_is_nullable(true);
         writer_opts.need_zone_map = true;
+        writer_opts.target_compressed_page_size = target_compressed_page_size;
 
         TabletColumn column(OLAP_FIELD_AGGREGATION_NONE, type);
         if (type == FieldType::OLAP_FIELD_TYPE_VARCHAR) {
@@ -115,6 +121,13 @@ void test_nullable_data(uint8_t* src_data, uint8_t* src_is_null, int num_rows,
         }
 
         EXPECT_TRUE(writer->finish().ok());
+        auto* scalar_writer = static_cast<ScalarColumnWriter*>(writer.get());
+        if (num_pages != nullptr) {
+            *num_pages = scalar_writer->_pages.size();
+        }
+        if (data_page_size != nullptr) {
+            *data_page_size = scalar_writer->_data_page_size;
+        }
         EXPECT_TRUE(writer->write_data().ok());
         EXPECT_TRUE(writer->write_ordinal_index().ok());
         EXPECT_TRUE(writer->write_zone_map().ok());
@@ -659,6 +672,288 @@ TEST_F(ColumnReaderWriterTest, test_nullable) {
     delete[] double_vals;
 }
 
+TEST_F(ColumnReaderWriterTest, test_adaptive_page_size) {
+    size_t num_uint8_rows = LOOP_LESS_OR_MORE(1024, 1024 * 1024);
+    uint8_t* is_null = new uint8_t[num_uint8_rows];
+    uint8_t* val = new uint8_t[num_uint8_rows];
+    for (int i = 0; i < num_uint8_rows; ++i) {
+        val[i] = i;
+        BitmapChange(is_null, i, (i % 4) == 0);
+    }
+
+    // pages grow for the compressible narrow values and shrink for a small target,
+    // sequential reads and seeks must still find every row
+    test_nullable_data<FieldType::OLAP_FIELD_TYPE_TINYINT, BIT_SHUFFLE>(
+            val, is_null, num_uint8_rows, "adaptive_tiny_bs", 65536);
+    test_nullable_data<FieldType::OLAP_FIELD_TYPE_INT, BIT_SHUFFLE>(
+            val, is_null, num_uint8_rows / 4, "adaptive_int_bs", 4096);
+    test_nullable_data<FieldType::OLAP_FIELD_TYPE_BIGINT, PLAIN_ENCODING>(
+            val, is_null, num_uint8_rows / 8, "adaptive_bigint_plain", 1024);
+    delete[] val;
+    delete[] is_null;
+
+    // 2MB of values, large enough to span several default sized pages in every build type
+    const int num_rows = 256 * 1024;
+    std::vector<int64_t> bigint_vals(num_rows);
+    std::vector<uint8_t> bigint_is_null(num_rows);
+    std::mt19937_64 rng(42);
+    for (int i = 0; i < num_rows; ++i) {
+        bigint_vals[i] = static_cast<int64_t>(rng());
+        BitmapChange(bigint_is_null.data(), i, (i % 4) == 0);
+    }
+    size_t default_pages = 0;
+    size_t default_page_size = 0;
+    test_nullable_data<FieldType::OLAP_FIELD_TYPE_BIGINT, PLAIN_ENCODING>(
+            reinterpret_cast<uint8_t*>(bigint_vals.data()), bigint_is_null.data(), num_rows,
+            "default_random_bigint", 0, &default_pages, &default_page_size);
+    EXPECT_EQ(default_page_size, STORAGE_PAGE_SIZE_DEFAULT_VALUE);
+
+    // random values do not compress, the pages are stored uncompressed and sized to the target
+    size_t adaptive_pages = 0;
+    size_t adaptive_page_size = 0;
+    test_nullable_data<FieldType::OLAP_FIELD_TYPE_BIGINT, PLAIN_ENCODING>(
+            reinterpret_cast<uint8_t*>(bigint_vals.data()), bigint_is_null.data(), num_rows,
+            "adaptive_random_bigint", 16384, &adaptive_pages, &adaptive_page_size);
+    EXPECT_EQ(adaptive_page_size, 16384UL);
+    EXPECT_GE(adaptive_pages, default_pages * 3);
+
+    // constant values compress so well that the pages are capped, by 64K rows and by 16x the
+    // configured data page size
+    std::fill(bigint_vals.begin(), bigint_vals.end(), 7);
+    test_nullable_data<FieldType::OLAP_FIELD_TYPE_BIGINT, PLAIN_ENCODING>(
+            reinterpret_cast<uint8_t*>(bigint_vals.data()), bigint_is_null.data(), num_rows,
+            "adaptive_constant_bigint", 65536, &adaptive_pages, &adaptive_page_size);
+    EXPECT_GT(adaptive_page_size, STORAGE_PAGE_SIZE_DEFAULT_VALUE);
+    EXPECT_LE(adaptive_page_size, 16 * STORAGE_PAGE_SIZE_DEFAULT_VALUE);
+    EXPECT_LE(adaptive_page_size, 65536 * sizeof(int64_t));
+    EXPECT_LT(adaptive_pages, default_pages);
+}
+
+TEST_F(ColumnReaderWriterTest, test_shared_dictionary) {
+    // the dictionary shared by the segments of a rowset, written one after another
+    SharedDictionary shared_dict(STORAGE_DICT_PAGE_SIZE_DEFAULT_VALUE);
+    auto fs = io::global_local_filesystem();
+    TabletColumnPtr column = create_varchar_key(1, false);
+
+    auto write_segment = [&](const std::string& fname, const std::vector<std::string>& values,
+                             ColumnMetaPB* meta, SharedDictionaryRef* ref) {
+        io::FileWriterPtr file_writer;
+        ASSERT_TRUE(fs->create_file(TEST_DIR + "/" + fname, &file_writer).ok());
+        ColumnWriterOptions writer_opts;
+        writer_opts.meta = meta;
+        meta->set_column_id(0);
+        meta->set_unique_id(1);
+        meta->set_type(FieldType::OLAP_FIELD_TYPE_VARCHAR);
+        meta->set_length(65533);
+        meta->set_encoding(DICT_ENCODING);
+        meta->set_compression(segment_v2::CompressionTypePB::LZ4F);
+        meta->set_is_nullable(false);
+        writer_opts.shared_dict = &shared_dict;
+        writer_opts.shared_dict_ref = ref;
+        std::unique_ptr<ColumnWriter> writer;
+        ASSERT_TRUE(ColumnWriter::create(writer_opts, column.get(), file_writer.get(), &writer).ok());
+        ASSERT_TRUE(writer->init().ok());
+        for (int i = 0; i < 1000; ++i) {
+            Slice value(values[i % values.size()]);
+            ASSERT_TRUE(writer->append(false, &value).ok());
+        }
+        ASSERT_TRUE(writer->finish().ok());
+        ASSERT_TRUE(writer->write_data().ok());
+        ASSERT_TRUE(writer->write_ordinal_index().ok());
+        ASSERT_TRUE(file_writer->close().ok());
+    };
+
+    std::vector<std::string> values_a {"beta", "alpha", ""};
+    std::vector<std::string> values_b {"alpha", "beta"};
+    std::vector<std::string> values_c {"", "alpha"};
+    std::vector<std::string> values_d {"delta", "alpha"};
+    ColumnMetaPB meta_a, meta_b, meta_c, meta_d;
+    SharedDictionaryRef ref_a, ref_b, ref_c, ref_d;
+    write_segment("shared_dict_a", values_a, &meta_a, &ref_a);
+    write_segment("shared_dict_b", values_b, &meta_b, &ref_b);
+    write_segment("shared_dict_c", values_c, &meta_c, &ref_c);
+    write_segment("shared_dict_d", values_d, &meta_d, &ref_d);
+
+    // the first segment is not seeded, the next ones hold the words of the first one
+    EXPECT_EQ(ref_a.num_words, 0U);
+    EXPECT_EQ(ref_b.num_words, 3U);
+    EXPECT_TRUE(ref_b.complete);
+    uint32_t checksum = 0;
+    for (const auto& word : values_a) {
+        checksum = extend_shared_dictionary_checksum(checksum, word.data(), word.size());
+    }
+    EXPECT_EQ(ref_b.checksum, checksum);
+    EXPECT_EQ(ref_c.num_words, 3U);
+    EXPECT_EQ(ref_c.checksum, checksum);
+    EXPECT_TRUE(ref_c.complete);
+    // "delta" is not a shared word, the dictionary page of the last segment can not be shared
+    EXPECT_EQ(ref_d.num_words, 3U);
+    EXPECT_FALSE(ref_d.complete);
+
+    std::string shared_dict_id = shared_dictionary_id("test_shared_dictionary", 1, ref_b);
+    uint32_t num_words = 0;
+    uint32_t parsed_checksum = 0;
+    EXPECT_TRUE(parse_shared_dictionary_id(shared_dict_id, &num_words, &parsed_checksum));
+    EXPECT_EQ(num_words, 3U);
+    EXPECT_EQ(parsed_checksum, checksum);
+    EXPECT_FALSE(parse_shared_dictionary_id("3.1", &num_words, &parsed_checksum));
+
+    std::vector<std::unique_ptr<ColumnReader>> readers;
+    std::vector<std::unique_ptr<ColumnIterator>> iters;
+    std::vector<io::FileReaderSPtr> file_readers;
+    OlapReaderStatistics stats;
+    auto read_segment = [&](const std::string& fname, const ColumnMetaPB& meta,
+                            const std::vector<std::string>& values) {
+        io::FileReaderSPtr file_reader;
+        ASSERT_EQ(fs->open_file(TEST_DIR + "/" + fname, &file_reader), Status::OK());
+        ColumnReaderOptions reader_opts;
+        // the last segment holds a word that is not shared, its footer would not record the
+        // id, a reader given it anyway must not share its dictionary page
+        reader_opts.shared_dict_id = shared_dict_id;
+        std::unique_ptr<ColumnReader> reader;
+        ASSERT_TRUE(ColumnReader::create(reader_opts, meta, 1000, file_reader, &reader).ok());
+        ColumnIterator* iter = nullptr;
+        ASSERT_TRUE(reader->new_iterator(&iter).ok());
+        iters.emplace_back(iter);
+        ColumnIteratorOptions iter_opts;
+        iter_opts.stats = &stats;
+        iter_opts.file_reader = file_reader.get();
+        ASSERT_TRUE(iter->init(iter_opts).ok());
+        ASSERT_TRUE(iter->seek_to_ordinal(0).ok());
+        vectorized::MutableColumnPtr dst = vectorized::ColumnString::create();
+        size_t rows_read = 1000;
+        ASSERT_TRUE(iter->next_batch(&rows_read, dst).ok());
+        ASSERT_EQ(rows_read, 1000U);
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_EQ(dst->get_data_at(i).to_string(), values[i % values.size()]);
+        }
+        readers.push_back(std::move(reader));
+        file_readers.push_back(std::move(file_reader));
+    };
+    read_segment("shared_dict_b", meta_b, values_b);
+    read_segment("shared_dict_c", meta_c, values_c);
+    read_segment("shared_dict_d", meta_d, values_d);
+
+    auto* iter_b = static_cast<FileColumnIterator*>(iters[0].get());
+    auto* iter_c = static_cast<FileColumnIterator*>(iters[1].get());
+    auto* iter_d = static_cast<FileColumnIterator*>(iters[2].get());
+    // the dictionary page of the second segment is not read, the one of the first is used
+    EXPECT_EQ(iter_b->_dict, iter_c->_dict);
+    EXPECT_EQ(SharedDictionaryCache::instance()->get(shared_dict_id), iter_b->_dict);
+    EXPECT_NE(iter_d->_dict, iter_b->_dict);
+    EXPECT_EQ(iter_d->_dict->decoder->count(), 4U);
+
+    // the cached dictionary is released with the last iterator using it
+    iters.clear();
+    EXPECT_EQ(SharedDictionaryCache::instance()->get(shared_dict_id), nullptr);
+}
+
+TEST_F(ColumnReaderWriterTest, test_page_sum_stats) {
+    auto fs = io::global_local_filesystem();
+    TabletColumnPtr column = create_int_key(1, true);
+    ColumnMetaPB meta;
+    meta.set_column_id(0);
+    meta.set_unique_id(1);
+    meta.set_type(FieldType::OLAP_FIELD_TYPE_INT);
+    meta.set_length(4);
+    meta.set_encoding(DEFAULT_ENCODING);
+    meta.set_compression(segment_v2::CompressionTypePB::LZ4F);
+    meta.set_is_nullable(true);
+
+    // every 7th value is null
+    constexpr int num_rows = 5000;
+    int64_t sum = 0;
+    uint64_t num_nulls = 0;
+    std::string page_stats;
+    {
+        io::FileWriterPtr file_writer;
+        ASSERT_TRUE(fs->create_file(TEST_DIR + "/page_sum_stats", &file_writer).ok());
+        ColumnWriterOptions writer_opts;
+        writer_opts.meta = &meta;
+        writer_opts.data_page_size = 4096;
+        writer_opts.page_stats = &page_stats;
+        std::unique_ptr<ColumnWriter> writer;
+        ASSERT_TRUE(ColumnWriter::create(writer_opts, column.get(), file_writer.get(), &writer).ok());
+        ASSERT_TRUE(writer->init().ok());
+        for (int32_t i = 0; i < num_rows; ++i) {
+            bool is_null = i % 7 == 0;
+            int32_t value = i - 1000;
+            ASSERT_TRUE(writer->append(is_null, &value).ok());
+            if (is_null) {
+                ++num_nulls;
+            } else {
+                sum += value;
+            }
+        }
+        ASSERT_TRUE(writer->finish().ok());
+        ASSERT_TRUE(writer->write_data().ok());
+        ASSERT_TRUE(writer->write_ordinal_index().ok());
+        ASSERT_TRUE(file_writer->close().ok());
+    }
+    ASSERT_FALSE(page_stats.empty());
+
+    io::FileReaderSPtr file_reader;
+    ASSERT_EQ(fs->open_file(TEST_DIR + "/page_sum_stats", &file_reader), Status::OK());
+    auto create_reader = [&](const std::string& stats, std::unique_ptr<ColumnReader>* reader) {
+        ColumnReaderOptions reader_opts;
+        reader_opts.page_stats = stats;
+        ASSERT_TRUE(ColumnReader::create(reader_opts, meta, num_rows, file_reader, reader).ok());
+    };
+
+    std::unique_ptr<ColumnReader> reader;
+    create_reader(page_stats, &reader);
+    const std::vector<PageSumStats>* pages = nullptr;
+    ASSERT_TRUE(reader->get_page_sum_stats(&pages).ok());
+    ASSERT_NE(pages, nullptr);
+    // the serialized stats are dropped once parsed
+    EXPECT_TRUE(reader->_opts.page_stats.empty());
+    const std::vector<PageSumStats>* parsed_again = nullptr;
+    ASSERT_TRUE(reader->get_page_sum_stats(&parsed_again).ok());
+    EXPECT_EQ(parsed_again, pages);
+
+    // one entry for each data page of the ordinal index
+    ColumnIterator* iter = nullptr;
+    ASSERT_TRUE(reader->new_iterator(&iter).ok());
+    std::unique_ptr<ColumnIterator> iter_guard(iter);
+    OlapReaderStatistics stats;
+    ColumnIteratorOptions iter_opts;
+    iter_opts.stats = &stats;
+    iter_opts.file_reader = file_reader.get();
+    ASSERT_TRUE(iter->init(iter_opts).ok());
+    ASSERT_TRUE(iter->seek_to_ordinal(0).ok());
+    int32_t num_pages = reader->_ordinal_index->num_data_pages();
+    EXPECT_GT(num_pages, 1);
+    ASSERT_EQ(pages->size(), static_cast<size_t>(num_pages));
+
+    __int128 page_sum = 0;
+    uint64_t page_rows = 0;
+    uint64_t page_nulls = 0;
+    for (int32_t i = 0; i < num_pages; ++i) {
+        const auto& page = (*pages)[i];
+        EXPECT_TRUE(page.has_sum);
+        EXPECT_EQ(page.num_not_nulls + page.num_nulls,
+                  reader->_ordinal_index->get_last_ordinal(i) -
+                          reader->_ordinal_index->get_first_ordinal(i) + 1);
+        page_sum += page.int_sum;
+        page_rows += page.num_not_nulls + page.num_nulls;
+        page_nulls += page.num_nulls;
+    }
+    EXPECT_TRUE(page_sum == sum);
+    EXPECT_EQ(page_rows, static_cast<uint64_t>(num_rows));
+    EXPECT_EQ(page_nulls, num_nulls);
+
+    // a column written without stats has none
+    std::unique_ptr<ColumnReader> reader_without_stats;
+    create_reader("", &reader_without_stats);
+    ASSERT_TRUE(reader_without_stats->get_page_sum_stats(&pages).ok());
+    EXPECT_EQ(pages, nullptr);
+
+    // a corrupted footer entry is reported when the stats are asked for
+    std::unique_ptr<ColumnReader> corrupted_reader;
+    create_reader(page_stats.substr(0, page_stats.size() - 1), &corrupted_reader);
+    EXPECT_FALSE(corrupted_reader->get_page_sum_stats(&pages).ok());
+}
+
 TEST_F(ColumnReaderWriterTest, test_types) {
     size_t num_uint8_rows = LOOP_LESS_OR_MORE(1024, 1024 * 1024);
     uint8_t* is_null = new uint8_t[num_uint8_rows];
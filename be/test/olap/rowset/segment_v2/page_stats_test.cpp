@@ -0,0 +1,108 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/page_stats.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace doris {
+namespace segment_v2 {
+
+TEST(PageStatsTest, UnsupportedType) {
+    std::unique_ptr<PageStatsWriter> writer;
+    PageStatsWriter::create(FieldType::OLAP_FIELD_TYPE_VARCHAR, &writer);
+    EXPECT_EQ(writer, nullptr);
+    EXPECT_FALSE(has_page_stats(FieldType::OLAP_FIELD_TYPE_STRING));
+    EXPECT_TRUE(has_page_stats(FieldType::OLAP_FIELD_TYPE_DECIMAL64));
+}
+
+TEST(PageStatsTest, IntegerRoundTrip) {
+    std::unique_ptr<PageStatsWriter> writer;
+    PageStatsWriter::create(FieldType::OLAP_FIELD_TYPE_BIGINT, &writer);
+    ASSERT_NE(writer, nullptr);
+
+    std::vector<int64_t> values = {1, -2, 30, 400};
+    writer->add_values(values.data(), values.size());
+    writer->add_nulls(3);
+    writer->flush();
+
+    std::vector<int64_t> big = {std::numeric_limits<int64_t>::max(),
+                                std::numeric_limits<int64_t>::max()};
+    writer->add_values(big.data(), big.size());
+    writer->flush();
+
+    std::string buf;
+    writer->finish(&buf);
+    std::vector<PageSumStats> pages;
+    ASSERT_TRUE(parse_page_stats(buf, &pages).ok());
+    ASSERT_EQ(pages.size(), 2);
+    EXPECT_TRUE(pages[0].has_sum);
+    EXPECT_TRUE(pages[0].int_sum == 429);
+    EXPECT_EQ(pages[0].num_not_nulls, 4);
+    EXPECT_EQ(pages[0].num_nulls, 3);
+    // the sum of int64 values is kept in 128 bits
+    EXPECT_TRUE(pages[1].has_sum);
+    EXPECT_TRUE(pages[1].int_sum == static_cast<__int128>(std::numeric_limits<int64_t>::max()) * 2);
+    EXPECT_EQ(pages[1].num_not_nulls, 2);
+    EXPECT_EQ(pages[1].num_nulls, 0);
+}
+
+TEST(PageStatsTest, Overflow) {
+    std::unique_ptr<PageStatsWriter> writer;
+    PageStatsWriter::create(FieldType::OLAP_FIELD_TYPE_LARGEINT, &writer);
+    ASSERT_NE(writer, nullptr);
+    std::vector<__int128> values = {std::numeric_limits<__int128>::max(), 1};
+    writer->add_values(values.data(), values.size());
+    writer->flush();
+
+    std::string buf;
+    writer->finish(&buf);
+    std::vector<PageSumStats> pages;
+    ASSERT_TRUE(parse_page_stats(buf, &pages).ok());
+    ASSERT_EQ(pages.size(), 1);
+    EXPECT_FALSE(pages[0].has_sum);
+    EXPECT_EQ(pages[0].num_not_nulls, 2);
+}
+
+TEST(PageStatsTest, DoubleRoundTrip) {
+    std::unique_ptr<PageStatsWriter> writer;
+    PageStatsWriter::create(FieldType::OLAP_FIELD_TYPE_FLOAT, &writer);
+    ASSERT_NE(writer, nullptr);
+    std::vector<float> values = {1.5, 2.25, -0.75};
+    writer->add_values(values.data(), values.size());
+    writer->add_nulls(1);
+    writer->flush();
+
+    std::string buf;
+    writer->finish(&buf);
+    std::vector<PageSumStats> pages;
+    ASSERT_TRUE(parse_page_stats(buf, &pages).ok());
+    ASSERT_EQ(pages.size(), 1);
+    EXPECT_DOUBLE_EQ(pages[0].double_sum, 3.0);
+    EXPECT_EQ(pages[0].num_not_nulls, 3);
+    EXPECT_EQ(pages[0].num_nulls, 1);
+
+    EXPECT_FALSE(parse_page_stats(Slice(buf.data(), buf.size() - 1), &pages).ok());
+}
+
+} // namespace segment_v2
+} // namespace doris
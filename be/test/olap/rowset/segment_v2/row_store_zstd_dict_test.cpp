@@ -0,0 +1,187 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gen_cpp/segment_v2.pb.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "common/consts.h"
+#include "io/fs/file_writer.h"
+#include "io/fs/local_file_system.h"
+#include "olap/iterators.h"
+#include "olap/olap_common.h"
+#include "olap/row_cursor.h"
+#include "olap/rowset/segment_v2/column_reader.h"
+#include "olap/rowset/segment_v2/segment.h"
+#include "olap/rowset/segment_v2/segment_writer.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet_schema.h"
+#include "olap/tablet_schema_helper.h"
+#include "runtime/exec_env.h"
+#include "util/defer_op.h"
+#include "util/faststring.h"
+#include "vec/columns/column_string.h"
+
+namespace doris {
+namespace segment_v2 {
+
+static const std::string kSegmentDir = "./ut_dir/row_store_zstd_dict_test";
+
+class RowStoreZstdDictTest : public testing::Test {
+public:
+    void SetUp() override {
+        auto st = io::global_local_filesystem()->delete_directory(kSegmentDir);
+        ASSERT_TRUE(st.ok()) << st;
+        st = io::global_local_filesystem()->create_directory(kSegmentDir);
+        ASSERT_TRUE(st.ok()) << st;
+        ExecEnv::GetInstance()->set_storage_engine(
+                std::make_unique<StorageEngine>(EngineOptions {}));
+    }
+
+    void TearDown() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(kSegmentDir).ok());
+        ExecEnv::GetInstance()->set_storage_engine(nullptr);
+    }
+
+    // A key column and a row store column of json-like rows sharing their keys
+    static TabletSchemaSPtr create_schema() {
+        TabletSchemaSPtr schema = std::make_shared<TabletSchema>();
+        schema->append_column(*create_int_key(0, false));
+        TabletColumn row_store;
+        row_store._unique_id = 1;
+        row_store._col_name = BeConsts::ROW_STORE_COL;
+        row_store._type = FieldType::OLAP_FIELD_TYPE_STRING;
+        row_store._is_key = false;
+        row_store._is_nullable = false;
+        row_store._length = 2147483643;
+        schema->append_column(row_store);
+        schema->_keys_type = DUP_KEYS;
+        schema->_compression_type = ZSTD;
+        return schema;
+    }
+
+    static std::string row_value(int i) {
+        return R"({"user_id":)" + std::to_string(i) + R"(,"name":"user_)" +
+               std::to_string(i * 7919 % 10007) + R"(","status":"active","region":"ap-southeast"})";
+    }
+
+    void write_and_read(size_t nrows, bool expect_dict) {
+        auto schema = create_schema();
+        std::string path = kSegmentDir + "/0.dat";
+        auto fs = io::global_local_filesystem();
+        io::FileWriterPtr file_writer;
+        ASSERT_TRUE(fs->create_file(path, &file_writer).ok());
+        SegmentWriterOptions opts;
+        SegmentWriter writer(file_writer.get(), 0, schema, nullptr, nullptr, opts, nullptr);
+        ASSERT_TRUE(writer.init().ok());
+
+        RowCursor row;
+        ASSERT_TRUE(row.init(schema).ok());
+        std::vector<std::string> values(nrows);
+        for (size_t i = 0; i < nrows; ++i) {
+            values[i] = row_value(static_cast<int>(i));
+            RowCursorCell key_cell = row.cell(0);
+            key_cell.set_not_null();
+            *(int*)key_cell.mutable_cell_ptr() = static_cast<int>(i);
+            RowCursorCell value_cell = row.cell(1);
+            value_cell.set_not_null();
+            *(Slice*)value_cell.mutable_cell_ptr() = Slice(values[i]);
+            ASSERT_TRUE(writer.append_row(row).ok());
+        }
+        uint64_t file_size = 0;
+        uint64_t index_size = 0;
+        ASSERT_TRUE(writer.finalize(&file_size, &index_size).ok());
+        ASSERT_TRUE(file_writer->close().ok());
+
+        std::shared_ptr<Segment> segment;
+        RowsetId rowset_id;
+        rowset_id.init(1);
+        ASSERT_TRUE(Segment::open(fs, path, 100, 0, rowset_id, schema, io::FileReaderOptions {},
+                                  &segment)
+                            .ok());
+        ASSERT_EQ(segment->num_rows(), nrows);
+
+        OlapReaderStatistics stats;
+        StorageReadOptions read_opts;
+        read_opts.stats = &stats;
+        std::unique_ptr<ColumnIterator> iter;
+        ASSERT_TRUE(segment->new_column_iterator(schema->column(1), &iter, &read_opts).ok());
+        // the dictionary is found in the footer, and only used to decompress
+        auto* reader = segment->_get_column_reader(schema->column(1));
+        ASSERT_NE(reader, nullptr);
+        EXPECT_EQ(reader->get_zstd_dict_codec() != nullptr, expect_dict);
+        if (expect_dict) {
+            faststring compressed;
+            EXPECT_FALSE(reader->get_zstd_dict_codec()->compress(Slice("abc"), &compressed).ok());
+        }
+
+        ColumnIteratorOptions iter_opts;
+        iter_opts.stats = &stats;
+        iter_opts.file_reader = segment->file_reader().get();
+        ASSERT_TRUE(iter->init(iter_opts).ok());
+        ASSERT_TRUE(iter->seek_to_ordinal(0).ok());
+        vectorized::MutableColumnPtr dst = vectorized::ColumnString::create();
+        size_t num_read = nrows;
+        bool has_null = false;
+        ASSERT_TRUE(iter->next_batch(&num_read, dst, &has_null).ok());
+        ASSERT_EQ(num_read, nrows);
+        for (size_t i = 0; i < nrows; ++i) {
+            ASSERT_EQ(dst->get_data_at(i).to_string(), values[i]) << i;
+        }
+
+        // a point read from the middle of the column
+        ASSERT_TRUE(iter->seek_to_ordinal(nrows / 2).ok());
+        dst = vectorized::ColumnString::create();
+        num_read = 1;
+        ASSERT_TRUE(iter->next_batch(&num_read, dst, &has_null).ok());
+        ASSERT_EQ(num_read, 1);
+        EXPECT_EQ(dst->get_data_at(0).to_string(), values[nrows / 2]);
+    }
+};
+
+TEST_F(RowStoreZstdDictTest, RoundTrip) {
+    auto old_enable = config::enable_row_store_zstd_dict;
+    auto old_capacity = config::row_store_zstd_dict_capacity;
+    config::enable_row_store_zstd_dict = true;
+    config::row_store_zstd_dict_capacity = 4096;
+    Defer defer {[&]() {
+        config::enable_row_store_zstd_dict = old_enable;
+        config::row_store_zstd_dict_capacity = old_capacity;
+    }};
+    // about 400KB of rows, the dictionary is trained while the column is written
+    write_and_read(5000, true);
+}
+
+TEST_F(RowStoreZstdDictTest, TooFewSamples) {
+    auto old_enable = config::enable_row_store_zstd_dict;
+    auto old_capacity = config::row_store_zstd_dict_capacity;
+    config::enable_row_store_zstd_dict = true;
+    config::row_store_zstd_dict_capacity = 4096;
+    Defer defer {[&]() {
+        config::enable_row_store_zstd_dict = old_enable;
+        config::row_store_zstd_dict_capacity = old_capacity;
+    }};
+    // less than 4 times the capacity of samples, the pages are compressed without a dictionary
+    write_and_read(100, false);
+}
+
+} // namespace segment_v2
+} // namespace doris
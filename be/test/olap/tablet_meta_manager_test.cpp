@@ -30,9 +30,13 @@
 #include <new>
 #include <roaring/roaring.hh>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest_pred_impl.h"
 #include "olap/data_dir.h"
+#include "olap/olap_define.h"
+#include "olap/olap_meta.h"
+#include "olap/rowset/rowset_meta.h"
 #include "olap/storage_engine.h"
 using std::string;
 
@@ -113,6 +117,115 @@ TEST_F(TabletMetaManagerTest, TestLoad) {
     // EXPECT_EQ(_json_header, json_meta_read);
 }
 
+TEST_F(TabletMetaManagerTest, TestSaveWithSeparateRsMetas) {
+    const TTabletId tablet_id = 15673;
+    const TSchemaHash schema_hash = 567997578;
+    TabletMetaPB tablet_meta_pb;
+    tablet_meta_pb.set_tablet_id(tablet_id);
+    tablet_meta_pb.set_schema_hash(schema_hash);
+    std::string meta_binary;
+    tablet_meta_pb.SerializeToString(&meta_binary);
+
+    std::vector<RowsetMetaSharedPtr> rs_metas;
+    for (int64_t i = 0; i < 4; ++i) {
+        RowsetId rowset_id;
+        rowset_id.init(2, 0, 1, i);
+        RowsetMetaPB rs_meta_pb;
+        rs_meta_pb.set_rowset_id_v2(rowset_id.to_string());
+        rs_meta_pb.set_tablet_id(tablet_id);
+        rs_meta_pb.set_start_version(i);
+        rs_meta_pb.set_end_version(i);
+        auto rs_meta = std::make_shared<RowsetMeta>();
+        rs_meta->init_from_pb(rs_meta_pb);
+        rs_metas.push_back(rs_meta);
+    }
+    TabletSeparateRsIds read_rs_ids;
+    auto read_meta = [&](TabletMetaPB* meta_pb) {
+        std::string value;
+        auto func = [&](long id, long hash, std::string_view meta,
+                        const TabletSeparateRsIds& rs_ids) {
+            EXPECT_EQ(id, tablet_id);
+            EXPECT_EQ(hash, schema_hash);
+            value = meta;
+            read_rs_ids = rs_ids;
+            return true;
+        };
+        EXPECT_TRUE(TabletMetaManager::traverse_headers(_data_dir->get_meta(), func).ok());
+        EXPECT_TRUE(meta_pb->ParseFromString(value));
+    };
+
+    // nothing is saved under separate keys yet, a full save does not look for them
+    EXPECT_FALSE(_data_dir->may_have_separate_rs_metas());
+    TabletRsMetaDelta delta;
+    delta.save_all = true;
+    delta.rs_metas_to_save = {rs_metas[0], rs_metas[1], rs_metas[2]};
+    Status s = TabletMetaManager::save_with_separate_rs_metas(_data_dir, tablet_id, schema_hash,
+                                                              meta_binary, delta);
+    EXPECT_EQ(Status::OK(), s);
+    EXPECT_TRUE(_data_dir->may_have_separate_rs_metas());
+    TabletMetaPB meta_read_pb;
+    read_meta(&meta_read_pb);
+    EXPECT_EQ(meta_read_pb.tablet_id(), tablet_id);
+    EXPECT_EQ(meta_read_pb.rs_metas_size(), 3);
+    EXPECT_EQ(meta_read_pb.stale_rs_metas_size(), 0);
+    EXPECT_EQ(read_rs_ids.rs_ids,
+              (std::vector<RowsetId> {rs_metas[0]->rowset_id(), rs_metas[1]->rowset_id(),
+                                      rs_metas[2]->rowset_id()}));
+    EXPECT_TRUE(read_rs_ids.stale_rs_ids.empty());
+
+    // rowsets 0 and 1 are compacted into rowset 3
+    delta = TabletRsMetaDelta();
+    delta.rs_metas_to_save = {rs_metas[3]};
+    delta.stale_rs_metas_to_save = {rs_metas[0], rs_metas[1]};
+    delta.rs_ids_to_remove = {rs_metas[0]->rowset_id(), rs_metas[1]->rowset_id()};
+    s = TabletMetaManager::save_with_separate_rs_metas(_data_dir, tablet_id, schema_hash,
+                                                       meta_binary, delta);
+    EXPECT_EQ(Status::OK(), s);
+    read_meta(&meta_read_pb);
+    ASSERT_EQ(meta_read_pb.rs_metas_size(), 2);
+    EXPECT_EQ(meta_read_pb.rs_metas(0).rowset_id_v2(), rs_metas[2]->rowset_id().to_string());
+    EXPECT_EQ(meta_read_pb.rs_metas(1).rowset_id_v2(), rs_metas[3]->rowset_id().to_string());
+    EXPECT_EQ(meta_read_pb.stale_rs_metas_size(), 2);
+    EXPECT_EQ(read_rs_ids.stale_rs_ids,
+              (std::vector<RowsetId> {rs_metas[0]->rowset_id(), rs_metas[1]->rowset_id()}));
+
+    // the rowset metas loaded from them are taken as saved, and the saved rowset ids without a
+    // rowset meta any more are removed by the next save
+    TabletMetaSharedPtr tablet_meta(new TabletMeta());
+    tablet_meta->_rs_metas = {rs_metas[2], rs_metas[3]};
+    tablet_meta->_stale_rs_metas = {rs_metas[0]};
+    tablet_meta->init_separately_saved_rs_metas(read_rs_ids);
+    EXPECT_TRUE(tablet_meta->_rs_metas_saved_separately);
+    EXPECT_EQ(tablet_meta->_saved_rs_metas.size(), 2);
+    EXPECT_EQ(tablet_meta->_saved_rs_metas[rs_metas[2]->rowset_id()], rs_metas[2]);
+    EXPECT_EQ(tablet_meta->_saved_rs_metas[rs_metas[3]->rowset_id()], rs_metas[3]);
+    EXPECT_EQ(tablet_meta->_saved_stale_rs_metas.size(), 2);
+    EXPECT_EQ(tablet_meta->_saved_stale_rs_metas[rs_metas[0]->rowset_id()], rs_metas[0]);
+    EXPECT_EQ(tablet_meta->_saved_stale_rs_metas[rs_metas[1]->rowset_id()], nullptr);
+
+    // a full save replaces the rowset metas saved under separate keys
+    s = TabletMetaManager::save(_data_dir, tablet_id, schema_hash, meta_binary);
+    EXPECT_EQ(Status::OK(), s);
+    read_meta(&meta_read_pb);
+    EXPECT_EQ(meta_read_pb.rs_metas_size(), 0);
+    EXPECT_EQ(meta_read_pb.stale_rs_metas_size(), 0);
+
+    s = TabletMetaManager::save_with_separate_rs_metas(_data_dir, tablet_id, schema_hash,
+                                                       meta_binary, delta);
+    EXPECT_EQ(Status::OK(), s);
+    s = TabletMetaManager::remove(_data_dir, tablet_id, schema_hash);
+    EXPECT_EQ(Status::OK(), s);
+    size_t num_keys = 0;
+    for (auto prefix : {TABLET_RS_META_PREFIX, TABLET_STALE_RS_META_PREFIX}) {
+        static_cast<void>(_data_dir->get_meta()->iterate(META_COLUMN_FAMILY_INDEX, prefix,
+                                                         [&](std::string_view, std::string_view) {
+                                                             ++num_keys;
+                                                             return true;
+                                                         }));
+    }
+    EXPECT_EQ(num_keys, 0);
+}
+
 TEST_F(TabletMetaManagerTest, TestDeleteBitmapEncode) {
     TTabletId tablet_id = 1234;
     int64_t version = 456;
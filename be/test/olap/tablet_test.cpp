@@ -24,6 +24,7 @@
 #include <gtest/gtest-test-part.h>
 #include <unistd.h>
 
+#include <functional>
 #include <memory>
 
 #include "gtest/gtest_pred_impl.h"
@@ -40,6 +41,8 @@
 #include "olap/utils.h"
 #include "runtime/exec_env.h"
 #include "testutil/mock_rowset.h"
+#include "util/debug_points.h"
+#include "util/defer_op.h"
 #include "util/time.h"
 #include "util/uid_util.h"
 
@@ -304,6 +307,164 @@ TEST_F(TestTablet, pad_rowset) {
     ASSERT_TRUE(_tablet->capture_rs_readers(version, &splits, false).ok());
 }
 
+TEST_F(TestTablet, capture_rowsets_from_snapshot) {
+    bool old_enable_lock_free_rowset_capture = config::enable_lock_free_rowset_capture;
+    config::enable_lock_free_rowset_capture = true;
+    Defer defer_config {[&]() {
+        config::enable_lock_free_rowset_capture = old_enable_lock_free_rowset_capture;
+    }};
+    std::vector<RowsetMetaSharedPtr> rs_metas;
+    for (auto [start, end] : std::vector<std::pair<int64_t, int64_t>> {{0, 1}, {2, 3}, {4, 5}}) {
+        auto ptr = std::make_shared<RowsetMeta>();
+        init_rs_meta(ptr, start, end);
+        rs_metas.push_back(ptr);
+        static_cast<void>(_tablet_meta->add_rs_meta(ptr));
+    }
+    static_cast<void>(_data_dir->init());
+    TabletSharedPtr _tablet(new Tablet(*k_engine, _tablet_meta, _data_dir.get()));
+    static_cast<void>(_tablet->init());
+
+    std::vector<RowsetSharedPtr> rowsets;
+    ASSERT_TRUE(_tablet->_capture_consistent_rowsets_from_snapshot({0, 5}, &rowsets));
+    ASSERT_EQ(rowsets.size(), 3);
+    EXPECT_EQ(rowsets[2]->version(), Version(4, 5));
+    ASSERT_TRUE(_tablet->_capture_consistent_rowsets_from_snapshot({2, 3}, &rowsets));
+    ASSERT_EQ(rowsets.size(), 1);
+    EXPECT_EQ(rowsets[0]->version(), Version(2, 3));
+    // not the end of a rowset
+    EXPECT_FALSE(_tablet->_capture_consistent_rowsets_from_snapshot({0, 4}, &rowsets));
+    // not the start of a rowset
+    EXPECT_FALSE(_tablet->_capture_consistent_rowsets_from_snapshot({1, 5}, &rowsets));
+    // missing versions
+    EXPECT_FALSE(_tablet->_capture_consistent_rowsets_from_snapshot({0, 6}, &rowsets));
+
+    // compact [2-3] and [4-5] into [2-5]
+    auto ptr = std::make_shared<RowsetMeta>();
+    init_rs_meta(ptr, 2, 5);
+    std::vector<RowsetSharedPtr> to_add {make_shared<BetaRowset>(nullptr, ptr, "")};
+    std::vector<RowsetSharedPtr> to_delete {_tablet->get_rowset_by_version({2, 3}),
+                                            _tablet->get_rowset_by_version({4, 5})};
+    {
+        std::lock_guard wrlock(_tablet->get_header_lock());
+        ASSERT_TRUE(_tablet->modify_rowsets(to_add, to_delete).ok());
+    }
+    ASSERT_TRUE(_tablet->_capture_consistent_rowsets_from_snapshot({0, 5}, &rowsets));
+    ASSERT_EQ(rowsets.size(), 2);
+    EXPECT_EQ(rowsets[1]->version(), Version(2, 5));
+    // the path of [0-3] goes through the stale rowsets, which are captured under the meta lock
+    EXPECT_FALSE(_tablet->_capture_consistent_rowsets_from_snapshot({0, 3}, &rowsets));
+    std::vector<RowSetSplits> splits;
+    ASSERT_TRUE(_tablet->capture_rs_readers({0, 3}, &splits, false).ok());
+    EXPECT_EQ(splits.size(), 2);
+}
+
+TEST_F(TestTablet, publish_rowset_snapshot_after_incremental_clone) {
+    bool old_enable_lock_free_rowset_capture = config::enable_lock_free_rowset_capture;
+    config::enable_lock_free_rowset_capture = true;
+    Defer defer_config {[&]() {
+        config::enable_lock_free_rowset_capture = old_enable_lock_free_rowset_capture;
+    }};
+    std::vector<RowsetMetaSharedPtr> rs_metas;
+    for (auto [start, end] : std::vector<std::pair<int64_t, int64_t>> {{0, 1}, {2, 3}, {4, 5}}) {
+        auto ptr = std::make_shared<RowsetMeta>();
+        init_rs_meta(ptr, start, end);
+        rs_metas.push_back(ptr);
+        static_cast<void>(_tablet_meta->add_rs_meta(ptr));
+    }
+    static_cast<void>(_data_dir->init());
+    TabletSharedPtr _tablet(new Tablet(*k_engine, _tablet_meta, _data_dir.get()));
+    static_cast<void>(_tablet->init());
+
+    bool old_enable_debug_points = config::enable_debug_points;
+    config::enable_debug_points = true;
+    Defer defer {[&]() {
+        DebugPoints::instance()->clear();
+        config::enable_debug_points = old_enable_debug_points;
+    }};
+    // when the delete bitmaps are calculated, the cloned rowset is in the tablet but queries
+    // capturing from the snapshot do not see it yet
+    bool called = false;
+    std::function<void(Tablet*)> check_unpublished = [&](Tablet* tablet) {
+        called = true;
+        std::vector<RowsetSharedPtr> rowsets;
+        EXPECT_NE(tablet->get_rowset_by_version({6, 7}), nullptr);
+        EXPECT_FALSE(tablet->_capture_consistent_rowsets_from_snapshot({0, 7}, &rowsets));
+        EXPECT_TRUE(tablet->_capture_consistent_rowsets_from_snapshot({0, 5}, &rowsets));
+    };
+    DebugPoints::instance()->add_with_callback("Tablet.revise_tablet_meta.delete_bitmap_calculated",
+                                               check_unpublished);
+
+    auto ptr = std::make_shared<RowsetMeta>();
+    init_rs_meta(ptr, 6, 7);
+    std::vector<RowsetSharedPtr> to_add {make_shared<BetaRowset>(nullptr, ptr, "")};
+    {
+        std::lock_guard wrlock(_tablet->get_header_lock());
+        ASSERT_TRUE(_tablet->revise_tablet_meta(to_add, {}, true).ok());
+    }
+    EXPECT_TRUE(called);
+    std::vector<RowsetSharedPtr> rowsets;
+    ASSERT_TRUE(_tablet->_capture_consistent_rowsets_from_snapshot({0, 7}, &rowsets));
+    ASSERT_EQ(rowsets.size(), 4);
+    EXPECT_EQ(rowsets[3]->version(), Version(6, 7));
+    EXPECT_FALSE(_tablet->_defer_rowset_snapshot_publish);
+}
+
+TEST_F(TestTablet, publish_rowset_snapshot_by_config) {
+    bool old_enable_lock_free_rowset_capture = config::enable_lock_free_rowset_capture;
+    config::enable_lock_free_rowset_capture = false;
+    Defer defer_config {[&]() {
+        config::enable_lock_free_rowset_capture = old_enable_lock_free_rowset_capture;
+    }};
+    int64_t rowset_id = 10000;
+    auto create_rowset = [&](int64_t start, int64_t end) {
+        auto ptr = std::make_shared<RowsetMeta>();
+        init_rs_meta(ptr, start, end);
+        RowsetId id;
+        id.init(++rowset_id);
+        ptr->set_rowset_id(id);
+        return std::make_shared<BetaRowset>(nullptr, ptr, "");
+    };
+    for (auto [start, end] : std::vector<std::pair<int64_t, int64_t>> {{0, 1}, {2, 3}, {4, 5}}) {
+        static_cast<void>(_tablet_meta->add_rs_meta(create_rowset(start, end)->rowset_meta()));
+    }
+    static_cast<void>(_data_dir->init());
+    TabletSharedPtr _tablet(new Tablet(*k_engine, _tablet_meta, _data_dir.get()));
+    static_cast<void>(_tablet->init());
+
+    // no snapshot is kept while the capture is disabled
+    EXPECT_EQ(_tablet->_rowset_snapshot.get(), nullptr);
+    std::vector<RowsetSharedPtr> rowsets;
+    EXPECT_FALSE(_tablet->_capture_consistent_rowsets_from_snapshot({0, 5}, &rowsets));
+    std::vector<RowSetSplits> splits;
+    ASSERT_TRUE(_tablet->capture_rs_readers({0, 5}, &splits, false).ok());
+    EXPECT_EQ(splits.size(), 3);
+
+    // the snapshot is built again on the next change of the rowsets
+    config::enable_lock_free_rowset_capture = true;
+    ASSERT_TRUE(_tablet->add_rowset(create_rowset(8, 9)).ok());
+    ASSERT_TRUE(_tablet->add_rowset(create_rowset(6, 7)).ok());
+    auto snapshot = _tablet->_rowset_snapshot.get();
+    ASSERT_NE(snapshot, nullptr);
+    ASSERT_TRUE(_tablet->_capture_consistent_rowsets_from_snapshot({0, 9}, &rowsets));
+    ASSERT_EQ(rowsets.size(), 5);
+    EXPECT_EQ(rowsets[3]->version(), Version(6, 7));
+    EXPECT_EQ(rowsets[4]->version(), Version(8, 9));
+
+    // a rowset containing the existing ones replaces them in order
+    ASSERT_TRUE(_tablet->add_rowset(create_rowset(2, 7)).ok());
+    ASSERT_TRUE(_tablet->_capture_consistent_rowsets_from_snapshot({0, 9}, &rowsets));
+    ASSERT_EQ(rowsets.size(), 3);
+    EXPECT_EQ(rowsets[0]->version(), Version(0, 1));
+    EXPECT_EQ(rowsets[1]->version(), Version(2, 7));
+    EXPECT_EQ(rowsets[2]->version(), Version(8, 9));
+    // the previous snapshot is not changed
+    EXPECT_EQ(snapshot->rowsets.size(), 5);
+
+    config::enable_lock_free_rowset_capture = false;
+    ASSERT_TRUE(_tablet->add_rowset(create_rowset(10, 11)).ok());
+    EXPECT_EQ(_tablet->_rowset_snapshot.get(), nullptr);
+}
+
 TEST_F(TestTablet, cooldown_policy) {
     std::vector<RowsetMetaSharedPtr> rs_metas;
     RowsetMetaSharedPtr ptr1(new RowsetMeta());
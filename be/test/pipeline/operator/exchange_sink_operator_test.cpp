@@ -23,6 +23,10 @@
 #include <vector>
 
 #include "pipeline/operator/operator_helper.h"
+#include "pipeline/thrift_builder.h"
+#include "runtime_filter/runtime_filter_consumer.h"
+#include "runtime_filter/runtime_filter_mgr.h"
+#include "runtime_filter/runtime_filter_producer.h"
 #include "testutil/column_helper.h"
 #include "testutil/mock/mock_data_stream_sender.h"
 #include "testutil/mock/mock_descriptors.h"
@@ -70,7 +74,8 @@ struct ChannelInfo {
     TUniqueId fragment_instance_id;
 };
 
-auto create_exchange_sink(std::vector<ChannelInfo> channel_info) {
+auto create_exchange_sink(std::vector<ChannelInfo> channel_info,
+                          std::vector<TRuntimeFilterDesc> runtime_filter_descs = {}) {
     std::shared_ptr<OperatorContext> ctx = std::make_shared<OperatorContext>();
 
     ctx->state._fragment_instance_id = fragment_instance_id;
@@ -78,6 +83,17 @@ auto create_exchange_sink(std::vector<ChannelInfo> channel_info) {
     std::shared_ptr<MockExchangeSinkOperatorX> op =
             std::make_shared<MockExchangeSinkOperatorX>(*ctx);
     EXPECT_TRUE(op->prepare(&ctx->state));
+    if (!runtime_filter_descs.empty()) {
+        op->_runtime_filter_descs = runtime_filter_descs;
+        ctx->state.set_runtime_filter_mgr(ctx->pool.add(new RuntimeFilterMgr(false)));
+        // the target exprs of the filters refer to the slot of the sink's row
+        auto* desc_tbl = ctx->pool.add(new DescriptorTbl());
+        desc_tbl->_slot_desc_map[0] = op->_row_desc.tuple_descriptors()[0]->slots()[0];
+        ctx->state.set_desc_tbl(desc_tbl);
+        if (ExecEnv::GetInstance()->runtime_filter_timer_queue() == nullptr) {
+            ExecEnv::GetInstance()->_init_runtime_filter_timer_queue();
+        }
+    }
 
     auto local_state = std::make_unique<MockExchangeLocalState>(op.get(), &ctx->state);
 
@@ -189,4 +205,45 @@ TEST(ExchangeSinkOperatorTest, test_some_api) {
     EXPECT_TRUE(exchange_sink_local_state->_finish_dependency->ready());
 }
 
+TEST(ExchangeSinkOperatorTest, test_runtime_filter) {
+    std::vector<TRuntimeFilterDesc> runtime_filter_descs = {
+            TRuntimeFilterDescBuilder()
+                    .set_type(TRuntimeFilterType::IN)
+                    .add_planId_to_target_expr(0)
+                    .build()};
+    auto [op, ctx, mock_channel] = create_exchange_sink(
+            {{.is_local = true, .fragment_instance_id = create_TUniqueId(1, 1)},
+             {.is_local = false, .fragment_instance_id = create_TUniqueId(1, 2)}},
+            runtime_filter_descs);
+    auto* local_state = dynamic_cast<MockExchangeLocalState*>(ctx->state.get_sink_local_state());
+    ASSERT_TRUE(local_state != nullptr);
+    ASSERT_TRUE(local_state->_runtime_filter_helper != nullptr);
+    // the sink does not wait for the filters
+    EXPECT_TRUE(local_state->_runtime_filter_conjuncts.empty());
+
+    // an IN filter of {1, 3} arrives after the sink is opened
+    std::shared_ptr<RuntimeFilterProducer> producer;
+    ASSERT_TRUE(RuntimeFilterProducer::create(ctx->state.get_query_ctx(),
+                                              runtime_filter_descs.data(), &producer)
+                        .ok());
+    ASSERT_TRUE(producer->init(2).ok());
+    ASSERT_TRUE(
+            producer->insert(ColumnHelper::create_column<DataTypeInt32>({1, 3}), 0).ok());
+    producer->set_wrapper_state_and_ready_to_publish(RuntimeFilterWrapper::State::READY);
+    local_state->_runtime_filter_helper->_consumers[0]->signal(producer.get());
+
+    bool eos = true;
+    vectorized::Block block = ColumnHelper::create_block<DataTypeInt32>({1, 2, 3, 4});
+    auto st = op->sink(&ctx->state, &block, eos);
+    EXPECT_TRUE(st.ok()) << st.msg();
+
+    EXPECT_EQ(local_state->_runtime_filter_conjuncts.size(), 1);
+    EXPECT_EQ(local_state->_rows_filtered_by_runtime_filter->value(), 2);
+    // the rows rejected by the filter are not sent
+    for (auto c : mock_channel) {
+        EXPECT_TRUE(ColumnHelper::block_equal(ColumnHelper::create_block<DataTypeInt32>({1, 3}),
+                                              c->get_block()));
+    }
+}
+
 } // namespace doris::pipeline
@@ -0,0 +1,333 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/exec/nested_loop_join_probe_operator.h"
+
+#include <gen_cpp/PlanNodes_types.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "pipeline/exec/mock_operator.h"
+#include "testutil/column_helper.h"
+#include "testutil/mock/mock_descriptors.h"
+#include "testutil/mock/mock_runtime_state.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris::pipeline {
+
+using namespace vectorized;
+
+namespace {
+
+std::optional<int64_t> value_at(const IColumn& column, size_t row) {
+    if (column.is_null_at(row)) {
+        return std::nullopt;
+    }
+    const IColumn& nested = column.is_nullable()
+                                    ? assert_cast<const ColumnNullable&>(column).get_nested_column()
+                                    : column;
+    return assert_cast<const ColumnInt64&>(nested).get_element(row);
+}
+
+// Join conjunct `column lhs < column rhs`, a pair with a null operand does not match.
+class MockLessExpr final : public VExpr {
+public:
+    MockLessExpr(int lhs, int rhs) : _lhs(lhs), _rhs(rhs) {
+        _data_type = std::make_shared<DataTypeUInt8>();
+    }
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override {
+        auto lhs = block->get_by_position(_lhs).column->convert_to_full_column_if_const();
+        auto rhs = block->get_by_position(_rhs).column->convert_to_full_column_if_const();
+        auto result = ColumnUInt8::create(block->rows());
+        for (size_t i = 0; i < block->rows(); ++i) {
+            auto l = value_at(*lhs, i);
+            auto r = value_at(*rhs, i);
+            result->get_data()[i] = l.has_value() && r.has_value() && *l < *r;
+        }
+        block->insert({std::move(result), _data_type, "less"});
+        *result_column_id = static_cast<int>(block->columns() - 1);
+        return Status::OK();
+    }
+    Status prepare(RuntimeState* state, const RowDescriptor& desc, VExprContext* context) override {
+        _prepare_finished = true;
+        return Status::OK();
+    }
+    Status open(RuntimeState* state, VExprContext* context,
+                FunctionContext::FunctionStateScope scope) override {
+        _open_finished = true;
+        return Status::OK();
+    }
+    const std::string& expr_name() const override { return _name; }
+
+private:
+    const int _lhs;
+    const int _rhs;
+    const std::string _name = "MockLessExpr";
+};
+
+using Row = std::pair<std::optional<int64_t>, std::optional<int64_t>>;
+
+} // namespace
+
+struct NestedLoopJoinProbeOperatorTest : public ::testing::Test {
+    void SetUp() override {
+        state = std::make_shared<MockRuntimeState>();
+        state->batsh_size = 4;
+    }
+
+    void create_op(TJoinOp::type join_op, bool with_conjunct,
+                   const std::vector<std::vector<int64_t>>& build_blocks) {
+        DataTypePtr probe_type = std::make_shared<DataTypeInt64>();
+        DataTypePtr build_type = std::make_shared<DataTypeInt64>();
+        if (join_op == TJoinOp::RIGHT_OUTER_JOIN || join_op == TJoinOp::FULL_OUTER_JOIN) {
+            probe_type = make_nullable(probe_type);
+        }
+        if (join_op == TJoinOp::LEFT_OUTER_JOIN || join_op == TJoinOp::FULL_OUTER_JOIN) {
+            build_type = make_nullable(build_type);
+        }
+        desc_tbl = std::make_unique<MockDescriptorTbl>(DataTypes {probe_type, build_type}, &pool);
+
+        TPlanNode tnode;
+        tnode.node_id = 0;
+        tnode.node_type = TPlanNodeType::CROSS_JOIN_NODE;
+        tnode.limit = -1;
+        tnode.row_tuples = {0};
+        tnode.nullable_tuples = {false};
+        tnode.__set_output_tuple_id(0);
+        tnode.__isset.nested_loop_join_node = true;
+        tnode.nested_loop_join_node.join_op = join_op;
+        tnode.nested_loop_join_node.vintermediate_tuple_id_list = {0};
+
+        op = std::make_unique<NestedLoopJoinProbeOperatorX>(&pool, tnode, -1, *desc_tbl);
+        op->_child = std::make_shared<MockOperatorX>();
+        op->_num_probe_side_columns = 1;
+        op->_num_build_side_columns = 1;
+        if (with_conjunct) {
+            auto ctx = VExprContext::create_shared(std::make_shared<MockLessExpr>(0, 1));
+            ctx->_prepared = true;
+            ctx->_opened = true;
+            op->_join_conjuncts = {ctx};
+        }
+
+        shared_state = NestedLoopJoinSharedState::create_shared();
+        switch (join_op) {
+#define M(NAME)                                                                   \
+    case TJoinOp::NAME:                                                           \
+        shared_state->join_op_variants                                            \
+                .emplace<std::integral_constant<TJoinOp::type, TJoinOp::NAME>>(); \
+        break;
+            M(INNER_JOIN)
+            M(CROSS_JOIN)
+            M(LEFT_OUTER_JOIN)
+            M(RIGHT_OUTER_JOIN)
+            M(FULL_OUTER_JOIN)
+            M(LEFT_SEMI_JOIN)
+            M(LEFT_ANTI_JOIN)
+            M(RIGHT_SEMI_JOIN)
+            M(RIGHT_ANTI_JOIN)
+#undef M
+        default:
+            FAIL() << "unexpected join op " << join_op;
+        }
+        for (const auto& values : build_blocks) {
+            shared_state->build_blocks.push_back(ColumnHelper::create_block<DataTypeInt64>(values));
+            shared_state->build_side_visited_flags.push_back(
+                    ColumnUInt8::create(values.size(), 0));
+        }
+
+        auto local_state_uptr = NestedLoopJoinProbeLocalState::create_unique(state.get(), op.get());
+        local_state = local_state_uptr.get();
+        LocalStateInfo info {.parent_profile = &profile,
+                             .scan_ranges = {},
+                             .shared_state = shared_state.get(),
+                             .shared_state_map = {},
+                             .task_idx = 0};
+        EXPECT_TRUE(local_state->init(state.get(), info));
+        state->resize_op_id_to_local_state(-100);
+        state->emplace_local_state(op->operator_id(), std::move(local_state_uptr));
+        EXPECT_TRUE(local_state->open(state.get()));
+    }
+
+    // Pushes the probe blocks and pulls the join result until eos, the side which a semi or
+    // anti join does not output is left empty in the returned rows.
+    std::vector<Row> run(TJoinOp::type join_op, const std::vector<std::vector<int64_t>>& probe) {
+        const bool output_probe =
+                join_op != TJoinOp::RIGHT_SEMI_JOIN && join_op != TJoinOp::RIGHT_ANTI_JOIN;
+        const bool output_build =
+                join_op != TJoinOp::LEFT_SEMI_JOIN && join_op != TJoinOp::LEFT_ANTI_JOIN;
+        std::vector<Row> rows;
+        bool eos = false;
+        for (size_t i = 0; i < probe.size() && !eos; ++i) {
+            *local_state->_child_block = ColumnHelper::create_block<DataTypeInt64>(probe[i]);
+            EXPECT_TRUE(op->push(state.get(), local_state->_child_block.get(),
+                                 i + 1 == probe.size()));
+            for (int pulls = 0; !eos && !op->need_more_input_data(state.get()); ++pulls) {
+                EXPECT_LT(pulls, 1000);
+                Block block;
+                EXPECT_TRUE(op->pull(state.get(), &block, &eos));
+                for (size_t row = 0; row < block.rows(); ++row) {
+                    rows.emplace_back(output_probe ? value_at(*block.get_by_position(0).column, row)
+                                                   : std::nullopt,
+                                      output_build ? value_at(*block.get_by_position(1).column, row)
+                                                   : std::nullopt);
+                }
+            }
+        }
+        EXPECT_TRUE(eos);
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    // The result of the join computed pair by pair.
+    static std::vector<Row> expected(TJoinOp::type join_op, bool with_conjunct,
+                                     const std::vector<std::vector<int64_t>>& probe,
+                                     const std::vector<std::vector<int64_t>>& build) {
+        std::vector<int64_t> probe_values;
+        std::vector<int64_t> build_values;
+        for (const auto& values : probe) {
+            probe_values.insert(probe_values.end(), values.begin(), values.end());
+        }
+        for (const auto& values : build) {
+            build_values.insert(build_values.end(), values.begin(), values.end());
+        }
+        std::vector<bool> probe_matched(probe_values.size(), false);
+        std::vector<bool> build_matched(build_values.size(), false);
+        std::vector<Row> pairs;
+        for (size_t i = 0; i < probe_values.size(); ++i) {
+            for (size_t j = 0; j < build_values.size(); ++j) {
+                if (!with_conjunct || probe_values[i] < build_values[j]) {
+                    probe_matched[i] = build_matched[j] = true;
+                    pairs.emplace_back(probe_values[i], build_values[j]);
+                }
+            }
+        }
+
+        std::vector<Row> rows;
+        const bool keep_unmatched_probe =
+                join_op == TJoinOp::LEFT_OUTER_JOIN || join_op == TJoinOp::FULL_OUTER_JOIN;
+        const bool keep_unmatched_build =
+                join_op == TJoinOp::RIGHT_OUTER_JOIN || join_op == TJoinOp::FULL_OUTER_JOIN;
+        switch (join_op) {
+        case TJoinOp::LEFT_SEMI_JOIN:
+        case TJoinOp::LEFT_ANTI_JOIN:
+            for (size_t i = 0; i < probe_values.size(); ++i) {
+                if (probe_matched[i] == (join_op == TJoinOp::LEFT_SEMI_JOIN)) {
+                    rows.emplace_back(probe_values[i], std::nullopt);
+                }
+            }
+            break;
+        case TJoinOp::RIGHT_SEMI_JOIN:
+        case TJoinOp::RIGHT_ANTI_JOIN:
+            for (size_t j = 0; j < build_values.size(); ++j) {
+                if (build_matched[j] == (join_op == TJoinOp::RIGHT_SEMI_JOIN)) {
+                    rows.emplace_back(std::nullopt, build_values[j]);
+                }
+            }
+            break;
+        default:
+            rows = pairs;
+            for (size_t i = 0; keep_unmatched_probe && i < probe_values.size(); ++i) {
+                if (!probe_matched[i]) {
+                    rows.emplace_back(probe_values[i], std::nullopt);
+                }
+            }
+            for (size_t j = 0; keep_unmatched_build && j < build_values.size(); ++j) {
+                if (!build_matched[j]) {
+                    rows.emplace_back(std::nullopt, build_values[j]);
+                }
+            }
+        }
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    void check(TJoinOp::type join_op, bool with_conjunct,
+               const std::vector<std::vector<int64_t>>& probe,
+               const std::vector<std::vector<int64_t>>& build) {
+        SetUp();
+        create_op(join_op, with_conjunct, build);
+        EXPECT_EQ(run(join_op, probe), expected(join_op, with_conjunct, probe, build))
+                << "join op " << join_op << ", with conjunct " << with_conjunct;
+    }
+
+    RuntimeProfile profile {"test"};
+    ObjectPool pool;
+    std::unique_ptr<MockDescriptorTbl> desc_tbl;
+    std::unique_ptr<NestedLoopJoinProbeOperatorX> op;
+    std::shared_ptr<NestedLoopJoinSharedState> shared_state;
+    NestedLoopJoinProbeLocalState* local_state = nullptr;
+    std::shared_ptr<MockRuntimeState> state;
+};
+
+TEST_F(NestedLoopJoinProbeOperatorTest, test_join_ops) {
+    const std::vector<std::vector<int64_t>> probe {{1, 2, 3, 4, 5, 6}, {7, 8}, {0}};
+    const std::vector<std::vector<int64_t>> build {{3, 1, 6}, {9}, {0, 2}, {5, 4, 7, 8, 10}};
+    for (auto join_op : {TJoinOp::INNER_JOIN, TJoinOp::CROSS_JOIN, TJoinOp::LEFT_OUTER_JOIN,
+                         TJoinOp::RIGHT_OUTER_JOIN, TJoinOp::FULL_OUTER_JOIN,
+                         TJoinOp::LEFT_SEMI_JOIN, TJoinOp::LEFT_ANTI_JOIN,
+                         TJoinOp::RIGHT_SEMI_JOIN, TJoinOp::RIGHT_ANTI_JOIN}) {
+        check(join_op, true, probe, build);
+        check(join_op, false, probe, build);
+    }
+}
+
+TEST_F(NestedLoopJoinProbeOperatorTest, test_all_filtered) {
+    // No pair matches the join conjunct, every evaluated build block is filtered entirely.
+    const std::vector<std::vector<int64_t>> probe {{5, 6, 7}, {8, 9}};
+    const std::vector<std::vector<int64_t>> build {{1, 2}, {0}, {3, 4, 5}};
+    for (auto join_op : {TJoinOp::INNER_JOIN, TJoinOp::CROSS_JOIN, TJoinOp::LEFT_OUTER_JOIN,
+                         TJoinOp::RIGHT_OUTER_JOIN, TJoinOp::FULL_OUTER_JOIN,
+                         TJoinOp::LEFT_SEMI_JOIN, TJoinOp::LEFT_ANTI_JOIN,
+                         TJoinOp::RIGHT_SEMI_JOIN, TJoinOp::RIGHT_ANTI_JOIN}) {
+        check(join_op, true, probe, build);
+    }
+    SetUp();
+    create_op(TJoinOp::INNER_JOIN, true, build);
+    EXPECT_TRUE(run(TJoinOp::INNER_JOIN, probe).empty());
+}
+
+TEST_F(NestedLoopJoinProbeOperatorTest, test_filter_before_materialize) {
+    // Inner and cross joins with join conjuncts only materialize the matched pairs, the
+    // number of evaluated pairs of one call is bounded by 4 times of the batch size.
+    const std::vector<std::vector<int64_t>> build {{100, 1, 2, 3, 4, 5, 6, 7, 8, 9}};
+    create_op(TJoinOp::INNER_JOIN, true, build);
+    *local_state->_child_block = ColumnHelper::create_block<DataTypeInt64>({50, 60, 70, 80, 90});
+    EXPECT_TRUE(local_state->_can_filter_before_materialize());
+    EXPECT_TRUE(op->push(state.get(), local_state->_child_block.get(), true));
+    // Every probe row matches one build row only, two build blocks of 10 rows are evaluated
+    // before the cap of 16 evaluated pairs stops the call.
+    EXPECT_EQ(local_state->_join_block.rows(), 2);
+    EXPECT_FALSE(local_state->_matched_rows_done);
+
+    SetUp();
+    create_op(TJoinOp::LEFT_OUTER_JOIN, true, build);
+    *local_state->_child_block = ColumnHelper::create_block<DataTypeInt64>({50});
+    EXPECT_FALSE(local_state->_can_filter_before_materialize());
+}
+
+} // namespace doris::pipeline
@@ -26,7 +26,9 @@
 #include "testutil/column_helper.h"
 #include "testutil/mock/mock_descriptors.h"
 #include "testutil/mock/mock_slot_ref.h"
+#include "vec/columns/column_fixed_length_object.h"
 #include "vec/core/block.h"
+#include "vec/data_types/data_type_fixed_length_object.h"
 namespace doris::pipeline {
 
 using namespace vectorized;
@@ -335,4 +337,63 @@ TEST_F(RepeatOperatorTest, test_with_expr2) {
     EXPECT_TRUE(op->need_more_input_data(state.get()));
 }
 
-} // namespace doris::pipeline
\ No newline at end of file
+TEST_F(RepeatOperatorTest, test_pass_through_serialized_agg_state) {
+    // Rollup shape Agg(serialize) -> Repeat -> Agg(merge): the repeat sees the serialized
+    // states of the pre-aggregation, while the intermediate slot is typed by the planner.
+    set_output_slots({std::make_shared<DataTypeNullable>(std::make_shared<DataTypeInt64>()),
+                      std::make_shared<DataTypeInt64>(), std::make_shared<DataTypeInt64>()});
+    auto state_type = std::make_shared<DataTypeFixedLengthObject>();
+    op->_expr_ctxs = MockSlotRef::create_mock_contexts(
+            DataTypes {std::make_shared<DataTypeInt64>(), state_type});
+    create_local_state();
+
+    {
+        auto state_column = ColumnFixedLengthObject::create(sizeof(Int64));
+        state_column->resize(3);
+        auto* states = reinterpret_cast<Int64*>(state_column->get_data().data());
+        states[0] = 11;
+        states[1] = 22;
+        states[2] = 33;
+        *local_state->_child_block = Block {
+                ColumnHelper::create_column_with_name<DataTypeInt64>({1, 2, 3}),
+                ColumnWithTypeAndName(std::move(state_column), state_type, "state")};
+        EXPECT_TRUE(op->push(state.get(), local_state->_child_block.get(), false));
+        EXPECT_EQ(local_state->_intermediate_block->rows(), 3);
+    }
+
+    op->_repeat_id_list_size = 2;
+    op->_grouping_list = {{0, 1}};
+    op->_all_slot_ids = {0};
+    op->_output_slots[0]->_id = 0;
+    op->_output_slots[1]->_id = 1;
+    op->_slot_id_set_list.resize(op->_repeat_id_list_size);
+    op->_slot_id_set_list[0].insert(0);
+
+    for (int repeat_id = 0; repeat_id < 2; repeat_id++) {
+        Block block;
+        bool eos = false;
+        EXPECT_FALSE(op->need_more_input_data(state.get()));
+        EXPECT_TRUE(op->pull(state.get(), &block, &eos));
+        ASSERT_EQ(block.rows(), 3);
+
+        const auto* state_column =
+                check_and_get_column<ColumnFixedLengthObject>(*block.get_by_position(1).column);
+        ASSERT_NE(state_column, nullptr);
+        EXPECT_EQ(state_column->item_size(), sizeof(Int64));
+        const auto* states = reinterpret_cast<const Int64*>(state_column->get_data().data());
+        EXPECT_EQ(states[0], 11);
+        EXPECT_EQ(states[1], 22);
+        EXPECT_EQ(states[2], 33);
+
+        EXPECT_TRUE(ColumnHelper::column_equal(
+                block.get_by_position(0).column,
+                ColumnHelper::create_nullable_column<DataTypeInt64>(
+                        {1, 2, 3}, {repeat_id == 1, repeat_id == 1, repeat_id == 1})));
+        EXPECT_TRUE(ColumnHelper::column_equal(
+                block.get_by_position(2).column,
+                ColumnHelper::create_column<DataTypeInt64>({repeat_id, repeat_id, repeat_id})));
+    }
+    EXPECT_TRUE(op->need_more_input_data(state.get()));
+}
+
+} // namespace doris::pipeline
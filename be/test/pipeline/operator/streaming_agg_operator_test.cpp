@@ -20,6 +20,7 @@
 
 #include <memory>
 
+#include "common/config.h"
 #include "pipeline/exec/aggregation_sink_operator.h"
 #include "pipeline/exec/aggregation_source_operator.h"
 #include "pipeline/exec/mock_operator.h"
@@ -30,6 +31,7 @@
 #include "testutil/mock/mock_runtime_state.h"
 #include "testutil/mock/mock_slot_ref.h"
 #include "util/bitmap_value.h"
+#include "util/defer_op.h"
 #include "util/jsonb_document.h"
 #include "vec/data_types/data_type_bitmap.h"
 #include "vec/data_types/data_type_number.h"
@@ -406,4 +408,124 @@ TEST_F(StreamingAggOperatorTest, test4) {
     { EXPECT_TRUE(local_state->close(state.get()).ok()); }
 }
 
+TEST_F(StreamingAggOperatorTest, sorted_input) {
+    auto enable_sorted_input = config::enable_streaming_agg_sorted_input;
+    config::enable_streaming_agg_sorted_input = true;
+    Defer restore_config {
+            [&]() { config::enable_streaming_agg_sorted_input = enable_sorted_input; }};
+
+    op->_aggregate_evaluators.push_back(vectorized::create_mock_agg_fn_evaluator(
+            pool, MockSlotRef::create_mock_contexts(1, std::make_shared<DataTypeInt64>()), false,
+            false));
+    op->_pool = &pool;
+    op->_needs_finalize = false;
+    op->_is_merge = false;
+
+    EXPECT_TRUE(op->set_child(child_op));
+
+    EXPECT_TRUE(op->prepare(state.get()).ok());
+    op->_probe_expr_ctxs = MockSlotRef::create_mock_contexts(
+            0, std::make_shared<DataTypeNullable>(std::make_shared<DataTypeInt64>()));
+
+    {
+        auto local_state = std::make_unique<MockStreamingAggLocalState>(state.get(), op.get());
+        LocalStateInfo info {.parent_profile = &profile,
+                             .scan_ranges = {},
+                             .shared_state = nullptr,
+                             .shared_state_map = {},
+                             .task_idx = 0};
+
+        EXPECT_TRUE(local_state->init(state.get(), info).ok());
+        state->resize_op_id_to_local_state(-100);
+        state->emplace_local_state(op->operator_id(), std::move(local_state));
+    }
+
+    {
+        local_state =
+                static_cast<MockStreamingAggLocalState*>(state->get_local_state(op->operator_id()));
+        EXPECT_TRUE(local_state->open(state.get()).ok());
+    }
+
+    {
+        // the null keys come first
+        vectorized::Block block {
+                ColumnHelper::create_nullable_column_with_name<DataTypeInt64>(
+                        {0, 1, 1, 2, 2, 2}, {true, false, false, false, false, false}),
+                ColumnHelper::create_column_with_name<DataTypeInt64>({5, 1, 1, 100, 100, 100})};
+        auto st = op->push(state.get(), &block, true);
+        EXPECT_TRUE(st.ok()) << st.msg();
+
+        EXPECT_EQ(local_state->_get_hash_table_size(), 0);
+        EXPECT_FALSE(op->need_more_input_data(state.get()));
+        // the run states and the last key are counted without the hash table
+        EXPECT_GT(local_state->_sorted_agg_arena_memory_usage, 0);
+        EXPECT_GE(local_state->_memory_usage(),
+                  local_state->_sorted_agg_arena_memory_usage +
+                          local_state->_last_sorted_keys[0]->allocated_bytes());
+        EXPECT_GE(local_state->_memory_used_counter->value(),
+                  int64_t(local_state->_sorted_agg_memory_usage()));
+
+        bool eos = false;
+        vectorized::Block output;
+        st = op->pull(state.get(), &output, &eos);
+        EXPECT_TRUE(st.ok()) << st.msg();
+        EXPECT_FALSE(eos);
+        vectorized::Block res_block {
+                ColumnHelper::create_nullable_column_with_name<DataTypeInt64>(
+                        {0, 1, 2}, {true, false, false}),
+                ColumnHelper::create_column_with_name<DataTypeInt64>({5, 2, 300})};
+        EXPECT_TRUE(ColumnHelper::block_equal(output, res_block))
+                << "Expected: " << res_block.dump_data() << ", but got: " << output.dump_data();
+    }
+
+    {
+        // the run of key 2 continues from the previous block
+        vectorized::Block block {
+                ColumnHelper::create_nullable_column_with_name<DataTypeInt64>(
+                        {2, 2, 3, 4, 4, 4}, {false, false, false, false, false, false}),
+                ColumnHelper::create_column_with_name<DataTypeInt64>({1, 1, 10, 2, 2, 2})};
+        auto st = op->push(state.get(), &block, true);
+        EXPECT_TRUE(st.ok()) << st.msg();
+
+        EXPECT_EQ(local_state->_get_hash_table_size(), 0);
+        bool eos = false;
+        vectorized::Block output;
+        st = op->pull(state.get(), &output, &eos);
+        EXPECT_TRUE(st.ok()) << st.msg();
+        vectorized::Block res_block {
+                ColumnHelper::create_nullable_column_with_name<DataTypeInt64>(
+                        {2, 3, 4}, {false, false, false}),
+                ColumnHelper::create_column_with_name<DataTypeInt64>({2, 10, 6})};
+        EXPECT_TRUE(ColumnHelper::block_equal(output, res_block))
+                << "Expected: " << res_block.dump_data() << ", but got: " << output.dump_data();
+    }
+
+    {
+        // the keys go back, the hash table is used from now on
+        vectorized::Block block {
+                ColumnHelper::create_nullable_column_with_name<DataTypeInt64>(
+                        {1, 1, 5, 5, 1, 1}, {false, false, false, false, false, false}),
+                ColumnHelper::create_column_with_name<DataTypeInt64>({1, 1, 1, 1, 1, 1})};
+        auto st = op->push(state.get(), &block, true);
+        EXPECT_TRUE(st.ok()) << st.msg();
+
+        EXPECT_EQ(local_state->_get_hash_table_size(), 2);
+        EXPECT_TRUE(op->need_more_input_data(state.get()));
+
+        bool eos = false;
+        vectorized::Block output;
+        st = op->pull(state.get(), &output, &eos);
+        EXPECT_TRUE(st.ok()) << st.msg();
+        EXPECT_TRUE(eos);
+        vectorized::Block res_block {
+                ColumnHelper::create_nullable_column_with_name<DataTypeInt64>({1, 5},
+                                                                              {false, false}),
+                ColumnHelper::create_column_with_name<DataTypeInt64>({4, 2})};
+        EXPECT_TRUE(ColumnHelper::block_equal_with_sort(output, res_block))
+                << "Expected: " << res_block.dump_data() << ", but got: " << output.dump_data();
+    }
+
+    { EXPECT_TRUE(local_state->close(state.get()).ok()); }
+}
+
 } // namespace doris::pipeline
@@ -0,0 +1,67 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "runtime/descriptor_tbl_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+
+namespace doris {
+
+static TDescriptorTable create_descriptor_table(const std::string& column_name) {
+    TDescriptorTableBuilder builder;
+    TTupleDescriptorBuilder()
+            .add_slot(TSlotDescriptorBuilder()
+                              .type(TYPE_INT)
+                              .column_name(column_name)
+                              .column_pos(0)
+                              .nullable(true)
+                              .build())
+            .build(&builder);
+    return builder.build();
+}
+
+TEST(DescriptorTblCacheTest, ShareSameDescriptorTable) {
+    DescriptorTblCache cache(16);
+
+    std::shared_ptr<CachedDescriptorTbl> first;
+    ASSERT_TRUE(cache.get_or_create(create_descriptor_table("c1"), &first).ok());
+    ASSERT_NE(first->desc_tbl, nullptr);
+    ASSERT_NE(first->desc_tbl->get_tuple_descriptor(0), nullptr);
+    // the descriptors are accounted to the cache, not to the query which built them
+    EXPECT_EQ(first->mem_tracker, cache.mem_tracker());
+
+    std::shared_ptr<CachedDescriptorTbl> second;
+    ASSERT_TRUE(cache.get_or_create(create_descriptor_table("c1"), &second).ok());
+    EXPECT_EQ(first, second);
+
+    // another schema builds other descriptors
+    std::shared_ptr<CachedDescriptorTbl> third;
+    ASSERT_TRUE(cache.get_or_create(create_descriptor_table("c2"), &third).ok());
+    EXPECT_NE(first, third);
+    EXPECT_EQ("c2", third->desc_tbl->get_tuple_descriptor(0)->slots()[0]->col_name());
+
+    // the descriptors outlive their eviction while a query holds them
+    cache.prune_all(true);
+    EXPECT_EQ("c1", first->desc_tbl->get_tuple_descriptor(0)->slots()[0]->col_name());
+}
+
+} // namespace doris
@@ -0,0 +1,143 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "common/config.h"
+#include "vec/exec/scan/scanner_scheduler.h"
+
+namespace doris::vectorized {
+class ScanTaskQueueTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _old_quantum_ms = config::scan_task_priority_level_quantum_ms;
+        _old_aging_ms = config::scan_task_priority_aging_ms;
+        config::scan_task_priority_level_quantum_ms = 100;
+        config::scan_task_priority_aging_ms = 3600 * 1000;
+    }
+
+    void TearDown() override {
+        config::scan_task_priority_level_quantum_ms = _old_quantum_ms;
+        config::scan_task_priority_aging_ms = _old_aging_ms;
+    }
+
+    SimplifiedScanTask make_task(int value) {
+        return SimplifiedScanTask([this, value] { _ran.push_back(value); }, nullptr);
+    }
+
+    void drain(ScanTaskQueue& queue) {
+        SimplifiedScanTask task;
+        while (queue.pop(&task)) {
+            task.scan_func();
+        }
+    }
+
+    std::vector<int> _ran;
+
+private:
+    int32_t _old_quantum_ms;
+    int32_t _old_aging_ms;
+};
+
+TEST_F(ScanTaskQueueTest, LevelOf) {
+    const int64_t ms = 1000 * 1000;
+    EXPECT_EQ(ScanTaskQueue::level_of(0), 0);
+    EXPECT_EQ(ScanTaskQueue::level_of(99 * ms), 0);
+    EXPECT_EQ(ScanTaskQueue::level_of(100 * ms), 1);
+    EXPECT_EQ(ScanTaskQueue::level_of(399 * ms), 1);
+    EXPECT_EQ(ScanTaskQueue::level_of(400 * ms), 2);
+    EXPECT_EQ(ScanTaskQueue::level_of(1600 * ms), 3);
+    EXPECT_EQ(ScanTaskQueue::level_of(6400 * ms), 4);
+    EXPECT_EQ(ScanTaskQueue::level_of(3600 * 1000 * ms), ScanTaskQueue::NUM_LEVELS - 1);
+}
+
+TEST_F(ScanTaskQueueTest, ShortTasksFirst) {
+    ScanTaskQueue queue;
+    // A big query has queued many scan tasks before a short query arrives.
+    for (int i = 0; i < 100; ++i) {
+        queue.push(make_task(1000 + i), 3);
+    }
+    queue.push(make_task(1), 0);
+    queue.push(make_task(2), 1);
+    queue.push(make_task(3), 0);
+    EXPECT_EQ(queue.size(), 103U);
+
+    drain(queue);
+    ASSERT_EQ(_ran.size(), 103U);
+    EXPECT_EQ(_ran[0], 1);
+    EXPECT_EQ(_ran[1], 3);
+    EXPECT_EQ(_ran[2], 2);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(_ran[3 + i], 1000 + i);
+    }
+    EXPECT_EQ(queue.size(), 0U);
+}
+
+TEST_F(ScanTaskQueueTest, Aging) {
+    const int64_t ms = 1000 * 1000;
+    config::scan_task_priority_aging_ms = 100;
+    int64_t now_ns = 0;
+    ScanTaskQueue queue([&now_ns] { return now_ns; });
+    queue.push(make_task(1), 4);
+    now_ns = 10 * ms;
+    queue.push(make_task(2), 2);
+    now_ns = 20 * ms;
+    queue.push(make_task(3), 0);
+
+    // Nothing has waited long enough, the highest level is served.
+    now_ns = 50 * ms;
+    SimplifiedScanTask task;
+    ASSERT_TRUE(queue.pop(&task));
+    task.scan_func();
+    EXPECT_EQ(_ran, (std::vector<int> {3}));
+
+    // Task 1 has waited 100ms and is served before the higher level task 2.
+    now_ns = 100 * ms;
+    ASSERT_TRUE(queue.pop(&task));
+    task.scan_func();
+    EXPECT_EQ(_ran, (std::vector<int> {3, 1}));
+
+    // Tasks aged at the same time are served in arrival order.
+    queue.push(make_task(4), 0);
+    queue.push(make_task(5), 3);
+    queue.push(make_task(6), 1);
+    now_ns = 1000 * ms;
+    drain(queue);
+    EXPECT_EQ(_ran, (std::vector<int> {3, 1, 2, 4, 5, 6}));
+}
+
+TEST_F(ScanTaskQueueTest, Remove) {
+    ScanTaskQueue queue;
+    queue.push(make_task(1), 0);
+    uint64_t id = queue.push(make_task(2), 1);
+    queue.push(make_task(3), 2);
+    EXPECT_TRUE(queue.remove(id));
+    EXPECT_FALSE(queue.remove(id));
+    EXPECT_EQ(queue.size(), 2U);
+    drain(queue);
+    EXPECT_EQ(_ran, (std::vector<int> {1, 3}));
+
+    queue.push(make_task(4), -1);
+    queue.push(make_task(5), ScanTaskQueue::NUM_LEVELS);
+    queue.clear();
+    EXPECT_EQ(queue.size(), 0U);
+    SimplifiedScanTask task;
+    EXPECT_FALSE(queue.pop(&task));
+}
+} // namespace doris::vectorized
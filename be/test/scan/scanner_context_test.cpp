@@ -23,11 +23,18 @@
 #include <gen_cpp/Types_types.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <tuple>
+#include <vector>
 
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "mock_scanner_scheduler.h"
 #include "mock_simplified_scan_scheduler.h"
@@ -36,6 +43,8 @@
 #include "runtime/descriptors.h"
 #include "runtime/query_context.h"
 #include "testutil/mock/mock_runtime_state.h"
+#include "util/defer_op.h"
+#include "util/time.h"
 #include "vec/core/block.h"
 #include "vec/exec/scan/olap_scanner.h"
 #include "vec/exec/scan/scan_node.h"
@@ -847,4 +856,120 @@ TEST_F(ScannerContextTest, get_block_from_queue) {
     EXPECT_EQ(scanner_context->_num_finished_scanners, 1);
 }
 
+TEST_F(ScannerContextTest, scan_task_priority_level) {
+    const int parallel_tasks = 1;
+    auto scan_operator = std::make_unique<pipeline::OlapScanOperatorX>(
+            obj_pool.get(), tnode, 0, *descs, parallel_tasks, TQueryCacheParam {});
+    auto olap_scan_local_state =
+            pipeline::OlapScanLocalState::create_unique(state.get(), scan_operator.get());
+    std::list<std::shared_ptr<ScannerDelegate>> scanners;
+    std::shared_ptr<ScannerContext> scanner_context = ScannerContext::create_shared(
+            state.get(), olap_scan_local_state.get(), output_tuple_desc, output_row_descriptor,
+            scanners, 100, scan_dependency, parallel_tasks);
+
+    auto old_quantum_ms = config::scan_task_priority_level_quantum_ms;
+    config::scan_task_priority_level_quantum_ms = 100;
+    Defer defer {[&]() { config::scan_task_priority_level_quantum_ms = old_quantum_ms; }};
+    const int64_t ms = 1000 * 1000;
+    SimplifiedScanTask task([] {}, scanner_context);
+    EXPECT_EQ(SimplifiedScanScheduler::priority_level(task), 0);
+    scanner_context->update_scan_time(150 * ms);
+    EXPECT_EQ(SimplifiedScanScheduler::priority_level(task), 1);
+    scanner_context->update_scan_time(10000 * ms);
+    EXPECT_EQ(SimplifiedScanScheduler::priority_level(task), 4);
+    // the rowid fetches have no scanner context, they always run first
+    EXPECT_EQ(SimplifiedScanScheduler::priority_level(SimplifiedScanTask([] {}, nullptr)), 0);
+}
+
+// A long query keeps 16 scan tasks of 2ms queued in a scheduler of 1 thread, while short queries
+// of one 0.2ms scan task arrive every 5ms. Each short query waits for all the queued tasks of
+// the long query in a FIFO pool, and at most for one of them by priority.
+TEST_F(ScannerContextTest, scan_task_priority_mixed_workload) {
+    const int parallel_tasks = 1;
+    auto scan_operator = std::make_unique<pipeline::OlapScanOperatorX>(
+            obj_pool.get(), tnode, 0, *descs, parallel_tasks, TQueryCacheParam {});
+    auto olap_scan_local_state =
+            pipeline::OlapScanLocalState::create_unique(state.get(), scan_operator.get());
+
+    auto old_enable = config::enable_scan_task_priority_scheduling;
+    auto old_quantum_ms = config::scan_task_priority_level_quantum_ms;
+    auto old_aging_ms = config::scan_task_priority_aging_ms;
+    config::scan_task_priority_level_quantum_ms = 100;
+    config::scan_task_priority_aging_ms = 2000;
+    Defer defer {[&]() {
+        config::enable_scan_task_priority_scheduling = old_enable;
+        config::scan_task_priority_level_quantum_ms = old_quantum_ms;
+        config::scan_task_priority_aging_ms = old_aging_ms;
+    }};
+
+    // the p99 latency of the short queries in ns
+    auto run_workload = [&](bool enable_priority) {
+        config::enable_scan_task_priority_scheduling = enable_priority;
+        auto scheduler = std::make_unique<SimplifiedScanScheduler>("ForTest", nullptr);
+        EXPECT_TRUE(scheduler->start(1, 1, 1024).ok());
+        std::list<std::shared_ptr<ScannerDelegate>> scanners;
+        // All the short queries share a context, their scan time stays below the quantum.
+        auto long_ctx = ScannerContext::create_shared(
+                state.get(), olap_scan_local_state.get(), output_tuple_desc,
+                output_row_descriptor, scanners, 100, scan_dependency, parallel_tasks);
+        auto short_ctx = ScannerContext::create_shared(
+                state.get(), olap_scan_local_state.get(), output_tuple_desc,
+                output_row_descriptor, scanners, 100, scan_dependency, parallel_tasks);
+
+        std::atomic<bool> stop_long_query = false;
+        std::atomic<int> long_tasks = 0;
+        std::function<void()> long_scan = [&]() {
+            int64_t start = MonotonicNanos();
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            long_ctx->update_scan_time(MonotonicNanos() - start);
+            if (stop_long_query ||
+                !scheduler->submit_scan_task(SimplifiedScanTask(long_scan, long_ctx)).ok()) {
+                --long_tasks;
+            }
+        };
+        for (int i = 0; i < 16; ++i) {
+            ++long_tasks;
+            EXPECT_TRUE(scheduler->submit_scan_task(SimplifiedScanTask(long_scan, long_ctx)).ok());
+        }
+        // the long query has consumed the quantum of the top level
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+        const int num_short_queries = 200;
+        std::vector<int64_t> latencies(num_short_queries);
+        std::atomic<int> finished = 0;
+        for (int i = 0; i < num_short_queries; ++i) {
+            int64_t submit_time = MonotonicNanos();
+            auto short_scan = [&, i, submit_time]() {
+                int64_t start = MonotonicNanos();
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                short_ctx->update_scan_time(MonotonicNanos() - start);
+                latencies[i] = MonotonicNanos() - submit_time;
+                ++finished;
+            };
+            EXPECT_TRUE(
+                    scheduler->submit_scan_task(SimplifiedScanTask(short_scan, short_ctx)).ok());
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        while (finished < num_short_queries) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        stop_long_query = true;
+        while (long_tasks > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        scheduler->stop();
+
+        std::sort(latencies.begin(), latencies.end());
+        int64_t p50 = latencies[num_short_queries / 2];
+        int64_t p99 = latencies[num_short_queries * 99 / 100];
+        LOG(INFO) << "short queries with priority scheduling " << enable_priority
+                  << ": p50 " << p50 / 1000 << "us, p99 " << p99 / 1000 << "us";
+        return p99;
+    };
+    int64_t fifo_p99 = run_workload(false);
+    int64_t priority_p99 = run_workload(true);
+    // about 40ms and 3ms on a single core
+    EXPECT_LT(priority_p99 * 2, fifo_p99);
+}
+
 } // namespace doris::vectorized
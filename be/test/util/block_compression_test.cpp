@@ -22,7 +22,9 @@
 #include <gtest/gtest-test-part.h>
 #include <stdlib.h>
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest_pred_impl.h"
 #include "util/faststring.h"
@@ -148,4 +150,47 @@ TEST_F(BlockCompressionTest, multi) {
     test_multi_slices(segment_v2::CompressionTypePB::ZSTD);
 }
 
+TEST_F(BlockCompressionTest, zstd_dict) {
+    // small json-like rows sharing their keys, like the pages of a row store column
+    std::vector<std::string> rows;
+    for (int i = 0; i < 2000; ++i) {
+        rows.emplace_back(R"({"user_id":)" + std::to_string(i) + R"(,"name":")" +
+                          generate_str(8) + R"(","status":"active","region":"ap-southeast"})");
+    }
+    std::vector<Slice> samples(rows.begin(), rows.end());
+    std::string dict;
+    auto st = train_zstd_dictionary(samples, 4096, &dict);
+    ASSERT_TRUE(st.ok()) << st;
+    EXPECT_FALSE(dict.empty());
+    EXPECT_LE(dict.size(), 4096U);
+
+    std::unique_ptr<BlockCompressionCodec> dict_codec;
+    ASSERT_TRUE(create_zstd_dict_codec(dict, &dict_codec).ok());
+    BlockCompressionCodec* plain_codec;
+    ASSERT_TRUE(get_block_compression_codec(segment_v2::CompressionTypePB::ZSTD, &plain_codec).ok());
+
+    const auto& orig = rows[7];
+    faststring dict_compressed;
+    ASSERT_TRUE(dict_codec->compress(orig, &dict_compressed).ok());
+    faststring plain_compressed;
+    ASSERT_TRUE(plain_codec->compress(orig, &plain_compressed).ok());
+    EXPECT_LT(dict_compressed.size(), plain_compressed.size());
+
+    std::string uncompressed;
+    uncompressed.resize(orig.size());
+    Slice uncompressed_slice(uncompressed);
+    st = dict_codec->decompress(Slice(dict_compressed), &uncompressed_slice);
+    ASSERT_TRUE(st.ok()) << st;
+    EXPECT_EQ(orig, uncompressed);
+
+    // pages compressed with a dictionary can not be read without it
+    uncompressed_slice = Slice(uncompressed);
+    EXPECT_FALSE(plain_codec->decompress(Slice(dict_compressed), &uncompressed_slice).ok());
+
+    // too few samples
+    std::vector<Slice> few_samples(samples.begin(), samples.begin() + 2);
+    EXPECT_FALSE(train_zstd_dictionary(few_samples, 4096, &dict).ok());
+    EXPECT_TRUE(dict.empty());
+}
+
 } // namespace doris
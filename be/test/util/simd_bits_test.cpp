@@ -0,0 +1,99 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/simd/bits.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace doris {
+
+static constexpr size_t kLength = simd::bits_mask_length();
+
+// the indexes walked by iterate_through_bits_mask
+static std::vector<size_t> mask_indexes(decltype(simd::bytes_mask_to_bits_mask(nullptr)) mask) {
+    std::vector<size_t> indexes;
+    simd::iterate_through_bits_mask([&](size_t index) { indexes.push_back(index); }, mask);
+    return indexes;
+}
+
+// Check the mask of the bytes equal to byte against the bytes, whatever the layout of the
+// platform: 4 bits per byte for NEON, 1 bit per byte for AVX2, SSE2 and the scalar loop.
+static void check_equal_mask(const std::vector<uint8_t>& data, uint8_t byte) {
+    ASSERT_EQ(data.size(), kLength);
+    std::vector<size_t> expected;
+    std::vector<uint8_t> byte_mask(kLength);
+    for (size_t i = 0; i < kLength; ++i) {
+        if (data[i] == byte) {
+            expected.push_back(i);
+            byte_mask[i] = 1;
+        }
+    }
+    auto mask = simd::bytes_equal_to_bits_mask(data.data(), byte);
+    EXPECT_EQ(mask_indexes(mask), expected);
+    EXPECT_EQ(mask == 0, expected.empty());
+    if (!expected.empty()) {
+        EXPECT_EQ(simd::first_index_of_bits_mask(mask), expected[0]);
+    }
+    // the same layout as bytes_mask_to_bits_mask
+    EXPECT_EQ(mask, simd::bytes_mask_to_bits_mask(byte_mask.data()));
+}
+
+TEST(SimdBitsTest, BytesEqualToBitsMask) {
+    std::vector<uint8_t> data(kLength, 'a');
+    check_equal_mask(data, ',');
+    check_equal_mask(data, 'a');
+
+    // the first and the last byte, and the bytes around the middle, where the SSE2 version
+    // joins its two halves
+    for (size_t pos : {size_t(0), kLength / 2 - 1, kLength / 2, kLength - 1}) {
+        std::vector<uint8_t> one(kLength, 'a');
+        one[pos] = ',';
+        check_equal_mask(one, ',');
+    }
+
+    std::vector<uint8_t> scattered(kLength);
+    for (size_t i = 0; i < kLength; ++i) {
+        scattered[i] = i % 3 == 1 ? '|' : static_cast<uint8_t>('0' + i % 10);
+    }
+    check_equal_mask(scattered, '|');
+    check_equal_mask(scattered, '0');
+
+    // the bytes of the high half, which are negative in a signed comparison
+    std::vector<uint8_t> high(kLength, 0x80);
+    high[3] = 0xff;
+    high[kLength - 2] = 0xff;
+    check_equal_mask(high, 0xff);
+    check_equal_mask(high, 0x80);
+    check_equal_mask(high, 0x7f);
+}
+
+TEST(SimdBitsTest, FirstIndexOfBitsMask) {
+    for (size_t pos = 0; pos < kLength; ++pos) {
+        std::vector<uint8_t> data(kLength, 'a');
+        data[pos] = '\t';
+        if (pos + 1 < kLength) {
+            data[kLength - 1] = '\t';
+        }
+        EXPECT_EQ(simd::first_index_of_bits_mask(simd::bytes_equal_to_bits_mask(data.data(), '\t')),
+                  pos);
+    }
+}
+
+} // namespace doris
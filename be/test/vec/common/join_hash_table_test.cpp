@@ -0,0 +1,222 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/hash_table/join_hash_table.h"
+
+#include <gen_cpp/PlanNodes_types.h>
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "vec/common/hash_table/hash_map_context.h"
+
+namespace doris {
+
+using StringJoinHashTable = JoinHashTable<StringRef>;
+
+static constexpr int kBatchSize = 1024;
+
+static uint8_t tag_of(const StringJoinHashTable& table, const std::string& value) {
+    return StringJoinHashTable::hash_tag(table.hash(StringRef(value)));
+}
+
+// two different values whose hashes have the same tag
+static std::pair<std::string, std::string> find_tag_collision(const StringJoinHashTable& table) {
+    std::vector<std::string> by_tag(256);
+    for (int i = 0;; ++i) {
+        std::string value = "join_key_" + std::to_string(i);
+        auto& other = by_tag[tag_of(table, value)];
+        if (!other.empty()) {
+            return {other, value};
+        }
+        other = value;
+    }
+}
+
+// a value whose hash has the tag 0, the tag of null keys
+static std::string find_zero_tag(const StringJoinHashTable& table) {
+    for (int i = 0;; ++i) {
+        std::string value = "join_key_" + std::to_string(i);
+        if (tag_of(table, value) == 0) {
+            return value;
+        }
+    }
+}
+
+// (probe row, build row) pairs of an inner join
+static std::set<std::pair<uint32_t, uint32_t>> probe_inner_join(
+        StringJoinHashTable& table, const std::vector<StringRef>& keys,
+        const std::vector<uint8_t>& tags, const std::vector<uint32_t>& buckets) {
+    DorisVector<uint32_t> build_idx_map(buckets.begin(), buckets.end());
+    table.pre_build_idxs(build_idx_map);
+    std::vector<uint32_t> probe_idxs(kBatchSize + 1);
+    std::vector<uint32_t> build_idxs(kBatchSize + 1);
+    std::set<std::pair<uint32_t, uint32_t>> result;
+    bool probe_visited = false;
+    int probe_idx = 0;
+    uint32_t build_idx = 0;
+    const int probe_rows = static_cast<int>(keys.size());
+    while (probe_idx < probe_rows) {
+        auto [new_probe_idx, new_build_idx, matched_cnt] =
+                table.find_batch<TJoinOp::INNER_JOIN>(
+                        keys.data(), tags.data(), build_idx_map.data(), probe_idx, build_idx,
+                        probe_rows, probe_idxs.data(), probe_visited, build_idxs.data(), nullptr,
+                        false, false, false);
+        for (uint32_t i = 0; i < matched_cnt; ++i) {
+            result.emplace(probe_idxs[i], build_idxs[i]);
+        }
+        probe_idx = new_probe_idx;
+        build_idx = new_build_idx;
+    }
+    return result;
+}
+
+// the probe rows matched by a left semi join
+static std::vector<uint32_t> probe_left_semi_join(StringJoinHashTable& table,
+                                                  const std::vector<StringRef>& keys,
+                                                  const std::vector<uint8_t>& tags,
+                                                  const std::vector<uint32_t>& buckets) {
+    DorisVector<uint32_t> build_idx_map(buckets.begin(), buckets.end());
+    table.pre_build_idxs(build_idx_map);
+    std::vector<uint32_t> probe_idxs(kBatchSize + 1);
+    bool probe_visited = false;
+    auto [probe_idx, build_idx, matched_cnt] = table.find_batch<TJoinOp::LEFT_SEMI_JOIN>(
+            keys.data(), tags.data(), build_idx_map.data(), 0, 0, static_cast<int>(keys.size()),
+            probe_idxs.data(), probe_visited, nullptr, nullptr, false, false, false);
+    EXPECT_EQ(probe_idx, static_cast<int>(keys.size()));
+    return {probe_idxs.begin(), probe_idxs.begin() + matched_cnt};
+}
+
+TEST(JoinHashTableTest, HashTagCollision) {
+    StringJoinHashTable table;
+    auto [a, b] = find_tag_collision(table);
+    ASSERT_NE(a, b);
+    ASSERT_EQ(tag_of(table, a), tag_of(table, b));
+    const std::string c = "join_key_c";
+    const std::string missing = "join_key_missing";
+
+    // row 0 is not a build row, all the rows are chained in bucket 0
+    std::vector<std::string> build_values = {"", a, b, a, c};
+    std::vector<StringRef> build_keys;
+    std::vector<uint8_t> build_tags;
+    for (const auto& value : build_values) {
+        build_keys.emplace_back(value);
+        build_tags.push_back(tag_of(table, value));
+    }
+    std::vector<uint32_t> build_buckets(build_keys.size(), 0);
+    table.prepare_build<TJoinOp::INNER_JOIN>(build_keys.size(), kBatchSize, false);
+    table.build(build_keys.data(), build_buckets.data(), build_keys.size(), false,
+                build_tags.data());
+
+    std::vector<std::string> probe_values = {a, b, missing, c};
+    std::vector<StringRef> probe_keys;
+    std::vector<uint8_t> probe_tags;
+    for (const auto& value : probe_values) {
+        probe_keys.emplace_back(value);
+        probe_tags.push_back(tag_of(table, value));
+    }
+    std::vector<uint32_t> probe_buckets(probe_keys.size(), 0);
+
+    // rows of another key with the same tag are compared by key and do not match
+    std::set<std::pair<uint32_t, uint32_t>> expected = {{0, 1}, {0, 3}, {1, 2}, {3, 4}};
+    EXPECT_EQ(probe_inner_join(table, probe_keys, probe_tags, probe_buckets), expected);
+    EXPECT_EQ(probe_left_semi_join(table, probe_keys, probe_tags, probe_buckets),
+              (std::vector<uint32_t> {0, 1, 3}));
+
+    // all the rows sharing one tag give the same result
+    std::vector<uint8_t> same_build_tags(build_keys.size(), 7);
+    std::vector<uint8_t> same_probe_tags(probe_keys.size(), 7);
+    StringJoinHashTable same_tag_table;
+    same_tag_table.prepare_build<TJoinOp::INNER_JOIN>(build_keys.size(), kBatchSize, false);
+    same_tag_table.build(build_keys.data(), build_buckets.data(), build_keys.size(), false,
+                         same_build_tags.data());
+    EXPECT_EQ(probe_inner_join(same_tag_table, probe_keys, same_probe_tags, probe_buckets),
+              expected);
+}
+
+TEST(JoinHashTableTest, NullKeyTag) {
+    // the null keys of a block get the null bucket and the tag 0
+    vectorized::MethodStringNoCache<JoinHashMap<StringRef>> method;
+    const std::string x = "join_key_x";
+    const std::string y = "join_key_y";
+    std::vector<StringRef> keys = {StringRef(x), StringRef(), StringRef(y)};
+    std::vector<uint8_t> null_map = {0, 1, 0};
+    const uint32_t bucket_size = 8;
+    method.keys = keys.data();
+    method.init_join_bucket_num(static_cast<uint32_t>(keys.size()), bucket_size,
+                                null_map.data());
+    ASSERT_EQ(method.hash_tags.size(), keys.size());
+    EXPECT_EQ(method.bucket_nums[1], bucket_size);
+    EXPECT_EQ(method.hash_tags[1], 0);
+    EXPECT_EQ(method.hash_tags[0], tag_of(*method.hash_table, x));
+    EXPECT_EQ(method.hash_tags[2], tag_of(*method.hash_table, y));
+
+    // a key whose tag is 0 too only matches its own rows, not the null rows
+    StringJoinHashTable table;
+    const std::string zero = find_zero_tag(table);
+    const std::string other = "join_key_other";
+    const std::string missing = "join_key_missing";
+    std::vector<StringRef> build_keys = {StringRef(), StringRef(zero), StringRef(),
+                                         StringRef(other)};
+    std::vector<uint8_t> build_tags = {0, 0, 0, tag_of(table, other)};
+    table.prepare_build<TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN>(build_keys.size(), kBatchSize, true);
+    const uint32_t null_bucket = table.get_bucket_size();
+    std::vector<uint32_t> build_buckets = {0, 0, null_bucket, 1};
+    table.build(build_keys.data(), build_buckets.data(), build_keys.size(), true,
+                build_tags.data());
+
+    std::vector<StringRef> probe_keys = {StringRef(zero), StringRef(missing)};
+    std::vector<uint8_t> probe_tags = {0, 0};
+    std::vector<uint32_t> probe_buckets = {0, 1};
+    std::set<std::pair<uint32_t, uint32_t>> expected = {{0, 1}};
+    EXPECT_EQ(probe_inner_join(table, probe_keys, probe_tags, probe_buckets), expected);
+
+    // null aware joins pick the null rows after the rows of the key, whatever their tags
+    DorisVector<uint32_t> build_idx_map(probe_buckets.begin(), probe_buckets.end());
+    table.pre_build_idxs(build_idx_map);
+    std::vector<uint32_t> probe_idxs(kBatchSize + 1);
+    std::vector<uint32_t> build_idxs(kBatchSize + 1);
+    std::vector<uint8_t> null_flags(kBatchSize + 1);
+    for (int probe_idx = 0; probe_idx < 2; ++probe_idx) {
+        auto [new_probe_idx, new_build_idx, matched_cnt, picking_null_keys] =
+                table.find_null_aware_with_other_conjuncts(
+                        probe_keys.data(), probe_tags.data(), build_idx_map.data(), probe_idx, 0,
+                        probe_idx + 1, probe_idxs.data(), build_idxs.data(), null_flags.data(),
+                        false, nullptr);
+        EXPECT_EQ(new_probe_idx, probe_idx + 1);
+        EXPECT_EQ(new_build_idx, 0U);
+        EXPECT_FALSE(picking_null_keys);
+        // the rows matched, then the end of the probe row
+        std::vector<std::pair<uint32_t, uint8_t>> matched;
+        for (uint32_t i = 0; i + 1 < matched_cnt; ++i) {
+            EXPECT_EQ(probe_idxs[i], static_cast<uint32_t>(probe_idx));
+            matched.emplace_back(build_idxs[i], null_flags[i]);
+        }
+        ASSERT_GT(matched_cnt, 0U);
+        EXPECT_EQ(build_idxs[matched_cnt - 1], 0U);
+        if (probe_idx == 0) {
+            EXPECT_EQ(matched, (std::vector<std::pair<uint32_t, uint8_t>> {{1, 0}, {2, 1}}));
+        } else {
+            EXPECT_EQ(matched, (std::vector<std::pair<uint32_t, uint8_t>> {{2, 1}}));
+        }
+    }
+}
+
+} // namespace doris
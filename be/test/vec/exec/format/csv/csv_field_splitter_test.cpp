@@ -0,0 +1,156 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "util/slice.h"
+#include "vec/exec/format/csv/csv_reader.h"
+
+namespace doris::vectorized {
+
+class PlainCsvTextFieldSplitterTest : public testing::Test {
+protected:
+    static std::vector<std::string> split(const std::string& line, const std::string& sep = ",",
+                                          bool trim_tailing_space = false, bool trim_ends = false,
+                                          char trimming_char = 0) {
+        PlainCsvTextFieldSplitter splitter(trim_tailing_space, trim_ends, sep, sep.size(),
+                                           trimming_char);
+        // an exact copy, so that a read past the end of the line is caught by ASAN
+        std::vector<char> data(line.begin(), line.end());
+        std::vector<Slice> values;
+        splitter.split_line(Slice(data.data(), data.size()), &values);
+        std::vector<std::string> result;
+        for (const auto& value : values) {
+            result.push_back(value.to_string());
+        }
+        return result;
+    }
+
+    // the fields of a line split byte by byte
+    static std::vector<std::string> expected_fields(const std::string& line, char sep) {
+        std::vector<std::string> fields(1);
+        for (char c : line) {
+            if (c == sep) {
+                fields.emplace_back();
+            } else {
+                fields.back().push_back(c);
+            }
+        }
+        return fields;
+    }
+};
+
+TEST_F(PlainCsvTextFieldSplitterTest, ShortLine) {
+    EXPECT_EQ(split("a,bb,ccc"), (std::vector<std::string> {"a", "bb", "ccc"}));
+    EXPECT_EQ(split(""), (std::vector<std::string> {""}));
+    EXPECT_EQ(split(","), (std::vector<std::string> {"", ""}));
+    EXPECT_EQ(split("a\tb", "\t"), (std::vector<std::string> {"a", "b"}));
+}
+
+TEST_F(PlainCsvTextFieldSplitterTest, LongLine) {
+    // fields shorter and longer than a vector of bytes
+    std::string line = std::string(5, 'a') + "," + std::string(40, 'b') + "," +
+                       std::string(70, 'c') + "," + std::string(3, 'd') + "," +
+                       std::string(31, 'e');
+    EXPECT_EQ(split(line), expected_fields(line, ','));
+
+    // a separator every 3 bytes over several vectors
+    std::string dense;
+    for (int i = 0; i < 100; ++i) {
+        dense += std::to_string(i % 100);
+        dense += i % 3 == 2 ? "|" : "";
+    }
+    EXPECT_EQ(split(dense, "|"), expected_fields(dense, '|'));
+}
+
+TEST_F(PlainCsvTextFieldSplitterTest, SeparatorAtVectorBoundary) {
+    // the last byte of a vector and the first byte of the next one, for the vectors of
+    // 16 bytes of NEON and of 32 bytes of AVX2
+    for (size_t pos : {15, 16, 31, 32, 63, 64}) {
+        for (size_t size : {pos + 1, pos + 2, pos + 40}) {
+            std::string line(size, 'x');
+            line[pos] = ',';
+            EXPECT_EQ(split(line), expected_fields(line, ',')) << pos << " " << size;
+        }
+    }
+    std::string both(48, 'x');
+    both[31] = ',';
+    both[32] = ',';
+    EXPECT_EQ(split(both),
+              (std::vector<std::string> {std::string(31, 'x'), "", std::string(15, 'x')}));
+}
+
+TEST_F(PlainCsvTextFieldSplitterTest, TrailingEmptyFields) {
+    EXPECT_EQ(split("a,b,,"), (std::vector<std::string> {"a", "b", "", ""}));
+    // a line of separators only, ending at the end of a vector
+    EXPECT_EQ(split(std::string(32, ',')), std::vector<std::string>(33, ""));
+    EXPECT_EQ(split(std::string(40, ',')), std::vector<std::string>(41, ""));
+    std::string line = std::string(35, 'a') + ",,,";
+    EXPECT_EQ(split(line), (std::vector<std::string> {std::string(35, 'a'), "", "", ""}));
+}
+
+TEST_F(PlainCsvTextFieldSplitterTest, Trimming) {
+    std::string line = "\"" + std::string(40, 'a') + "\",b  ,\"c\"";
+    EXPECT_EQ(split(line, ",", true, true, '"'),
+              (std::vector<std::string> {std::string(40, 'a'), "b", "c"}));
+    EXPECT_EQ(split(line, ",", false, false),
+              (std::vector<std::string> {"\"" + std::string(40, 'a') + "\"", "b  ", "\"c\""}));
+}
+
+TEST_F(PlainCsvTextFieldSplitterTest, MultiCharSeparator) {
+    std::string line = std::string(40, 'a') + "||" + std::string(3, 'b') + "||";
+    EXPECT_EQ(split(line, "||"), (std::vector<std::string> {std::string(40, 'a'), "bbb", ""}));
+}
+
+TEST_F(PlainCsvTextFieldSplitterTest, SplitByLineReaderCtx) {
+    auto ctx = std::make_shared<PlainCsvLineReaderCtx>("\n", 1, ",", 2, false);
+    PlainCsvTextFieldSplitter splitter(false, false, ",", 1, 0, ctx);
+    std::string input = "a,bb,\r\n" + std::string(40, 'c') + ",d\ne,f";
+    const auto* data = reinterpret_cast<const uint8_t*>(input.data());
+    auto split_line = [&](const uint8_t* line, size_t size) {
+        std::vector<Slice> values;
+        splitter.split_line(Slice(line, size), &values);
+        std::vector<std::string> result;
+        for (const auto& value : values) {
+            result.push_back(value.to_string());
+        }
+        return result;
+    };
+
+    ctx->refresh();
+    const uint8_t* line_end = ctx->read_line(data, input.size());
+    ASSERT_EQ(line_end, data + 5);
+    EXPECT_EQ(split_line(data, 5), (std::vector<std::string> {"a", "bb", ""}));
+    // a line other than the one just read, like the one without its bom, is split by itself
+    EXPECT_EQ(split_line(data + 2, 3), (std::vector<std::string> {"bb", ""}));
+
+    ctx->refresh();
+    line_end = ctx->read_line(data + 7, input.size() - 7);
+    ASSERT_EQ(line_end, data + 49);
+    EXPECT_EQ(split_line(data + 7, 42), (std::vector<std::string> {std::string(40, 'c'), "d"}));
+
+    // the last line without a line delimiter
+    ctx->refresh();
+    ASSERT_EQ(ctx->read_line(data + 50, input.size() - 50), nullptr);
+    EXPECT_EQ(split_line(data + 50, input.size() - 50), (std::vector<std::string> {"e", "f"}));
+}
+
+} // namespace doris::vectorized
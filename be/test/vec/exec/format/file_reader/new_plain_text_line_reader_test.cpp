@@ -64,6 +64,95 @@ TEST_F(PlainTextLineReaderTest, PlainTextBasic) {
     verify_split_result("line1||line2||line3", "||", false, {"line1", "line2", "line3"});
 }
 
+// Test class for CSV line reader indexing the line feeds and column separators of the buffer
+class PlainCsvLineReaderTest : public testing::Test {
+protected:
+    // The column positions of the last line without a line delimiter are not found by the ctx.
+    void verify_csv_split(const std::string& input, const std::string& col_sep,
+                          const std::vector<std::string>& expected_lines,
+                          const std::vector<std::vector<size_t>>& expected_col_positions) {
+        PlainCsvLineReaderCtx ctx("\n", 1, col_sep, 10, false);
+
+        const auto* data = reinterpret_cast<const uint8_t*>(input.c_str());
+        size_t pos = 0;
+        size_t size = input.size();
+        std::vector<std::string> actual_lines;
+        std::vector<std::vector<size_t>> actual_col_positions;
+
+        while (pos < size) {
+            ctx.refresh();
+            const uint8_t* line_end = ctx.read_line(data + pos, size - pos);
+            if (!line_end) {
+                ASSERT_FALSE(ctx.is_last_line(data + pos, size - pos));
+                actual_lines.emplace_back(reinterpret_cast<const char*>(data + pos), size - pos);
+                actual_col_positions.emplace_back();
+                break;
+            }
+            size_t line_len = line_end - (data + pos);
+            ASSERT_TRUE(ctx.is_last_line(data + pos, line_len));
+            actual_lines.emplace_back(reinterpret_cast<const char*>(data + pos), line_len);
+            actual_col_positions.push_back(ctx.column_sep_positions());
+            pos += line_len + ctx.line_delimiter_length();
+        }
+
+        ASSERT_EQ(expected_lines, actual_lines);
+        ASSERT_EQ(expected_col_positions, actual_col_positions);
+    }
+};
+
+TEST_F(PlainCsvLineReaderTest, CsvBasic) {
+    verify_csv_split("a,b,c\nd,e,f\n", ",", {"a,b,c", "d,e,f"}, {{1, 3}, {1, 3}});
+
+    verify_csv_split("a,b,c\nd,e,f", ",", {"a,b,c", "d,e,f"}, {{1, 3}, {}});
+
+    verify_csv_split("\n\n,a,\n", ",", {"", "", ",a,"}, {{}, {}, {0, 2}});
+
+    verify_csv_split("a\tb\r\nc\td\r\n", "\t", {"a\tb", "c\td"}, {{1}, {1}});
+
+    verify_csv_split("\r\n\ra,b\r\n", ",", {"", "\ra,b"}, {{}, {2}});
+}
+
+TEST_F(PlainCsvLineReaderTest, CsvSupported) {
+    EXPECT_TRUE(PlainCsvLineReaderCtx::is_supported("\n", ",", false));
+    EXPECT_FALSE(PlainCsvLineReaderCtx::is_supported("\n", ",", true));
+    EXPECT_FALSE(PlainCsvLineReaderCtx::is_supported("\r\n", ",", false));
+    EXPECT_FALSE(PlainCsvLineReaderCtx::is_supported("\n", "||", false));
+    EXPECT_FALSE(PlainCsvLineReaderCtx::is_supported("\n", "\r", false));
+}
+
+TEST_F(PlainCsvLineReaderTest, LongLines) {
+    // lines longer than a window of the index, with the separators around the window boundaries
+    std::string line(200 * 1024, 'a');
+    std::vector<size_t> col_positions;
+    for (size_t pos : {0UL, 31UL, 32UL, 65535UL, 65536UL, 65537UL, 131072UL, line.size() - 1}) {
+        line[pos] = ',';
+        col_positions.push_back(pos);
+    }
+    verify_csv_split(line + "\n" + line + "\r\n" + line + "\n", ",", {line, line, line},
+                     {col_positions, col_positions, col_positions});
+}
+
+TEST_F(PlainCsvLineReaderTest, BufferMoved) {
+    PlainCsvLineReaderCtx ctx("\n", 1, ",", 10, false);
+    // the rest of the line is not read yet
+    std::string input = "a,b\nc,d";
+    const auto* data = reinterpret_cast<const uint8_t*>(input.c_str());
+    ctx.refresh();
+    const uint8_t* line_end = ctx.read_line(data, input.size());
+    ASSERT_EQ(line_end, data + 3);
+    EXPECT_EQ(ctx.column_sep_positions(), std::vector<size_t>({1}));
+    ctx.refresh();
+    ASSERT_EQ(ctx.read_line(data + 4, input.size() - 4), nullptr);
+
+    // the line is read into a new buffer with the rest of it
+    std::string moved = "c,d,e\n";
+    data = reinterpret_cast<const uint8_t*>(moved.c_str());
+    line_end = ctx.read_line(data, moved.size());
+    ASSERT_EQ(line_end, data + 5);
+    EXPECT_TRUE(ctx.is_last_line(data, 5));
+    EXPECT_EQ(ctx.column_sep_positions(), std::vector<size_t>({1, 3}));
+}
+
 // Test class for CSV line reader with enclosure support
 class EncloseCsvLineReaderTest : public testing::Test {
 protected:
@@ -165,4 +254,50 @@ TEST_F(EncloseCsvLineReaderTest, MultiCharDelimiters) {
                      {"\"a|||b\"|||c", "\"d|||e\"|||f"}, {{7}, {7}});
 }
 
+TEST_F(EncloseCsvLineReaderTest, LongFields) {
+    // fields longer than a vector of bytes, with the enclose and escape inside of them
+    std::string f1(40, 'a');
+    std::string f2 =
+            "\"" + std::string(30, 'b') + "\"\",,,,," + "\\\"" + std::string(40, 'c') + "\"";
+    std::string f3(70, 'd');
+    std::string line = f1 + "," + f2 + "," + f3;
+    std::vector<size_t> col_positions = {f1.size(), f1.size() + 1 + f2.size()};
+    verify_csv_split(line + "\n" + line, "\n", ",", '"', '\\', false, {line, line},
+                     {col_positions, col_positions});
+
+    // the enclose is not matched until the end of the last line
+    std::string unmatched = f1 + ",\"" + f3 + "," + f3;
+    verify_csv_split(unmatched, "\n", ",", '"', '\\', false, {unmatched}, {{f1.size()}});
+}
+
+TEST_F(EncloseCsvLineReaderTest, LongLines) {
+    // lines longer than a window of the index, with a line feed enclosed in the second field
+    std::string f1(70 * 1024, 'a');
+    std::string f2 = "\"" + std::string(70 * 1024, 'b') + "\n" + std::string(10, 'b') + "\"";
+    std::string line = f1 + "," + f2 + ",c";
+    std::vector<size_t> col_positions = {f1.size(), f1.size() + 1 + f2.size()};
+    verify_csv_split(line + "\n" + line + "\n", "\n", ",", '"', '\\', false, {line, line},
+                     {col_positions, col_positions});
+}
+
+TEST_F(EncloseCsvLineReaderTest, BufferMoved) {
+    EncloseCsvLineReaderCtx ctx("\n", 1, ",", 1, 10, '"', '\\', false);
+    // the enclosed field is not closed in the buffer read
+    std::string input = "a,\"b,\nc";
+    const auto* data = reinterpret_cast<const uint8_t*>(input.c_str());
+    ctx.refresh();
+    ASSERT_EQ(ctx.read_line(data, input.size()), nullptr);
+
+    // the line is read again into a new buffer with the rest of it
+    std::string moved = "a,\"b,\nc\",d\ne,f\n";
+    data = reinterpret_cast<const uint8_t*>(moved.c_str());
+    const uint8_t* line_end = ctx.read_line(data, moved.size());
+    ASSERT_EQ(line_end, data + 10);
+    EXPECT_EQ(ctx.column_sep_positions(), std::vector<size_t>({1, 8}));
+    ctx.refresh();
+    line_end = ctx.read_line(data + 11, moved.size() - 11);
+    ASSERT_EQ(line_end, data + 14);
+    EXPECT_EQ(ctx.column_sep_positions(), std::vector<size_t>({1}));
+}
+
 } // namespace doris::vectorized
@@ -0,0 +1,296 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/format/file_reader/parallel_decompression_reader.h"
+
+#include <gtest/gtest.h>
+#include <lz4/lz4frame.h>
+#include <zlib.h>
+#include <zstd.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "io/fs/stream_load_pipe.h"
+#include "util/threadpool.h"
+
+namespace doris {
+
+class ParallelDecompressionReaderTest : public testing::Test {
+protected:
+    void SetUp() override {
+        static_cast<void>(ThreadPoolBuilder("ParallelDecompressionReaderTest")
+                                  .set_min_threads(2)
+                                  .set_max_threads(4)
+                                  .build(&_pool));
+        for (int i = 0; i < 3; ++i) {
+            std::string frame;
+            for (int j = 0; j < 1000; ++j) {
+                frame += std::to_string(i) + "," + std::to_string(j) + ",some text\n";
+            }
+            _frames.push_back(frame);
+        }
+    }
+
+    void TearDown() override { _pool->shutdown(); }
+
+    // Read all the content of the compressed pieces through a ParallelDecompressionReader.
+    Status read_all(CompressType type, const std::vector<std::string>& pieces,
+                    size_t max_frame_bytes, std::string* content) {
+        ParallelDecompressionReader reader(create_pipe(pieces), type, _pool.get(),
+                                           max_frame_bytes, 1 << 20);
+        content->clear();
+        std::vector<char> buf(1000);
+        size_t bytes_read = 0;
+        do {
+            RETURN_IF_ERROR(reader.read_at(0, Slice(buf.data(), buf.size()), &bytes_read));
+            content->append(buf.data(), bytes_read);
+        } while (bytes_read > 0);
+        return reader.close();
+    }
+
+    static io::FileReaderSPtr create_pipe(const std::vector<std::string>& pieces) {
+        auto pipe = std::make_shared<io::StreamLoadPipe>();
+        for (const auto& piece : pieces) {
+            EXPECT_TRUE(pipe->append_and_flush(piece.data(), piece.size()).ok());
+        }
+        EXPECT_TRUE(pipe->finish().ok());
+        return pipe;
+    }
+
+    std::string expected() const { return _frames[0] + _frames[1] + _frames[2]; }
+
+    static std::string zstd_frame(const std::string& data) {
+        std::string frame(ZSTD_compressBound(data.size()), '\0');
+        frame.resize(ZSTD_compress(frame.data(), frame.size(), data.data(), data.size(), 1));
+        return frame;
+    }
+
+    static std::string lz4_frame(const std::string& data, bool content_size = false) {
+        LZ4F_preferences_t prefs = LZ4F_INIT_PREFERENCES;
+        prefs.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+        prefs.frameInfo.contentSize = content_size ? data.size() : 0;
+        std::string frame(LZ4F_compressFrameBound(data.size(), &prefs), '\0');
+        frame.resize(LZ4F_compressFrame(frame.data(), frame.size(), data.data(), data.size(),
+                                        &prefs));
+        return frame;
+    }
+
+    // A gzip member, with the bgzf extra subfield if bgzf is true.
+    static std::string gzip_member(const std::string& data, bool bgzf) {
+        z_stream strm {};
+        deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                     Z_DEFAULT_STRATEGY);
+        std::string deflated(deflateBound(&strm, data.size()), '\0');
+        strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+        strm.avail_in = data.size();
+        strm.next_out = reinterpret_cast<Bytef*>(deflated.data());
+        strm.avail_out = deflated.size();
+        deflate(&strm, Z_FINISH);
+        deflated.resize(strm.total_out);
+        deflateEnd(&strm);
+
+        std::string member = {'\x1f', '\x8b', '\x08', bgzf ? '\x04' : '\x00', 0, 0, 0, 0, 0,
+                              '\xff'};
+        if (bgzf) {
+            size_t block_size = 12 + 6 + deflated.size() + 8;
+            member += std::string {6, 0, 'B', 'C', 2, 0, static_cast<char>((block_size - 1) & 0xff),
+                                   static_cast<char>((block_size - 1) >> 8)};
+        }
+        member += deflated;
+        uint32_t crc = crc32(0, reinterpret_cast<const Bytef*>(data.data()), data.size());
+        uint32_t size = data.size();
+        for (uint32_t v : {crc, size}) {
+            for (int i = 0; i < 4; ++i) {
+                member.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+            }
+        }
+        return member;
+    }
+
+    std::unique_ptr<ThreadPool> _pool;
+    std::vector<std::string> _frames;
+};
+
+TEST_F(ParallelDecompressionReaderTest, FrameSize) {
+    std::string frame = zstd_frame(_frames[0]);
+    size_t frame_size = 0;
+    size_t content_size = 0;
+    bool has_data = false;
+    std::string data = frame + zstd_frame(_frames[1]);
+    const auto* ptr = reinterpret_cast<const uint8_t*>(data.data());
+    EXPECT_TRUE(ParallelDecompressionReader::get_frame_size(CompressType::ZSTD, ptr, data.size(),
+                                                            &frame_size, &content_size, &has_data));
+    EXPECT_EQ(frame_size, frame.size());
+    EXPECT_EQ(content_size, _frames[0].size());
+    EXPECT_TRUE(has_data);
+    // more bytes are needed
+    EXPECT_TRUE(ParallelDecompressionReader::get_frame_size(CompressType::ZSTD, ptr,
+                                                            frame.size() - 1, &frame_size,
+                                                            &content_size, &has_data));
+    EXPECT_EQ(frame_size, 0);
+
+    frame = lz4_frame(_frames[0]);
+    data = frame + lz4_frame(_frames[1]);
+    ptr = reinterpret_cast<const uint8_t*>(data.data());
+    EXPECT_TRUE(ParallelDecompressionReader::get_frame_size(CompressType::LZ4FRAME, ptr,
+                                                            data.size(), &frame_size, &content_size, &has_data));
+    EXPECT_EQ(frame_size, frame.size());
+    // lz4 frames have no content size by default
+    EXPECT_EQ(content_size, 0U);
+    EXPECT_TRUE(ParallelDecompressionReader::get_frame_size(CompressType::LZ4FRAME, ptr,
+                                                            frame.size() - 1, &frame_size,
+                                                            &content_size, &has_data));
+    EXPECT_EQ(frame_size, 0);
+
+    frame = lz4_frame(_frames[0], true);
+    ptr = reinterpret_cast<const uint8_t*>(frame.data());
+    EXPECT_TRUE(ParallelDecompressionReader::get_frame_size(CompressType::LZ4FRAME, ptr,
+                                                            frame.size(), &frame_size,
+                                                            &content_size, &has_data));
+    EXPECT_EQ(frame_size, frame.size());
+    EXPECT_EQ(content_size, _frames[0].size());
+
+    frame = gzip_member(_frames[0], true);
+    ptr = reinterpret_cast<const uint8_t*>(frame.data());
+    EXPECT_TRUE(ParallelDecompressionReader::get_frame_size(CompressType::GZIP, ptr, frame.size(),
+                                                            &frame_size, &content_size, &has_data));
+    EXPECT_EQ(frame_size, frame.size());
+    EXPECT_EQ(content_size, _frames[0].size());
+    // the members of plain gzip files can not be split
+    frame = gzip_member(_frames[0], false);
+    ptr = reinterpret_cast<const uint8_t*>(frame.data());
+    EXPECT_FALSE(ParallelDecompressionReader::get_frame_size(CompressType::GZIP, ptr,
+                                                             frame.size(), &frame_size,
+                                                             &content_size, &has_data));
+}
+
+TEST_F(ParallelDecompressionReaderTest, Zstd) {
+    // a skippable frame between the frames
+    std::string skippable = {'\x50', '\x2a', '\x4d', '\x18', 3, 0, 0, 0, 'a', 'b', 'c'};
+    std::vector<std::string> pieces = {zstd_frame(_frames[0]), skippable, zstd_frame(_frames[1]),
+                                       zstd_frame(_frames[2])};
+    std::string content;
+    ASSERT_TRUE(read_all(CompressType::ZSTD, pieces, 1 << 20, &content).ok());
+    EXPECT_EQ(content, expected());
+}
+
+TEST_F(ParallelDecompressionReaderTest, Lz4Frame) {
+    std::vector<std::string> pieces = {lz4_frame(_frames[0]), lz4_frame(_frames[1]),
+                                       lz4_frame(_frames[2])};
+    std::string content;
+    ASSERT_TRUE(read_all(CompressType::LZ4FRAME, pieces, 1 << 20, &content).ok());
+    EXPECT_EQ(content, expected());
+}
+
+TEST_F(ParallelDecompressionReaderTest, Gzip) {
+    std::string content;
+    std::vector<std::string> pieces = {gzip_member(_frames[0], true),
+                                       gzip_member(_frames[1], true),
+                                       gzip_member(_frames[2], true)};
+    ASSERT_TRUE(read_all(CompressType::GZIP, pieces, 1 << 20, &content).ok());
+    EXPECT_EQ(content, expected());
+
+    // a plain gzip member after the bgzf blocks is decompressed serially
+    pieces[2] = gzip_member(_frames[2], false);
+    ASSERT_TRUE(read_all(CompressType::GZIP, pieces, 1 << 20, &content).ok());
+    EXPECT_EQ(content, expected());
+}
+
+TEST_F(ParallelDecompressionReaderTest, LargeFrame) {
+    std::vector<std::string> pieces = {zstd_frame(_frames[0]), zstd_frame(_frames[1]),
+                                       zstd_frame(_frames[2])};
+    std::string content;
+    // frames larger than max_frame_bytes are decompressed serially
+    ASSERT_TRUE(read_all(CompressType::ZSTD, pieces, 16, &content).ok());
+    EXPECT_EQ(content, expected());
+}
+
+TEST_F(ParallelDecompressionReaderTest, FramePieces) {
+    std::string data = expected();
+    for (auto type : {CompressType::ZSTD, CompressType::LZ4FRAME}) {
+        // a worker decompresses at most max_output_bytes of a frame at a time
+        ParallelDecompressionReader::Frame frame;
+        frame.input = type == CompressType::ZSTD ? zstd_frame(data) : lz4_frame(data);
+        std::string content;
+        while (!ParallelDecompressionReader::_frame_finished(frame)) {
+            ASSERT_TRUE(ParallelDecompressionReader::_decompress_frame(type, 4096, &frame).ok());
+            EXPECT_LE(frame.output.size(), 4096U);
+            content += frame.output;
+        }
+        EXPECT_EQ(content, data);
+        EXPECT_EQ(frame.decompressor, nullptr);
+        EXPECT_TRUE(frame.input.empty());
+    }
+
+    // the rest of a frame is decompressed by the reading thread, the frame after it is still
+    // decompressed ahead
+    std::string large = std::string(200000, 'x') + data;
+    ParallelDecompressionReader reader(create_pipe({zstd_frame(large), zstd_frame(_frames[0])}),
+                                       CompressType::ZSTD, _pool.get(), 65536, 1 << 20);
+    std::string content;
+    std::vector<char> buf(1000);
+    size_t bytes_read = 0;
+    do {
+        ASSERT_TRUE(reader.read_at(0, Slice(buf.data(), buf.size()), &bytes_read).ok());
+        content.append(buf.data(), bytes_read);
+        if (reader._current != nullptr) {
+            EXPECT_LE(reader._current->output.size(), 65536U);
+        }
+    } while (bytes_read > 0);
+    EXPECT_FALSE(reader._serial);
+    EXPECT_EQ(content, large + _frames[0]);
+    ASSERT_TRUE(reader.close().ok());
+}
+
+TEST_F(ParallelDecompressionReaderTest, QueueBytes) {
+    std::vector<std::string> pieces;
+    for (int i = 0; i < 3; ++i) {
+        pieces.push_back(zstd_frame(_frames[i]));
+    }
+    // the frames reserve their content size, the queue holds the frame being read and the
+    // one after it
+    size_t max_queue_bytes = _frames[0].size() + _frames[1].size();
+    ParallelDecompressionReader reader(create_pipe(pieces), CompressType::ZSTD, _pool.get(),
+                                       1 << 20, max_queue_bytes);
+    std::vector<char> buf(100);
+    size_t bytes_read = 0;
+    ASSERT_TRUE(reader.read_at(0, Slice(buf.data(), buf.size()), &bytes_read).ok());
+    EXPECT_EQ(bytes_read, buf.size());
+    ASSERT_EQ(reader._frames.size(), 1U);
+    EXPECT_EQ(reader._queued_bytes, _frames[1].size());
+
+    // a frame of an unknown size reserves max_frame_bytes
+    pieces = {lz4_frame(_frames[0]), lz4_frame(_frames[1]), lz4_frame(_frames[2])};
+    ParallelDecompressionReader lz4_reader(create_pipe(pieces), CompressType::LZ4FRAME,
+                                           _pool.get(), 1 << 20, 2 << 20);
+    ASSERT_TRUE(lz4_reader.read_at(0, Slice(buf.data(), buf.size()), &bytes_read).ok());
+    ASSERT_EQ(lz4_reader._frames.size(), 1U);
+    EXPECT_EQ(lz4_reader._queued_bytes, 1U << 20);
+    ASSERT_TRUE(reader.close().ok());
+    ASSERT_TRUE(lz4_reader.close().ok());
+}
+
+TEST_F(ParallelDecompressionReaderTest, Truncated) {
+    std::string frame = zstd_frame(_frames[1]);
+    std::vector<std::string> pieces = {zstd_frame(_frames[0]), frame.substr(0, frame.size() / 2)};
+    std::string content;
+    EXPECT_FALSE(read_all(CompressType::ZSTD, pieces, 1 << 20, &content).ok());
+}
+
+} // namespace doris
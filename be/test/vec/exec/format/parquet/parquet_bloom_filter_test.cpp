@@ -0,0 +1,320 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/format/parquet/vparquet_bloom_filter.h"
+
+#include <cctz/time_zone.h>
+#include <gen_cpp/PlanNodes_types.h>
+#include <gen_cpp/parquet_types.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/config.h"
+#include "exec/olap_common.h"
+#include "io/fs/local_file_system.h"
+#include "util/defer_op.h"
+#include "util/timezone_utils.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/exec/format/parquet/parquet_pred_cmp.h"
+#include "vec/exec/format/parquet/parquet_thrift_util.h"
+#include "vec/exec/format/parquet/schema_desc.h"
+#include "vec/exec/format/parquet/vparquet_file_metadata.h"
+#include "vec/exec/format/parquet/vparquet_reader.h"
+
+namespace doris::vectorized {
+
+// Written by the parquet writer of Arrow C++ (pyarrow 26), with a bloom filter of 1024 bytes in
+// each of its 2 row groups of 500 rows for every column, and neither statistics nor dictionaries:
+//   n = 1000
+//   t = pa.table({"id": pa.array(range(n), pa.int32()),
+//                 "big": pa.array([i * 1000003 for i in range(n)], pa.int64()),
+//                 "name": pa.array(["name_%d" % i for i in range(n)], pa.string()),
+//                 "score": pa.array([i * 0.5 for i in range(n)], pa.float64())})
+//   pq.write_table(t, path, row_group_size=500, use_dictionary=False, compression="none",
+//                  write_statistics=False,
+//                  bloom_filter_options={c: {"ndv": 500, "fpp": 0.01} for c in t.column_names})
+static const std::string kBloomFilterFile =
+        "./be/test/exec/test_data/parquet_scanner/bloom_filter.parquet";
+static constexpr int kRowsPerGroup = 500;
+
+class ParquetBloomFilterTest : public testing::Test {
+protected:
+    static ParquetBlockSplitBloomFilter _create_filter(uint32_t num_bytes) {
+        std::unique_ptr<uint8_t[]> bitset(new uint8_t[num_bytes]);
+        memset(bitset.get(), 0, num_bytes);
+        ParquetBlockSplitBloomFilter filter;
+        EXPECT_TRUE(filter.init(std::move(bitset), num_bytes).ok());
+        return filter;
+    }
+};
+
+TEST_F(ParquetBloomFilterTest, test_invalid_size) {
+    ParquetBlockSplitBloomFilter filter;
+    EXPECT_FALSE(filter.init(std::unique_ptr<uint8_t[]>(new uint8_t[16]), 16).ok());
+    EXPECT_FALSE(filter.init(std::unique_ptr<uint8_t[]>(new uint8_t[96]), 96).ok());
+    EXPECT_TRUE(filter.init(std::unique_ptr<uint8_t[]>(new uint8_t[64]), 64).ok());
+}
+
+TEST_F(ParquetBloomFilterTest, test_insert_and_find) {
+    auto filter = _create_filter(1024);
+    for (int64_t i = 0; i < 100; ++i) {
+        filter.insert_hash(ParquetBlockSplitBloomFilter::hash(&i, sizeof(i)));
+    }
+    for (int64_t i = 0; i < 100; ++i) {
+        EXPECT_TRUE(filter.find_hash(ParquetBlockSplitBloomFilter::hash(&i, sizeof(i))));
+    }
+    int false_positive = 0;
+    for (int64_t i = 100; i < 10100; ++i) {
+        false_positive += filter.find_hash(ParquetBlockSplitBloomFilter::hash(&i, sizeof(i)));
+    }
+    EXPECT_LT(false_positive, 100);
+}
+
+TEST_F(ParquetBloomFilterTest, test_filter_int_values) {
+    auto filter = _create_filter(256);
+    for (int32_t v : {1, 3, 5}) {
+        filter.insert_hash(ParquetBlockSplitBloomFilter::hash(&v, sizeof(v)));
+    }
+    FieldSchema col_schema;
+    col_schema.physical_type = tparquet::Type::INT32;
+    col_schema.data_type = std::make_shared<DataTypeInt32>();
+
+    ColumnValueRange<TYPE_INT> hit_range("c");
+    static_cast<void>(hit_range.add_fixed_value(2));
+    static_cast<void>(hit_range.add_fixed_value(3));
+    EXPECT_FALSE(ParquetPredicate::filter_by_bloom_filter(ColumnValueRangeType(hit_range),
+                                                          &col_schema, filter));
+
+    ColumnValueRange<TYPE_INT> miss_range("c");
+    static_cast<void>(miss_range.add_fixed_value(1000));
+    EXPECT_TRUE(ParquetPredicate::filter_by_bloom_filter(ColumnValueRangeType(miss_range),
+                                                         &col_schema, filter));
+
+    // the plain encoding of an int column stored as INT64 is different, never filter
+    col_schema.physical_type = tparquet::Type::INT64;
+    EXPECT_FALSE(ParquetPredicate::filter_by_bloom_filter(ColumnValueRangeType(miss_range),
+                                                          &col_schema, filter));
+}
+
+TEST_F(ParquetBloomFilterTest, test_filter_string_values) {
+    auto filter = _create_filter(256);
+    std::string value = "doris";
+    filter.insert_hash(ParquetBlockSplitBloomFilter::hash(value.data(), value.size()));
+
+    FieldSchema col_schema;
+    col_schema.physical_type = tparquet::Type::BYTE_ARRAY;
+    col_schema.data_type = std::make_shared<DataTypeString>();
+
+    ColumnValueRange<TYPE_STRING> hit_range("c");
+    static_cast<void>(hit_range.add_fixed_value(StringRef(value)));
+    EXPECT_FALSE(ParquetPredicate::filter_by_bloom_filter(ColumnValueRangeType(hit_range),
+                                                          &col_schema, filter));
+
+    std::string other = "parquet";
+    ColumnValueRange<TYPE_STRING> miss_range("c");
+    static_cast<void>(miss_range.add_fixed_value(StringRef(other)));
+    EXPECT_TRUE(ParquetPredicate::filter_by_bloom_filter(ColumnValueRangeType(miss_range),
+                                                         &col_schema, filter));
+
+    // range predicates can not use bloom filter
+    ColumnValueRange<TYPE_STRING> scope_range("c");
+    EXPECT_FALSE(ParquetPredicate::filter_by_bloom_filter(ColumnValueRangeType(scope_range),
+                                                          &col_schema, filter));
+}
+
+// The filters written by another implementation of the spec find all the values of their row
+// group, and few of the others.
+TEST_F(ParquetBloomFilterTest, test_read_arrow_written_file) {
+    io::FileReaderSPtr file_reader;
+    ASSERT_TRUE(io::global_local_filesystem()->open_file(kBloomFilterFile, &file_reader).ok());
+    FileMetaData* file_metadata = nullptr;
+    size_t meta_size = 0;
+    ASSERT_TRUE(parse_thrift_footer(file_reader, &file_metadata, &meta_size, nullptr).ok());
+    std::unique_ptr<FileMetaData> metadata_holder(file_metadata);
+    const auto& t_metadata = file_metadata->to_thrift();
+    ASSERT_EQ(t_metadata.row_groups.size(), 2);
+
+    // the plain encoding of the value of each column in row i
+    auto encode = [](int column, int i) -> std::string {
+        switch (column) {
+        case 0: {
+            auto v = static_cast<int32_t>(i);
+            return {reinterpret_cast<const char*>(&v), sizeof(v)};
+        }
+        case 1: {
+            auto v = static_cast<int64_t>(i) * 1000003;
+            return {reinterpret_cast<const char*>(&v), sizeof(v)};
+        }
+        case 2:
+            return "name_" + std::to_string(i);
+        default: {
+            double v = i * 0.5;
+            return {reinterpret_cast<const char*>(&v), sizeof(v)};
+        }
+        }
+    };
+    for (int group = 0; group < 2; ++group) {
+        const auto& row_group = t_metadata.row_groups[group];
+        ASSERT_EQ(row_group.columns.size(), 4);
+        for (int column = 0; column < 4; ++column) {
+            const auto& meta = row_group.columns[column].meta_data;
+            ParquetBlockSplitBloomFilter filter;
+            bool has_filter = false;
+            int64_t read_bytes = 0;
+            ASSERT_TRUE(filter.read(file_reader, meta, nullptr, &has_filter, &read_bytes).ok());
+            ASSERT_TRUE(has_filter);
+            EXPECT_EQ(filter.num_bytes(), 1024);
+            // a header of 16 bytes and the bitset
+            EXPECT_EQ(read_bytes, 1040);
+
+            int first_row = group * kRowsPerGroup;
+            for (int i = first_row; i < first_row + kRowsPerGroup; ++i) {
+                auto value = encode(column, i);
+                EXPECT_TRUE(filter.find_hash(
+                        ParquetBlockSplitBloomFilter::hash(value.data(), value.size())))
+                        << column << " " << i;
+            }
+            // the rows of the other group and rows never written, fpp is 0.01
+            int false_positive = 0;
+            int other_row = (1 - group) * kRowsPerGroup;
+            for (int i = 0; i < 4500; ++i) {
+                auto value = encode(column, i < kRowsPerGroup ? other_row + i : 500 + i);
+                false_positive += filter.find_hash(
+                        ParquetBlockSplitBloomFilter::hash(value.data(), value.size()));
+            }
+            EXPECT_LT(false_positive, 90) << column;
+        }
+    }
+
+    // the predicates on the columns of the file skip the row group without the value
+    const auto& schema = file_metadata->schema();
+    for (int group = 0; group < 2; ++group) {
+        auto read_filter = [&](const std::string& column_name) {
+            const FieldSchema* col_schema = schema.get_column(column_name);
+            ParquetBlockSplitBloomFilter filter;
+            bool has_filter = false;
+            int64_t read_bytes = 0;
+            EXPECT_TRUE(filter.read(file_reader,
+                                    t_metadata.row_groups[group]
+                                            .columns[col_schema->physical_column_index]
+                                            .meta_data,
+                                    nullptr, &has_filter, &read_bytes)
+                                .ok());
+            EXPECT_TRUE(has_filter);
+            return std::make_pair(col_schema, std::move(filter));
+        };
+        // row 700 is in the second group
+        bool expect_filter = group == 0;
+        {
+            auto [col_schema, filter] = read_filter("id");
+            ColumnValueRange<TYPE_INT> range("id");
+            static_cast<void>(range.add_fixed_value(700));
+            EXPECT_EQ(ParquetPredicate::filter_by_bloom_filter(ColumnValueRangeType(range),
+                                                               col_schema, filter),
+                      expect_filter);
+        }
+        {
+            auto [col_schema, filter] = read_filter("big");
+            ColumnValueRange<TYPE_BIGINT> range("big");
+            static_cast<void>(range.add_fixed_value(700L * 1000003));
+            EXPECT_EQ(ParquetPredicate::filter_by_bloom_filter(ColumnValueRangeType(range),
+                                                               col_schema, filter),
+                      expect_filter);
+        }
+        {
+            auto [col_schema, filter] = read_filter("name");
+            std::string name = "name_700";
+            ColumnValueRange<TYPE_STRING> range("name");
+            static_cast<void>(range.add_fixed_value(StringRef(name)));
+            EXPECT_EQ(ParquetPredicate::filter_by_bloom_filter(ColumnValueRangeType(range),
+                                                               col_schema, filter),
+                      expect_filter);
+        }
+        {
+            auto [col_schema, filter] = read_filter("score");
+            ColumnValueRange<TYPE_DOUBLE> range("score");
+            static_cast<void>(range.add_fixed_value(350.0));
+            EXPECT_EQ(ParquetPredicate::filter_by_bloom_filter(ColumnValueRangeType(range),
+                                                               col_schema, filter),
+                      expect_filter);
+        }
+    }
+}
+
+// The row groups skipped by ParquetReader when its value ranges are equal predicates
+TEST_F(ParquetBloomFilterTest, test_reader_prunes_row_groups) {
+    bool old_enable = config::enable_parquet_bloom_filter;
+    Defer defer {[&]() { config::enable_parquet_bloom_filter = old_enable; }};
+
+    io::FileReaderSPtr file_reader;
+    ASSERT_TRUE(io::global_local_filesystem()->open_file(kBloomFilterFile, &file_reader).ok());
+    cctz::time_zone ctz;
+    TimezoneUtils::find_cctz_time_zone(TimezoneUtils::default_time_zone, ctz);
+    std::vector<std::string> column_names = {"id", "big", "name", "score"};
+
+    // the row groups read, and the row groups skipped by bloom filter
+    auto prune = [&](const std::unordered_map<std::string, ColumnValueRangeType>& ranges) {
+        TFileScanRangeParams scan_params;
+        TFileRangeDesc scan_range;
+        scan_range.path = kBloomFilterFile;
+        scan_range.start_offset = 0;
+        scan_range.size = file_reader->size();
+        ParquetReader reader(nullptr, scan_params, scan_range, 992, &ctz, nullptr, nullptr);
+        reader.set_file_reader(file_reader);
+        std::vector<int32_t> read_groups;
+        auto st = reader.init_reader(column_names, &ranges, {}, nullptr, nullptr, nullptr,
+                                     nullptr, nullptr);
+        if (st.ok()) {
+            for (const auto& group : reader._read_row_groups) {
+                read_groups.push_back(group.row_group_id);
+            }
+        } else {
+            EXPECT_TRUE(st.is<ErrorCode::END_OF_FILE>()) << st;
+        }
+        return std::make_pair(read_groups, reader._statistics.filtered_row_groups_by_bloom_filter);
+    };
+
+    ColumnValueRange<TYPE_INT> id_700("id");
+    static_cast<void>(id_700.add_fixed_value(700));
+    std::string name_20 = "name_20";
+    std::string name_missing = "name_missing";
+    ColumnValueRange<TYPE_STRING> name_20_or_missing("name");
+    static_cast<void>(name_20_or_missing.add_fixed_value(StringRef(name_20)));
+    static_cast<void>(name_20_or_missing.add_fixed_value(StringRef(name_missing)));
+    ColumnValueRange<TYPE_BIGINT> big_missing("big");
+    static_cast<void>(big_missing.add_fixed_value(1));
+
+    config::enable_parquet_bloom_filter = false;
+    EXPECT_EQ(prune({{"id", id_700}}), std::make_pair(std::vector<int32_t> {0, 1}, 0));
+
+    config::enable_parquet_bloom_filter = true;
+    EXPECT_EQ(prune({{"id", id_700}}), std::make_pair(std::vector<int32_t> {1}, 1));
+    EXPECT_EQ(prune({{"name", name_20_or_missing}}),
+              std::make_pair(std::vector<int32_t> {0}, 1));
+    EXPECT_EQ(prune({{"big", big_missing}}), std::make_pair(std::vector<int32_t> {}, 2));
+    // a range predicate does not use bloom filters
+    ColumnValueRange<TYPE_INT> id_scope("id");
+    EXPECT_EQ(prune({{"id", id_scope}}), std::make_pair(std::vector<int32_t> {0, 1}, 0));
+}
+
+} // namespace doris::vectorized
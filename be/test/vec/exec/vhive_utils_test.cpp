@@ -19,6 +19,9 @@
 
 #include <gtest/gtest.h>
 
+#include "testutil/column_helper.h"
+#include "vec/data_types/data_type_number.h"
+
 namespace doris::vectorized {
 
 class VHiveUtilsTest : public testing::Test {
@@ -67,4 +70,27 @@ TEST_F(VHiveUtilsTest, test_make_partition_name) {
     }
 }
 
+TEST_F(VHiveUtilsTest, test_group_rows_by_columns) {
+    Block block;
+    block.insert(ColumnHelper::create_nullable_column_with_name<DataTypeInt32>(
+            {1, 2, 1, 1, 3, 2, 0, 0}, {0, 0, 0, 0, 0, 0, 1, 1}));
+    block.insert(ColumnHelper::create_column_with_name<DataTypeString>(
+            {"a", "b", "a", "c", "a", "b", "a", "a"}));
+
+    std::vector<IColumn::Selector> groups;
+    VHiveUtils::group_rows_by_columns(block, {0, 1}, &groups);
+    ASSERT_EQ(groups.size(), 5);
+    std::vector<std::vector<uint64_t>> expected = {{0, 2}, {1, 5}, {3}, {4}, {6, 7}};
+    for (size_t i = 0; i < groups.size(); ++i) {
+        EXPECT_EQ(std::vector<uint64_t>(groups[i].begin(), groups[i].end()), expected[i]);
+    }
+
+    VHiveUtils::group_rows_by_columns(block, {1}, &groups);
+    ASSERT_EQ(groups.size(), 3);
+    EXPECT_EQ(groups[0].size(), 5);
+
+    VHiveUtils::group_rows_by_columns(Block(), {}, &groups);
+    EXPECT_TRUE(groups.empty());
+}
+
 } // namespace doris::vectorized
@@ -0,0 +1,71 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/json/parse2column.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_variant.h"
+
+namespace doris::vectorized {
+
+TEST(Parse2ColumnTest, BatchMatchesRowByRow) {
+    std::vector<std::string> rows = {R"({"a":1,"b":"x"})",
+                                     R"({"b":"y","c":1.5})",
+                                     "",
+                                     R"({"a":2,"b":"z","c":2.5})",
+                                     R"({"d":{"e":[1,2]}})",
+                                     R"({"a":3})"};
+    auto raw_json_column = ColumnString::create();
+    for (const auto& row : rows) {
+        raw_json_column->insert_data(row.data(), row.size());
+    }
+    ParseConfig config;
+
+    auto batch = ColumnVariant::create(true);
+    parse_json_to_variant(*batch, *raw_json_column, config);
+
+    auto row_by_row = ColumnVariant::create(true);
+    JsonParser parser;
+    for (const auto& row : rows) {
+        parse_json_to_variant(*row_by_row, StringRef(row.data(), row.size()), &parser, config);
+    }
+
+    ASSERT_EQ(batch->size(), rows.size());
+    ASSERT_EQ(row_by_row->size(), rows.size());
+    ASSERT_EQ(batch->get_subcolumns().size(), row_by_row->get_subcolumns().size());
+    for (const auto& entry : row_by_row->get_subcolumns()) {
+        const auto* subcolumn = batch->get_subcolumn(entry->path);
+        ASSERT_NE(subcolumn, nullptr) << entry->path.get_path();
+        ASSERT_EQ(subcolumn->size(), rows.size()) << entry->path.get_path();
+        EXPECT_EQ(subcolumn->get_least_common_type()->get_name(),
+                  entry->data.get_least_common_type()->get_name());
+        for (size_t i = 0; i < rows.size(); ++i) {
+            Field expected;
+            Field actual;
+            entry->data.get(i, expected);
+            subcolumn->get(i, actual);
+            EXPECT_EQ(actual, expected) << entry->path.get_path() << " row " << i;
+        }
+    }
+}
+
+} // namespace doris::vectorized
@@ -20,9 +20,12 @@
 #include <gtest/gtest-message.h>
 #include <gtest/gtest-test-part.h>
 
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest_pred_impl.h"
+#include "vec/functions/date_format_type.h"
 
 namespace doris::vectorized {
 
@@ -878,4 +881,108 @@ TEST(VDateTimeValueTest, datetime_diff_test) {
     }
 }
 
+template <typename DateType>
+void check_format_program(const DateType& value, const std::string& format) {
+    char buf[100 + SAFE_FORMAT_STRING_MARGIN];
+    bool ok = value.to_format_string_conservative(format.data(), format.size(), buf,
+                                                  100 + SAFE_FORMAT_STRING_MARGIN);
+
+    time_format_type::FormatProgram program;
+    ASSERT_TRUE(program.compile(format)) << format;
+    char program_buf[time_format_type::FormatProgram::MAX_OUTPUT_LENGTH];
+    char* end = program.execute(value, program_buf);
+    ASSERT_EQ(ok, end != nullptr) << format;
+    if (ok) {
+        EXPECT_EQ(std::string(buf), std::string(program_buf, end)) << format;
+    }
+}
+
+TEST(VDateTimeValueTest, format_program_test) {
+    std::vector<std::string> formats = {"%Y/%m/%d",
+                                        "%y%m%d %H%i%s",
+                                        "%Y-%m-%d %H:%i:%s.%f",
+                                        "%c/%e/%Y %k:%i %p",
+                                        "%l o'clock %h %I %S",
+                                        "%M %e, %Y %T",
+                                        "%r",
+                                        "100%% %Z%",
+                                        "plain text",
+                                        ""};
+    DateV2Value<DateTimeV2ValueType> datetime_v2;
+    DateV2Value<DateV2ValueType> date_v2;
+    VecDateTimeValue datetime;
+    for (const auto* str : {"2024-03-05 07:08:09.012345", "1999-12-31 23:59:59.999999",
+                            "0001-01-01 00:00:00", "2020-11-20 12:00:00"}) {
+        ASSERT_TRUE(datetime_v2.from_date_str(str, (int)strlen(str), 6));
+        ASSERT_TRUE(date_v2.from_date_str(str, (int)strlen(str)));
+        ASSERT_TRUE(datetime.from_date_str(str, 19));
+        for (const auto& format : formats) {
+            check_format_program(datetime_v2, format);
+            check_format_program(date_v2, format);
+            check_format_program(datetime, format);
+        }
+    }
+
+    time_format_type::FormatProgram program;
+    // weekday and week specifiers are not compiled
+    EXPECT_FALSE(program.compile("%Y %W"));
+    EXPECT_FALSE(program.compiled());
+    EXPECT_FALSE(program.compile(std::string(101, 'a')));
+    EXPECT_TRUE(program.compile(std::string(100, 'a')));
+}
+
+template <typename T>
+void check_parse_program(const std::string& format, const std::string& value, bool fast) {
+    time_format_type::ParseProgram program;
+    ASSERT_TRUE(program.compile(format.data(), format.size(),
+                                std::is_same_v<T, DateTimeV2ValueType>))
+            << format;
+    DateV2Value<T> expected;
+    bool ok = expected.from_date_format_str(format.data(), (int)format.size(), value.data(),
+                                            value.size());
+    DateV2Value<T> parsed;
+    bool parsed_fast = program.execute(value.data(), value.size(), parsed);
+    EXPECT_EQ(fast, parsed_fast) << format << " " << value;
+    if (parsed_fast) {
+        // the fast path never accepts a value which from_date_format_str rejects
+        ASSERT_TRUE(ok) << format << " " << value;
+        EXPECT_EQ(expected.to_date_int_val(), parsed.to_date_int_val()) << format << " " << value;
+    }
+}
+
+TEST(VDateTimeValueTest, parse_program_test) {
+    using DateTime = DateTimeV2ValueType;
+    using Date = DateV2ValueType;
+    check_parse_program<DateTime>("%Y-%m-%d %H:%i:%s", "2024-03-05 07:08:09", true);
+    check_parse_program<DateTime>("%Y-%m-%d %H:%i:%s", "2024-03-05   07:08:09", true);
+    check_parse_program<DateTime>("%Y-%m-%d %H:%i:%s", " 2024-03-05 07:08:09", true);
+    check_parse_program<DateTime>("%Y%m%d%H%i%s", "20240305070809", true);
+    check_parse_program<DateTime>("%d/%m/%Y", "05/03/2024", true);
+    check_parse_program<Date>("%Y-%m-%d", "2024-02-29", true);
+    check_parse_program<Date>("%Y%m%d", "20240305", true);
+
+    // left to from_date_format_str
+    check_parse_program<DateTime>("%Y-%m-%d %H:%i:%s", "2024-3-5 7:8:9", false);
+    check_parse_program<DateTime>("%Y-%m-%d %H:%i:%s", "2024-03-05", false);
+    check_parse_program<DateTime>("%Y-%m-%d %H:%i:%s", "2024-03-05 07:08:09 ", false);
+    check_parse_program<DateTime>("%Y-%m-%d %H:%i:%s", "2024-03-05 07:08:09.123", false);
+    check_parse_program<DateTime>("%Y-%m-%d %H:%i:%s", "2024-03-05 25:08:09", false);
+    check_parse_program<DateTime>("%Y-%m-%d %H:%i:%s", "2024/03/05 07:08:09", false);
+    check_parse_program<Date>("%Y-%m-%d", "2023-02-29", false);
+    check_parse_program<Date>("%Y-%m-%d", "24-02-01", false);
+    check_parse_program<Date>("%Y-%m-%d", "", false);
+
+    time_format_type::ParseProgram program;
+    // names, 12 hour clock, fractions and partial dates are not compiled
+    for (const std::string format : {"%Y-%M-%d", "%Y-%m-%d %h:%i:%s %p", "%Y-%m-%d %H:%i:%s.%f",
+                                     "%Y-%m", "%Y-%m-%d %%", "%Y-%m-%d%", "%Y-%m-%d %Y"}) {
+        EXPECT_FALSE(program.compile(format.data(), format.size(), true)) << format;
+        EXPECT_FALSE(program.compiled());
+    }
+    // time parts make from_date_format_str fail for dates
+    std::string format = "%Y-%m-%d %H";
+    EXPECT_FALSE(program.compile(format.data(), format.size(), false));
+    EXPECT_TRUE(program.compile(format.data(), format.size(), true));
+}
+
 } // namespace doris::vectorized
@@ -0,0 +1,234 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/sink/writer/vhive_table_writer.h"
+
+#include <arrow/memory_pool.h>
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "io/fs/local_file_system.h"
+#include "runtime/exec_env.h"
+#include "testutil/column_helper.h"
+#include "testutil/mock/mock_runtime_state.h"
+#include "testutil/mock/mock_slot_ref.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/sink/writer/vhive_partition_writer.h"
+
+namespace doris::vectorized {
+
+class VHiveTableWriterTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _max_partition_nums = config::table_sink_partition_write_max_partition_nums_per_writer;
+        _close_cold_writers = config::enable_table_sink_close_cold_partition_writers;
+        _max_file_size = config::hive_sink_max_file_size;
+        if (ExecEnv::GetInstance()->_arrow_memory_pool == nullptr) {
+            ExecEnv::GetInstance()->_arrow_memory_pool = arrow::default_memory_pool();
+            _set_arrow_memory_pool = true;
+        }
+
+        auto st = io::global_local_filesystem()->delete_directory(_test_dir);
+        ASSERT_TRUE(st.ok()) << st;
+        for (const auto& partition : {"p=a", "p=b", "p=c", "p=__HIVE_DEFAULT_PARTITION__"}) {
+            st = io::global_local_filesystem()->create_directory(_test_dir + "/" + partition);
+            ASSERT_TRUE(st.ok()) << st;
+        }
+        _profile.create_child("CustomCounters", true, true);
+    }
+
+    void TearDown() override {
+        config::table_sink_partition_write_max_partition_nums_per_writer = _max_partition_nums;
+        config::enable_table_sink_close_cold_partition_writers = _close_cold_writers;
+        config::hive_sink_max_file_size = _max_file_size;
+        if (_set_arrow_memory_pool) {
+            ExecEnv::GetInstance()->_arrow_memory_pool = nullptr;
+        }
+        static_cast<void>(io::global_local_filesystem()->delete_directory(_test_dir));
+    }
+
+    // A table of a regular int column id and a partition string column p, written as parquet
+    // into local directories.
+    std::unique_ptr<VHiveTableWriter> _create_writer() {
+        std::vector<THiveColumn> columns(2);
+        columns[0].__set_name("id");
+        columns[0].__set_column_type(THiveColumnType::REGULAR);
+        columns[1].__set_name("p");
+        columns[1].__set_column_type(THiveColumnType::PARTITION_KEY);
+        THiveLocationParams location;
+        location.__set_write_path(_test_dir);
+        location.__set_original_write_path(_test_dir);
+        location.__set_target_path(_test_dir);
+        location.__set_file_type(TFileType::FILE_LOCAL);
+        THiveTableSink hive_table_sink;
+        hive_table_sink.__set_columns(columns);
+        hive_table_sink.__set_location(location);
+        hive_table_sink.__set_file_format(TFileFormatType::FORMAT_PARQUET);
+        hive_table_sink.__set_compression_type(TFileCompressType::PLAIN);
+        hive_table_sink.__set_hadoop_config({});
+        TDataSink t_sink;
+        t_sink.__set_hive_table_sink(hive_table_sink);
+
+        auto output_exprs = MockSlotRef::create_mock_contexts(
+                DataTypes {std::make_shared<DataTypeInt32>(),
+                           std::make_shared<DataTypeNullable>(std::make_shared<DataTypeString>())});
+        auto writer = std::make_unique<VHiveTableWriter>(t_sink, output_exprs, nullptr, nullptr);
+        writer->_operator_profile = &_profile;
+        return writer;
+    }
+
+    static Block _create_block(const std::vector<int32_t>& ids,
+                               const std::vector<std::string>& partitions,
+                               const std::vector<uint8_t>& nulls) {
+        Block block;
+        block.insert(ColumnHelper::create_column_with_name<DataTypeInt32>(ids));
+        block.insert(
+                ColumnHelper::create_nullable_column_with_name<DataTypeString>(partitions, nulls));
+        return block;
+    }
+
+    static Block _create_block(const std::vector<int32_t>& ids,
+                               const std::vector<std::string>& partitions) {
+        return _create_block(ids, partitions, std::vector<uint8_t>(ids.size(), 0));
+    }
+
+    static std::set<std::string> _open_partitions(const VHiveTableWriter& writer) {
+        std::set<std::string> partitions;
+        for (const auto& [partition_name, _] : writer._partitions_to_writers) {
+            partitions.insert(partition_name);
+        }
+        return partitions;
+    }
+
+    const std::string _test_dir = "./ut_dir/vhive_table_writer_test";
+    MockRuntimeState _state;
+    RuntimeProfile _profile {"HiveTableSink"};
+
+private:
+    int32_t _max_partition_nums = 0;
+    bool _close_cold_writers = false;
+    int64_t _max_file_size = 0;
+    bool _set_arrow_memory_pool = false;
+};
+
+TEST_F(VHiveTableWriterTest, TooManyPartitions) {
+    config::table_sink_partition_write_max_partition_nums_per_writer = 2;
+    config::enable_table_sink_close_cold_partition_writers = false;
+    auto writer = _create_writer();
+    ASSERT_TRUE(writer->open(&_state, &_profile).ok());
+
+    auto block = _create_block({1, 2, 3}, {"a", "b", "a"});
+    auto st = writer->write(&_state, block);
+    ASSERT_TRUE(st.ok()) << st;
+    block = _create_block({4}, {"c"});
+    st = writer->write(&_state, block);
+    EXPECT_FALSE(st.ok());
+    EXPECT_TRUE(st.to_string().find("Too many open partitions") != std::string::npos) << st;
+    EXPECT_EQ(_open_partitions(*writer), std::set<std::string>({"p=a", "p=b"}));
+    EXPECT_TRUE(_state.hive_partition_updates().empty());
+
+    st = writer->close(Status::OK());
+    ASSERT_TRUE(st.ok()) << st;
+    EXPECT_EQ(_state.hive_partition_updates().size(), 2);
+}
+
+TEST_F(VHiveTableWriterTest, CloseColdPartitionWriter) {
+    config::table_sink_partition_write_max_partition_nums_per_writer = 2;
+    config::enable_table_sink_close_cold_partition_writers = true;
+    auto writer = _create_writer();
+    ASSERT_TRUE(writer->open(&_state, &_profile).ok());
+
+    auto block = _create_block({1, 2, 3}, {"a", "b", "a"});
+    ASSERT_TRUE(writer->write(&_state, block).ok());
+    block = _create_block({4}, {"a"});
+    ASSERT_TRUE(writer->write(&_state, block).ok());
+
+    // b is the least recently written partition
+    block = _create_block({5, 6}, {"c", "c"});
+    auto st = writer->write(&_state, block);
+    ASSERT_TRUE(st.ok()) << st;
+    EXPECT_EQ(_open_partitions(*writer), std::set<std::string>({"p=a", "p=c"}));
+    auto updates = _state.hive_partition_updates();
+    ASSERT_EQ(updates.size(), 1);
+    EXPECT_EQ(updates[0].name, "p=b");
+    EXPECT_EQ(updates[0].row_count, 1);
+
+    // reopening b closes a, and writes b into a new file
+    block = _create_block({7}, {"b"});
+    st = writer->write(&_state, block);
+    ASSERT_TRUE(st.ok()) << st;
+    EXPECT_EQ(_open_partitions(*writer), std::set<std::string>({"p=b", "p=c"}));
+    updates = _state.hive_partition_updates();
+    ASSERT_EQ(updates.size(), 2);
+    EXPECT_EQ(updates[1].name, "p=a");
+    EXPECT_EQ(updates[1].row_count, 3);
+    EXPECT_EQ(writer->_write_file_count, 4);
+
+    // the writers of b and c are written by this block, none of them can be closed for a
+    block = _create_block({8, 9, 10}, {"b", "c", "a"});
+    st = writer->write(&_state, block);
+    EXPECT_FALSE(st.ok());
+    EXPECT_TRUE(st.to_string().find("Too many open partitions") != std::string::npos) << st;
+
+    st = writer->close(Status::OK());
+    ASSERT_TRUE(st.ok()) << st;
+    updates = _state.hive_partition_updates();
+    ASSERT_EQ(updates.size(), 4);
+    std::map<std::string, int64_t> partition_rows;
+    std::set<std::string> file_names;
+    for (const auto& update : updates) {
+        partition_rows[update.name] += update.row_count;
+        ASSERT_EQ(update.file_names.size(), 1);
+        file_names.insert(update.file_names[0]);
+    }
+    EXPECT_EQ(partition_rows, (std::map<std::string, int64_t> {{"p=a", 3}, {"p=b", 2}, {"p=c", 2}}));
+    EXPECT_EQ(file_names.size(), 4);
+}
+
+TEST_F(VHiveTableWriterTest, RollOverPartitionInBlock) {
+    auto writer = _create_writer();
+    ASSERT_TRUE(writer->open(&_state, &_profile).ok());
+
+    auto block = _create_block({1, 2}, {"", ""});
+    ASSERT_TRUE(writer->write(&_state, block).ok());
+    ASSERT_EQ(writer->_write_file_count, 1);
+
+    // a null and an empty partition value are two groups of rows with the same partition name,
+    // the file is rolled over once for both of them
+    config::hive_sink_max_file_size = 0;
+    block = _create_block({3, 4, 5, 6}, {"", "", "", ""}, {1, 0, 1, 0});
+    auto st = writer->write(&_state, block);
+    ASSERT_TRUE(st.ok()) << st;
+    EXPECT_EQ(writer->_write_file_count, 2);
+    EXPECT_EQ(_open_partitions(*writer),
+              std::set<std::string>({"p=__HIVE_DEFAULT_PARTITION__"}));
+
+    st = writer->close(Status::OK());
+    ASSERT_TRUE(st.ok()) << st;
+    auto updates = _state.hive_partition_updates();
+    ASSERT_EQ(updates.size(), 2);
+    EXPECT_EQ(updates[0].name, "p=__HIVE_DEFAULT_PARTITION__");
+    EXPECT_EQ(updates[0].row_count, 2);
+    EXPECT_EQ(updates[1].name, "p=__HIVE_DEFAULT_PARTITION__");
+    EXPECT_EQ(updates[1].row_count, 4);
+    ASSERT_EQ(updates[1].file_names.size(), 1);
+    EXPECT_TRUE(updates[1].file_names[0].find("-1.") != std::string::npos)
+            << updates[1].file_names[0];
+}
+
+} // namespace doris::vectorized